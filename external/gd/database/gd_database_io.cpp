@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "../gd_database_record.h"
 
 #include "gd_database_io.h"
@@ -24,13 +26,146 @@ static void prepare_columns_s(const gd::database::record* precord, gd::table::ta
    }
 }
 
+/// How value in record column is copied to table column
+enum enumCopy
+{
+   eCopyFixed   = 0,   ///< same fixed size type in record and table, value bytes are copied into row buffer
+   eCopySet     = 1,   ///< same type, value is set through variant_view
+   eCopyConvert = 2,   ///< type differs, value is converted to table column type
+};
+
+/// Copy plan for column, computed once before rows are read
+struct copy_column
+{
+   unsigned m_uRead;          ///< column index in record
+   unsigned m_uWrite;         ///< column index in table
+   unsigned m_uCopy;          ///< copy type, value from enumCopy
+   unsigned m_uSize;          ///< bytes to copy for fixed values
+   unsigned m_uPosition;      ///< value offset in table row for fixed values
+   const uint8_t* m_puValue;  ///< record buffer for fixed values
+};
+
+/// Generate copy plan for columns read from record and written to table
+static std::vector<copy_column> prepare_copy_s( const gd::database::record* precord, const gd::table::dto::table* ptable, const std::vector<unsigned>& vectorRead, const std::vector<unsigned>& vectorWrite )
+{                                                                                                  assert( vectorRead.size() == vectorWrite.size() );
+   std::vector<copy_column> vectorCopy;
+   vectorCopy.reserve( vectorRead.size() );
+
+   for( size_t u = 0; u < vectorRead.size(); u++ )
+   {
+      copy_column copy_{ vectorRead[u], vectorWrite[u], eCopyConvert, 0, 0, nullptr };
+      const auto* pcolumnRead = precord->get_column( copy_.m_uRead );
+      const auto* pcolumnWrite = ptable->column_get( copy_.m_uWrite, gd::table::tag_pointer{} );
+      unsigned uTypeRead = pcolumnRead->type() & eColumnType_FilterTypeNumber;
+
+      if( uTypeRead == pcolumnWrite->ctype_number() )
+      {
+         copy_.m_uCopy = eCopySet;
+         // ## numbers stored in fixed buffer in record and as fixed value in table are copied as bytes
+         bool bNumber = uTypeRead >= eColumnTypeNumberInt16 && uTypeRead <= eColumnTypeNumberCDouble;
+         if( bNumber == true && pcolumnRead->is_fixed() == true && pcolumnWrite->is_fixed() == true && pcolumnWrite->primitive_size() <= pcolumnRead->size_buffer() )
+         {
+            copy_.m_uCopy = eCopyFixed;
+            copy_.m_uSize = pcolumnWrite->primitive_size();
+            copy_.m_uPosition = pcolumnWrite->position();
+            copy_.m_puValue = precord->buffer_get( copy_.m_uRead );
+         }
+      }
+
+      vectorCopy.push_back( copy_ );
+   }
+
+   return vectorCopy;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Read all rows from cursor into table using copy plan
+ *
+ * Rows are reserved in blocks, fixed values are copied straight into the row
+ * buffer and other values are set with one `variant_view` each (no vector with
+ * values is created for rows).
+ *
+ * @param pcursor cursor positioned at first row to read
+ * @param ptable table rows are added to
+ * @param vectorCopy copy plan for columns
+ * @param uMaxRowCount max number of rows to read, cursor is left at next row to read
+ */
+static void load_rows_s( gd::database::cursor_i* pcursor, gd::table::dto::table* ptable, const std::vector<copy_column>& vectorCopy, uint64_t uMaxRowCount )
+{
+   const auto* precord = pcursor->get_record();
+   const bool bNull = ptable->is_null();
+   const bool bAllColumns = vectorCopy.size() == ptable->get_column_count();
+
+   for( uint64_t uReadCount = 0; uReadCount < uMaxRowCount && pcursor->is_valid_row() == true; uReadCount++ )
+   {
+      uint64_t uRow = ptable->get_row_count();
+      if( uRow == ptable->get_reserved_row_count() )                          // reserve block, double size up to max block size
+      {
+         uint64_t uBlock = uRow < 64 ? 64 : ( uRow < 0x10000 ? uRow : 0x10000 );
+         ptable->row_reserve_add( uBlock );
+      }
+      ptable->row_add();
+      if( bNull == true && bAllColumns == false ) ptable->row_set_null( uRow );// columns not in result are null
+
+      uint8_t* puRow = ptable->row_get( uRow );
+      for( const auto& it : vectorCopy )
+      {
+         switch( it.m_uCopy )
+         {
+         case eCopyFixed:
+            if( precord->get_column( it.m_uRead )->is_null() == true )
+            {
+               if( bNull == true ) ptable->cell_set_null( uRow, it.m_uWrite );
+               break;
+            }
+            memcpy( puRow + it.m_uPosition, it.m_puValue, it.m_uSize );
+            if( bNull == true ) ptable->cell_set_not_null( uRow, it.m_uWrite );
+            break;
+         case eCopySet:
+            ptable->cell_set( uRow, it.m_uWrite, precord->get_variant_view( it.m_uRead ) );
+            break;
+         default:
+            ptable->cell_set( uRow, it.m_uWrite, precord->get_variant_view( it.m_uRead ), gd::table::tag_convert{} );
+         }
+      }
+
+      pcursor->next();
+   }
+}
+
 /** ---------------------------------------------------------------------------
  * @brief Fill table with data from cursor
+ * 
+ * How each column is copied is decided once before rows are read, numbers with
+ * same type in result and table are copied directly into table row buffer.
+ * 
  * @param pcursor cursor with data that is inserted into table
  * @param ptable pointer to table that is filled with data
  * @return true if ok, false and error information if not
  */
 std::pair<bool, std::string> to_table(gd::database::cursor_i* pcursor, gd::table::dto::table* ptable)
+{
+   return to_table( pcursor, ptable, std::numeric_limits<uint64_t>::max() );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Fill table with max number of rows from cursor
+ * 
+ * Cursor is left at the row after last row read, call again with same table to
+ * read next batch. This is used to stream large results without holding all rows.
+ * 
+ * @code
+ * table.row_clear();
+ * to_table( pcursor, &table, 1000 );                                           // read next 1000 rows
+ * if( pcursor->is_valid_row() == false ) { ... }                              // no more rows
+ * @endcode
+ * 
+ * @param pcursor cursor with data that is inserted into table
+ * @param ptable pointer to table that is filled with data
+ * @param uMaxRowCount max number of rows read from cursor
+ * @return true if ok, false and error information if not
+ */
+std::pair<bool, std::string> to_table(gd::database::cursor_i* pcursor, gd::table::dto::table* ptable, uint64_t uMaxRowCount)
 {                                                                                                  assert( pcursor != nullptr ); assert( ptable != nullptr );
    const auto* precord = pcursor->get_record();                                                    assert( precord != nullptr );
 
@@ -50,34 +185,31 @@ std::pair<bool, std::string> to_table(gd::database::cursor_i* pcursor, gd::table
    // Match column names, only fill in columns with matching name in table and result
    auto vectorMatch = gd::table::table_column_buffer::column_match_s( vectorTableName, vectorResultName );
 
+   std::vector<unsigned> vectorWriteTable;
+   std::vector<unsigned> vectorReadResult;
+
    if(vectorMatch.empty() == false)                                           // if there are matching columns then fill in only those columns
    {
-      std::vector<unsigned> vectorWriteTable;
-      std::vector<unsigned> vectorReadResult;
-
       for( const auto& it : vectorMatch )
       {
          vectorWriteTable.push_back( it.first );
          vectorReadResult.push_back( it.second );
       }
-
-      while( pcursor->is_valid_row() == true )
-      {
-         auto vectorValue = precord->get_variant_view( vectorReadResult );
-         ptable->row_add( vectorValue, vectorWriteTable, gd::table::tag_convert{} );
-         pcursor->next();
-      }
    }
    else
    {
-      while( pcursor->is_valid_row() == true )                                // if there are no matching columns then fill in all columns
+      unsigned uCount = (unsigned)precord->size();                            // if there are no matching columns then fill in all columns
+      if( uCount > ptable->get_column_count() ) uCount = ptable->get_column_count();
+      for( unsigned u = 0; u < uCount; u++ )
       {
-         auto vectorValue = precord->get_variant_view();
-         ptable->row_add( vectorValue, gd::table::tag_convert{} );
-         pcursor->next();
+         vectorWriteTable.push_back( u );
+         vectorReadResult.push_back( u );
       }
    }
 
+   auto vectorCopy = prepare_copy_s( precord, ptable, vectorReadResult, vectorWriteTable );
+   load_rows_s( pcursor, ptable, vectorCopy, uMaxRowCount );
+
    return { true, std::string() };
 }
 
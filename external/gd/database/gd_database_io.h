@@ -16,6 +16,8 @@
 _GD_DATABASE_BEGIN
 
 std::pair<bool, std::string> to_table(gd::database::cursor_i* pcursor, gd::table::dto::table* ptable);
+/// Fill table with max number of rows from cursor, cursor is left at next row
+std::pair<bool, std::string> to_table(gd::database::cursor_i* pcursor, gd::table::dto::table* ptable, uint64_t uMaxRowCount);
 
 
 _GD_DATABASE_END
\ No newline at end of file
@@ -1003,6 +1003,9 @@ public:
 
    argument operator[](arguments::const_pointer p) { return get_argument(p); }
    const argument operator[](arguments::const_pointer p) const { return get_argument(p); }
+   /// Value for slot from `arguments_index`, name lookup in index is hashed, `args[index_["name"]]`
+   template<typename SLOT, typename = typename SLOT::tag_is_arguments_index_slot>
+   const argument operator[](const SLOT& slot_) const { if( slot_.empty() == true ) { return argument(); } return get_argument(buffer_offset(slot_.offset())); }
    /// returns first found element of those in list
    const argument operator[](std::initializer_list<std::string_view> list_) const { return get_argument( list_ ); }
    /// index operator edit is needed
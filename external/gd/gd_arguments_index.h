@@ -28,9 +28,11 @@
  * ### Key Features
  * - Works with any arguments type that satisfies the buffer interface (template parameter).
  * - Each `slot` stores a `size_t` byte offset and a `string_view` into the buffer (zero-copy).
- * - `build()` iterates the buffer once using `next()`; subsequent access is O(1) by position
- *   or O(n-slots) by name, where each slot comparison is a cheap string_view equality check.
- * - `add()` keeps the index live as values are appended one at a time.
+ * - `build()` iterates the buffer once using `next()`; subsequent access is O(1) by position.
+ * - Name lookup is O(1) through a compact open-addressing hash built alongside the slots
+ *   when index has `m_uHashMin_s` or more slots, smaller indexes compare names in order.
+ * - `add()` keeps the index (and hash) live as values are appended one at a time.
+ * - `arguments` and `shared::arguments` accept slots in `operator[]`, `args[idx["width"]]`.
  *
  * ### Example Usage
  * \code
@@ -70,6 +72,7 @@
 
 #pragma once
 #include <cassert>
+#include <cstdint>
 #include <string_view>
 #include <vector>
 
@@ -124,9 +127,10 @@ args.append("label", "hello");
 gd::argument::arguments_index<gd::argument::arguments> idx;
 idx.build(args);
 
-int x     = idx.get_argument(args, "x").as_int();      // name lookup via slot scan
+int x     = idx.get_argument(args, "x").as_int();      // name lookup, hashed for larger indexes
 int y     = idx.get_argument(args, 1u).as_int();        // direct positional slot
 auto lbl  = idx[2u].get(args).as_string();              // slot then direct buffer read
+auto y_   = args[idx["y"]].as_int();                    // arguments accept slot from index
  \endcode
  */
 template<typename ARGUMENTS>
@@ -154,6 +158,7 @@ public:
    struct slot
    {
       using self = slot;
+      struct tag_is_arguments_index_slot {};        ///< tag dispatcher, arguments accept slots in `operator[]`
 
       slot() : m_uOffset(0) {}
       slot(std::string_view stringName, offset_type uOffset) : m_stringName(stringName), m_uOffset(uOffset) {}
@@ -227,7 +232,7 @@ public: //0TAG0build.arguments_index
    void add(const ARGUMENTS& argumentsSource, offset_type uOffset);
 
    /// Remove all stored slots without releasing vector capacity
-   void clear() noexcept { m_vectorSlot.clear(); }
+   void clear() noexcept { m_vectorSlot.clear(); m_vectorHash.clear(); }
 
    /// Build and return an index for `argumentsSource` (static factory)
    [[nodiscard]] static self build_s(const ARGUMENTS& argumentsSource);
@@ -267,7 +272,7 @@ public: //0TAG0utility.arguments_index
    [[nodiscard]] bool empty() const noexcept { return m_vectorSlot.empty(); }
 
    /// True when a slot with the given name exists in the index
-   [[nodiscard]] bool exists(std::string_view stringName) const { return find_s(m_vectorSlot, stringName) != nullptr; }
+   [[nodiscard]] bool exists(std::string_view stringName) const { return find_(stringName) != nullptr; }
 
    /// True when positional index `uIndex` is within range
    [[nodiscard]] bool exists(size_type uIndex) const { return uIndex < m_vectorSlot.size(); }
@@ -285,10 +290,26 @@ public:
    /// Find the first slot in `vectorSlot` matching `stringName`; returns `nullptr` if not found
    [[nodiscard]] static const slot* find_s(const std::vector<slot>& vectorSlot, std::string_view stringName);
 
+   /// Hash for name, low bits select bucket and high 16 bits are stored as fingerprint
+   [[nodiscard]] static uint64_t hash_s(std::string_view stringName) noexcept;
+
+protected:
+/** \name INTERNAL
+*///@{
+   const slot* find_(std::string_view stringName) const;
+   void hash_add_(size_type uSlot);
+   void hash_build_();
+//@}
+
 
 // ## attributes ---------------------------------------------------------------
 public:
    std::vector<slot> m_vectorSlot;  ///< ordered list of offset slots, one per argument
+   /// open-addressing hash for names, entry is fingerprint (high 16 bits) and slot index + 1 (low 16 bits), 0 = empty bucket
+   std::vector<uint32_t> m_vectorHash;
+
+   inline static size_type m_uHashMin_s = 8;         ///< hash is built when index has this many slots, fewer slots are scanned
+   static constexpr size_type m_uHashMaxSlot_s = 0xFFFF; ///< max slots that fit in hash entry, larger indexes are scanned
 };
 
 
@@ -334,7 +355,7 @@ template<typename ARGUMENTS>
 const typename arguments_index<ARGUMENTS>::slot&
 arguments_index<ARGUMENTS>::operator[](std::string_view stringName) const
 {
-   const slot* pSlot = find_s(m_vectorSlot, stringName);
+   const slot* pSlot = find_(stringName);
    if(pSlot != nullptr) { return *pSlot; }
    static const slot slotEmpty_;
    return slotEmpty_;
@@ -354,6 +375,7 @@ void arguments_index<ARGUMENTS>::build(const ARGUMENTS& argumentsSource)
       if( ARGUMENTS::is_name_s(pPosition) ) { stringName = ARGUMENTS::get_name_s(pPosition); }
       m_vectorSlot.emplace_back(stringName, uOffset);
    }
+   hash_build_();
 }
 
 template<typename ARGUMENTS>
@@ -363,6 +385,11 @@ void arguments_index<ARGUMENTS>::add(const ARGUMENTS& argumentsSource, const_poi
    std::string_view stringName;
    if( ARGUMENTS::is_name_s(pPosition) ) { stringName = ARGUMENTS::get_name_s(pPosition); }
    m_vectorSlot.emplace_back(stringName, uOffset);
+
+   // ## keep hash live, table is rebuilt when it gets more than half full
+   size_type uSize = m_vectorSlot.size();
+   if( uSize >= m_uHashMin_s && uSize <= m_uHashMaxSlot_s && uSize * 2 <= m_vectorHash.size() ) { hash_add_(uSize - 1); }
+   else { hash_build_(); }
 }
 
 template<typename ARGUMENTS>
@@ -393,7 +420,7 @@ template<typename ARGUMENTS>
 typename arguments_index<ARGUMENTS>::argument_type
 arguments_index<ARGUMENTS>::get_argument(const ARGUMENTS& argumentsSource, std::string_view stringName) const
 {
-   const slot* pSlot = find_s(m_vectorSlot, stringName);
+   const slot* pSlot = find_(stringName);
    if( pSlot != nullptr ) { return pSlot->get(argumentsSource); }
    return argument_type();
 }
@@ -409,7 +436,7 @@ template<typename ARGUMENTS>
 const typename arguments_index<ARGUMENTS>::slot*
 arguments_index<ARGUMENTS>::get_slot(std::string_view stringName) const
 {
-   return find_s(m_vectorSlot, stringName);
+   return find_(stringName);
 }
 
 template<typename ARGUMENTS>
@@ -423,7 +450,7 @@ template<typename ARGUMENTS>
 typename arguments_index<ARGUMENTS>::const_pointer
 arguments_index<ARGUMENTS>::get_position(const ARGUMENTS& argumentsSource, std::string_view stringName) const
 {
-   const slot* pSlot = find_s(m_vectorSlot, stringName);
+   const slot* pSlot = find_(stringName);
    if( pSlot != nullptr ) { return pSlot->position(argumentsSource); }
    return nullptr;
 }
@@ -432,10 +459,8 @@ arguments_index<ARGUMENTS>::get_position(const ARGUMENTS& argumentsSource, std::
 template<typename ARGUMENTS>
 int64_t arguments_index<ARGUMENTS>::get_index(std::string_view stringName) const
 {
-   for(size_type u = 0; u < m_vectorSlot.size(); u++)
-   {
-      if(m_vectorSlot[u].name() == stringName) { return static_cast<int64_t>(u); }
-   }
+   const slot* pSlot = find_(stringName);
+   if( pSlot != nullptr ) { return static_cast<int64_t>(pSlot - m_vectorSlot.data()); }
    return -1;
 }
 
@@ -452,6 +477,75 @@ arguments_index<ARGUMENTS>::find_s(const std::vector<slot>& vectorSlot, std::str
    return nullptr;
 }
 
+/// FNV-1a, names are short so this is cheaper than std::hash and gives same value on all platforms
+template<typename ARGUMENTS>
+uint64_t arguments_index<ARGUMENTS>::hash_s(std::string_view stringName) noexcept
+{
+   uint64_t uHash = 0xcbf29ce484222325ull;
+   for( char ch_ : stringName ) { uHash ^= (uint8_t)ch_; uHash *= 0x100000001b3ull; }
+   return uHash;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Find first slot for name, uses hash if built and scans slots if not
+ *
+ * Buckets are probed until empty bucket is found, name is only compared for
+ * entries where the 16 bit fingerprint match.
+ */
+template<typename ARGUMENTS>
+const typename arguments_index<ARGUMENTS>::slot*
+arguments_index<ARGUMENTS>::find_(std::string_view stringName) const
+{
+   if( m_vectorHash.empty() == true ) { return find_s(m_vectorSlot, stringName); }
+
+   uint64_t uHash = hash_s(stringName);
+   uint32_t uFingerprint = uint32_t(uHash >> 48) << 16;
+   size_type uMask = m_vectorHash.size() - 1;
+   for( size_type uBucket = (size_type)uHash & uMask; m_vectorHash[uBucket] != 0; uBucket = (uBucket + 1) & uMask )
+   {
+      uint32_t uEntry = m_vectorHash[uBucket];
+      if( (uEntry & 0xFFFF0000u) == uFingerprint )
+      {
+         const slot* pSlot = &m_vectorSlot[(uEntry & 0xFFFFu) - 1];
+         if( pSlot->m_stringName == stringName ) { return pSlot; }
+      }
+   }
+   return nullptr;
+}
+
+/// Add named slot to hash, slot is skipped if earlier slot has same name (first slot is found)
+template<typename ARGUMENTS>
+void arguments_index<ARGUMENTS>::hash_add_(size_type uSlot)
+{                                                                                                   assert( uSlot < m_uHashMaxSlot_s ); assert( m_vectorHash.empty() == false );
+   std::string_view stringName = m_vectorSlot[uSlot].m_stringName;
+   if( stringName.empty() == true ) return;                                    // unnamed values are only found by position
+
+   uint64_t uHash = hash_s(stringName);
+   uint32_t uFingerprint = uint32_t(uHash >> 48) << 16;
+   size_type uMask = m_vectorHash.size() - 1;
+   size_type uBucket = (size_type)uHash & uMask;
+   for( ; m_vectorHash[uBucket] != 0; uBucket = (uBucket + 1) & uMask )
+   {
+      uint32_t uEntry = m_vectorHash[uBucket];
+      if( (uEntry & 0xFFFF0000u) == uFingerprint && m_vectorSlot[(uEntry & 0xFFFFu) - 1].m_stringName == stringName ) return;
+   }
+   m_vectorHash[uBucket] = uFingerprint | uint32_t(uSlot + 1);
+}
+
+/// Build hash for all slots, table size is power of two with at least twice as many buckets as slots
+template<typename ARGUMENTS>
+void arguments_index<ARGUMENTS>::hash_build_()
+{
+   m_vectorHash.clear();
+   size_type uSize = m_vectorSlot.size();
+   if( uSize < m_uHashMin_s || uSize > m_uHashMaxSlot_s ) return;
+
+   size_type uBucketCount = 16;
+   while( uBucketCount < uSize * 4 ) uBucketCount *= 2;                        // start at quarter load so `add` can insert before rebuild
+   m_vectorHash.assign(uBucketCount, 0);
+   for( size_type u = 0; u < uSize; u++ ) hash_add_(u);
+}
+
 
 // ================================================================================================
 // ================================================================================ type aliases
@@ -712,7 +712,7 @@ std::pair<bool, std::string> cursor::bind_parameter( int iIndex, const gd::varia
          else
          {
             auto value_ = VVValue.as_string();
-            iResult = ::sqlite3_bind_text( m_pstmt, iIndex, value_.c_str(), (int)value_.size(), nullptr );
+            iResult = ::sqlite3_bind_text( m_pstmt, iIndex, value_.c_str(), (int)value_.size(), SQLITE_TRANSIENT ); // temporary string, sqlite need to copy text
          }
       }
       break;
@@ -1,5 +1,6 @@
 #include <stdio.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <fstream>
@@ -7,6 +8,7 @@
 #include <filesystem>
 #include <regex>
 #include <chrono>
+#include <new>
 
 //#undef stat
 
@@ -28,6 +30,10 @@
 #include <unistd.h>
 #endif
 
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
 #include "gd_file.h"
 
 
@@ -973,5 +979,153 @@ void path::normalize_path_s(std::string& stringPath)
 }
 
 
+// ----------------------------------------------------------------------------
+// ------------------------------------------------------------------------ map
+// ----------------------------------------------------------------------------
+
+/** ---------------------------------------------------------------------------
+ * @brief Open file and make content available in `data()`
+ *
+ * Files from `m_uMapLimit_s` and larger are memory mapped, smaller files are read
+ * into the internal buffer. Mapped files are marked for sequential access.
+ *
+ * @param stringFileName file to open
+ * @param uFlags flags from `enumFlag`, `eFlagTerminate` guarantees zero after data
+ * @return true if ok, false and error information if file could not be read
+ */
+std::pair<bool, std::string> map::open( const std::string_view& stringFileName, unsigned uFlags )
+{
+   close();
+
+   std::filesystem::path pathFile( stringFileName );
+   std::error_code errorcode_;
+   uint64_t uSize = std::filesystem::file_size( pathFile, errorcode_ );
+   if( errorcode_ ) return { false, errorcode_.message() + " " + std::string( stringFileName ) };
+
+   if( uSize == 0 ) return { true, "" };                                       // empty file, data points to empty string
+
+#ifdef WIN32
+   SYSTEM_INFO systeminfo_;
+   ::GetSystemInfo( &systeminfo_ );
+   uint64_t uPageSize = systeminfo_.dwPageSize;
+#else
+   uint64_t uPageSize = (uint64_t)::sysconf( _SC_PAGESIZE );
+#endif
+
+   // ## select if file is mapped or read into buffer, mapped files need space after end to be terminated
+   bool bMap = uSize >= m_uMapLimit_s;
+   if( bMap == true && ( uFlags & eFlagTerminate ) && ( uSize % uPageSize ) == 0 ) bMap = false;
+
+#ifdef WIN32
+   HANDLE hFile = ::CreateFileW( pathFile.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+   if( hFile == INVALID_HANDLE_VALUE ) return { false, "Failed to open file: " + std::string( stringFileName ) };
+
+   if( bMap == true )
+   {
+      HANDLE hMap = ::CreateFileMappingW( hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+      if( hMap != nullptr )
+      {
+         m_pMap = ::MapViewOfFile( hMap, FILE_MAP_READ, 0, 0, 0 );
+         ::CloseHandle( hMap );                                                // view keeps mapping alive
+      }
+   }
+
+   if( m_pMap == nullptr )                                                     // read into buffer if small or mapping failed
+   {
+      char* pbszBuffer = reserve_buffer( uSize );
+      uint64_t uRead = 0;
+      while( uRead < uSize )
+      {
+         DWORD dwRead = 0;
+         DWORD dwChunk = (DWORD)std::min<uint64_t>( uSize - uRead, 0x4000'0000 );
+         if( ::ReadFile( hFile, pbszBuffer + uRead, dwChunk, &dwRead, nullptr ) == FALSE || dwRead == 0 ) break;
+         uRead += dwRead;
+      }
+      uSize = uRead;
+      pbszBuffer[uSize] = '\0';
+      m_pbszData = pbszBuffer;
+   }
+   else { m_pbszData = (const char*)m_pMap; }
+
+   ::CloseHandle( hFile );
+#else
+   std::string stringFile( stringFileName );
+   int iFileHandle = ::open( stringFile.c_str(), O_RDONLY );
+   if( iFileHandle < 0 ) return { false, "Failed to open file: " + stringFile + " " + std::strerror( errno ) };
+
+   if( bMap == true )
+   {
+      void* pMap = ::mmap( nullptr, uSize, PROT_READ, MAP_PRIVATE, iFileHandle, 0 );
+      if( pMap != MAP_FAILED )
+      {
+         ::madvise( pMap, uSize, MADV_SEQUENTIAL );
+         m_pMap = pMap;
+      }
+   }
+
+   if( m_pMap == nullptr )                                                     // read into buffer if small or mapping failed
+   {
+      char* pbszBuffer = reserve_buffer( uSize );
+      uint64_t uRead = 0;
+      while( uRead < uSize )
+      {
+         auto iRead = ::read( iFileHandle, pbszBuffer + uRead, uSize - uRead );
+         if( iRead <= 0 ) break;
+         uRead += (uint64_t)iRead;
+      }
+      uSize = uRead;
+      pbszBuffer[uSize] = '\0';
+      m_pbszData = pbszBuffer;
+   }
+   else { m_pbszData = (const char*)m_pMap; }
+
+   ::close( iFileHandle );                                                     // mapping is valid after file is closed
+#endif
+
+   m_uSize = uSize;
+
+   return { true, "" };
+}
+
+/// Release mapped memory, buffer is kept to be reused for next file unless it is larger than `m_uBufferKeepLimit_s`
+void map::close()
+{
+   if( m_pMap != nullptr )
+   {
+#ifdef WIN32
+      ::UnmapViewOfFile( m_pMap );
+#else
+      ::munmap( m_pMap, m_uSize );
+#endif
+      m_pMap = nullptr;
+   }
+
+   if( m_uBufferCapacity > m_uBufferKeepLimit_s ) free_buffer();             // large files are rare, do not keep memory for them
+
+   m_pbszData = "";
+   m_uSize = 0;
+}
+
+/// Make sure buffer can hold `uSize` bytes and zero terminator, buffer is aligned to cache line
+char* map::reserve_buffer( uint64_t uSize )
+{
+   if( uSize + 1 > m_uBufferCapacity )
+   {
+      free_buffer();
+      m_uBufferCapacity = ( uSize + 1 + 63 ) & ~uint64_t( 63 );
+      m_pbszBuffer = (char*)::operator new( m_uBufferCapacity, std::align_val_t{ 64 } );
+   }
+
+   return m_pbszBuffer;
+}
+
+void map::free_buffer()
+{
+   if( m_pbszBuffer != nullptr ) ::operator delete( m_pbszBuffer, std::align_val_t{ 64 } );
+   m_pbszBuffer = nullptr;
+   m_uBufferCapacity = 0;
+}
+
+
 _GD_FILE_END
 
@@ -291,4 +291,71 @@ inline bool operator!=(const path& p, const std::filesystem::path& p_) { return
 inline bool operator!=(const std::filesystem::path& p_, const path& p) { return !(p_ == p); }
 
 
+// ----------------------------------------------------------------------------
+// ------------------------------------------------------------------------ map
+// ----------------------------------------------------------------------------
+
+/**
+ * \brief Read only view of file content, large files are memory mapped and small files are read into buffer
+ *
+ * Mapping has a cost (page table setup and unmap) so files below `m_uMapLimit_s`
+ * are read with one read into an aligned buffer. The buffer is kept between
+ * `open` calls, reuse the same object when many files are scanned. Buffers larger
+ * than `m_uBufferKeepLimit_s` are released in `close`, a large file read into
+ * buffer does not keep its memory while small files are scanned.
+ *
+ * With `eFlagTerminate` the byte after data is guaranteed to be zero. Mapped files
+ * get zeros after end in the last page, files where size is a multiple of page
+ * size are read into buffer. Use this when data is compared with c-string methods
+ * like `strncmp` that may read past the end of text.
+ *
+ * @code
+ * gd::file::map map_;
+ * auto result_ = map_.open( "source.cpp", gd::file::map::eFlagTerminate );
+ * if( result_.first == true ) { auto uCount = gd::parse::count_character_g( map_.string_view(), '\n' ); }
+ * @endcode
+ */
+struct map
+{
+   enum enumFlag
+   {
+      eFlagTerminate = 0x01,   ///< byte after data is zero
+   };
+
+   // ## construction ------------------------------------------------------------
+   map() {}
+   ~map() { close(); free_buffer(); }
+   map( const map& ) = delete;
+   map& operator=( const map& ) = delete;
+
+   // ## methods -----------------------------------------------------------------
+   const char* data() const { return m_pbszData; }
+   uint64_t size() const { return m_uSize; }
+   bool empty() const { return m_uSize == 0; }
+   const char* begin() const { return m_pbszData; }
+   const char* end() const { return m_pbszData + m_uSize; }
+   std::string_view string_view() const { return std::string_view( m_pbszData, m_uSize ); }
+   bool is_mapped() const { return m_pMap != nullptr; } ///< true if data is memory mapped
+
+   /// open file and make content available in `data()`
+   std::pair<bool, std::string> open( const std::string_view& stringFileName, unsigned uFlags = 0 );
+   /// release mapping, buffer is kept for next file if not larger than `m_uBufferKeepLimit_s`
+   void close();
+
+   /// make sure buffer holds `uSize` bytes and a zero terminator
+   char* reserve_buffer( uint64_t uSize );
+   void free_buffer();
+
+   // ## attributes --------------------------------------------------------------
+   const char* m_pbszData = "";     ///< file content, points to mapped memory or buffer
+   uint64_t m_uSize = 0;            ///< file size
+   void* m_pMap = nullptr;          ///< start of mapped memory, null if data is in buffer
+   char* m_pbszBuffer = nullptr;    ///< buffer for small files, aligned to cache line
+   uint64_t m_uBufferCapacity = 0;  ///< size of buffer
+
+   inline static uint64_t m_uMapLimit_s = 64 * 1024; ///< files below this size are read into buffer
+   inline static uint64_t m_uBufferKeepLimit_s = 256 * 1024; ///< buffer larger than this is released when file is closed
+};
+
+
 _GD_FILE_END
@@ -1,9 +1,11 @@
 #include <cassert>
 #include <cstdarg>
 #include <chrono>
+#include <cstring>
 #include <stdarg.h>
 
 #include "gd_log_logger.h"
+#include "gd_log_logger_binary.h"
 
 
 #if defined( __clang__ )
@@ -872,6 +874,269 @@ std::unique_ptr<char> message::printf_s(const wchar_t* pwszFormat, va_list va_li
 
 
 
+// ================================================================================================
+// ================================================================================= i_printer
+// ================================================================================================
+
+/// Generate text for deferred message and print it as text message
+bool i_printer::print_binary( const binary_view& binary_ )
+{
+   std::string stringText = binary_render_g( binary_ );
+   message message_( binary_.m_uSeverity, eMessageTypeAll );
+   message_.m_pbszTextView = stringText.c_str();
+   return print( message_ );
+}
+
+
+// ================================================================================================
+// ================================================================================= async_queue
+// ================================================================================================
+
+namespace {
+   /// rings for calling thread, rings are marked as closed when thread exits and consumer removes them when they are empty
+   struct thread_ring
+   {
+      ~thread_ring() { for( auto& it : m_vectorRing ) it.second->m_bClosed.store( true, std::memory_order_release ); }
+      std::vector< std::pair< uint64_t, std::shared_ptr<async_queue::ring> > > m_vectorRing; ///< async queue id and ring
+   };
+}
+
+/*----------------------------------------------------------------------------- async_queue */ /**
+ * Create queue and start consumer thread
+ * \param uOverflow overflow policy, value from `enumOverflow`
+ * \param uRingSize size for each thread ring buffer, rounded up to power of two
+ * \param print_ called on consumer thread for each message with record flags
+ * \param print_binary_ called on consumer thread for each deferred message
+ * \param batch_ called on consumer thread with false before and true after batch of messages
+ */
+async_queue::async_queue( unsigned uOverflow, uint64_t uRingSize, std::function<void( const message&, unsigned )> print_, std::function<void( const binary_view& )> print_binary_, std::function<void( bool )> batch_ )
+   : m_uId( m_uNextId_s.fetch_add( 1 ) ), m_uOverflow( uOverflow ), m_print( std::move( print_ ) ), m_printBinary( std::move( print_binary_ ) ), m_batch( std::move( batch_ ) )
+{
+   uint64_t uSize = 4096;
+   while( uSize < uRingSize ) uSize <<= 1;
+   m_uRingSize = uSize;
+
+   m_threadConsumer = std::thread( &async_queue::work, this );
+}
+
+/*----------------------------------------------------------------------------- push */ /**
+ * Copy message to ring buffer for calling thread.
+ * If ring is full the overflow policy decides if thread waits or message is dropped,
+ * error and fatal messages always wait.
+ * \param message_ message to print
+ * \param uFlags record flags, `eRecordFilter` and `eRecordFlush`
+ * \return true if message was queued, false if it was dropped
+ */
+bool async_queue::push( const message& message_, unsigned uFlags )
+{
+   ring* pring = get_ring();
+
+   const char* pbszText = message_.get_text();
+   uint64_t uLength = pbszText != nullptr ? std::strlen( pbszText ) + 1 : 0;  // length with zero terminator
+   uint64_t uMaxLength = m_uRingSize / 2 - sizeof( record ) - 8;
+   if( uLength > uMaxLength ) uLength = uMaxLength;                            // very long message is truncated
+
+   record record_{ (uint32_t)uLength, message_.get_severity(), message_.m_uMessageType, (uint16_t)message_.m_uFlags, (uint16_t)( uFlags | ( uLength > 0 ? eRecordText : 0 ) ) };
+
+   return push_( pring, record_, pbszText, uLength > 0 ? (uint32_t)uLength - 1 : 0, nullptr, 0, message_.get_severity() );
+}
+
+/*----------------------------------------------------------------------------- push */ /**
+ * Copy deferred message to ring buffer for calling thread.
+ * Data in ring is time followed by packed arguments, format id is stored in message type.
+ * \param binary_ deferred message
+ * \return true if message was queued, false if it was dropped
+ */
+bool async_queue::push( const binary_view& binary_ )
+{
+   ring* pring = get_ring();
+
+   uint32_t uSize = binary_.m_uSize;
+   if( uSize > m_uRingSize / 4 ) uSize = 0;                                    // too many arguments, print format text only
+
+   record record_{ (uint32_t)( sizeof( uint64_t ) + uSize + 1 ), binary_.m_uSeverity, binary_.m_uFormat, 0, eRecordBinary };
+
+   return push_( pring, record_, &binary_.m_uTime, sizeof( uint64_t ), binary_.m_puArgument, uSize, binary_.m_uSeverity );
+}
+
+/*----------------------------------------------------------------------------- push_ */ /**
+ * Copy record to ring, overflow policy decides what to do if ring is full.
+ * \param pring ring for calling thread
+ * \param record_ record header
+ * \param pFirst first part of data copied after header
+ * \param uFirst bytes in first part
+ * \param pSecond second part of data, may be null
+ * \param uSecond bytes in second part
+ * \param uSeverity message severity, error and fatal are never dropped
+ * \return true if message was queued, false if it was dropped
+ */
+bool async_queue::push_( ring* pring, const record& record_, const void* pFirst, uint32_t uFirst, const void* pSecond, uint32_t uSecond, unsigned uSeverity )
+{
+   unsigned uOverflow = m_uOverflow;
+   if( ( uSeverity & static_cast<unsigned>( enumSeverityMask::eSeverityMaskNumber ) ) <= eSeverityNumberError ) uOverflow = eOverflowBlock; // fatal, error and messages without severity are never dropped
+   if( uOverflow == eOverflowBlock && is_consumer() == true ) uOverflow = eOverflowDrop; // printer logging on consumer thread, waiting for room would wait for itself
+
+   if( uOverflow == eOverflowSample && pring->size() > ( m_uRingSize / 4 ) * 3 )
+   {
+      if( ( pring->m_uSample++ % m_uSampleRate_s ) != 0 ) { m_uDropped.fetch_add( 1, std::memory_order_relaxed ); return false; }
+   }
+
+   while( pring->push( record_, pFirst, uFirst, pSecond, uSecond ) == false )
+   {
+      m_conditionWork.notify_one();
+      if( uOverflow != eOverflowBlock || m_bStopped.load( std::memory_order_acquire ) == true ) { m_uDropped.fetch_add( 1, std::memory_order_relaxed ); return false; } // no consumer to make room after stop
+
+      std::unique_lock<std::mutex> lock_( m_mutex );
+      m_conditionDone.wait_for( lock_, std::chrono::milliseconds( 1 ) );     // wait for consumer to make room
+   }
+
+   if( pring->size() > m_uRingSize / 2 ) m_conditionWork.notify_one();       // wake consumer before ring is full
+   return true;
+}
+
+/*----------------------------------------------------------------------------- flush */ /**
+ * Barrier, returns when all messages pushed before flush are printed.
+ * Do not call from consumer thread (printer), that would wait for itself.
+ */
+void async_queue::flush()
+{                                                                                                  assert( is_consumer() == false );
+   uint64_t uTicket;
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );
+      uTicket = m_uFlushRequest.fetch_add( 1, std::memory_order_acq_rel ) + 1;
+   }
+   m_conditionWork.notify_one();
+
+   std::unique_lock<std::mutex> lock_( m_mutex );
+   m_conditionDone.wait( lock_, [&] { return m_uFlushDone.load( std::memory_order_acquire ) >= uTicket || m_bStopped.load( std::memory_order_acquire ) == true; } );
+}
+
+/*----------------------------------------------------------------------------- stop */ /**
+ * Print remaining messages and stop consumer thread.
+ * Messages pushed by other threads while queue is stopped may be lost, threads that wait
+ * for room in ring or for flush return when consumer has exited.
+ */
+void async_queue::stop()
+{
+   if( m_threadConsumer.joinable() == false ) return;
+
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );
+      m_bStop.store( true, std::memory_order_release );
+   }
+   m_conditionWork.notify_one();
+   m_threadConsumer.join();
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );
+      m_bStopped.store( true, std::memory_order_release );
+   }
+   m_conditionDone.notify_all();                                               // wake threads waiting for flush or room in ring
+
+   std::lock_guard<std::mutex> lockRing( m_mutexRing );
+   for( auto& pring : m_vectorRing ) pring->m_bClosed.store( true, std::memory_order_release );
+   m_vectorRing.clear();
+}
+
+/// Get ring for calling thread, ring is created and registered the first time thread logs
+async_queue::ring* async_queue::get_ring()
+{
+   thread_local thread_ring threadring_;
+   for( auto& it : threadring_.m_vectorRing ) { if( it.first == m_uId ) return it.second.get(); }
+
+   std::erase_if( threadring_.m_vectorRing, []( const auto& it ) { return it.second->m_bClosed.load( std::memory_order_acquire ); } ); // rings from stopped queues
+
+   auto pring = std::make_shared<ring>( m_uRingSize );
+   {
+      std::lock_guard<std::mutex> lock_( m_mutexRing );
+      m_vectorRing.push_back( pring );
+   }
+   threadring_.m_vectorRing.emplace_back( m_uId, pring );
+   return pring.get();
+}
+
+/// Consumer thread, drains rings until queue is stopped
+void async_queue::work()
+{
+   m_idConsumer.store( std::this_thread::get_id(), std::memory_order_relaxed );
+   while( true )
+   {
+      uint64_t uRequest = m_uFlushRequest.load( std::memory_order_acquire );  // read before drain, messages pushed before request are in rings
+      bool bStop = m_bStop.load( std::memory_order_acquire );
+
+      uint64_t uCount = drain();
+
+      bool bNotify = uCount > 0;                                               // producers may wait for room
+      if( uRequest != m_uFlushDone.load( std::memory_order_relaxed ) )
+      {
+         std::lock_guard<std::mutex> lock_( m_mutex );
+         m_uFlushDone.store( uRequest, std::memory_order_release );
+         bNotify = true;
+      }
+      if( bNotify == true ) m_conditionDone.notify_all();
+
+      if( uCount > 0 ) continue;
+      if( bStop == true ) break;
+
+      std::unique_lock<std::mutex> lock_( m_mutex );
+      m_conditionWork.wait_for( lock_, std::chrono::milliseconds( 10 ), [&] { 
+         return m_bStop.load( std::memory_order_relaxed ) == true || m_uFlushRequest.load( std::memory_order_relaxed ) != uRequest; 
+      });
+   }
+}
+
+/*----------------------------------------------------------------------------- drain */ /**
+ * Print all messages in rings as one batch.
+ * Messages are printed with text pointing into ring memory, no copy is made.
+ * \return number of printed messages
+ */
+uint64_t async_queue::drain()
+{
+   std::vector< std::shared_ptr<ring> > vectorRing;
+   {
+      std::lock_guard<std::mutex> lock_( m_mutexRing );
+      std::erase_if( m_vectorRing, []( const auto& pring ) { return pring->m_bClosed.load( std::memory_order_acquire ) == true && pring->size() == 0; } );
+      vectorRing = m_vectorRing;
+   }
+
+   uint64_t uCount = 0;
+   bool bBatch = false;
+   for( auto& pring : vectorRing )
+   {
+      uCount += pring->pop( [&]( const record& record_, const char* pbszText ) {
+         if( bBatch == false ) { m_batch( false ); bBatch = true; }
+         if( ( record_.m_uFlags & eRecordBinary ) != 0 )
+         {
+            binary_view binary_{ record_.m_uMessageType, record_.m_uSeverity, 0, (const uint8_t*)pbszText + sizeof( uint64_t ), record_.m_uLength - 1 - (uint32_t)sizeof( uint64_t ) };
+            std::memcpy( &binary_.m_uTime, pbszText, sizeof( uint64_t ) );
+            m_printBinary( binary_ );
+            return;
+         }
+
+         message message_( record_.m_uSeverity, record_.m_uMessageType );
+         message_.m_uFlags = record_.m_uMessageFlags;
+         message_.m_pbszTextView = pbszText;
+         m_print( message_, record_.m_uFlags );
+      });
+   }
+
+   // ## report dropped messages
+   uint64_t uDropped = m_uDropped.load( std::memory_order_relaxed );
+   if( uDropped != m_uDroppedReported )
+   {
+      if( bBatch == false ) { m_batch( false ); bBatch = true; }
+      std::string stringDropped = "log queue full, " + std::to_string( uDropped - m_uDroppedReported ) + " messages dropped";
+      message message_( eSeverityWarning, eMessageTypeSeverity );
+      message_.m_pbszTextView = stringDropped.c_str();
+      m_print( message_, eRecordFlush );
+      m_uDroppedReported = uDropped;
+   }
+
+   if( bBatch == true ) m_batch( true );
+   return uCount;
+}
+
+
+
 // ================================================================================================
 // ================================================================================= GLOBAL
 // ================================================================================================
@@ -134,7 +134,11 @@ auto plogger = get_s();            // default logger
 // https://stackoverflow.com/questions/28596298/is-it-possible-to-compile-out-stream-expressions-in-c
 
 #pragma once
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <string>
 #include <string_view>
@@ -144,6 +148,7 @@ auto plogger = get_s();            // default logger
 #include <sstream>
 #include <iosfwd>
 #include <mutex>
+#include <thread>
 
 #include "gd_types.h"
 #include "gd_utf8.hpp"
@@ -1010,6 +1015,26 @@ inline char* message::allocate_s(std::size_t uSize, char* pbszCurrent) {
    return pbszNew;
 }
 
+// ================================================================================================
+// ================================================================================= binary_view
+// ================================================================================================
+
+/**
+ * \brief Deferred log message, format id and packed argument values instead of text
+ *
+ * Format text for id is registered once for each call site (see `gd_log_logger_binary.h`),
+ * log calls only pack argument values. Text is generated when message is printed.
+ * Memory for arguments is owned by caller and only valid during print.
+ */
+struct binary_view
+{
+   uint32_t m_uFormat = 0;                ///< format id from `format_add_g`
+   unsigned m_uSeverity = 0;              ///< message severity
+   uint64_t m_uTime = 0;                  ///< nanoseconds since epoch when message was logged
+   const uint8_t* m_puArgument = nullptr; ///< packed argument values
+   uint32_t m_uSize = 0;                  ///< bytes in argument buffer
+};
+
 // ================================================================================================
 // ================================================================================= i_printer
 // ================================================================================================
@@ -1054,11 +1079,23 @@ public:
    /// \return true if ok, false if error (get error information from error method)
    virtual bool print(const message& message) { return true; };
 
+   /// Print deferred message, default implementation generates text from format and
+   /// arguments and calls `print` with message. Printers that store values override this.
+   /// \return true if ok, false if error (get error information from error method)
+   virtual bool print_binary( const binary_view& binary_ );
+
    /// may be called occasionally and printer should here finish jobs that are
    /// pending, may be some sort of heavy write to media.
    /// \return true if ok, false if error (get error information from error method)
    virtual bool flush() { return true; };
 
+   /// Called by async logger before a batch of messages is printed, printer may collect
+   /// output in memory until `batch_end` is called
+   virtual void batch_begin() {}
+   /// Called by async logger when batch is done, printer writes collected output
+   /// \return true if ok, false if error (get error information from error method)
+   virtual bool batch_end() { return true; }
+
    /// Collect error information, if printer has some internal error then call
    /// error to get information about internal error if there is any
    /// \param message gets error information
@@ -1070,6 +1107,229 @@ public:
 };
 
 
+// ================================================================================================
+// ================================================================================= async_queue
+// ================================================================================================
+
+/// What producer does when its ring buffer in async logger is full
+enum enumOverflow
+{
+   eOverflowBlock  = 0,             ///< wait until consumer has made room, no messages are lost
+   eOverflowDrop   = 1,             ///< drop message, number of dropped messages is reported by consumer
+   eOverflowSample = 2,             ///< when ring is above 3/4 only every n:th message is kept, drop when full
+};
+
+/**
+ * \brief Queue used by logger in async mode, messages are copied to ring buffers and printed by a background thread
+ *
+ * Each producer thread gets its own single producer / single consumer ring buffer the
+ * first time it logs. Pushing a message is a copy into the ring and two atomic operations,
+ * no locks and no heap allocations. The consumer thread drains all rings, messages are
+ * read directly from ring memory and passed to printers in batches so printers are able
+ * to write a batch with one system call.
+ *
+ * Messages with severity error or fatal always block when the ring is full, they are
+ * never dropped or sampled. Messages logged by printers on the consumer thread never
+ * block, consumer can not make room while it waits so they are dropped when ring is full.
+ *
+ * Printers compute time and date when message is printed, in async mode that is on the
+ * consumer thread and may be some milliseconds after the message was created.
+ *
+ \code
+auto plogger = gd::log::get_s();
+plogger->append( std::make_unique<gd::log::printer_file>( "app.log" ) );
+plogger->async_start( gd::log::eOverflowSample );                            // printers are called from background thread after this
+LOG_DEBUG_RAW( "hello" );
+plogger->flush();                                                            // barrier, returns when all messages logged before are printed
+ \endcode
+ */
+class async_queue
+{
+public:
+   enum enumRecordFlag
+   {
+      eRecordFilter  = 0x01,        ///< apply tag filter when printed
+      eRecordFlush   = 0x02,        ///< flush printers after message is printed
+      eRecordText    = 0x04,        ///< message has text
+      eRecordBinary  = 0x08,        ///< deferred message, data is time and packed arguments, `m_uMessageType` is format id
+   };
+
+   /// header for message in ring, zero terminated text follows header
+   struct record
+   {
+      uint32_t m_uLength;           ///< text length with zero terminator, `npos_s` marks that rest of ring is skipped
+      uint32_t m_uSeverity;
+      uint32_t m_uMessageType;
+      uint16_t m_uMessageFlags;     ///< flags from message
+      uint16_t m_uFlags;            ///< record flags, values from `enumRecordFlag`
+   };
+
+   /**
+    * \brief Ring buffer for one producer thread
+    *
+    * Positions are counters that only increase, position in buffer is counter masked with size - 1.
+    * Only producer writes `m_uHead` and only consumer writes `m_uTail`.
+    */
+   struct ring
+   {
+      explicit ring( uint64_t uSize ): m_uSize( uSize ), m_puBuffer( new uint8_t[uSize] ) { assert( (uSize & (uSize - 1)) == 0 ); }
+
+      /// bytes used in ring
+      uint64_t size() const { return m_uHead.load( std::memory_order_acquire ) - m_uTail.load( std::memory_order_acquire ); }
+      bool push( const record& record_, const char* pbszText ) { return push( record_, pbszText, record_.m_uLength > 0 ? record_.m_uLength - 1 : 0, nullptr, 0 ); }
+      bool push( const record& record_, const void* pFirst, uint32_t uFirst, const void* pSecond, uint32_t uSecond );
+      template<typename CALLBACK>
+      uint64_t pop( CALLBACK&& callback_ );
+
+      uint64_t m_uSize;                          ///< buffer size, power of two
+      std::unique_ptr<uint8_t[]> m_puBuffer;     ///< ring buffer memory
+      alignas(64) std::atomic<uint64_t> m_uHead{ 0 };///< write position, only producer thread writes
+      alignas(64) std::atomic<uint64_t> m_uTail{ 0 };///< read position, only consumer thread writes
+      std::atomic<bool> m_bClosed{ false };      ///< producer thread has exited, ring is removed when empty
+      uint32_t m_uSample = 0;                    ///< counter used by sample overflow, only producer use it
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   async_queue( unsigned uOverflow, uint64_t uRingSize, std::function<void( const message&, unsigned )> print_, std::function<void( const binary_view& )> print_binary_, std::function<void( bool )> batch_ );
+   ~async_queue() { stop(); }
+
+   async_queue( const async_queue& ) = delete;
+   async_queue& operator=( const async_queue& ) = delete;
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Copy message to ring for calling thread, returns false if message was dropped
+   bool push( const message& message_, unsigned uFlags );
+   /// Copy deferred message to ring for calling thread, returns false if message was dropped
+   bool push( const binary_view& binary_ );
+   /// Wait until all messages pushed before call are printed and printers are flushed
+   void flush();
+   /// Print remaining messages and stop consumer thread
+   void stop();
+
+   /// number of messages dropped because ring was full
+   uint64_t get_dropped() const { return m_uDropped.load( std::memory_order_relaxed ); }
+   /// check if calling thread is the consumer thread
+   bool is_consumer() const { return std::this_thread::get_id() == m_idConsumer.load( std::memory_order_relaxed ); }
+
+protected:
+/** \name INTERNAL
+*///@{
+   ring* get_ring();
+   bool push_( ring* pring, const record& record_, const void* pFirst, uint32_t uFirst, const void* pSecond, uint32_t uSecond, unsigned uSeverity );
+   void work();
+   uint64_t drain();
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   uint64_t m_uId;                                 ///< unique id, used to find ring for thread
+   unsigned m_uOverflow;                           ///< overflow policy, value from `enumOverflow`
+   uint64_t m_uRingSize;                           ///< size for each ring buffer
+   std::function<void( const message&, unsigned )> m_print; ///< print message, called on consumer thread
+   std::function<void( const binary_view& )> m_printBinary; ///< print deferred message, called on consumer thread
+   std::function<void( bool )> m_batch;            ///< called with false before batch and true after
+
+   std::mutex m_mutexRing;                         ///< guards ring list
+   std::vector<std::shared_ptr<ring>> m_vectorRing;///< rings for all producer threads
+
+   std::mutex m_mutex;                             ///< used with condition variables
+   std::condition_variable m_conditionWork;        ///< wakes consumer
+   std::condition_variable m_conditionDone;        ///< signaled when consumer has drained rings
+   std::thread m_threadConsumer;                   ///< consumer thread
+   std::atomic<std::thread::id> m_idConsumer;      ///< id for consumer thread, set by consumer thread when it starts
+   std::atomic<bool> m_bStop{ false };
+   std::atomic<bool> m_bStopped{ false };          ///< consumer thread has exited, producers do not wait for room
+   std::atomic<uint64_t> m_uFlushRequest{ 0 };     ///< incremented by flush
+   std::atomic<uint64_t> m_uFlushDone{ 0 };        ///< last flush request that is done
+   std::atomic<uint64_t> m_uDropped{ 0 };          ///< dropped messages
+   uint64_t m_uDroppedReported = 0;                ///< dropped messages reported, only consumer use it
+
+   static constexpr uint32_t npos_s = 0xffff'ffff;
+   inline static uint64_t m_uRingSize_s = 64 * 1024;///< default ring size for each thread
+   inline static uint32_t m_uSampleRate_s = 16;    ///< keep every n:th message when sampling
+   inline static std::atomic<uint64_t> m_uNextId_s{ 1 };
+};
+
+/// Get bytes for record in ring, records are aligned to 8 bytes
+inline uint64_t async_record_size_g( uint32_t uLength ) { return ( sizeof( async_queue::record ) + uLength + 7 ) & ~uint64_t( 7 ); }
+
+/** ---------------------------------------------------------------------------
+ * @brief Copy message to ring, producer thread only
+ * Data is copied in two parts after header and zero terminator is added if length is set.
+ * @param record_ header for message, `m_uLength` is data length with zero terminator (0 = no data)
+ * @param pFirst first part of data
+ * @param uFirst bytes in first part
+ * @param pSecond second part of data, may be null
+ * @param uSecond bytes in second part
+ * @return true if message was copied, false if ring do not have room
+ */
+inline bool async_queue::ring::push( const record& record_, const void* pFirst, uint32_t uFirst, const void* pSecond, uint32_t uSecond )
+{                                                                                                  assert( record_.m_uLength == 0 || record_.m_uLength == uFirst + uSecond + 1 );
+   uint64_t uNeed = async_record_size_g( record_.m_uLength );
+   uint64_t uHead = m_uHead.load( std::memory_order_relaxed );
+   uint64_t uTail = m_uTail.load( std::memory_order_acquire );
+   uint64_t uOffset = uHead & ( m_uSize - 1 );
+   uint64_t uToEnd = m_uSize - uOffset;
+   uint64_t uTotal = uToEnd < uNeed ? uToEnd + uNeed : uNeed;                 // record do not fit at end, skip to start of buffer
+   if( uHead + uTotal - uTail > m_uSize ) return false;
+
+   if( uToEnd < uNeed )
+   {
+      if( uToEnd >= sizeof( record ) ) { record recordSkip{ npos_s, 0, 0, 0, 0 }; std::memcpy( m_puBuffer.get() + uOffset, &recordSkip, sizeof( record ) ); }
+      uOffset = 0;
+   }
+
+   uint8_t* puPosition = m_puBuffer.get() + uOffset;
+   std::memcpy( puPosition, &record_, sizeof( record ) );
+   if( record_.m_uLength > 0 )
+   {
+      if( uFirst > 0 ) std::memcpy( puPosition + sizeof( record ), pFirst, uFirst );
+      if( uSecond > 0 ) std::memcpy( puPosition + sizeof( record ) + uFirst, pSecond, uSecond );
+      puPosition[sizeof( record ) + record_.m_uLength - 1] = '\0';
+   }
+
+   m_uHead.store( uHead + uTotal, std::memory_order_release );
+   return true;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Read all messages in ring, consumer thread only
+ *
+ * Text passed to callback points into ring memory and is valid until pop returns,
+ * room is given back to producer when all messages are read.
+ *
+ * @param callback_ called with record header and text (null if no text)
+ * @return number of messages read
+ */
+template<typename CALLBACK>
+uint64_t async_queue::ring::pop( CALLBACK&& callback_ )
+{
+   uint64_t uCount = 0;
+   uint64_t uTail = m_uTail.load( std::memory_order_relaxed );
+   uint64_t uHead = m_uHead.load( std::memory_order_acquire );
+   while( uTail < uHead )
+   {
+      uint64_t uOffset = uTail & ( m_uSize - 1 );
+      uint64_t uToEnd = m_uSize - uOffset;
+      if( uToEnd < sizeof( record ) ) { uTail += uToEnd; continue; }          // too small for header, producer skipped to start
+
+      record record_;
+      std::memcpy( &record_, m_puBuffer.get() + uOffset, sizeof( record ) );
+      if( record_.m_uLength == npos_s ) { uTail += uToEnd; continue; }
+
+      const char* pbszText = record_.m_uLength > 0 ? (const char*)m_puBuffer.get() + uOffset + sizeof( record ) : nullptr;
+      callback_( record_, pbszText );
+      uTail += async_record_size_g( record_.m_uLength );
+      uCount++;
+   }
+
+   m_uTail.store( uTail, std::memory_order_release );
+   return uCount;
+}
+
+
 // ================================================================================================
 // ================================================================================= logger
 // ================================================================================================
@@ -1161,6 +1421,8 @@ public:
    bool is_severity_error() const { return check_severity(eSeverityError); }
    bool is_severity_fatal() const { return check_severity(eSeverityFatal); }
    bool is_severity_none() const { return check_severity(eSeverityNone); }
+   /// check if message with severity passes severity filter, used to skip building messages that are not printed
+   bool is_severity( unsigned uSeverity ) const { return check_severity( uSeverity ); }
 
 
 //@}
@@ -1178,8 +1440,20 @@ public:
    virtual void print( const message& message, bool bFlush );
    virtual void print( std::initializer_list<message> listMessage );
    virtual void print_always( const message& message, bool bFlush );
+   /// Send deferred message to connected printers, tags and callbacks are not applied to deferred messages
+   void print( const binary_view& binary_ );
+   /// Flush printers, in async mode this waits until all messages logged before are printed
    virtual void flush();
 
+   // ## async methods, in async mode messages are printed from background thread
+
+   /// Start async mode, printers must not be added or removed while async mode is active
+   void async_start( unsigned uOverflow = eOverflowBlock, uint64_t uRingSize = async_queue::m_uRingSize_s );
+   /// Print pending messages and stop async mode, printers are called from logging threads after this
+   void async_stop();
+   /// Check if logger is in async mode
+   bool is_async() const { return m_pasync.load( std::memory_order_acquire ) != nullptr; }
+
    /// number of printers attached
    size_t printer_size() const { return m_vectorPrinter.size(); }
 
@@ -1211,6 +1485,9 @@ public:
 protected:
    // internal printing
    void print_(const message& message, bool bFilter );
+   void print_binary_( const binary_view& binary_ );
+   /// flush all printers
+   void flush_();
 /** \name INTERNAL
 *///@{
    /// check severity against internal severity filter
@@ -1243,6 +1520,8 @@ public:
    std::vector<std::string> m_vectorError;   ///< list of internal errors stored as text
    std::vector< message_callback > m_vectorCallback;
    std::vector< std::string > m_vectorTag;   ///< active tags if tags should be checked
+   std::atomic<async_queue*> m_pasync{ nullptr };///< set in async mode, messages are queued and printed from background thread. Read by logging threads without lock
+   std::unique_ptr<async_queue> m_pasyncQueue;///< owns queue, kept after `async_stop` until next `async_start` so threads that read `m_pasync` before stop do not use freed memory
 
    static std::mutex m_mutex_s;              ///< mutex to enable thread safety printing messages
    
@@ -1315,6 +1594,8 @@ inline void logger<iLoggerKey,bThread>::print(const message& message, bool bFlus
 {
    if( check_severity(message.get_severity()) )                                  // check if message has severity within bounds for output
    {
+      if( async_queue* pasync = m_pasync.load( std::memory_order_acquire ); pasync != nullptr ) { pasync->push( message, async_queue::eRecordFilter | ( bFlush == true ? async_queue::eRecordFlush : 0 ) ); return; }
+
       // if template argument bThread is set to true this print method will be thread safe
       if constexpr( bThread == true )
       {
@@ -1337,6 +1618,8 @@ inline void logger<iLoggerKey,bThread>::print_always(const message& message, boo
 {
    if( check_severity(message.get_severity()) )                                  // check if message has severity within bounds for output
    {
+      if( async_queue* pasync = m_pasync.load( std::memory_order_acquire ); pasync != nullptr ) { pasync->push( message, bFlush == true ? async_queue::eRecordFlush : 0 ); return; }
+
       // if template argument bThread is set to true this print method will be thread safe
       if constexpr( bThread == true )
       {
@@ -1353,6 +1636,27 @@ inline void logger<iLoggerKey,bThread>::print_always(const message& message, boo
 }
 
 
+/// ----------------------------------------------------------------------------
+/// Sends deferred message to all attached printers, in async mode message is copied to queue
+template<int iLoggerKey, bool bThread>
+inline void logger<iLoggerKey,bThread>::print( const binary_view& binary_ )
+{
+   if( check_severity( binary_.m_uSeverity ) )
+   {
+      if( async_queue* pasync = m_pasync.load( std::memory_order_acquire ); pasync != nullptr ) { pasync->push( binary_ ); return; }
+
+      if constexpr( bThread == true )
+      {
+         std::lock_guard<std::mutex> lock( get_mutex_s() );
+         print_binary_( binary_ );
+      }
+      else
+      {
+         print_binary_( binary_ );
+      }
+   }
+}
+
 /// ----------------------------------------------------------------------------
 /// Sends message list to all attached printers, 
 template<int iLoggerKey, bool bThread>
@@ -1362,6 +1666,12 @@ void logger<iLoggerKey, bThread>::print(std::initializer_list<message> listMessa
    //message* pmessage = &(*listMessage.begin());
    if( itBegin->check_severity(m_uSeverity) )                                   // check first message has severity within bounds for output
    {
+      if( async_queue* pasync = m_pasync.load( std::memory_order_acquire ); pasync != nullptr )
+      {
+         for( auto it = listMessage.begin(); it != listMessage.end(); ++it ) { pasync->push( *it, ( it + 1 ) == listMessage.end() ? async_queue::eRecordFlush : 0 ); }
+         return;
+      }
+
       // if template argument bThread is set to true this print method will be thread safe
       if constexpr( bThread == true )
       {
@@ -1407,6 +1717,8 @@ void logger<iLoggerKey, bThread>::print(std::initializer_list<message> listMessa
 template<int iLoggerKey, bool bThread>
 logger<iLoggerKey, bThread>::~logger() 
 {
+   async_stop();                                                               // print pending messages before printers are deleted
+
    for( auto it = m_vectorPrinter.begin(); it != m_vectorPrinter.end(); it++ )
    {
       //(*it)->
@@ -1469,9 +1781,40 @@ void logger<iLoggerKey, bThread>::print_( const message& message, bool bFilter )
 }
 
 /// ----------------------------------------------------------------------------
-/// Flush all connected printers. 
+/// Print deferred message to printers, printer severity filter is checked as for text messages
+template<int iLoggerKey, bool bThread>
+void logger<iLoggerKey, bThread>::print_binary_( const binary_view& binary_ )
+{
+   message messageSeverity( binary_.m_uSeverity );                             // used to check printer severity
+   for( auto it = m_vectorPrinter.begin(); it != m_vectorPrinter.end(); it++ )
+   {
+      if( (*it)->get_severity() != 0 && messageSeverity.check_severity( (*it)->get_severity() ) == false ) continue;
+      if( (*it)->print_binary( binary_ ) == true ) continue;
+
+      gd::log::message messageError;
+      (*it)->error( messageError );
+      if( messageError.empty() == false ) error_push( messageError );
+   }
+}
+
+/// ----------------------------------------------------------------------------
+/// Flush all connected printers, in async mode wait for consumer to print and flush
 template<int iLoggerKey, bool bThread>
 void logger<iLoggerKey,bThread>::flush()
+{
+   if( async_queue* pasync = m_pasync.load( std::memory_order_acquire ); pasync != nullptr ) 
+   { 
+      if( pasync->is_consumer() == false ) pasync->flush();                   // flush from printer callback on consumer thread would wait for itself
+      return; 
+   }
+
+   flush_();
+}
+
+/// ----------------------------------------------------------------------------
+/// Flush all connected printers. 
+template<int iLoggerKey, bool bThread>
+void logger<iLoggerKey,bThread>::flush_()
 {
    // ## print message to all attached printers
    for( auto it = m_vectorPrinter.begin(); it != m_vectorPrinter.end(); ++it )
@@ -1480,11 +1823,59 @@ void logger<iLoggerKey,bThread>::flush()
    }
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Start async mode, messages are copied to per thread ring buffers and printed from background thread
+ *
+ * Configure printers, tags and callbacks before async mode is started, they are
+ * used from the background thread without locks.
+ *
+ * @param uOverflow what to do when ring buffer is full, value from `enumOverflow`
+ * @param uRingSize size in bytes for each thread ring buffer, rounded up to power of two
+ */
+template<int iLoggerKey, bool bThread>
+void logger<iLoggerKey,bThread>::async_start( unsigned uOverflow, uint64_t uRingSize )
+{
+   if( m_pasync.load( std::memory_order_acquire ) != nullptr ) return;
+
+   auto print_callback_ = [this]( const message& message_, unsigned uFlags ) {
+      print_( message_, ( uFlags & async_queue::eRecordFilter ) != 0 );
+      if( ( uFlags & async_queue::eRecordFlush ) != 0 ) flush_();
+   };
+   auto batch_callback_ = [this]( bool bEnd ) {
+      for( auto it = m_vectorPrinter.begin(); it != m_vectorPrinter.end(); ++it )
+      {
+         if( bEnd == false ) { (*it)->batch_begin(); continue; }
+         if( (*it)->batch_end() == false )
+         {
+            gd::log::message messageError;
+            (*it)->error( messageError );
+            if( messageError.empty() == false ) error_push( messageError );
+         }
+      }
+   };
+
+   auto print_binary_callback_ = [this]( const binary_view& binary_ ) { print_binary_( binary_ ); };
+
+   m_pasyncQueue = std::make_unique<async_queue>( uOverflow, uRingSize, print_callback_, print_binary_callback_, batch_callback_ );
+   m_pasync.store( m_pasyncQueue.get(), std::memory_order_release );
+}
+
+/// ----------------------------------------------------------------------------
+/// Stop async mode, waits for pending messages to be printed. Queue memory is kept until async mode is started again or logger is destroyed
+template<int iLoggerKey, bool bThread>
+void logger<iLoggerKey,bThread>::async_stop()
+{
+   async_queue* pasync = m_pasync.exchange( nullptr, std::memory_order_acq_rel );
+   if( pasync == nullptr ) return;
+   pasync->stop();
+}
+
 /// ----------------------------------------------------------------------------
 /// Clear internal printer data, like resetting and it needs to be filled again to print
 template<int iLoggerKey, bool bThread>
 void logger<iLoggerKey,bThread>::clear() 
 { 
+   async_stop();
    m_uFlags = 0;
    m_vectorPrinter.clear();
    m_vectorPrinter.shrink_to_fit();
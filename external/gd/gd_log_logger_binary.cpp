@@ -0,0 +1,429 @@
+// @FILE [tag: log, binary] [description: Deferred log messages, format registry, printer and decoder] [type: source] [name: gd_log_logger_binary.cpp]
+
+#include <cassert>
+#include <charconv>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+#include "gd_log_logger_binary.h"
+#include "gd_log_logger_printer.h"
+
+_GD_LOG_LOGGER_BEGIN
+
+namespace {
+   constexpr std::string_view SESSION_HEADER{ "GDLOGB\x01\n", 8 };         // starts each session in binary log file
+
+   std::mutex& format_mutex_s() { static std::mutex mutex_; return mutex_; }
+   std::deque<format_info>& format_list_s() { static std::deque<format_info> deque_; return deque_; } // deque do not move items, pointers are valid
+
+   /// Append unsigned LEB128 number
+   void append_number_( std::string& stringBuffer, uint64_t uNumber )
+   {
+      while( uNumber >= 0x80 ) { stringBuffer += char( ( uNumber & 0x7f ) | 0x80 ); uNumber >>= 7; }
+      stringBuffer += char( uNumber );
+   }
+
+   /// Read unsigned LEB128 number, returns false if data ends before number
+   bool read_number_( const uint8_t*& puPosition, const uint8_t* puEnd, uint64_t& uNumber )
+   {
+      uNumber = 0;
+      for( unsigned uShift = 0; puPosition < puEnd && uShift < 64; uShift += 7 )
+      {
+         uint8_t uByte = *puPosition++;
+         uNumber |= uint64_t( uByte & 0x7f ) << uShift;
+         if( ( uByte & 0x80 ) == 0 ) return true;
+      }
+      return false;
+   }
+
+   /// Read text with length before text
+   bool read_text_( const uint8_t*& puPosition, const uint8_t* puEnd, std::string_view& stringText )
+   {
+      uint64_t uLength;
+      if( read_number_( puPosition, puEnd, uLength ) == false || uLength > uint64_t( puEnd - puPosition ) ) return false;
+      stringText = std::string_view( (const char*)puPosition, (size_t)uLength );
+      puPosition += uLength;
+      return true;
+   }
+
+   template<typename NUMBER>
+   void append_value_( std::string& stringText, const uint8_t* puValue )
+   {
+      NUMBER value_;
+      std::memcpy( &value_, puValue, sizeof( NUMBER ) );
+      char pbszBuffer[32];
+      auto result_ = std::to_chars( pbszBuffer, pbszBuffer + sizeof( pbszBuffer ), value_ );
+      stringText.append( pbszBuffer, result_.ptr );
+   }
+
+   /// Append text for packed value, returns position after value or null if type is unknown or data is too short
+   const uint8_t* append_value_( std::string& stringText, const uint8_t* puPosition, const uint8_t* puEnd )
+   {
+      uint8_t uType = *puPosition++;
+      uint32_t uSize = 0;
+      switch( uType & ~binary_arguments::eValueLength )
+      {
+      case gd::types::eTypeNumberBool:    uSize = 1; break;
+      case gd::types::eTypeNumberInt8:    case gd::types::eTypeNumberUInt8:  uSize = 1; break;
+      case gd::types::eTypeNumberInt16:   case gd::types::eTypeNumberUInt16: uSize = 2; break;
+      case gd::types::eTypeNumberInt32:   case gd::types::eTypeNumberUInt32: case gd::types::eTypeNumberFloat: uSize = 4; break;
+      case gd::types::eTypeNumberInt64:   case gd::types::eTypeNumberUInt64: case gd::types::eTypeNumberDouble: case gd::types::eTypeNumberPointer: uSize = 8; break;
+      case gd::types::eTypeNumberString:
+         if( puEnd - puPosition < 2 ) return nullptr;
+         uint16_t uLength;
+         std::memcpy( &uLength, puPosition, sizeof( uint16_t ) );
+         puPosition += 2;
+         uSize = uLength;
+         break;
+      default: return nullptr;
+      }
+
+      if( uint32_t( puEnd - puPosition ) < uSize ) return nullptr;
+
+      switch( uType & ~binary_arguments::eValueLength )
+      {
+      case gd::types::eTypeNumberBool:    stringText += *puPosition != 0 ? "true" : "false"; break;
+      case gd::types::eTypeNumberInt8:    append_value_<int8_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberUInt8:   append_value_<uint8_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberInt16:   append_value_<int16_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberUInt16:  append_value_<uint16_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberInt32:   append_value_<int32_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberUInt32:  append_value_<uint32_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberInt64:   append_value_<int64_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberUInt64:  append_value_<uint64_t>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberFloat:   append_value_<float>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberDouble:  append_value_<double>( stringText, puPosition ); break;
+      case gd::types::eTypeNumberPointer:
+      {
+         uint64_t uPointer;
+         std::memcpy( &uPointer, puPosition, sizeof( uint64_t ) );
+         char pbszBuffer[24];
+         auto result_ = std::to_chars( pbszBuffer, pbszBuffer + sizeof( pbszBuffer ), uPointer, 16 );
+         stringText += "0x";
+         stringText.append( pbszBuffer, result_.ptr );
+      }
+      break;
+      case gd::types::eTypeNumberString:  stringText.append( (const char*)puPosition, uSize ); break;
+      }
+
+      return puPosition + uSize;
+   }
+}
+
+
+// ================================================================================================
+// ================================================================================= format
+// ================================================================================================
+
+/*----------------------------------------------------------------------------- format_add_g */ /**
+ * Register format for call site. Log macros call this once for each call site and
+ * keep id in function local static.
+ * \param uSeverity severity used at call site
+ * \param pbszFile source file (__FILE__)
+ * \param uLine line in source file
+ * \param pbszFormat format text, `{}` is replaced with argument value
+ * \return format id, first id is 1
+ */
+uint32_t format_add_g( unsigned uSeverity, const char* pbszFile, unsigned uLine, const char* pbszFormat )
+{
+   std::lock_guard<std::mutex> lock_( format_mutex_s() );
+   auto& deque_ = format_list_s();
+   uint32_t uId = (uint32_t)deque_.size() + 1;
+   deque_.push_back( format_info{ uId, uSeverity, uLine, pbszFile, pbszFormat } );
+   return uId;
+}
+
+/// Get format for id, null if id is not registered
+const format_info* format_get_g( uint32_t uId )
+{
+   std::lock_guard<std::mutex> lock_( format_mutex_s() );
+   auto& deque_ = format_list_s();
+   if( uId == 0 || uId > deque_.size() ) return nullptr;
+   return &deque_[uId - 1];
+}
+
+
+// ================================================================================================
+// ================================================================================= render
+// ================================================================================================
+
+/*----------------------------------------------------------------------------- binary_render_g */ /**
+ * Generate text from format and packed values.
+ * `{}` is replaced with next value, `{?}` is printed if there are no more values.
+ * Values not used by format are added at end separated with space.
+ * \param stringFormat format text
+ * \param puArgument packed values
+ * \param uSize bytes in packed values
+ * \param stringText text is appended to this string
+ */
+void binary_render_g( std::string_view stringFormat, const uint8_t* puArgument, uint32_t uSize, std::string& stringText )
+{
+   const uint8_t* puPosition = puArgument;
+   const uint8_t* puEnd = puArgument + uSize;
+
+   for( size_t u = 0; u < stringFormat.length(); u++ )
+   {
+      char chCharacter = stringFormat[u];
+      if( ( chCharacter == '{' || chCharacter == '}' ) && u + 1 < stringFormat.length() && stringFormat[u + 1] == chCharacter ) { stringText += chCharacter; u++; continue; } // escaped brace
+
+      if( chCharacter == '{' && u + 1 < stringFormat.length() && stringFormat[u + 1] == '}' )
+      {
+         u++;
+         if( puPosition != nullptr && puPosition < puEnd ) { puPosition = append_value_( stringText, puPosition, puEnd ); continue; }
+         stringText += "{?}";
+         continue;
+      }
+
+      stringText += chCharacter;
+   }
+
+   // ## values without placeholder
+   while( puPosition != nullptr && puPosition < puEnd )
+   {
+      stringText += ' ';
+      puPosition = append_value_( stringText, puPosition, puEnd );
+   }
+}
+
+/// Generate text for deferred message, unknown format id prints id with values
+std::string binary_render_g( const binary_view& binary_ )
+{
+   std::string stringText;
+   const format_info* pformat = format_get_g( binary_.m_uFormat );
+   if( pformat != nullptr ) { binary_render_g( pformat->m_pbszFormat, binary_.m_puArgument, binary_.m_uSize, stringText ); }
+   else
+   {
+      stringText = "format " + std::to_string( binary_.m_uFormat ) + ":";
+      binary_render_g( std::string_view(), binary_.m_puArgument, binary_.m_uSize, stringText );
+   }
+   return stringText;
+}
+
+
+// ================================================================================================
+// ================================================================================= printer_binary
+// ================================================================================================
+
+printer_binary::printer_binary( const std::string_view& stringFileName )
+   : m_stringFileName( stringFileName.begin(), stringFileName.end() )
+{
+   m_stringBuffer.reserve( m_uBufferSize_s );
+   m_stringBuffer += SESSION_HEADER;
+}
+
+printer_binary::printer_binary( const std::string_view& stringName, const std::string_view& stringFileName )
+   : i_printer( stringName ), m_stringFileName( stringFileName.begin(), stringFileName.end() )
+{
+   m_stringBuffer.reserve( m_uBufferSize_s );
+   m_stringBuffer += SESSION_HEADER;
+}
+
+printer_binary::~printer_binary()
+{
+   write_( true );
+   if( m_iFileHandle >= 0 ) printer_file::file_close_s( m_iFileHandle );
+}
+
+/// Store text message as text record, time is set when message is printed
+bool printer_binary::print( const message& message )
+{
+   const char* pbszText = message.get_text();
+   if( pbszText == nullptr ) return true;
+
+   std::string_view stringText( pbszText );
+   m_stringBuffer += 'T';
+   append_number_( m_stringBuffer, message.get_severity() );
+   add_time_( (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now().time_since_epoch() ).count() );
+   append_number_( m_stringBuffer, stringText.length() );
+   m_stringBuffer += stringText;
+
+   return write_( m_bBatch == false && message.get_severity_number() <= eSeverityNumberError );
+}
+
+/// Store deferred message, format text is added first time format id is used
+bool printer_binary::print_binary( const binary_view& binary_ )
+{
+   add_format_( binary_.m_uFormat );
+
+   m_stringBuffer += 'R';
+   append_number_( m_stringBuffer, binary_.m_uFormat );
+   append_number_( m_stringBuffer, binary_.m_uSeverity );
+   add_time_( binary_.m_uTime );
+   append_number_( m_stringBuffer, binary_.m_uSize );
+   m_stringBuffer.append( (const char*)binary_.m_puArgument, binary_.m_uSize );
+
+   bool bError = ( binary_.m_uSeverity & static_cast<unsigned>( enumSeverityMask::eSeverityMaskNumber ) ) <= eSeverityNumberError;
+   return write_( m_bBatch == false && bError == true );
+}
+
+bool printer_binary::flush()
+{
+   return write_( true );
+}
+
+/// Write messages collected in batch with one write call
+bool printer_binary::batch_end()
+{
+   m_bBatch = false;
+   return write_( true );
+}
+
+unsigned printer_binary::error( message& message )
+{
+   if( m_stringError.empty() == true ) return 0;
+   message.set_severity( eSeverityError );
+   message.set_text( m_stringError );
+   m_stringError.clear();
+   return 1;
+}
+
+/*----------------------------------------------------------------------------- write_ */ /**
+ * Write buffer to file, file is opened first time something is written
+ * \param bForce write even if buffer is not full
+ * \return true if ok, false if write failed (error is stored in printer)
+ */
+bool printer_binary::write_( bool bForce )
+{
+   if( m_stringBuffer.empty() == true ) return true;
+   if( bForce == false && m_stringBuffer.size() < m_uBufferSize_s ) return true;
+
+   if( m_iFileHandle < 0 )
+   {
+      auto [iFileHandle, stringError] = printer_file::file_open_s( m_stringFileName );
+      if( iFileHandle < 0 ) { m_stringError = stringError; m_stringBuffer.clear(); return false; }
+      m_iFileHandle = iFileHandle;
+   }
+
+   auto [bOk, stringError] = printer_file::file_write_s( m_iFileHandle, m_stringBuffer );
+   m_stringBuffer.clear();
+   if( bOk == false ) { m_stringError = stringError; return false; }
+   return true;
+}
+
+/// Add format definition if format id has not been written in session
+void printer_binary::add_format_( uint32_t uFormat )
+{
+   if( uFormat >= m_vectorFormat.size() ) m_vectorFormat.resize( uFormat + 64, false );
+   if( m_vectorFormat[uFormat] == true ) return;
+   m_vectorFormat[uFormat] = true;
+
+   const format_info* pformat = format_get_g( uFormat );
+   if( pformat == nullptr ) return;                                            // decoder prints id and values
+
+   std::string_view stringFile( pformat->m_pbszFile != nullptr ? pformat->m_pbszFile : "" );
+   std::string_view stringFormat( pformat->m_pbszFormat != nullptr ? pformat->m_pbszFormat : "" );
+   m_stringBuffer += 'F';
+   append_number_( m_stringBuffer, uFormat );
+   append_number_( m_stringBuffer, pformat->m_uSeverity );
+   append_number_( m_stringBuffer, pformat->m_uLine );
+   append_number_( m_stringBuffer, stringFile.length() );
+   m_stringBuffer += stringFile;
+   append_number_( m_stringBuffer, stringFormat.length() );
+   m_stringBuffer += stringFormat;
+}
+
+/// Add time as zigzag encoded difference from last record, messages from different threads may be out of order
+void printer_binary::add_time_( uint64_t uTime )
+{
+   int64_t iDifference = int64_t( uTime - m_uTime );
+   append_number_( m_stringBuffer, ( uint64_t( iDifference ) << 1 ) ^ uint64_t( iDifference >> 63 ) );
+   m_uTime = uTime;
+}
+
+
+// ================================================================================================
+// ================================================================================= decode
+// ================================================================================================
+
+/*----------------------------------------------------------------------------- binary_decode_g */ /**
+ * Read data written by `printer_binary` and generate text for each message
+ * \param stringData file data
+ * \param callback_ called for each message, return false to stop
+ * \return true if ok, false and error information if data is invalid
+ */
+std::pair<bool, std::string> binary_decode_g( std::string_view stringData, const std::function<bool( const binary_record& )>& callback_ )
+{
+   struct format_
+   {
+      unsigned m_uSeverity;
+      unsigned m_uLine;
+      std::string_view m_stringFile;
+      std::string_view m_stringFormat;
+   };
+
+   const uint8_t* puBegin = (const uint8_t*)stringData.data();
+   const uint8_t* puEnd = puBegin + stringData.length();
+   const uint8_t* puPosition = puBegin;
+
+   std::unordered_map<uint64_t, format_> mapFormat;                            // format for id in active session
+   uint64_t uTime = 0;
+   binary_record record_;
+
+   auto error_ = [&]( const char* pbszError ) -> std::pair<bool, std::string> { return { false, std::string( pbszError ) + " at offset " + std::to_string( puPosition - puBegin ) }; };
+
+   if( stringData.starts_with( SESSION_HEADER.substr( 0, 6 ) ) == false ) return error_( "not a binary log file" );
+
+   while( puPosition < puEnd )
+   {
+      uint8_t uChunk = *puPosition;
+      if( uChunk == 'G' )                                                      // new session
+      {
+         if( std::string_view( (const char*)puPosition, std::min<size_t>( SESSION_HEADER.length(), puEnd - puPosition ) ) != SESSION_HEADER ) return error_( "unknown session header" );
+         puPosition += SESSION_HEADER.length();
+         mapFormat.clear();
+         uTime = 0;
+         continue;
+      }
+
+      puPosition++;
+      uint64_t uId = 0, uSeverity = 0, uLine = 0, uTimeDifference = 0, uSize = 0;
+      std::string_view stringFile, stringText;
+
+      if( uChunk == 'F' )
+      {
+         if( read_number_( puPosition, puEnd, uId ) == false || read_number_( puPosition, puEnd, uSeverity ) == false || read_number_( puPosition, puEnd, uLine ) == false ) return error_( "invalid format" );
+         if( read_text_( puPosition, puEnd, stringFile ) == false || read_text_( puPosition, puEnd, stringText ) == false ) return error_( "invalid format" );
+         mapFormat[uId] = format_{ (unsigned)uSeverity, (unsigned)uLine, stringFile, stringText };
+         continue;
+      }
+
+      if( uChunk == 'R' && read_number_( puPosition, puEnd, uId ) == false ) return error_( "invalid record" );
+      if( uChunk != 'R' && uChunk != 'T' ) return error_( "unknown chunk" );
+
+      if( read_number_( puPosition, puEnd, uSeverity ) == false || read_number_( puPosition, puEnd, uTimeDifference ) == false ) return error_( "invalid record" );
+      if( read_number_( puPosition, puEnd, uSize ) == false || uSize > uint64_t( puEnd - puPosition ) ) return error_( "invalid record" );
+
+      uTime += uint64_t( int64_t( uTimeDifference >> 1 ) ^ -int64_t( uTimeDifference & 1 ) );
+
+      record_.m_uSeverity = (unsigned)uSeverity;
+      record_.m_uTime = uTime;
+      record_.m_stringFile = std::string_view();
+      record_.m_uLine = 0;
+      record_.m_stringText.clear();
+
+      if( uChunk == 'T' ) { record_.m_stringText.assign( (const char*)puPosition, (size_t)uSize ); }
+      else
+      {
+         auto itFormat = mapFormat.find( uId );
+         if( itFormat != mapFormat.end() )
+         {
+            record_.m_stringFile = itFormat->second.m_stringFile;
+            record_.m_uLine = itFormat->second.m_uLine;
+            binary_render_g( itFormat->second.m_stringFormat, puPosition, (uint32_t)uSize, record_.m_stringText );
+         }
+         else
+         {
+            record_.m_stringText = "format " + std::to_string( uId ) + ":";
+            binary_render_g( std::string_view(), puPosition, (uint32_t)uSize, record_.m_stringText );
+         }
+      }
+
+      puPosition += uSize;
+      if( callback_( record_ ) == false ) break;
+   }
+
+   return { true, "" };
+}
+
+_GD_LOG_LOGGER_END
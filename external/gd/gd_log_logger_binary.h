@@ -0,0 +1,277 @@
+// @FILE [tag: log, binary] [description: Deferred log messages stored as format id and packed arguments] [type: header] [name: gd_log_logger_binary.h]
+
+/**
+ * \file gd_log_logger_binary.h
+ *
+ * \brief Deferred log messages, text is generated when message is printed or by offline decoder
+ *
+ * Format text is registered once for each call site and gets a format id. Log calls only
+ * check severity, pack argument values into a stack buffer and pass format id with values
+ * to logger. No text is formatted and nothing is allocated in the logging thread.
+ *
+ * Arguments are packed like `gd::argument::arguments`, one type byte (same type numbers)
+ * followed by value. Strings have length flag in type byte and a 16 bit length before text.
+ *
+ * - `format_add_g` register format for call site, returns format id
+ * - `binary_arguments` stack buffer with packed argument values
+ * - `binary_render_g` generate text from format and packed values, `{}` is replaced with next value
+ * - `printer_binary` printer that writes deferred messages without formatting them
+ * - `binary_decode_g` read file written by `printer_binary` and generate text
+ *
+ \code
+gd::log::get_s()->append( std::make_unique<gd::log::printer_binary>( "server.glog" ) );
+gd::log::get_s()->async_start();
+
+LOG_DEBUG_BINARY( "request {} took {} ms", stringPath, uMilliseconds );   // only values are stored
+ \endcode
+ *
+ * ### File format written by `printer_binary`
+ * Numbers are unsigned LEB128 (7 bits for each byte), time is zigzag encoded difference
+ * in nanoseconds from previous record. Each time file is opened a new session starts,
+ * format ids are only valid within session.
+ \verbatim
+file     = { session }
+session  = "GDLOGB" version(1 byte) '\n' { chunk }
+chunk    = 'F' id severity line file-length file format-length format    format text for id, written before first use
+         | 'R' id severity time argument-length arguments               deferred message
+         | 'T' severity time text-length text                           text message
+ \endverbatim
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "gd_types.h"
+#include "gd_log_logger.h"
+
+#ifndef _GD_LOG_LOGGER_BEGIN
+
+#  define _GD_LOG_LOGGER_BEGIN namespace gd { namespace log {
+#  define _GD_LOG_LOGGER_END } }
+
+#endif
+
+_GD_LOG_LOGGER_BEGIN
+
+// ================================================================================================
+// ================================================================================= format
+// ================================================================================================
+
+/// Format registered for call site logging deferred messages
+struct format_info
+{
+   uint32_t m_uId = 0;                 ///< format id, position in registry + 1
+   unsigned m_uSeverity = 0;           ///< severity used at call site
+   unsigned m_uLine = 0;               ///< line in source file
+   const char* m_pbszFile = nullptr;   ///< source file
+   const char* m_pbszFormat = nullptr; ///< format text, `{}` is replaced with argument value
+};
+
+/// Register format for call site, strings need to live as long as the application (literals)
+uint32_t format_add_g( unsigned uSeverity, const char* pbszFile, unsigned uLine, const char* pbszFormat );
+/// Get format for id, null if id is unknown
+const format_info* format_get_g( uint32_t uId );
+
+
+// ================================================================================================
+// ================================================================================= binary_arguments
+// ================================================================================================
+
+/**
+ * \brief Stack buffer with packed argument values for deferred log message
+ *
+ * Values that do not fit are skipped, renderer prints `{?}` for placeholders that are
+ * missing values. Supported values are booleans, integers, enums, floating point numbers,
+ * pointers and ascii/utf8 strings.
+ */
+class binary_arguments
+{
+public:
+   enum { eValueLength = 0b0100'0000 };   ///< same flag as in `gd::argument::arguments`, value has length before data
+
+public:
+   binary_arguments() {}
+   template<typename... ARGUMENTS>
+   explicit binary_arguments( const ARGUMENTS&... arguments_ ) { ( append( arguments_ ), ... ); }
+
+   binary_arguments( const binary_arguments& ) = delete;
+   binary_arguments& operator=( const binary_arguments& ) = delete;
+
+// ## methods ------------------------------------------------------------------
+public:
+   template<typename VALUE>
+   void append( const VALUE& v_ );
+
+   const uint8_t* data() const { return m_puBuffer; }
+   uint32_t size() const { return m_uSize; }
+
+   /// Create view used by logger, time is set to now
+   binary_view view( uint32_t uFormat, unsigned uSeverity ) const;
+
+protected:
+   void append_( uint8_t uType, const void* pValue, uint32_t uSize );
+   void append_( std::string_view stringValue );
+
+// ## attributes ----------------------------------------------------------------
+public:
+   uint32_t m_uSize = 0;                           ///< used bytes in buffer
+   static constexpr uint32_t m_uCapacity_s = 512;  ///< max bytes for packed values
+   uint8_t m_puBuffer[m_uCapacity_s];              ///< packed values
+};
+
+/// Pack value, type number is selected from value type at compile time
+template<typename VALUE>
+void binary_arguments::append( const VALUE& v_ )
+{
+   using type = std::decay_t<VALUE>;
+   if constexpr( std::is_same_v<type, bool> ) { uint8_t u_ = v_ ? 1 : 0; append_( gd::types::eTypeNumberBool, &u_, 1 ); }
+   else if constexpr( std::is_same_v<type, char> ) { append_( std::string_view( &v_, 1 ) ); }
+   else if constexpr( std::is_enum_v<type> ) { append( static_cast<std::underlying_type_t<type>>( v_ ) ); }
+   else if constexpr( std::is_integral_v<type> )
+   {
+      constexpr uint8_t uType = sizeof( type ) == 1 ? ( std::is_signed_v<type> ? gd::types::eTypeNumberInt8 : gd::types::eTypeNumberUInt8 )
+                              : sizeof( type ) == 2 ? ( std::is_signed_v<type> ? gd::types::eTypeNumberInt16 : gd::types::eTypeNumberUInt16 )
+                              : sizeof( type ) == 4 ? ( std::is_signed_v<type> ? gd::types::eTypeNumberInt32 : gd::types::eTypeNumberUInt32 )
+                              : ( std::is_signed_v<type> ? gd::types::eTypeNumberInt64 : gd::types::eTypeNumberUInt64 );
+      append_( uType, &v_, sizeof( type ) );
+   }
+   else if constexpr( std::is_same_v<type, float> ) { append_( gd::types::eTypeNumberFloat, &v_, sizeof( float ) ); }
+   else if constexpr( std::is_floating_point_v<type> ) { double d_ = (double)v_; append_( gd::types::eTypeNumberDouble, &d_, sizeof( double ) ); }
+   else if constexpr( std::is_convertible_v<const VALUE&, std::string_view> ) { append_( std::string_view( v_ ) ); }
+#  if defined(__cpp_char8_t)
+   else if constexpr( std::is_convertible_v<const VALUE&, std::u8string_view> ) { std::u8string_view s_( v_ ); append_( std::string_view( (const char*)s_.data(), s_.size() ) ); }
+#  endif
+   else if constexpr( std::is_pointer_v<type> ) { uint64_t u_ = (uint64_t)(uintptr_t)v_; append_( gd::types::eTypeNumberPointer, &u_, sizeof( uint64_t ) ); }
+   else { static_assert( sizeof( type ) == 0, "value type is not supported in deferred log message" ); }
+}
+
+/// Add value with type byte, value is skipped if buffer is full
+inline void binary_arguments::append_( uint8_t uType, const void* pValue, uint32_t uSize )
+{
+   if( m_uSize + 1 + uSize > m_uCapacity_s ) return;
+   m_puBuffer[m_uSize] = uType;
+   std::memcpy( m_puBuffer + m_uSize + 1, pValue, uSize );
+   m_uSize += 1 + uSize;
+}
+
+/// Add string with length, string is truncated to fit in buffer
+inline void binary_arguments::append_( std::string_view stringValue )
+{
+   if( m_uSize + 3 >= m_uCapacity_s ) return;
+   uint32_t uLength = (uint32_t)stringValue.length();
+   if( uLength > m_uCapacity_s - m_uSize - 3 ) uLength = m_uCapacity_s - m_uSize - 3;
+   m_puBuffer[m_uSize] = uint8_t( gd::types::eTypeNumberString ) | uint8_t( eValueLength );
+   uint16_t uLength16 = (uint16_t)uLength;
+   std::memcpy( m_puBuffer + m_uSize + 1, &uLength16, sizeof( uint16_t ) );
+   // copy in 8 byte blocks, compilers expand memcpy with known max size to `rep movs` that is slow for short strings
+   uint8_t* puTarget = m_puBuffer + m_uSize + 3;
+   const char* pbszSource = stringValue.data();
+   uint32_t uCopy = uLength;
+   for( ; uCopy >= 8; uCopy -= 8, puTarget += 8, pbszSource += 8 ) std::memcpy( puTarget, pbszSource, 8 );
+   for( ; uCopy > 0; uCopy-- ) *puTarget++ = (uint8_t)*pbszSource++;
+   m_uSize += 3 + uLength;
+}
+
+
+// ================================================================================================
+// ================================================================================= render
+// ================================================================================================
+
+/// Append text for format with packed values to string, `{}` is replaced with value and `{{` `}}` are escaped braces
+void binary_render_g( std::string_view stringFormat, const uint8_t* puArgument, uint32_t uSize, std::string& stringText );
+/// Generate text for deferred message, format is read from registry
+std::string binary_render_g( const binary_view& binary_ );
+
+
+// ================================================================================================
+// ================================================================================= printer_binary
+// ================================================================================================
+
+/**
+ * \brief Write deferred messages to file without formatting them
+ *
+ * Format text is written the first time a format id is used in file, each message
+ * only stores format id, time difference and packed values. Text messages are stored
+ * as text. Read file with `binary_decode_g` (or the `logdecode` tool).
+ *
+ * Output is collected in memory and written when buffer is full, when error messages
+ * are printed, in `flush` and when async batch ends.
+ */
+class printer_binary : public i_printer
+{
+// ## construction -------------------------------------------------------------
+public:
+   printer_binary( const std::string_view& stringFileName );
+   printer_binary( const std::string_view& stringName, const std::string_view& stringFileName );
+   ~printer_binary();
+
+   printer_binary( const printer_binary& ) = delete;
+   printer_binary& operator=( const printer_binary& ) = delete;
+
+// ## override -----------------------------------------------------------------
+public:
+   bool print( const message& message ) override;
+   bool print_binary( const binary_view& binary_ ) override;
+   bool flush() override;
+   void batch_begin() override { m_bBatch = true; }
+   bool batch_end() override;
+   unsigned error( message& message ) override;
+
+protected:
+/** \name INTERNAL
+*///@{
+   bool write_( bool bForce );
+   void add_format_( uint32_t uFormat );
+   void add_time_( uint64_t uTime );
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   std::wstring m_stringFileName;      ///< log file
+   int m_iFileHandle = -1;             ///< file handle, file is opened on first write
+   bool m_bBatch = false;              ///< async batch is active, buffer is written when batch ends
+   std::string m_stringBuffer;         ///< data not written to file
+   std::vector<bool> m_vectorFormat;   ///< format ids written to file in this session
+   uint64_t m_uTime = 0;               ///< time for last record, records store difference
+   std::string m_stringError;          ///< last error
+
+   inline static size_t m_uBufferSize_s = 64 * 1024;  ///< buffer is written to file when it is this size
+};
+
+
+// ================================================================================================
+// ================================================================================= decode
+// ================================================================================================
+
+/// Decoded message from binary log file
+struct binary_record
+{
+   unsigned m_uSeverity = 0;
+   uint64_t m_uTime = 0;               ///< nanoseconds since epoch
+   std::string_view m_stringFile;      ///< source file, empty for text messages
+   unsigned m_uLine = 0;               ///< line in source file
+   std::string m_stringText;           ///< message text
+};
+
+/// Read binary log data and call callback for each message, callback returns false to stop
+std::pair<bool, std::string> binary_decode_g( std::string_view stringData, const std::function<bool( const binary_record& )>& callback_ );
+
+
+/// ----------------------------------------------------------------------------
+/// Create view for logger
+inline binary_view binary_arguments::view( uint32_t uFormat, unsigned uSeverity ) const
+{
+   uint64_t uTime = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::system_clock::now().time_since_epoch() ).count();
+   return binary_view{ uFormat, uSeverity, uTime, m_puBuffer, m_uSize };
+}
+
+_GD_LOG_LOGGER_END
@@ -12,6 +12,7 @@
  * - `LOG_IF_` Generate log if condition is true
  * - `LOG_IF` Use default logger 0 with condition if log or not
  * - `LOG_IF_NR` If log based on condition is true or not and multiple loggers are used
+ * - `LOG_BINARY_` Deferred message, format id and argument values are logged and text is generated when printed
  * 
  * Other log macros are used to simplify or make code more readable, one macro type for
  * each severity level.
@@ -23,13 +24,16 @@
 #ifdef GD_LOG_SIMPLE
 
    // `LOG_` does it all, in the end all other log macros will call `LOG_`
-   #define LOG_( uLogger, uSeverity, expression ) gd::log::get_g<uLogger,false>()->print( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << __FILE__ << __func__ << expression )
+   // severity is checked before message is created, text is not generated for messages that are filtered
+   #define LOG_( uLogger, uSeverity, expression ) \
+      if( gd::log::get_g<uLogger,false>()->is_severity( gd::log::severity_get_g( uSeverity ) ) == false ) {;} else gd::log::get_g<uLogger,false>()->print( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << __FILE__ << __func__ << expression )
    #define LOG2_( uLogger, uSeverity, tag, expression ) \
       if( (*gd::log::get_g<uLogger,false>())( tag ) ) gd::log::get_g<uLogger,false>()->print_always( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << __FILE__ << __func__ << expression )
    // `LOG_RAW_` doesn't print file and function name, it only prints what is sent. Good to have when you only want to produce information
    //#define LOG_RAW_( uLogger, uSeverity, expression ) gd::log::get_g<uLogger,false>()->print( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << expression )
    
-   #define LOG_RAW_( uLogger, uSeverity, expression ) gd::log::print_message<uLogger,false>( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << expression )
+   #define LOG_RAW_( uLogger, uSeverity, expression ) \
+      if( gd::log::get_g<uLogger,false>()->is_severity( gd::log::severity_get_g( uSeverity ) ) == false ) {;} else gd::log::print_message<uLogger,false>( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << expression )
    #define LOG_RAW2_( uLogger, uSeverity, tag, expression ) \
       if( (*gd::log::get_g<uLogger,false>())( tag ) ) gd::log::print_message_always<uLogger,false>( gd::log::message( gd::log::severity_get_g( uSeverity ), gd::log::eMessageTypeAll ) << expression )
 
@@ -40,6 +44,12 @@
    #define LOG_RAW( uSeverity, expression ) LOG_RAW_( 0, gd::log::severity_get_g( uSeverity ), expression )
    #define LOG_RAW2( uSeverity, tag, expression ) LOG_RAW2_( 0, gd::log::severity_get_g( uSeverity ), tag, expression )
 
+   // `LOG_BINARY_` logs deferred message, format is registered once for call site and only argument values are stored (include gd_log_logger_binary.h)
+   #define LOG_BINARY_( uLogger, uSeverity, pbszFormat, ... ) \
+      if( gd::log::get_g<uLogger,false>()->is_severity( gd::log::severity_get_g( uSeverity ) ) == false ) {;} else \
+         gd::log::get_g<uLogger,false>()->print( gd::log::binary_arguments( __VA_ARGS__ ).view( []() { static const uint32_t uFormat_s = gd::log::format_add_g( gd::log::severity_get_g( uSeverity ), __FILE__, __LINE__, pbszFormat ); return uFormat_s; }(), gd::log::severity_get_g( uSeverity ) ) )
+   #define LOG_BINARY( uSeverity, ... ) LOG_BINARY_( 0, uSeverity, __VA_ARGS__ )
+
    #define LOG_SET_SEVERITY( uSeverity ) gd::log::get_g<0,false>()->set_severity( gd::log::severity_get_g( uSeverity ) )
    #define LOG_GET_SEVERITY() gd::log::get_g<0,false>()->get_severity()
    
@@ -75,6 +85,13 @@
    #define LOG_VERBOSE_RAW(expression)             LOG_RAW("VERBOSE", expression)
    #define LOG_NONE_RAW(expression)                LOG_RAW("NONE", expression)
 
+   #define LOG_FATAL_BINARY(...)                   LOG_BINARY("FATAL", __VA_ARGS__)
+   #define LOG_ERROR_BINARY(...)                   LOG_BINARY("ERROR", __VA_ARGS__)
+   #define LOG_WARNING_BINARY(...)                 LOG_BINARY("WARNING", __VA_ARGS__)
+   #define LOG_INFORMATION_BINARY(...)             LOG_BINARY("INFORMATION", __VA_ARGS__)
+   #define LOG_DEBUG_BINARY(...)                   LOG_BINARY("DEBUG", __VA_ARGS__)
+   #define LOG_VERBOSE_BINARY(...)                 LOG_BINARY("VERBOSE", __VA_ARGS__)
+
    #define LOG_FATAL_RAW2(tag, expression)         LOG_RAW2("FATAL", tag, expression)
    #define LOG_ERROR_RAW2(tag, expression)         LOG_RAW2("ERROR", tag, expression)
    #define LOG_WARNING_RAW2(tag, expression)       LOG_RAW2("WARNING", tag, expression)
@@ -129,6 +146,9 @@
    #define LOG_RAW( uSeverity, expression ) LOG_RAW_( 0, gd::log::severity_get_g( uSeverity ), expression )
    #define LOG_RAW2( uSeverity, tag, expression ) LOG_RAW2_( 0, gd::log::severity_get_g( uSeverity ), tag, expression )
 
+   #define LOG_BINARY_( uLogger, uSeverity, ... ) ((void)0)
+   #define LOG_BINARY( uSeverity, ... ) ((void)0)
+
    #define LOG_SET_SEVERITY( uSeverity ) ((void)0)
    #define LOG_GET_SEVERITY() 0
 
@@ -164,6 +184,13 @@
    #define LOG_VERBOSE_RAW(expression)             LOG_RAW("VERBOSE", expression)
    #define LOG_NONE_RAW(expression)                LOG_RAW("NONE", expression)
 
+   #define LOG_FATAL_BINARY(...)                   LOG_BINARY("FATAL", __VA_ARGS__)
+   #define LOG_ERROR_BINARY(...)                   LOG_BINARY("ERROR", __VA_ARGS__)
+   #define LOG_WARNING_BINARY(...)                 LOG_BINARY("WARNING", __VA_ARGS__)
+   #define LOG_INFORMATION_BINARY(...)             LOG_BINARY("INFORMATION", __VA_ARGS__)
+   #define LOG_DEBUG_BINARY(...)                   LOG_BINARY("DEBUG", __VA_ARGS__)
+   #define LOG_VERBOSE_BINARY(...)                 LOG_BINARY("VERBOSE", __VA_ARGS__)
+
    #define LOG_FATAL_RAW2(tag, expression)         LOG_RAW2("FATAL", tag, expression)
    #define LOG_ERROR_RAW2(tag, expression)         LOG_RAW2("ERROR", tag, expression)
    #define LOG_WARNING_RAW2(tag, expression)       LOG_RAW2("WARNING", tag, expression)
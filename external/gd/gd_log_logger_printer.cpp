@@ -211,6 +211,13 @@ void printer_console::print(const std::wstring_view& stringMessage)
    m_uMessageCounter++;                                                          // add message counter, number of messages before flush is called
 }
 
+/// Text is written to console for each message, batch only resets batch mode
+bool printer_console::batch_end()
+{
+   m_bBatch = false;
+   return true;
+}
+
 #else 
 /*----------------------------------------------------------------------------- print */ /**
  * print is overridden from i_print and is called when logger prints something and sends it
@@ -330,11 +337,29 @@ bool printer_console::flush()
 void printer_console::print(const std::wstring_view& stringMessage)
 {
    std::string stringMessageAscii = gd::utf8::convert_unicode_to_ascii( stringMessage );
-   auto uWriteLength = write( STDOUT_FILENO, (const void*)stringMessageAscii.c_str(), stringMessageAscii.length() );
+   if( m_bBatch == true ) { m_stringBatch += stringMessageAscii; }
+   else                   { auto uWriteLength = write( STDOUT_FILENO, (const void*)stringMessageAscii.c_str(), stringMessageAscii.length() ); }
 
    m_uMessageCounter++;                                                          // add message counter, number of messages before flush is called
 }
 
+/// Write output collected in batch with one write call
+bool printer_console::batch_end()
+{
+   m_bBatch = false;
+   const char* pbszWrite = m_stringBatch.c_str();
+   std::size_t uLeft = m_stringBatch.length();
+   while( uLeft > 0 )                                                            // write may write less than requested for pipes
+   {
+      auto iWriteLength = write( STDOUT_FILENO, (const void*)pbszWrite, uLeft );
+      if( iWriteLength <= 0 ) { m_stringBatch.clear(); return false; }
+      pbszWrite += iWriteLength;
+      uLeft -= (std::size_t)iWriteLength;
+   }
+   m_stringBatch.clear();
+   return true;
+}
+
 #endif
 
 // ================================================================================================
@@ -415,7 +440,7 @@ bool printer_file::print(const message& message)
 
    if( stringMessage.empty() == false )
    {
-      auto [bOk, stringError] = file_write_s(m_iFileHandle, stringMessage, gd::utf8::tag_utf8{});
+      bool bOk = write_(stringMessage, gd::utf8::tag_utf8{});
       if( bOk == false )
       {
          // TODO: manage error, get information from string and 
@@ -426,7 +451,7 @@ bool printer_file::print(const message& message)
 
    const char* pbszMessage = message.get_text();
 
-   auto [ bOk, stringError] = file_write_s(m_iFileHandle, pbszMessage);
+   bool bOk = write_(pbszMessage);
    if( bOk == false )
    {
       // TODO: manage error, get information from string and 
@@ -446,13 +471,53 @@ bool printer_file::flush()
          pbsz[0] = (char)m_stringNewLine[0];
          pbsz[1] = (char)m_stringNewLine[1];
          pbsz[2] = 0;
-         file_write_s(m_iFileHandle, pbsz);
+         write_(pbsz);
       }
    }
 
    return true;
 }
 
+/// Write text collected in batch with one write call
+bool printer_file::batch_end()
+{
+   m_bBatch = false;
+   if( m_stringBatch.empty() == true || is_open() == false ) { m_stringBatch.clear(); return true; }
+
+   auto [bOk, stringError] = file_write_s(m_iFileHandle, m_stringBatch);
+   m_stringBatch.clear();
+   if( bOk == false )
+   {
+      m_messageError.set_severity(eSeverityError);
+      m_messageError << stringError;
+      return false;
+   }
+
+   return true;
+}
+
+/// Write ascii/utf8 text, in batch mode text is added to batch buffer
+bool printer_file::write_( const std::string_view& stringText )
+{
+   if( m_bBatch == true ) { m_stringBatch += stringText; return true; }
+   return file_write_s(m_iFileHandle, stringText).first;
+}
+
+/// Write unicode text converted to utf8, in batch mode text is added to batch buffer
+bool printer_file::write_( const std::wstring_view& stringText, gd::utf8::tag_utf8 )
+{
+   if( m_bBatch == true ) 
+   { 
+      auto uUtf8Size = gd::utf8::size(stringText.data());                        // how big buffer is needed to store unicode as utf8 text
+      auto uOffset = m_stringBatch.size();
+      m_stringBatch.resize( uOffset + uUtf8Size + 1 );                           // make room for zero terminator
+      gd::utf8::convert_unicode(stringText.data(), m_stringBatch.data() + uOffset, m_stringBatch.data() + m_stringBatch.size() );
+      m_stringBatch.resize( uOffset + uUtf8Size );
+      return true; 
+   }
+   return file_write_s(m_iFileHandle, stringText, gd::utf8::tag_utf8{}).first;
+}
+
 unsigned printer_file::error(message& message)
 {
    if( m_messageError.empty() == false )
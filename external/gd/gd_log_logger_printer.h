@@ -220,6 +220,8 @@ public:
    *///@{
    virtual bool print(const message& message);
    virtual bool flush();
+   virtual void batch_begin() { m_bBatch = true; }
+   virtual bool batch_end();
 
    void print(const std::wstring_view& stringMessage);
    //@}
@@ -243,6 +245,8 @@ public:
    unsigned m_uSeverityMargin = 0;     ///< To make formating better this may be used to have similar margin for all type of messages
    unsigned m_uMessageCounter = 0;     ///< number of messages needed to flush (when flush is called this is reset to 0)
    unsigned m_uMarginColor    = 0;     ///< color for margin text
+   bool     m_bBatch          = false; ///< collect output in `m_stringBatch` until batch ends
+   std::string m_stringBatch;          ///< output collected in batch mode, written with one write call
    std::array<unsigned, eSeverity_Count> m_arrayColor;///< colors for severity types
 
    /// default colors
@@ -317,6 +321,8 @@ public:
    virtual bool print(const message& message);
    virtual bool flush();
    virtual unsigned error( message& message );
+   virtual void batch_begin() { m_bBatch = true; }
+   virtual bool batch_end();
 
 
 // ## methods ------------------------------------------------------------------
@@ -345,6 +351,9 @@ protected:
    /// check if internal error
    /// \param uErrorCode code to check, usually a bit that is tested
    bool is_error(unsigned uErrorCode) const { return ((uErrorCode & m_uInternalError) != 0); }
+   /// write text to file, in batch mode text is collected and written in `batch_end`
+   bool write_( const std::string_view& stringText );
+   bool write_( const std::wstring_view& stringText, gd::utf8::tag_utf8 );
 //@}
 
 public:
@@ -364,6 +373,8 @@ public:
    wchar_t m_wchEndWrap  = L']';    ///< If text is wrapped then add this after text
    int m_iFileHandle = -1;          ///< used as file handle to log file that is written to
    gd::log::message m_messageError; ///< temporary storage for internal error information
+   bool m_bBatch = false;           ///< collect text in `m_stringBatch` until batch ends
+   std::string m_stringBatch;       ///< text collected in batch mode, written with one write call
    
    
 // ## free functions ------------------------------------------------------------
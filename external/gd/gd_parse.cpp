@@ -1,5 +1,6 @@
 
 
+#include <algorithm>
 #include <bit>
 #include <charconv>
 
@@ -31,6 +32,12 @@
 
 #endif
 
+// sse2 is part of x64, used for scan methods that do not need to be tagged
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#  define GD_SSE2
+#  include <emmintrin.h>
+#endif
+
 
 #include "gd_parse.h"
 
@@ -364,6 +371,91 @@ const char* next_character_or_end_g( const char* pbsz, char chFind, tag_avx256 )
 }
 
 
+/** ---------------------------------------------------------------------------
+ * @brief Move to first character that is any of the characters in `stringAny`
+ *
+ * Scans 16 bytes at the time if sse2 is available, compares with each character
+ * in set and stops at first block with a match. Used to skip text up to positions
+ * where something might start, like first character in markers.
+ *
+ * @param pbsz start of text
+ * @param pbszEnd end of text
+ * @param stringAny characters to find, keep it short, each character is one compare for each block
+ * @return pointer to first found character or `pbszEnd` if not found
+ */
+const char* next_any_character_or_end_g( const char* pbsz, const char* pbszEnd, const std::string_view& stringAny )
+{                                                                                                  assert( pbsz <= pbszEnd );
+   if( stringAny.empty() == true ) return pbszEnd;
+
+#ifdef GD_SSE2
+   if( stringAny.length() <= 16 )
+   {
+      __m128i piAny[16];
+      for( size_t u = 0; u < stringAny.length(); u++ ) piAny[u] = _mm_set1_epi8( stringAny[u] );
+
+      for( ; (pbszEnd - pbsz) >= 16; pbsz += 16 )
+      {
+         __m128i i16ByteSection = _mm_loadu_si128( (const __m128i*)pbsz );
+         __m128i iCompare = _mm_cmpeq_epi8( i16ByteSection, piAny[0] );
+         for( size_t u = 1; u < stringAny.length(); u++ ) iCompare = _mm_or_si128( iCompare, _mm_cmpeq_epi8( i16ByteSection, piAny[u] ) );
+
+         int iMask = _mm_movemask_epi8( iCompare );
+         if( iMask != 0 ) return pbsz + std::countr_zero( (unsigned)iMask );
+      }
+   }
+#endif
+
+   for( ; pbsz < pbszEnd; pbsz++ )
+   {
+      if( stringAny.find( *pbsz ) != std::string_view::npos ) return pbsz;
+   }
+
+   return pbszEnd;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Count number of `chFind` characters in text
+ *
+ * Scans 16 bytes at the time if sse2 is available, matches are summed in byte
+ * counters that are folded to total before they are able to overflow.
+ *
+ * @param pbsz start of text
+ * @param pbszEnd end of text
+ * @param chFind character to count
+ * @return number of found characters
+ */
+uint64_t count_character_g( const char* pbsz, const char* pbszEnd, char chFind )
+{                                                                                                  assert( pbsz <= pbszEnd );
+   uint64_t uCount = 0;
+
+#ifdef GD_SSE2
+   const __m128i iCharFind = _mm_set1_epi8( chFind );
+   const __m128i iZero = _mm_setzero_si128();
+
+   while( (pbszEnd - pbsz) >= 16 )
+   {
+      __m128i iByteCount = _mm_setzero_si128();                                // counters for each byte position, max 255 blocks before fold
+      const char* pbszBlockEnd = pbsz + std::min<std::ptrdiff_t>( (pbszEnd - pbsz) & ~std::ptrdiff_t(15), 255 * 16 );
+      for( ; pbsz < pbszBlockEnd; pbsz += 16 )
+      {
+         __m128i i16ByteSection = _mm_loadu_si128( (const __m128i*)pbsz );
+         iByteCount = _mm_sub_epi8( iByteCount, _mm_cmpeq_epi8( i16ByteSection, iCharFind ) ); // match is -1, subtract to add one
+      }
+
+      __m128i iSum = _mm_sad_epu8( iByteCount, iZero );                        // sum byte counters into two 64 bit values
+      uCount += (uint64_t)_mm_cvtsi128_si32( iSum ) + (uint64_t)_mm_cvtsi128_si32( _mm_unpackhi_epi64( iSum, iSum ) );
+   }
+#endif
+
+   for( ; pbsz < pbszEnd; pbsz++ )
+   {
+      if( *pbsz == chFind ) uCount++;
+   }
+
+   return uCount;
+}
+
+
 
 
 /// Move to space character
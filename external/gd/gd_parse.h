@@ -539,6 +539,15 @@ const char* next_character_or_end_g( const char* pbsz, const char* pbszEnd, char
 inline const char* next_character_or_end_g( const char* pbsz, std::size_t uLength, char chFind ) { return next_character_or_end_g( pbsz, pbsz + uLength, chFind ); }
 const char* next_character_or_end_g( const char* pbsz, char chFind, tag_avx256 );
 
+/// Move to first character found in `stringAny` or end
+const char* next_any_character_or_end_g( const char* pbsz, const char* pbszEnd, const std::string_view& stringAny );
+
+// ## count methods
+
+/// Count number of `chFind` characters in text
+uint64_t count_character_g( const char* pbsz, const char* pbszEnd, char chFind );
+inline uint64_t count_character_g( const std::string_view& stringText, char chFind ) { return count_character_g( stringText.data(), stringText.data() + stringText.length(), chFind ); }
+
 
 const char* next_space_g( const char* pbsz );
 const char* next_space_g( const char* pbsz, const char* pbszEnd );
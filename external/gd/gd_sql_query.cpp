@@ -1,6 +1,8 @@
 // @FILE [tag: sql, query] [description: Core logic for SQL queries] [type: source] [name: gd_sql_query.cpp]
 
 #include <array>
+#include <cctype>
+#include <charconv>
 
 #include "gd_utf8.h"
 #include "gd_parse.h"
@@ -2085,9 +2087,17 @@ void query::sql_append( std::string_view stringPart, std::string& stringSql, boo
  *
  * @see replace_g() for the underlying implementation
  * @see append_g() for value formatting and SQL escaping logic
+ * @par Bind Parameters
+ * When `pvectorBind` is set, value placeholders (`{name}`, `{*name}`, `{0}`) are
+ * replaced with `?` and the value is added to `pvectorBind` in parameter order.
+ * Same template and same placeholders generates the same SQL text so prepared
+ * statements can be reused. Values are still placed in text for raw values,
+ * arrays, formatted values, binary values, clause injection and placeholders
+ * that are part of another token like `X{key}`.
+ *
  * @see sql_get_part() for the SQL generation implementation
  */
-std::pair<bool, std::string> query::sql_format( std::string_view stringTemplate, std::string& stringSqlAddTo, const gd::argument::arguments* pargumentsValues ) const
+std::pair<bool, std::string> query::sql_format( std::string_view stringTemplate, std::string& stringSqlAddTo, const gd::argument::arguments* pargumentsValues, std::vector<gd::variant>* pvectorBind ) const
 {
    using namespace gd::types;
    unsigned uArgumentIndex = 0;    // Used to count index in positional arguments when placeholder is numeric and no named argument is found
@@ -2098,6 +2108,16 @@ std::pair<bool, std::string> query::sql_format( std::string_view stringTemplate,
 
    stringSql.reserve( stringTemplate.length() + 64 );
 
+   const char* pitTemplateEnd = stringTemplate.data() + stringTemplate.length();
+   // ## placeholder can be bound as parameter if it is a separate token in sql, characters around can not be part of a name or literal
+   auto is_bind_ = [&stringSql, pvectorBind, pitTemplateEnd]( const char* pitNext ) -> bool {
+      if( pvectorBind == nullptr ) return false;
+      auto is_token_ = []( char ch ) { return std::isalnum( static_cast<unsigned char>( ch ) ) != 0 || ch == '_' || ch == '\'' || ch == '"' || ch == '%'; };
+      if( stringSql.empty() == false && is_token_( stringSql.back() ) == true ) return false;
+      if( pitNext < pitTemplateEnd && is_token_( *pitNext ) == true ) return false;
+      return true;
+   };
+
    for( const char* pit = stringTemplate.data(), * pitEnd = stringTemplate.data() + stringTemplate.length(); pit < pitEnd; pit++ )
    {
       if( *pit != '{' )
@@ -2203,7 +2223,8 @@ std::pair<bool, std::string> query::sql_format( std::string_view stringTemplate,
             auto variantviewFound = (*pargumentsValues)[uIndex].as_variant_view();
             if( variantviewFound.is_null() == false )
             {
-               if( bRaw == false ) append_g( variantviewFound, 0u, get_dialect(), stringSql, gd::types::tag_view{} ); // format value for sql
+               if( bRaw == false && is_bind_( pit + 1 ) == true && variantviewFound.is_binary() == false ) { stringSql += '?'; pvectorBind->push_back( variantviewFound.as_variant() ); }
+               else if( bRaw == false ) append_g( variantviewFound, 0u, get_dialect(), stringSql, gd::types::tag_view{} ); // format value for sql
                else                append_g( variantviewFound, stringSql, gd::sql::tag_raw{} ); // raw value, no formatting
                uArgumentIndex = uIndex + 1;
             }
@@ -2234,9 +2255,15 @@ std::pair<bool, std::string> query::sql_format( std::string_view stringTemplate,
          auto variantviewFound = (*pargumentsValues)[std::string_view(stringName)].as_variant_view();
          if( variantviewFound.is_null() == false )
          {
-            if( bRaw == false ) append_g( variantviewFound, uType, get_dialect(), stringSql, gd::types::tag_view{} );
+            if( bRaw == false && is_bind_( pit + 1 ) == true && is_binary_g( uType ) == false && variantviewFound.is_binary() == false ) 
+            { 
+               stringSql += '?';
+               if( uType == 0 ) { pvectorBind->push_back( variantviewFound.as_variant() ); }
+               else             { pvectorBind->push_back( to_bind_value_g( variantviewFound.as_string(), uType ) ); }
+            }
+            else if( bRaw == false ) append_g( variantviewFound, uType, get_dialect(), stringSql, gd::types::tag_view{} );
             else                append_g( variantviewFound, stringSql, gd::sql::tag_raw{} );
-            bValueFound = true;
+            continue;                                                         // value from arguments is added
          }
       }
 
@@ -2257,7 +2284,8 @@ std::pair<bool, std::string> query::sql_format( std::string_view stringTemplate,
       }
 
       // ## append resolved value .................................................
-      if( bRaw == false ) append_g( stringValue, uType, get_dialect(), stringSql );
+      if( bRaw == false && is_bind_( pit + 1 ) == true && is_binary_g( uType ) == false ) { stringSql += '?'; pvectorBind->push_back( to_bind_value_g( stringValue, uType ) ); }
+      else if( bRaw == false ) append_g( stringValue, uType, get_dialect(), stringSql );
       else                stringSql += stringValue;
    }
 
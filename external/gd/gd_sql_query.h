@@ -622,7 +622,9 @@ public:
 
    /// Format replaces {0}, {name} and {name:format} in string template in query or from passed argument.
    [[nodiscard]] std::string sql_format( std::string_view stringTemplate, const gd::argument::arguments* pargumentsValues = nullptr ) const;
-   std::pair<bool, std::string> sql_format( std::string_view stringTemplate, std::string& stringSqlAddTo, const gd::argument::arguments* pargumentsValues = nullptr ) const;
+   std::pair<bool, std::string> sql_format( std::string_view stringTemplate, std::string& stringSqlAddTo, const gd::argument::arguments* pargumentsValues = nullptr ) const { return sql_format( stringTemplate, stringSqlAddTo, pargumentsValues, nullptr ); }
+   /// Format template, if `pvectorBind` is set value placeholders are replaced with `?` and values are added to vector to bind as parameters
+   std::pair<bool, std::string> sql_format( std::string_view stringTemplate, std::string& stringSqlAddTo, const gd::argument::arguments* pargumentsValues, std::vector<gd::variant>* pvectorBind ) const;
 
 
 
@@ -6,6 +6,7 @@
  */
 
 
+#include <charconv>
 #include <stdlib.h>
 
 #include "gd_binary.h"
@@ -886,6 +887,36 @@ bool validate_value_g( std::string_view stringValue, unsigned uType )
    }
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Convert text value to variant that is bound as parameter in prepared statement
+ *
+ * Integer, boolean and decimal types are converted to numbers when the whole text is a
+ * number (needed for `LIMIT ?` and similar), other values are bound as text.
+ *
+ * @param stringValue text value
+ * @param uType type from `gd::types` for column value is bound to, 0 if unknown
+ * @return variant with value to bind
+ */
+gd::variant to_bind_value_g( std::string_view stringValue, unsigned uType )
+{
+   const char* pbszEnd = stringValue.data() + stringValue.length();
+   if( gd::types::is_integer_g( uType ) == true || gd::types::is_boolean_g( uType ) == true )
+   {
+      int64_t iValue = 0;
+      auto [pbszPosition, errorcode_] = std::from_chars( stringValue.data(), pbszEnd, iValue );
+      if( errorcode_ == std::errc() && pbszPosition == pbszEnd ) { return gd::variant( iValue ); }
+   }
+   else if( gd::types::is_decimal_g( uType ) == true )
+   {
+      double dValue = 0.0;
+      auto [pbszPosition, errorcode_] = std::from_chars( stringValue.data(), pbszEnd, dValue );
+      if( errorcode_ == std::errc() && pbszPosition == pbszEnd ) { return gd::variant( dValue ); }
+   }
+
+   if( stringValue.empty() == true ) { return gd::variant( std::string_view( "" ) ); }
+   return gd::variant( stringValue );
+}
+
 
 
 /** --------------------------------------------------------------------------- make_bulk_g
@@ -75,6 +75,11 @@ inline void append_g( const gd::variant& variantValue, std::string& stringSql, t
 
 bool validate_value_g( std::string_view stringValue, unsigned uType );
 
+// @API [tag: bind] [description: convert value to type used to bind it as parameter in prepared statement]
+
+/// Convert text value to variant for binding, numbers are bound as numbers if text is a valid number for type
+gd::variant to_bind_value_g( std::string_view stringValue, unsigned uType );
+
 
 /// Make bulk text suitable for parameterized sql insert or updates
 std::tuple<uint64_t,std::string,std::string> make_bulk_g( const std::string_view& stringFixed, const std::string_view& stringParameter, uint64_t uCount, uint64_t uBulkCount );
@@ -82,19 +82,20 @@ void names::reserve(unsigned uSize)
 
 references::references( const references& o )
 {
-   for( auto it = std::begin( o.m_vectorReference ), itEnd = std::end(o. m_vectorReference ); it != itEnd; it++ )
-   {
-      const reference* preferenceFrom = (const reference*)it->get();
-      reference* preference = allocate( *preferenceFrom );
-      copy_data_s( preference, preferenceFrom->data(), preferenceFrom->size() );
-   }
+   *this = o;
 }
 
 references& references::operator=( const references& o )
 {
-   for( auto it = std::begin( o.m_vectorReference ), itEnd = std::end(o. m_vectorReference ); it != itEnd; it++ )
+   if( this == &o ) return *this;
+   clear();
+
+   uint64_t uDataSize = 0;
+   for( const auto* it : o.m_vectorReference ) { uDataSize += sizeof( reference ) + it->capacity() + alignof( reference ); }
+   reserve( o.size(), uDataSize );
+
+   for( const auto* preferenceFrom : o.m_vectorReference )
    {
-      const reference* preferenceFrom = (const reference*)it->get();
       reference* preference = allocate( *preferenceFrom );
       copy_data_s( preference, preferenceFrom->data(), preferenceFrom->size() );
    }
@@ -112,7 +113,9 @@ uint64_t references::add( const gd::variant_view& v_ )
    reference reference_( v_.type(), v_.length(), uSize );                                          assert( v_.length() <= uSize );
 
    reference* preference = allocate( reference_ );
-   copy_data_s( preference, v_.get_value_buffer(), uSize );
+   unsigned uValueSize = value_size_s( v_.type(), uSize );
+   if( uSize > uValueSize ) memset( preference->data() + uValueSize, 0, uSize - uValueSize ); // zero terminate text, view may be part of larger text
+   if( uValueSize > 0 ) copy_data_s( preference, v_.get_value_buffer(), uValueSize );
 #if DEBUG_RELEASE > 0
    //copy_data_s( preference, v_.get_value_buffer(), uSize );                                        
                                                                                                    DEBUG_RELEASE_EXECUTE( preference->assert_valid_d() );
@@ -131,27 +134,185 @@ std::byte* references::add( uint64_t uSize, tag_buffer )
 
 
 void references::set( uint64_t uIndex, const uint8_t* puData, unsigned uSize )
-{                                                                                                  assert( uIndex < m_vectorReference.capacity() );
-   auto& preference = m_vectorReference[uIndex]; 
-   copy_data_s( (reference*)preference.get(), puData, uSize );
+{                                                                                                  assert( uIndex < m_vectorReference.size() );
+   copy_data_s( m_vectorReference[uIndex], puData, uSize );
+   if( uIndex < m_uIndexCount ) index_clear();                                 // value in hash table is changed
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Find index for value
+ *
+ * Few values are compared one by one, for more values the hash table is used. Values
+ * added since last find are added to hash table before it is searched.
+ *
+ * @param variantviewFindValue value to find
+ * @return index to first value that is equal, -1 if not found
+ */
 int64_t references::find( const gd::variant_view& variantviewFindValue ) const noexcept
 {
-   for( auto it = std::begin( m_vectorReference ), itEnd = std::end( m_vectorReference ); it != itEnd; it++ )
+   const uint8_t* puFind = (const uint8_t*)variantviewFindValue.get_value_buffer();
+   unsigned uLength = variantviewFindValue.length();
+   unsigned uSize = gd::types::value_size_g( variantviewFindValue.type(), uLength );
+   unsigned uValueSize = value_size_s( variantviewFindValue.type(), uSize );   // terminator is not compared
+
+   if( m_vectorReference.size() <= m_uLinearFind_s )
    {
-      const reference* preference = (const reference*)it->get();
-      if( preference->length() == variantviewFindValue.length() )
+      for( std::size_t u = 0; u < m_vectorReference.size(); u++ )
       {
-         if( memcmp( preference->data(), variantviewFindValue.get_value_buffer(), preference->size() ) == 0 ) // compare data
-         {
-            return std::distance( std::begin( m_vectorReference ), it );       // return index to data in list
-         }
+         const reference* preference = m_vectorReference[u];
+         if( preference->length() == uLength && preference->size() == uSize && memcmp( preference->data(), puFind, uValueSize ) == 0 ) return (int64_t)u;
       }
+      return -1;                                                               // no match, return -1 meaning that index is not found
+   }
+
+   index_update();
+
+   uint64_t uHash = hash_s( puFind, uValueSize );
+   uint64_t uMask = m_vectorIndex.size() - 1;
+   uint64_t uHashHigh = uHash & 0xffff'ffff'0000'0000ull;
+   for( uint64_t uSlot = uHash & uMask; m_vectorIndex[uSlot] != 0; uSlot = ( uSlot + 1 ) & uMask )
+   {
+      uint64_t uValue = m_vectorIndex[uSlot];
+      if( ( uValue & 0xffff'ffff'0000'0000ull ) != uHashHigh ) continue;
+
+      std::size_t uIndex = (std::size_t)( uValue & 0xffff'ffff ) - 1;
+      const reference* preference = m_vectorReference[uIndex];
+      if( preference->length() == uLength && preference->size() == uSize && memcmp( preference->data(), puFind, uValueSize ) == 0 ) return (int64_t)uIndex;
    }
+
    return -1;                                                                  // no match, return -1 meaning that index is not found
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Add references that is not in hash table, hash table grows to keep it less than half full
+ */
+void references::index_update() const
+{
+   std::size_t uCount = m_vectorReference.size();                                                  assert( uCount < 0xffff'ffff );
+   if( m_uIndexCount == uCount ) return;
+
+   if( uCount * 2 > m_vectorIndex.size() )
+   {
+      std::size_t uSlotCount = m_vectorIndex.empty() == true ? 64 : m_vectorIndex.size();
+      while( uSlotCount < uCount * 2 ) uSlotCount *= 2;
+      m_vectorIndex.assign( uSlotCount, 0 );
+      m_uIndexCount = 0;                                                       // all references are added to new table
+   }
+
+   uint64_t uMask = m_vectorIndex.size() - 1;
+   for( std::size_t uIndex = m_uIndexCount; uIndex < uCount; uIndex++ )
+   {
+      const reference* preference = m_vectorReference[uIndex];
+      uint64_t uHash = hash_s( preference->data(), value_size_s( preference->ctype(), preference->size() ) );
+      uint64_t uSlot = uHash & uMask;
+      while( m_vectorIndex[uSlot] != 0 ) uSlot = ( uSlot + 1 ) & uMask;     // slots are taken in order, first added value is found first
+      m_vectorIndex[uSlot] = ( uHash & 0xffff'ffff'0000'0000ull ) | (uint64_t)( uIndex + 1 );
+   }
+
+   m_uIndexCount = uCount;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Reserve room for references
+ * @param uCount number of references
+ * @param uDataSize total size for values, current page is replaced if it do not have room
+ */
+void references::reserve( std::size_t uCount, uint64_t uDataSize )
+{
+   m_vectorReference.reserve( m_vectorReference.size() + uCount );
+
+   uint64_t uAvailable = (uint64_t)( m_puPageEnd - m_puPageNext );
+   if( uDataSize > uAvailable )
+   {
+      uint64_t uPageSize = uDataSize > m_uPageSize_s ? uDataSize : m_uPageSize_s;
+      m_vectorPage.push_back( std::make_unique<uint8_t[]>( uPageSize ) );
+      m_puPageNext = m_vectorPage.back().get();
+      m_puPageEnd = m_puPageNext + uPageSize;
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Remove values that are not used
+ *
+ * Used values are copied to new pages, cells in table that store index to
+ * values need to be updated with new index.
+ *
+ * @param vectorUsed flag for each value, true if value is used
+ * @return new index for each old index, `uint64_t(-1)` for removed values
+ */
+std::vector<uint64_t> references::compact( const std::vector<bool>& vectorUsed )
+{                                                                                                  assert( vectorUsed.size() == m_vectorReference.size() );
+   std::vector<uint64_t> vectorMap( m_vectorReference.size(), uint64_t(-1) );
+
+   std::size_t uCount = 0;
+   uint64_t uDataSize = 0;
+   for( std::size_t u = 0; u < m_vectorReference.size(); u++ )
+   {
+      if( vectorUsed[u] == false ) continue;
+      uCount++;
+      uDataSize += sizeof( reference ) + m_vectorReference[u]->capacity() + alignof( reference );
+   }
+
+   references referencesUsed;
+   referencesUsed.reserve( uCount, uDataSize );
+   for( std::size_t u = 0; u < m_vectorReference.size(); u++ )
+   {
+      if( vectorUsed[u] == false ) continue;
+      const reference* preferenceFrom = m_vectorReference[u];
+      reference* preference = referencesUsed.allocate( *preferenceFrom );
+      copy_data_s( preference, preferenceFrom->data(), preferenceFrom->size() );
+      vectorMap[u] = referencesUsed.size() - 1;
+   }
+
+#if DEBUG_RELEASE > 0
+   for( auto* it : m_vectorReference ) { it->delete_d(); }
+#endif
+   *this = std::move( referencesUsed );
+   return vectorMap;
+}
+
+void references::clear() noexcept
+{
+#if DEBUG_RELEASE > 0
+   for( auto* it : m_vectorReference ) { it->delete_d(); }
+#endif
+   m_vectorReference.clear();
+   m_vectorPage.clear();
+   m_puPageNext = nullptr;
+   m_puPageEnd = nullptr;
+   index_clear();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Memory for reference object in page
+ *
+ * Large values get their own page, current page is kept for smaller values.
+ *
+ * @param uSize size needed (reference object and data)
+ * @return pointer to memory, aligned for reference object
+ */
+uint8_t* references::allocate_memory( uint64_t uSize )
+{
+   uSize = ( uSize + alignof( reference ) - 1 ) & ~uint64_t( alignof( reference ) - 1 );
+
+   if( uSize > (uint64_t)( m_puPageEnd - m_puPageNext ) )
+   {
+      if( uSize > m_uPageSize_s / 4 )
+      {
+         m_vectorPage.push_back( std::make_unique<uint8_t[]>( uSize ) );     // big value, own page and current page is kept
+         return m_vectorPage.back().get();
+      }
+
+      m_vectorPage.push_back( std::make_unique<uint8_t[]>( m_uPageSize_s ) );
+      m_puPageNext = m_vectorPage.back().get();
+      m_puPageEnd = m_puPageNext + m_uPageSize_s;
+   }
+
+   uint8_t* puMemory = m_puPageNext;
+   m_puPageNext += uSize;
+   return puMemory;
+}
+
 /** ---------------------------------------------------------------------------
  * @brief allocate reference object and the amount of data that reference describes
  * Reference is used to store blob data in tables. It works like a pointer
@@ -163,35 +324,23 @@ int64_t references::find( const gd::variant_view& variantviewFindValue ) const n
 */
 reference* references::allocate( const reference& referenceToCopy )
 {                                                                                                  assert( referenceToCopy.reference_count() == 1 );
+   uint64_t uTotalSize = sizeof(reference) + referenceToCopy.capacity();       // Total size = reference object size and data
 #if DEBUG_RELEASE > 0
-   auto uSize_d = sizeof(reference) + referenceToCopy.capacity();
-#endif // DEBUG_RELEASE
-   // To avoid errors using sanitizers a custom deleter is used that deletes the memory block allocated
-   // with similar technique as it was allocated.
-   unsigned uTotalSize = sizeof(reference) + referenceToCopy.capacity(); // Total size = reference object size and data
-
-
-   //std::unique_ptr<reference, decltype(&reference::delete_reference_s) > preference = std::unique_ptr<reference, decltype(&reference::delete_reference_s) >( (reference*) new uint8_t[ uTotalSize ], reference::delete_reference_s );
-   
-#if DEBUG_RELEASE > 0
-   // increase allocated size with 2 bytes to add debug markers, this may be deleted when everything is tested and works
-   std::unique_ptr<uint8_t[]> pReference = std::make_unique<uint8_t[]>( uTotalSize + 2 ); 
+   // increase allocated size to add debug markers after data, this may be deleted when everything is tested and works
+   reference* preferenceRaw = (reference*)allocate_memory( uTotalSize + 3 );
 #else
-   std::unique_ptr<uint8_t[]> pReference = std::make_unique<uint8_t[]>( uTotalSize );
+   reference* preferenceRaw = (reference*)allocate_memory( uTotalSize );
 #endif // DEBUG_RELEASE
-   
-   reference* preferenceRaw = (reference*)pReference.get();
-   
+
    memcpy(static_cast<void*>(preferenceRaw), &referenceToCopy, sizeof(reference) );
 #if DEBUG_RELEASE > 0
    *preferenceRaw->data_end( 1 ) = uTailetextMarker_d;
    *preferenceRaw->data_end( 2 ) = uTailetextMarker_d;
-   preferenceRaw->m_uAllocated_d = uTotalSize;
+   preferenceRaw->m_uAllocated_d = (unsigned)uTotalSize;
    preferenceRaw->m_puClone_d = nullptr;                                       // this need to be copied as soon as reference value is set
 #endif // DEBUG_RELEASE
 
-
-   m_vectorReference.push_back( std::move( pReference ) );
+   m_vectorReference.push_back( preferenceRaw );
 
    return preferenceRaw;
 }
@@ -44,6 +44,7 @@ inline constexpr uint8_t uTailetextMarker_d = 0x01;
 #include <cstring>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -133,6 +134,8 @@ struct tag_length {};
 struct tag_range {};
 /// tag dispatcher for measurement handling
 struct tag_measurement {};
+/// tag dispatcher for operations that split work between threads
+struct tag_parallel {};
 /// tag dispatcher columns are static and shared between tables, should not be modified
 struct tag_static_columns {};
 
@@ -155,6 +158,8 @@ struct tag_first_sorted {};
 struct tag_sort_selection {};
 /// tag dispatcher for bubble sort
 struct tag_sort_bubble {};
+/// tag dispatcher for index sort, typed comparators builds row permutation (rows are not moved)
+struct tag_sort_index {};
 /// tag dispatcher for some type of find logic
 struct tag_find {}; 
 
@@ -667,10 +672,37 @@ struct page
 
 inline uint64_t page::get_page_count() const noexcept {                                            assert( m_uPageSize != 0 ); 
    if( m_uRowCount < m_uPageSize ) return 1;
-   return (uint64_t)ceil( get_row_count() / m_uPageSize ); 
+   return (uint64_t)ceil( get_row_count() / m_uPageSize );
 }
 
 
+/** ===========================================================================
+ * \brief Sort key, describes one column and how to order values in that column
+ *
+ * Used by sort methods that take a list of keys. Rows are compared on first key,
+ * if equal on second and so on. Null values are placed first or last based on
+ * `m_bNullFirst`.
+ *
+ * Example usage:
+ * \code
+ * table.sort( { gd::table::sort_key( 2, false ), gd::table::sort_key( 0 ) } ); // column 2 descending, then column 0 ascending
+ * \endcode
+ */
+struct sort_key
+{
+// ## construction ------------------------------------------------------------
+   sort_key() {}
+   sort_key( unsigned uColumn ): m_uColumn{ uColumn } {}
+   sort_key( unsigned uColumn, bool bAscending ): m_uColumn{ uColumn }, m_bAscending{ bAscending } {}
+   sort_key( unsigned uColumn, bool bAscending, bool bNullFirst ): m_uColumn{ uColumn }, m_bAscending{ bAscending }, m_bNullFirst{ bNullFirst } {}
+
+// ## attributes --------------------------------------------------------------
+   unsigned m_uColumn  = 0;         ///< index to column with values to sort on
+   bool m_bAscending   = true;      ///< sort order, true = ascending, false = descending
+   bool m_bNullFirst   = true;      ///< place null values first if true, last if false
+};
+
+
 
 /**
  * @brief Used for columns without name
@@ -883,7 +915,13 @@ struct reference
  *
  * Blob items managed by references should not be deleted until where the data is
  * used is deleted. It is not coded to be able to remove and insert values into
- * references object.
+ * references object, use `compact` to remove values that are not used.
+ *
+ * Reference objects and their data are placed after each other in memory pages,
+ * values larger than a quarter of page size get their own page. Values are found
+ * with a open addressing hash table (hash and index), hash table is updated with
+ * added values when `find` is called so adding values without looking for them
+ * (table flag for duplicated strings or reading serialized data) has no extra cost.
  * 
  * @code
 // add three values into and find one of those
@@ -940,10 +978,10 @@ struct references
       using reference_type = reference*&;
 
       iterator() : m_pCurrent(nullptr) {}
-      explicit iterator(std::unique_ptr<uint8_t[]>* pCurrent) : m_pCurrent(pCurrent) {}
+      explicit iterator(reference** pCurrent) : m_pCurrent(pCurrent) {}
 
-      reference* operator*() const { return (reference*)m_pCurrent->get(); }
-      reference* operator->() const { return (reference*)m_pCurrent->get(); }
+      reference* operator*() const { return *m_pCurrent; }
+      reference* operator->() const { return *m_pCurrent; }
 
       iterator& operator++() { ++m_pCurrent; return *this; }
       iterator operator++(int) { iterator tmp = *this; ++m_pCurrent; return tmp; }
@@ -956,7 +994,7 @@ struct references
       iterator operator-(difference_type n) const { return iterator(m_pCurrent - n); }
       difference_type operator-(const iterator& o) const { return m_pCurrent - o.m_pCurrent; }
 
-      reference* operator[](difference_type n) const { return (reference*)(m_pCurrent[n].get()); }
+      reference* operator[](difference_type n) const { return m_pCurrent[n]; }
 
       bool operator==(const iterator& o) const { return m_pCurrent == o.m_pCurrent; }
       bool operator!=(const iterator& o) const { return m_pCurrent != o.m_pCurrent; }
@@ -965,7 +1003,7 @@ struct references
       bool operator>(const iterator& o) const { return m_pCurrent > o.m_pCurrent; }
       bool operator>=(const iterator& o) const { return m_pCurrent >= o.m_pCurrent; }
 
-      std::unique_ptr<uint8_t[]>* m_pCurrent;
+      reference** m_pCurrent;
    };
 
    /// const iterator class for references container
@@ -978,11 +1016,11 @@ struct references
       using reference_type = const reference*&;
 
       const_iterator() : m_pCurrent(nullptr) {}
-      explicit const_iterator(const std::unique_ptr<uint8_t[]>* pCurrent) : m_pCurrent(pCurrent) {}
-      const_iterator(const iterator& it) : m_pCurrent(&(*it.m_pCurrent)) {}
+      explicit const_iterator(reference* const* pCurrent) : m_pCurrent(pCurrent) {}
+      const_iterator(const iterator& it) : m_pCurrent(it.m_pCurrent) {}
 
-      const reference* operator*() const { return (const reference*)m_pCurrent->get(); }
-      const reference* operator->() const { return (const reference*)m_pCurrent->get(); }
+      const reference* operator*() const { return *m_pCurrent; }
+      const reference* operator->() const { return *m_pCurrent; }
 
       const_iterator& operator++() { ++m_pCurrent; return *this; }
       const_iterator operator++(int) { const_iterator tmp = *this; ++m_pCurrent; return tmp; }
@@ -995,7 +1033,7 @@ struct references
       const_iterator operator-(difference_type n) const { return const_iterator(m_pCurrent - n); }
       difference_type operator-(const const_iterator& o) const { return m_pCurrent - o.m_pCurrent; }
 
-      const reference* operator[](difference_type n) const { return (const reference*)(m_pCurrent[n].get()); }
+      const reference* operator[](difference_type n) const { return m_pCurrent[n]; }
 
       bool operator==(const const_iterator& o) const { return m_pCurrent == o.m_pCurrent; }
       bool operator!=(const const_iterator& o) const { return m_pCurrent != o.m_pCurrent; }
@@ -1004,7 +1042,7 @@ struct references
       bool operator>(const const_iterator& o) const { return m_pCurrent > o.m_pCurrent; }
       bool operator>=(const const_iterator& o) const { return m_pCurrent >= o.m_pCurrent; }
 
-      const std::unique_ptr<uint8_t[]>* m_pCurrent;
+      reference* const* m_pCurrent;
    };
 
    using reverse_iterator = std::reverse_iterator<iterator>;
@@ -1014,20 +1052,26 @@ struct references
 
    references() {}
    references( const references& o );
-   references( references&& o ) noexcept {
-      m_vectorReference = std::move( o.m_vectorReference );
-   }
+   references( references&& o ) noexcept { common_construct( std::move( o ) ); }
    references& operator=( const references& o );
-   references& operator=( references&& o ) noexcept {
-      m_vectorReference = std::move( o.m_vectorReference );
-      return *this;
-   }
+   references& operator=( references&& o ) noexcept { if( this != &o ) { common_construct( std::move( o ) ); } return *this; }
    ~references() {
 #if DEBUG_RELEASE > 0
-      for( auto& it : m_vectorReference ) { ((reference*)it.get())->delete_d(); }
+      for( auto* it : m_vectorReference ) { it->delete_d(); }
 #endif
    }
 
+private:
+   void common_construct( references&& o ) noexcept {
+      m_vectorPage = std::move( o.m_vectorPage );
+      m_vectorReference = std::move( o.m_vectorReference );
+      m_puPageNext = std::exchange( o.m_puPageNext, nullptr );
+      m_puPageEnd = std::exchange( o.m_puPageEnd, nullptr );
+      m_vectorIndex = std::move( o.m_vectorIndex );
+      m_uIndexCount = std::exchange( o.m_uIndexCount, 0 );
+   }
+
+public:
    /// adds value to references internal list of values
    uint64_t add( const gd::variant_view& v_ );
    std::byte* add( uint64_t uSize, tag_buffer );
@@ -1035,7 +1079,7 @@ struct references
    void set( uint64_t uIndex, const uint8_t* puData, unsigned uSize );
 
    /// Return pointer to reference item in internal list
-   reference* at( std::size_t uIndex ) const noexcept { return (reference*)m_vectorReference[uIndex].get(); }
+   reference* at( std::size_t uIndex ) const noexcept { return m_vectorReference[uIndex]; }
    /// Find index for value if it exist in internal list
    int64_t find( const gd::variant_view& variantviewFindValue ) const noexcept;
    /// Add to reference counter for specific value at index
@@ -1045,12 +1089,27 @@ struct references
    /// Returns whether the references is empty (i.e. no references added).
    bool empty() const noexcept { return m_vectorReference.empty(); }
 
+   /// Reserve room for number of values and the total size of value data
+   void reserve( std::size_t uCount, uint64_t uDataSize );
+   /// Remove values that are not used, returns vector with new index for each old index (-1 for removed values)
+   std::vector<uint64_t> compact( const std::vector<bool>& vectorUsed );
+
    /// Allocate memory for reference object and return pointer to reference item
    reference* allocate( const reference& r_ );
    reference* allocate( const uint8_t* puData ) { return allocate( *(reference*)puData ); }
 
    /// Clear all references and free memory
-   void clear() noexcept { m_vectorReference.clear(); }
+   void clear() noexcept;
+
+/** \name INTERNAL
+*///@{
+   /// memory for reference in page, new page is added if there is no room
+   uint8_t* allocate_memory( uint64_t uSize );
+   /// add references that is not in hash table to hash table
+   void index_update() const;
+   /// clear hash table, it is rebuilt when find is called
+   void index_clear() const noexcept { m_vectorIndex.clear(); m_uIndexCount = 0; }
+//@}
 
    // ## iterator methods ---------------------------------------------------------
 
@@ -1070,9 +1129,21 @@ struct references
 #endif // GD_COMPILER_HAS_CPP20_SUPPORT
 
    // ## attributes
-   std::vector< std::unique_ptr<uint8_t[]> > m_vectorReference;
+   std::vector< std::unique_ptr<uint8_t[]> > m_vectorPage; ///< memory pages with reference objects and data
+   std::vector< reference* > m_vectorReference;            ///< references in order added, index is stored in table cells
+   uint8_t* m_puPageNext = nullptr;                         ///< next free position in current page
+   uint8_t* m_puPageEnd = nullptr;                          ///< end of current page
+   mutable std::vector<uint64_t> m_vectorIndex;             ///< hash table, each slot is high 32 bits from hash and index + 1, 0 = empty slot
+   mutable std::size_t m_uIndexCount = 0;                   ///< number of references added to hash table
 
    static void copy_data_s( reference* preference, const uint8_t* puData, unsigned uSize );
+   /// value size without terminator for text types, terminator is not part of value when values are compared
+   static unsigned value_size_s( unsigned uType, unsigned uSize ) noexcept { return uSize - gd::types::value_size_g( uType, 0u ); }
+   /// hash for value data
+   static uint64_t hash_s( const uint8_t* puData, unsigned uSize ) noexcept { return std::hash<std::string_view>{}( std::string_view( (const char*)puData, uSize ) ); }
+
+   static constexpr uint64_t m_uPageSize_s = 64 * 1024;     ///< default page size
+   static constexpr std::size_t m_uLinearFind_s = 8;        ///< number of references searched without hash table
 };
 
 // ## helper object used to pass table information as arguments
@@ -22,13 +22,18 @@
 
 
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <exception>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <memory>
 #include <unordered_set>
 #include <algorithm>
+#include <thread>
+#include <type_traits>
 
 #include "gd/gd_table.h"
 
@@ -39,6 +44,189 @@
 
 _GD_TABLE_BEGIN
 
+namespace detail {
+
+// ## states used by typed aggregate kernels, each state collects values with `add`
+
+/// sum values, TYPE is the type used to store sum
+template<typename TYPE>
+struct aggregate_sum
+{
+   template<typename VALUE>
+   void add( VALUE v_ ) noexcept { m_sum += static_cast<TYPE>( v_ ); }
+   void merge( const aggregate_sum& o_ ) noexcept { m_sum += o_.m_sum; }
+   TYPE m_sum{};
+};
+
+/// find minimum value
+template<typename TYPE>
+struct aggregate_min
+{
+   template<typename VALUE>
+   void add( VALUE v_ ) noexcept { TYPE value_ = static_cast<TYPE>( v_ ); if( m_bValue == false || value_ < m_min ) { m_min = value_; m_bValue = true; } }
+   void merge( const aggregate_min& o_ ) noexcept { if( o_.m_bValue == true ) add( o_.m_min ); }
+   TYPE m_min{};
+   bool m_bValue = false;
+};
+
+/// find maximum value
+template<typename TYPE>
+struct aggregate_max
+{
+   template<typename VALUE>
+   void add( VALUE v_ ) noexcept { TYPE value_ = static_cast<TYPE>( v_ ); if( m_bValue == false || m_max < value_ ) { m_max = value_; m_bValue = true; } }
+   void merge( const aggregate_max& o_ ) noexcept { if( o_.m_bValue == true ) add( o_.m_max ); }
+   TYPE m_max{};
+   bool m_bValue = false;
+};
+
+/// count, mean and sum of squared differences from mean (Welford), used for average and variance
+struct aggregate_variance
+{
+   template<typename VALUE>
+   void add( VALUE v_ ) noexcept {
+      double dValue = static_cast<double>( v_ );
+      m_uCount++;
+      double dDelta = dValue - m_dMean;
+      m_dMean += dDelta / static_cast<double>( m_uCount );
+      m_dM2 += dDelta * ( dValue - m_dMean );
+   }
+   /// combine with state collected from other rows (Chan et al. pairwise update)
+   void merge( const aggregate_variance& o_ ) noexcept {
+      if( o_.m_uCount == 0 ) return;
+      if( m_uCount == 0 ) { *this = o_; return; }
+      uint64_t uCount = m_uCount + o_.m_uCount;
+      double dDelta = o_.m_dMean - m_dMean;
+      m_dMean += dDelta * static_cast<double>( o_.m_uCount ) / static_cast<double>( uCount );
+      m_dM2 += o_.m_dM2 + dDelta * dDelta * static_cast<double>( m_uCount ) * static_cast<double>( o_.m_uCount ) / static_cast<double>( uCount );
+      m_uCount = uCount;
+   }
+   /// sample variance, 0 if less than two values
+   double variance() const noexcept { return m_uCount > 1 ? m_dM2 / static_cast<double>( m_uCount - 1 ) : 0.0; }
+   uint64_t m_uCount = 0;
+   double m_dMean = 0.0;
+   double m_dM2 = 0.0;
+};
+
+/// values for median and percentile, each chunk is sorted with `sort` and sorted chunks are merged.
+/// Result is exact and same as serial result, memory is one value for each row (no approximate sketch)
+template<typename TYPE>
+struct aggregate_quantile
+{
+   template<typename VALUE>
+   void add( VALUE v_ ) { m_vectorValue.push_back( static_cast<TYPE>( v_ ) ); }
+   void sort() { std::sort( m_vectorValue.begin(), m_vectorValue.end() ); }
+   /// merge sorted values from other state, both states need to be sorted
+   void merge( const aggregate_quantile& o_ ) {
+      auto uMiddle = m_vectorValue.size();
+      m_vectorValue.insert( m_vectorValue.end(), o_.m_vectorValue.begin(), o_.m_vectorValue.end() );
+      std::inplace_merge( m_vectorValue.begin(), m_vectorValue.begin() + uMiddle, m_vectorValue.end() );
+   }
+   std::vector<TYPE> m_vectorValue;
+};
+
+/// unique values as text, merge moves nodes from other set without copying strings
+struct aggregate_unique
+{
+   void add( const gd::variant_view& v_ ) { m_setValue.insert( v_.as_string() ); }
+   void merge( aggregate_unique& o_ ) { m_setValue.merge( o_.m_setValue ); }
+   std::unordered_set<std::string> m_setValue;
+};
+
+} // namespace detail
+
+/** ---------------------------------------------------------------------------
+ * @brief Summary for column, count, sum, min, max, mean and variance collected in one pass
+ *
+ * Filled by `aggregate::summary`, one summary for each column. Summaries collected
+ * for different row ranges are combined with `merge`.
+ */
+struct aggregate_summary
+{
+   template<typename VALUE>
+   void add( VALUE v_ ) noexcept {
+      if constexpr( std::is_integral_v<VALUE> ) { m_uSum += static_cast<uint64_t>( v_ ); } // integer sum wraps like uint64_t and keeps full precision
+      else { m_bDecimal = true; }
+      double dValue = static_cast<double>( v_ );
+      m_dSum += dValue;
+      if( m_variance.m_uCount == 0 || dValue < m_dMin ) m_dMin = dValue;
+      if( m_variance.m_uCount == 0 || dValue > m_dMax ) m_dMax = dValue;
+      m_variance.add( dValue );
+   }
+   void merge( const aggregate_summary& o_ ) noexcept {
+      if( o_.m_variance.m_uCount == 0 ) return;
+      if( m_variance.m_uCount == 0 || o_.m_dMin < m_dMin ) m_dMin = o_.m_dMin;
+      if( m_variance.m_uCount == 0 || o_.m_dMax > m_dMax ) m_dMax = o_.m_dMax;
+      m_uSum += o_.m_uSum;
+      m_dSum += o_.m_dSum;
+      m_bDecimal = m_bDecimal || o_.m_bDecimal;
+      m_variance.merge( o_.m_variance );
+   }
+   /// sum as TYPE, integer sum is used for integer columns to avoid precision loss
+   template<typename TYPE>
+   TYPE sum() const noexcept {
+      if constexpr( std::is_integral_v<TYPE> ) { return m_bDecimal == true ? static_cast<TYPE>( m_dSum ) : static_cast<TYPE>( m_uSum ); }
+      else { return static_cast<TYPE>( m_dSum ); }
+   }
+   uint64_t count() const noexcept { return m_variance.m_uCount; }
+   double min() const noexcept { return m_dMin; }
+   double max() const noexcept { return m_dMax; }
+   double average() const noexcept { return m_variance.m_dMean; }
+   double variance() const noexcept { return m_variance.variance(); }
+   double std_deviation() const noexcept { return std::sqrt( m_variance.variance() ); }
+
+   uint64_t m_uSum = 0;
+   double m_dSum = 0.0;
+   double m_dMin = 0.0;
+   double m_dMax = 0.0;
+   bool m_bDecimal = false;   ///< set if decimal values are added
+   detail::aggregate_variance m_variance;
+};
+
+namespace detail {
+
+/// merge state collected by other thread into state
+template<typename STATE>
+void merge_g( STATE& state_, STATE& stateFrom ) { state_.merge( stateFrom ); }
+inline void merge_g( std::vector<aggregate_summary>& vectorState, std::vector<aggregate_summary>& vectorFrom ) { assert( vectorState.size() == vectorFrom.size() );
+   for( size_t u = 0; u < vectorState.size(); u++ ) { vectorState[u].merge( vectorFrom[u] ); }
+}
+
+/// median from sorted values, average of two middle values if even number of values
+template<typename TYPE>
+TYPE median_sorted_g( const std::vector<TYPE>& vectorValue ) {
+   if( vectorValue.empty() ) return TYPE{};
+   size_t uSize = vectorValue.size();
+   if( uSize % 2 == 0 ) {
+      if constexpr( std::is_integral_v<TYPE> ) { return ( vectorValue[uSize/2 - 1] + vectorValue[uSize/2] ) / 2; }
+      else { return ( vectorValue[uSize/2 - 1] + vectorValue[uSize/2] ) / static_cast<TYPE>( 2.0 ); }
+   }
+   return vectorValue[uSize / 2];
+}
+
+/// percentile from sorted values, linear interpolation between closest ranks
+template<typename TYPE>
+TYPE percentile_sorted_g( const std::vector<TYPE>& vectorValue, double dPercentile ) {
+   if( vectorValue.empty() ) return TYPE{};
+   if( dPercentile == 0.0 ) return vectorValue.front();
+   if( dPercentile == 100.0 ) return vectorValue.back();
+
+   double dIndex = ( dPercentile / 100.0 ) * ( vectorValue.size() - 1 );
+   size_t uLowerIndex = static_cast<size_t>( std::floor( dIndex ) );
+   size_t uUpperIndex = static_cast<size_t>( std::ceil( dIndex ) );
+   if( uLowerIndex == uUpperIndex ) return vectorValue[uLowerIndex];
+
+   double dFraction = dIndex - std::floor( dIndex );
+   if constexpr( std::is_integral_v<TYPE> ) {
+      return static_cast<TYPE>( vectorValue[uLowerIndex] + dFraction * ( vectorValue[uUpperIndex] - vectorValue[uLowerIndex] ) );
+   }
+   else {
+      return vectorValue[uLowerIndex] + static_cast<TYPE>( dFraction ) * ( vectorValue[uUpperIndex] - vectorValue[uLowerIndex] );
+   }
+}
+
+} // namespace detail
+
  /**
   * \brief aggregate is used to aggregate data from table classes
   *
@@ -93,6 +281,17 @@ public:
    template<typename TYPE>
    TYPE min( const std::string_view& stringName, uint64_t uBeginRow, uint64_t uCount ) const { return min<TYPE>( m_ptable->column_get_index( stringName ), uBeginRow, uCount ); }
 
+   // ## max operation - find maximum values
+
+   template<typename TYPE>
+   TYPE max( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount ) const;
+   template<typename TYPE>
+   TYPE max( unsigned uColumn ) const { return max<TYPE>( uColumn, 0, m_ptable->get_row_count() ); }
+   template<typename TYPE>
+   TYPE max( const std::string_view& stringName ) const { return max<TYPE>( m_ptable->column_get_index( stringName ), 0, m_ptable->get_row_count() ); }
+   template<typename TYPE>
+   TYPE max( const std::string_view& stringName, uint64_t uBeginRow, uint64_t uCount ) const { return max<TYPE>( m_ptable->column_get_index( stringName ), uBeginRow, uCount ); }
+
 
    // ## max operation calculating size in bytes each value needs related to read it as text
 
@@ -183,6 +382,26 @@ public:
    template<typename TYPE>
    TYPE percentile( const std::string_view& stringName, double dPercentile, uint64_t uBeginRow, uint64_t uCount ) const { return percentile<TYPE>( m_ptable->column_get_index( stringName ), dPercentile, uBeginRow, uCount ); }
 
+   // ## parallel operations, rows are split in chunks for threads and partial results are merged
+   //    uThreadCount = 0 uses hardware concurrency, small ranges are processed in calling thread
+   template<typename TYPE>
+   TYPE sum( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount = 0 ) const;
+   template<typename TYPE>
+   double variance( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount = 0 ) const;
+   template<typename TYPE>
+   double std_deviation( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount = 0 ) const { return std::sqrt( variance<TYPE>( uColumn, uBeginRow, uCount, tag_parallel{}, uThreadCount ) ); }
+   template<typename TYPE>
+   TYPE median( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount = 0 ) const;
+   template<typename TYPE>
+   TYPE percentile( unsigned uColumn, double dPercentile, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount = 0 ) const;
+   uint64_t count_unique( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount = 0 ) const;
+
+   // ## summary operations, aggregates for all columns in vectorColumn are collected in one scan
+   void summary( const std::vector<unsigned>& vectorColumn, uint64_t uBeginRow, uint64_t uCount, std::vector<aggregate_summary>& vectorSummary ) const;
+   void summary( const std::vector<unsigned>& vectorColumn, std::vector<aggregate_summary>& vectorSummary ) const { summary( vectorColumn, 0, m_ptable->get_row_count(), vectorSummary ); }
+   void summary( const std::vector<unsigned>& vectorColumn, uint64_t uBeginRow, uint64_t uCount, std::vector<aggregate_summary>& vectorSummary, tag_parallel, unsigned uThreadCount = 0 ) const;
+   void summary( const std::vector<unsigned>& vectorColumn, std::vector<aggregate_summary>& vectorSummary, tag_parallel, unsigned uThreadCount = 0 ) const { summary( vectorColumn, 0, m_ptable->get_row_count(), vectorSummary, tag_parallel{}, uThreadCount ); }
+
    // ## string-specific operations
    unsigned count_contains( unsigned uColumn, const std::string_view& stringPattern, uint64_t uBeginRow, uint64_t uCount ) const;
    unsigned count_contains( unsigned uColumn, const std::string_view& stringPattern ) const { return count_contains( uColumn, stringPattern, 0, m_ptable->get_row_count() ); }
@@ -205,6 +424,17 @@ public:
 protected:
    /** \name INTERNAL
    *///@{
+   // ## typed kernels for fixed size columns, reads values at row stride without variant conversion
+   template<typename STATE>
+   bool fixed_( unsigned uColumn, uint64_t uBeginRow, uint64_t uEndRow, STATE& state_ ) const;
+   template<typename VALUE, typename STATE>
+   void kernel_( unsigned uColumn, uint64_t uBeginRow, uint64_t uEndRow, STATE& state_ ) const;
+   uint64_t null_mask_( unsigned uColumn, uint64_t uRow, uint64_t uCount ) const;
+   template<typename TYPE, typename STATE>
+   void collect_( unsigned uColumn, uint64_t uBeginRow, uint64_t uEndRow, STATE& state_ ) const;
+   void summary_( const std::vector<unsigned>& vectorColumn, uint64_t uBeginRow, uint64_t uEndRow, std::vector<aggregate_summary>& vectorSummary ) const;
+   template<typename STATE, typename CALLBACK>
+   void parallel_( uint64_t uBeginRow, uint64_t uEndRow, unsigned uThreadCount, STATE& state_, CALLBACK&& callback_ ) const;
 
    //@}
 
@@ -219,6 +449,9 @@ public:
 public:
    const TABLE* m_ptable;
 
+   static const uint64_t m_uParallelMinRows_s = 0x4000;   ///< minimum number of rows for each thread in parallel operations
+   static const uint64_t m_uSummaryBlock_s = 0x1000;      ///< rows in block for summary, all columns are read for block while rows are in cache
+
    // ## free functions ------------------------------------------------------------
 public:
 
@@ -242,6 +475,203 @@ template<typename TYPE, typename TABLE>
 TYPE sum( const TABLE& t_, unsigned uColumn, uint64_t uBeginRow, uint64_t uCount ) { return aggregate( &t_ ).template sum<TYPE>( uColumn, uBeginRow, uCount ); }
 
 
+/** ---------------------------------------------------------------------------
+ * @brief Get null flags for column in block of rows, bit n is set if row `uRow + n` is null
+ * @param uColumn index to column null flags are read for
+ * @param uRow first row in block
+ * @param uCount number of rows in block, max 64
+ * @return uint64_t mask with null flags for rows in block
+ */
+template <typename TABLE>
+uint64_t aggregate<TABLE>::null_mask_( unsigned uColumn, uint64_t uRow, uint64_t uCount ) const { assert( uCount <= 64 ); assert( m_ptable->is_null() == true );
+   uint64_t uMask = 0;
+   const uint8_t* puNull = m_ptable->row_get_null( uRow );
+   const unsigned uMetaSize = m_ptable->size_row_meta();
+   if( m_ptable->is_null32() == true ) {
+      for( uint64_t u = 0; u < uCount; u++, puNull += uMetaSize ) { uMask |= (uint64_t)( ( *(const uint32_t*)puNull >> uColumn ) & 1u ) << u; }
+   }
+   else {
+      for( uint64_t u = 0; u < uCount; u++, puNull += uMetaSize ) { uMask |= ( ( *(const uint64_t*)puNull >> uColumn ) & 1ull ) << u; }
+   }
+   return uMask;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Walk values in fixed size column at row stride and add them to state
+ *
+ * Null flags are checked for 64 rows at a time, blocks without null values are
+ * processed in a tight loop without any checks.
+ *
+ * @tparam VALUE native type for values stored in column
+ * @tparam STATE state object values are added to
+ * @param uColumn index to column
+ * @param uBeginRow first row
+ * @param uEndRow end row (not included)
+ * @param state_ state values are added to
+ */
+template <typename TABLE>
+template<typename VALUE, typename STATE>
+void aggregate<TABLE>::kernel_( unsigned uColumn, uint64_t uBeginRow, uint64_t uEndRow, STATE& state_ ) const { assert( uBeginRow < uEndRow );
+   const bool bHasNull = m_ptable->is_null();
+   const uint64_t uStride = m_ptable->size_row();
+   const uint8_t* puValue = m_ptable->cell_get( uBeginRow, uColumn );
+
+   for( uint64_t uRow = uBeginRow; uRow < uEndRow; ) {
+      const uint64_t uBlock = ( uEndRow - uRow ) < 64 ? ( uEndRow - uRow ) : 64;
+      const uint64_t uNullMask = bHasNull == true ? null_mask_( uColumn, uRow, uBlock ) : 0;
+
+      if( uNullMask == 0 ) {
+         for( uint64_t u = 0; u < uBlock; u++ ) { state_.add( *(const VALUE*)( puValue + u * uStride ) ); }
+      }
+      else if( uNullMask != ( uBlock == 64 ? ~0ull : ( ( 1ull << uBlock ) - 1 ) ) ) {
+         for( uint64_t u = 0; u < uBlock; u++ ) {
+            if( ( uNullMask & ( 1ull << u ) ) == 0 ) state_.add( *(const VALUE*)( puValue + u * uStride ) );
+         }
+      }
+
+      puValue += uBlock * uStride;
+      uRow += uBlock;
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Select typed kernel for column type and run it
+ * @param uColumn index to column
+ * @param uBeginRow first row
+ * @param uEndRow end row (not included)
+ * @param state_ state values are added to
+ * @return true if column was fixed numeric type and values are added, false if caller need to handle values
+ */
+template <typename TABLE>
+template<typename STATE>
+bool aggregate<TABLE>::fixed_( unsigned uColumn, uint64_t uBeginRow, uint64_t uEndRow, STATE& state_ ) const {
+   using namespace gd::types;
+   if( uBeginRow >= uEndRow ) return true;
+
+   switch( m_ptable->column_get_ctype( uColumn ) & 0x0000'00ff ) {
+   case eTypeNumberInt8:   kernel_<int8_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberUInt8:  kernel_<uint8_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberInt16:  kernel_<int16_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberUInt16: kernel_<uint16_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberInt32:  kernel_<int32_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberUInt32: kernel_<uint32_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberInt64:  kernel_<int64_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberUInt64: kernel_<uint64_t>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberFloat:  kernel_<float>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   case eTypeNumberDouble: kernel_<double>( uColumn, uBeginRow, uEndRow, state_ ); return true;
+   default: break;
+   }
+   return false;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Add values in column to state, values not stored as fixed numbers are converted to TYPE
+ * @param uColumn index to column
+ * @param uBeginRow first row
+ * @param uEndRow end row (not included)
+ * @param state_ state values are added to
+ */
+template <typename TABLE>
+template<typename TYPE, typename STATE>
+void aggregate<TABLE>::collect_( unsigned uColumn, uint64_t uBeginRow, uint64_t uEndRow, STATE& state_ ) const {
+   if( fixed_( uColumn, uBeginRow, uEndRow, state_ ) == true ) return;
+
+   auto eType = gd::types::type_g<TYPE>( gd::types::tag_ask_compiler{});
+   bool bHasNull = m_ptable->is_null();
+   for( uint64_t uRow = uBeginRow; uRow < uEndRow; uRow++ ) {
+      if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue;
+      gd::variant variantConvertTo;
+      auto variantviewValue = m_ptable->cell_get_variant_view( uRow, uColumn );
+      if( variantviewValue.convert_to( eType, variantConvertTo ) == true ) { state_.add( (TYPE)variantConvertTo ); }
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Collect summary for columns in row range
+ *
+ * Rows are read in blocks, each column is read for block before moving to next
+ * block. That way row data is read from memory once for all columns.
+ *
+ * @param vectorColumn columns to summarize
+ * @param uBeginRow first row
+ * @param uEndRow end row (not included)
+ * @param vectorSummary summary for each column, same size as vectorColumn
+ */
+template <typename TABLE>
+void aggregate<TABLE>::summary_( const std::vector<unsigned>& vectorColumn, uint64_t uBeginRow, uint64_t uEndRow, std::vector<aggregate_summary>& vectorSummary ) const { assert( vectorSummary.size() == vectorColumn.size() );
+   bool bHasNull = m_ptable->is_null();
+   for( uint64_t uBlock = uBeginRow; uBlock < uEndRow; uBlock += m_uSummaryBlock_s ) {
+      uint64_t uBlockEnd = uEndRow - uBlock < m_uSummaryBlock_s ? uEndRow : uBlock + m_uSummaryBlock_s;
+      for( size_t u = 0; u < vectorColumn.size(); u++ ) {
+         unsigned uColumn = vectorColumn[u];                                                        assert( uColumn < m_ptable->get_column_count() );
+         if( fixed_( uColumn, uBlock, uBlockEnd, vectorSummary[u] ) == true ) continue;
+
+         // ## column is not fixed number, add values that are numbers
+         for( uint64_t uRow = uBlock; uRow < uBlockEnd; uRow++ ) {
+            if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue;
+            auto variantviewValue = m_ptable->cell_get_variant_view( uRow, uColumn );
+            if( variantviewValue.is_integer() == true ) vectorSummary[u].add( variantviewValue.as_int64() );
+            else if( variantviewValue.is_decimal() == true ) vectorSummary[u].add( variantviewValue.as_double() );
+         }
+      }
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Split row range in chunks, process chunks in threads and merge results into state
+ *
+ * Each thread works on its own copy of `state_`, pass state without values.
+ * The calling thread process the first chunk. Ranges that are too small to
+ * gain anything from threads are processed directly in calling thread.
+ * Exceptions thrown in threads are rethrown after all threads are joined.
+ *
+ * @param uBeginRow first row
+ * @param uEndRow end row (not included)
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @param state_ state results are merged into
+ * @param callback_ called with `( uBeginRow, uEndRow, STATE& )` for each chunk
+ */
+template <typename TABLE>
+template<typename STATE, typename CALLBACK>
+void aggregate<TABLE>::parallel_( uint64_t uBeginRow, uint64_t uEndRow, unsigned uThreadCount, STATE& state_, CALLBACK&& callback_ ) const {
+   if( uBeginRow >= uEndRow ) return;
+   if( uThreadCount == 0 ) { uThreadCount = std::thread::hardware_concurrency(); }
+   if( uThreadCount == 0 ) { uThreadCount = 1; }
+
+   uint64_t uRowCount = uEndRow - uBeginRow;
+   uint64_t uMaxThread = uRowCount / m_uParallelMinRows_s;                    // no need for threads if each thread do not get enough rows
+   if( uMaxThread < uThreadCount ) { uThreadCount = uMaxThread > 1 ? (unsigned)uMaxThread : 1; }
+
+   if( uThreadCount == 1 ) { callback_( uBeginRow, uEndRow, state_ ); return; }
+
+   // ## start threads for all chunks except the first that is processed in this thread
+
+   uint64_t uChunk = ( uRowCount + uThreadCount - 1 ) / uThreadCount;
+   std::vector<STATE> vectorState( uThreadCount - 1, state_ );
+   std::vector<std::exception_ptr> vectorError( uThreadCount - 1 );
+   std::vector<std::thread> vectorThread;
+   vectorThread.reserve( uThreadCount - 1 );
+
+   for( unsigned u = 1; u < uThreadCount; u++ ) {
+      uint64_t uFrom = uBeginRow + uChunk * u;
+      uint64_t uTo = uFrom + uChunk < uEndRow ? uFrom + uChunk : uEndRow;
+      vectorThread.emplace_back( [&, u, uFrom, uTo]() {
+         try { callback_( uFrom, uTo, vectorState[u - 1] ); }
+         catch( ... ) { vectorError[u - 1] = std::current_exception(); }
+      } );
+   }
+
+   std::exception_ptr pexception;
+   try { callback_( uBeginRow, uBeginRow + uChunk, state_ ); }
+   catch( ... ) { pexception = std::current_exception(); }
+
+   for( auto& thread_ : vectorThread ) { thread_.join(); }
+   if( pexception ) std::rethrow_exception( pexception );
+   for( auto& perror : vectorError ) { if( perror ) std::rethrow_exception( perror ); }
+
+   for( auto& it : vectorState ) { detail::merge_g( state_, it ); }
+}
+
 /** ---------------------------------------------------------------------------
  * @brief Find minimum value in specified column range
  * @param uColumn index to column to find minimum value in
@@ -261,6 +691,11 @@ TYPE aggregate<TABLE>::min( unsigned uColumn, uint64_t uBeginRow, uint64_t uCoun
    bool bInitialized = false;
    TYPE min_{};
 
+   if constexpr( std::is_arithmetic_v<TYPE> ) {
+      detail::aggregate_min<TYPE> min_state;
+      if( fixed_( uColumn, uBeginRow, uEndRow, min_state ) == true ) return min_state.m_min;
+   }
+
    if( (( unsigned )eType & 0xff) == (uColumnType & 0xff) ) {
       for( uint64_t uRow = uBeginRow; uRow < uEndRow; uRow++ ) {
          if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue;
@@ -289,6 +724,64 @@ TYPE aggregate<TABLE>::min( unsigned uColumn, uint64_t uBeginRow, uint64_t uCoun
    return min_;
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Find maximum value in specified column range
+ * @param uColumn index to column to find maximum value in
+ * @param uBeginRow start row to check values from
+ * @param uCount number of rows from start row
+ * @return maximum value found in column within specified range
+ */
+template<typename TABLE>
+template<typename TYPE>
+TYPE aggregate<TABLE>::max( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount ) const {        assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   if constexpr( std::is_arithmetic_v<TYPE> ) {
+      detail::aggregate_max<TYPE> max_state;
+      if( fixed_( uColumn, uBeginRow, uEndRow, max_state ) == true ) return max_state.m_max;
+   }
+
+   auto eType = gd::types::type_g<TYPE>( gd::types::tag_ask_compiler{});
+   bool bHasNull = m_ptable->is_null();
+   detail::aggregate_max<TYPE> max_state;
+   for( uint64_t uRow = uBeginRow; uRow < uEndRow; uRow++ ) {
+      if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue;
+      gd::variant variantConvertTo;
+      auto variantviewValue = m_ptable->cell_get_variant_view( uRow, uColumn );
+      if( variantviewValue.convert_to( eType, variantConvertTo ) == true ) { max_state.add( (TYPE)variantConvertTo ); }
+   }
+   return max_state.m_max;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Calculate average for values in specified column range, null values are skipped
+ * @param uColumn index to column to calculate average for
+ * @param uBeginRow start row to calculate from
+ * @param uCount number of rows from start row
+ * @return average for values in column, 0 if no values
+ */
+template<typename TABLE>
+template<typename TYPE>
+double aggregate<TABLE>::average( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount ) const { assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   detail::aggregate_variance mean_state;                                     // count and mean for values
+   if( fixed_( uColumn, uBeginRow, uEndRow, mean_state ) == false ) {
+      auto eType = gd::types::type_g<TYPE>( gd::types::tag_ask_compiler{});
+      bool bHasNull = m_ptable->is_null();
+      for( uint64_t uRow = uBeginRow; uRow < uEndRow; uRow++ ) {
+         if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue;
+         gd::variant variantConvertTo;
+         auto variantviewValue = m_ptable->cell_get_variant_view( uRow, uColumn );
+         if( variantviewValue.convert_to( eType, variantConvertTo ) == true ) { mean_state.add( (TYPE)variantConvertTo ); }
+      }
+   }
+
+   return mean_state.m_dMean;
+}
+
 /** ---------------------------------------------------------------------------
  * @brief count max number of ascii characters needed for column
  * @param uColumn index to column max number of ascii characters value needs
@@ -469,6 +962,11 @@ TYPE aggregate<TABLE>::sum( unsigned uColumn, uint64_t uBeginRow, uint64_t uCoun
    bool bHasNull = m_ptable->is_null(); // get if table has null values
    TYPE sum_{};
 
+   if constexpr( std::is_arithmetic_v<TYPE> ) {
+      detail::aggregate_sum<TYPE> sum_state;
+      if( fixed_( uColumn, uBeginRow, uEndRow, sum_state ) == true ) return sum_state.m_sum;
+   }
+
    if( (( unsigned )eType & 0xff) == (uColumnType & 0xff) ) {
       for( uint64_t uRow = uBeginRow; uRow < uEndRow; uRow++ ) {
          if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue; // skip null values
@@ -586,32 +1084,25 @@ uint64_t aggregate<TABLE>::count_unique( unsigned uColumn, uint64_t uBeginRow, u
 
 
 /** ---------------------------------------------------------------------------
- * @brief Calculate variance of values in specified column range (non-template version)
+ * @brief Calculate sample variance of values in specified column range
+ *
+ * Values are collected in one pass with Welford's algorithm, fixed size numeric
+ * columns are read with typed kernel. Null values are skipped.
+ *
  * @param uColumn index to column to calculate variance for
  * @param uBeginRow start row to calculate from
  * @param uCount number of rows from start row
- * @return variance of values found in column within specified range
+ * @return variance of values found in column within specified range, 0 if less than two values
  */
 template<typename TABLE>
 template<typename TYPE>
 double aggregate<TABLE>::variance( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount ) const { assert( m_ptable != nullptr );
-   // Use double as default type for variance calculation
-   auto eType = m_ptable->column_get_ctype( uColumn );
-   
-   // ## Dispatch to appropriate type based on column type
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
 
-   if( gd::types::detail::is_integer( eType ) ) 
-   {
-      return variance<int64_t>( uColumn, uBeginRow, uCount );
-   }
-   else if( gd::types::detail::is_decimal( eType ) ) 
-   {
-      return variance<double>( uColumn, uBeginRow, uCount );
-   }
-   else 
-   {
-      return variance<double>( uColumn, uBeginRow, uCount );                  // For other types, try to convert to double
-   }
+   detail::aggregate_variance variance_state;
+   collect_<TYPE>( uColumn, uBeginRow, uEndRow, variance_state );
+   return variance_state.variance();
 }
 
 /** ---------------------------------------------------------------------------
@@ -625,7 +1116,7 @@ template<typename TABLE>
 template<typename TYPE>
 double aggregate<TABLE>::std_deviation( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount ) const {
    assert( m_ptable != nullptr );
-   return std::sqrt( variance( uColumn, uBeginRow, uCount ) );
+   return std::sqrt( variance<TYPE>( uColumn, uBeginRow, uCount ) );
 }
 
 
@@ -672,29 +1163,8 @@ TYPE aggregate<TABLE>::median( unsigned uColumn, uint64_t uBeginRow, uint64_t uC
       }
    }
 
-   if( vectorValue.empty() ) return TYPE{};
-
    std::sort(vectorValue.begin(), vectorValue.end());                         // Sort values to find median
-   size_t uSize = vectorValue.size();
-
-   // ## Calculate median value
-
-   if( uSize % 2 == 0 ) 
-   {
-      
-      if constexpr( std::is_integral_v<TYPE> ) 
-      {
-         return (vectorValue[uSize/2 - 1] + vectorValue[uSize/2]) / 2;        // Even number of elements - return average of middle two (no single value in the middle)
-      } 
-      else 
-      {
-         return (vectorValue[uSize/2 - 1] + vectorValue[uSize/2]) / static_cast<TYPE>(2.0); // Floating point - return precise average
-      }
-   } 
-   else 
-   {
-      return vectorValue[uSize / 2];                                          // Odd number of elements - return middle element
-   }
+   return detail::median_sorted_g( vectorValue );
 }
 
 /** ---------------------------------------------------------------------------
@@ -717,7 +1187,7 @@ TYPE aggregate<TABLE>::percentile( unsigned uColumn, double dPercentile, uint64_
    bool bHasNull = m_ptable->is_null();
    std::vector<TYPE> vectorValue;
 
-   if( type_number_g( eType ) == type_number_g( uColumnType ) ) 
+   if( (( unsigned )eType & 0xff) == (uColumnType & 0xff) )
    {
       for( uint64_t uRow = uBeginRow; uRow < uEndRow; uRow++ ) 
       {
@@ -739,31 +1209,161 @@ TYPE aggregate<TABLE>::percentile( unsigned uColumn, double dPercentile, uint64_
       }
    }
 
-   if( vectorValue.empty() ) return TYPE{};
-
    std::sort( vectorValue.begin(), vectorValue.end() );
+   return detail::percentile_sorted_g( vectorValue, dPercentile );
+}
 
-   if( dPercentile == 0.0 ) return vectorValue.front();
-   if( dPercentile == 100.0 ) return vectorValue.back();
-
-   double dIndex = (dPercentile / 100.0) * (vectorValue.size() - 1);
-   size_t uLowerIndex = static_cast<size_t>( std::floor( dIndex ) );
-   size_t uUpperIndex = static_cast<size_t>( std::ceil( dIndex ) );
+/** ---------------------------------------------------------------------------
+ * @brief Sum values in column range, rows are split between threads
+ * @param uColumn index to column to sum values in
+ * @param uBeginRow start row
+ * @param uCount number of rows from start row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return sum of values in column within specified range
+ */
+template<typename TABLE>
+template<typename TYPE>
+TYPE aggregate<TABLE>::sum( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount ) const { assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
 
-   if( uLowerIndex == uUpperIndex ) {
-      return vectorValue[uLowerIndex];
+   if constexpr( std::is_arithmetic_v<TYPE> ) {
+      detail::aggregate_sum<TYPE> sum_state;
+      parallel_( uBeginRow, uEndRow, uThreadCount, sum_state, [this, uColumn]( uint64_t uFrom, uint64_t uTo, detail::aggregate_sum<TYPE>& state_ ) {
+         collect_<TYPE>( uColumn, uFrom, uTo, state_ );
+      } );
+      return sum_state.m_sum;
    }
+   else { return sum<TYPE>( uColumn, uBeginRow, uCount ); }
+}
 
-   // Linear interpolation between the two values
-   double dFraction = dIndex - std::floor( dIndex );
-   if constexpr( std::is_integral_v<TYPE> ) 
-   {
-      return static_cast<TYPE>( vectorValue[uLowerIndex] + dFraction * (vectorValue[uUpperIndex] - vectorValue[uLowerIndex]) );
-   } 
-   else 
-   {
-      return vectorValue[uLowerIndex] + static_cast<TYPE>( dFraction ) * (vectorValue[uUpperIndex] - vectorValue[uLowerIndex]);
-   }
+/** ---------------------------------------------------------------------------
+ * @brief Sample variance for column range, partial results from threads are merged with Welford merge
+ * @param uColumn index to column
+ * @param uBeginRow start row
+ * @param uCount number of rows from start row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return variance of values in column within specified range, 0 if less than two values
+ */
+template<typename TABLE>
+template<typename TYPE>
+double aggregate<TABLE>::variance( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount ) const { assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   detail::aggregate_variance variance_state;
+   parallel_( uBeginRow, uEndRow, uThreadCount, variance_state, [this, uColumn]( uint64_t uFrom, uint64_t uTo, detail::aggregate_variance& state_ ) {
+      collect_<TYPE>( uColumn, uFrom, uTo, state_ );
+   } );
+   return variance_state.variance();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Median for column range, each thread sorts its values and sorted chunks are merged
+ * @param uColumn index to column
+ * @param uBeginRow start row
+ * @param uCount number of rows from start row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return median value in column within specified range
+ */
+template<typename TABLE>
+template<typename TYPE>
+TYPE aggregate<TABLE>::median( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount ) const { assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   detail::aggregate_quantile<TYPE> quantile_state;
+   parallel_( uBeginRow, uEndRow, uThreadCount, quantile_state, [this, uColumn]( uint64_t uFrom, uint64_t uTo, detail::aggregate_quantile<TYPE>& state_ ) {
+      collect_<TYPE>( uColumn, uFrom, uTo, state_ );
+      state_.sort();
+   } );
+   return detail::median_sorted_g( quantile_state.m_vectorValue );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Percentile for column range, each thread sorts its values and sorted chunks are merged
+ * @param uColumn index to column
+ * @param dPercentile percentile to find (0.0 to 100.0)
+ * @param uBeginRow start row
+ * @param uCount number of rows from start row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return percentile value in column within specified range
+ */
+template<typename TABLE>
+template<typename TYPE>
+TYPE aggregate<TABLE>::percentile( unsigned uColumn, double dPercentile, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount ) const { assert( m_ptable != nullptr ); assert( dPercentile >= 0.0 && dPercentile <= 100.0 );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   detail::aggregate_quantile<TYPE> quantile_state;
+   parallel_( uBeginRow, uEndRow, uThreadCount, quantile_state, [this, uColumn]( uint64_t uFrom, uint64_t uTo, detail::aggregate_quantile<TYPE>& state_ ) {
+      collect_<TYPE>( uColumn, uFrom, uTo, state_ );
+      state_.sort();
+   } );
+   return detail::percentile_sorted_g( quantile_state.m_vectorValue, dPercentile );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Count unique values in column range, each thread collects values in own set and sets are merged
+ * @param uColumn index to column
+ * @param uBeginRow start row
+ * @param uCount number of rows from start row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return number of unique values in column within specified range
+ */
+template <typename TABLE>
+uint64_t aggregate<TABLE>::count_unique( unsigned uColumn, uint64_t uBeginRow, uint64_t uCount, tag_parallel, unsigned uThreadCount ) const { assert( m_ptable != nullptr ); assert( uColumn < m_ptable->get_column_count() );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   detail::aggregate_unique unique_state;
+   parallel_( uBeginRow, uEndRow, uThreadCount, unique_state, [this, uColumn]( uint64_t uFrom, uint64_t uTo, detail::aggregate_unique& state_ ) {
+      bool bHasNull = m_ptable->is_null();
+      for( uint64_t uRow = uFrom; uRow < uTo; uRow++ ) {
+         if( bHasNull == true && m_ptable->cell_is_null(uRow, uColumn) == true ) continue;
+         state_.add( m_ptable->cell_get_variant_view( uRow, uColumn ) );
+      }
+   } );
+   return unique_state.m_setValue.size();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Collect count, sum, min, max, average and variance for columns in one scan
+ *
+ * Use this when many aggregate values are needed, table rows are only read once
+ * compared to one pass for each call to sum, min, max etc.
+ *
+ * @param vectorColumn columns to summarize
+ * @param uBeginRow start row
+ * @param uCount number of rows from start row
+ * @param vectorSummary gets summary for each column in vectorColumn
+ *
+ * @code
+ * std::vector<gd::table::aggregate_summary> vectorSummary;
+ * gd::table::aggregate aggregate_( &table_ );
+ * aggregate_.summary( { 2, 3 }, vectorSummary, gd::table::tag_parallel{} );
+ * auto uSum = vectorSummary[0].sum<uint64_t>();
+ * @endcode
+ */
+template <typename TABLE>
+void aggregate<TABLE>::summary( const std::vector<unsigned>& vectorColumn, uint64_t uBeginRow, uint64_t uCount, std::vector<aggregate_summary>& vectorSummary ) const { assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   vectorSummary.assign( vectorColumn.size(), aggregate_summary{} );
+   summary_( vectorColumn, uBeginRow, uEndRow, vectorSummary );
+}
+
+/// Collect summary for columns, rows are split between threads and summaries are merged
+template <typename TABLE>
+void aggregate<TABLE>::summary( const std::vector<unsigned>& vectorColumn, uint64_t uBeginRow, uint64_t uCount, std::vector<aggregate_summary>& vectorSummary, tag_parallel, unsigned uThreadCount ) const { assert( m_ptable != nullptr );
+   uint64_t uEndRow = uBeginRow + uCount;
+   if( uEndRow > m_ptable->get_row_count() ) { uEndRow = m_ptable->get_row_count(); }
+
+   vectorSummary.assign( vectorColumn.size(), aggregate_summary{} );
+   parallel_( uBeginRow, uEndRow, uThreadCount, vectorSummary, [this, &vectorColumn]( uint64_t uFrom, uint64_t uTo, std::vector<aggregate_summary>& vectorState ) {
+      summary_( vectorColumn, uFrom, uTo, vectorState );
+   } );
 }
 
 /** ---------------------------------------------------------------------------
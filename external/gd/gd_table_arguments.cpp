@@ -2,6 +2,7 @@
 #include "gd_variant.h"
 
 #include "gd_table_arguments.h"
+#include "gd_table_sort.h"
 
 #if GD_COMPILER_HAS_CPP20_SUPPORT
 
@@ -4211,6 +4212,77 @@ void table::sort( unsigned uColumn, bool bAscending, uint64_t uFrom, uint64_t uC
    }
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Reorder rows so row at `vectorIndex[n]` is placed at `uFrom + n`
+ * All rows are moved in one pass, rows are copied to temporary buffer in new
+ * order and then copied back. Meta data for rows are moved in the same way.
+ * @param vectorIndex permutation with absolute row indexes, each row in range [uFrom, uFrom + size) once
+ * @param uFrom first row in range that is reordered
+*/
+void table::reorder( const std::vector<uint64_t>& vectorIndex, uint64_t uFrom )
+{                                                                                                  assert( (uFrom + vectorIndex.size()) <= get_row_count() );
+   const uint64_t uCount = vectorIndex.size();
+   if( uCount < 2 ) return;
+
+   std::unique_ptr<uint8_t[]> puBuffer = std::make_unique<uint8_t[]>( uCount * m_uRowSize );
+   uint8_t* puPosition = puBuffer.get();
+   for( auto uRow : vectorIndex )
+   {                                                                                               assert( uRow >= uFrom && uRow < (uFrom + uCount) );
+      std::memcpy( puPosition, row_get( uRow ), m_uRowSize );
+      puPosition += m_uRowSize;
+   }
+   std::memcpy( row_get( uFrom ), puBuffer.get(), uCount * m_uRowSize );
+
+   // ## move meta data for rows
+   if( is_rowmeta() == true )
+   {
+      std::unique_ptr<uint8_t[]> puMeta = std::make_unique<uint8_t[]>( uCount * m_uRowMetaSize );
+      puPosition = puMeta.get();
+      for( auto uRow : vectorIndex )
+      {
+         std::memcpy( puPosition, row_get_meta( uRow ), m_uRowMetaSize );
+         puPosition += m_uRowMetaSize;
+      }
+      std::memcpy( row_get_meta( uFrom ), puMeta.get(), uCount * m_uRowMetaSize );
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Sort rows on one or more keys
+ *
+ * Builds sorted row permutation with typed comparators for each key column and
+ * then moves rows in one pass. Sort is stable, equal rows keep their order.
+ *
+ * @code
+table table_( table::eTableFlagNull32, { { "int32", 0, "key"}, { "string", 20, "name"} }, tag_prepare{});
+for( int i = 0; i < 1000; i++ ) table_.row_add( { i % 10, std::to_string( i ) }, tag_convert{} );
+table_.sort( { sort_key( 0, false ), sort_key( 1 ) } );                   // key descending, name ascending
+ * @endcode
+ * @param vectorKey keys to sort on, first key is most significant
+ * @param uFrom first row to sort
+ * @param uCount number of rows to sort
+*/
+void table::sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount )
+{                                                                                                  assert( (uFrom + uCount) <= get_row_count() );
+   std::vector<uint64_t> vectorIndex;
+   sort_index_g( *this, vectorKey, uFrom, uCount, vectorIndex );
+   reorder( vectorIndex, uFrom );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Get sorted row order for one or more keys, rows in table are not moved
+ * @param vectorKey keys to sort on, first key is most significant
+ * @param uFrom first row to sort
+ * @param uCount number of rows to sort
+ * @return std::vector<uint64_t> absolute row indexes in sorted order
+*/
+std::vector<uint64_t> table::sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount, tag_sort_index ) const
+{                                                                                                  assert( (uFrom + uCount) <= get_row_count() );
+   std::vector<uint64_t> vectorIndex;
+   sort_index_g( *this, vectorKey, uFrom, uCount, vectorIndex );
+   return vectorIndex;
+}
+
 /// split will create a new table with the section range has
 table table::split( range rangeSplit ) const
 {
@@ -962,12 +962,21 @@ public:
 
    // ## @API [tag: sort, reorder] [description: sort is to reorder the rows in the table based on the values in a specific column]
    void swap( uint64_t uRow1, uint64_t uRow2 );
+   void reorder( const std::vector<uint64_t>& vectorIndex, uint64_t uFrom );
 
    // https://github.com/kevinhermawan/sortire
 
    void sort( unsigned uColumn, bool bAscending, uint64_t uFrom, uint64_t uCount, tag_sort_selection );
    void sort( unsigned uColumn, bool bAscending, uint64_t uFrom, uint64_t uCount, tag_sort_bubble );
 
+   // ## typed sort on one or more keys, O(n log n) and stable
+   void sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount );
+   void sort( const std::vector<sort_key>& vectorKey ) { sort( vectorKey, 0, get_row_count() ); }
+   std::vector<uint64_t> sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount, tag_sort_index ) const;
+   std::vector<uint64_t> sort( const std::vector<sort_key>& vectorKey, tag_sort_index ) const { return sort( vectorKey, 0, get_row_count(), tag_sort_index{} ); }
+
+   void sort( unsigned uColumn, bool bAscending ) { sort( { sort_key( uColumn, bAscending ) }, 0, get_row_count() ); }
+
    template<typename TAG_ALGORITHM>
    void sort( unsigned uColumn, bool bAscending, TAG_ALGORITHM tag_ ) { sort( uColumn, bAscending, 0, get_row_count(), tag_ ); }
    template<typename TAG_ALGORITHM>
@@ -17,6 +17,7 @@
 #include "gd_table_table.h"
 
 #include "gd_table_column-buffer.h"
+#include "gd_table_sort.h"
 
 
 #if defined( __clang__ )
@@ -4378,6 +4379,77 @@ void table_column_buffer::sort_null(unsigned uColumn, bool bAscending, uint64_t
    }
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Reorder rows so row at `vectorIndex[n]` is placed at `uFrom + n`
+ * All rows are moved in one pass, rows are copied to temporary buffer in new
+ * order and then copied back. Meta data for rows are moved in the same way.
+ * @param vectorIndex permutation with absolute row indexes, each row in range [uFrom, uFrom + size) once
+ * @param uFrom first row in range that is reordered
+*/
+void table_column_buffer::reorder( const std::vector<uint64_t>& vectorIndex, uint64_t uFrom )
+{                                                                                                  assert( (uFrom + vectorIndex.size()) <= get_row_count() );
+   const uint64_t uCount = vectorIndex.size();
+   if( uCount < 2 ) return;
+
+   std::unique_ptr<uint8_t[]> puBuffer = std::make_unique<uint8_t[]>( uCount * m_uRowSize );
+   uint8_t* puPosition = puBuffer.get();
+   for( auto uRow : vectorIndex )
+   {                                                                                               assert( uRow >= uFrom && uRow < (uFrom + uCount) );
+      std::memcpy( puPosition, row_get( uRow ), m_uRowSize );
+      puPosition += m_uRowSize;
+   }
+   std::memcpy( row_get( uFrom ), puBuffer.get(), uCount * m_uRowSize );
+
+   // ## move meta data for rows
+   if( is_rowmeta() == true )
+   {
+      std::unique_ptr<uint8_t[]> puMeta = std::make_unique<uint8_t[]>( uCount * m_uRowMetaSize );
+      puPosition = puMeta.get();
+      for( auto uRow : vectorIndex )
+      {
+         std::memcpy( puPosition, row_get_meta( uRow ), m_uRowMetaSize );
+         puPosition += m_uRowMetaSize;
+      }
+      std::memcpy( row_get_meta( uFrom ), puMeta.get(), uCount * m_uRowMetaSize );
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Sort rows on one or more keys
+ *
+ * Builds sorted row permutation with typed comparators for each key column and
+ * then moves rows in one pass. Sort is stable, equal rows keep their order.
+ *
+ * @code
+table_column_buffer table_( table_column_buffer::eTableFlagNull32, { { "int32", 0, "key"}, { "string", 20, "name"} }, tag_prepare{});
+for( int i = 0; i < 1000; i++ ) table_.row_add( { i % 10, std::to_string( i ) }, tag_convert{} );
+table_.sort( { sort_key( 0, false ), sort_key( 1 ) } );                   // key descending, name ascending
+ * @endcode
+ * @param vectorKey keys to sort on, first key is most significant
+ * @param uFrom first row to sort
+ * @param uCount number of rows to sort
+*/
+void table_column_buffer::sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount )
+{                                                                                                  assert( (uFrom + uCount) <= get_row_count() );
+   std::vector<uint64_t> vectorIndex;
+   sort_index_g( *this, vectorKey, uFrom, uCount, vectorIndex );
+   reorder( vectorIndex, uFrom );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Get sorted row order for one or more keys, rows in table are not moved
+ * @param vectorKey keys to sort on, first key is most significant
+ * @param uFrom first row to sort
+ * @param uCount number of rows to sort
+ * @return std::vector<uint64_t> absolute row indexes in sorted order
+*/
+std::vector<uint64_t> table_column_buffer::sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount, tag_sort_index ) const
+{                                                                                                  assert( (uFrom + uCount) <= get_row_count() );
+   std::vector<uint64_t> vectorIndex;
+   sort_index_g( *this, vectorKey, uFrom, uCount, vectorIndex );
+   return vectorIndex;
+}
+
 /** ---------------------------------------------------------------------------
  * @brief Split table into new tables with max amount of rows
  * @code
@@ -4485,7 +4557,7 @@ void table_column_buffer::erase( uint64_t uFrom, uint64_t uCount )
 
       /// ### calculate to where memmory is moved and move it
       uint8_t* puMoveTo = puStartOfMoveBlock - uEraseMetaSize;
-      memcpy( puMoveTo, puStartOfMoveBlock, uMoveSize );
+      memmove( puMoveTo, puStartOfMoveBlock, uMoveSize );                    // blocks overlap
    }
 
    // ## move
@@ -4494,7 +4566,7 @@ void table_column_buffer::erase( uint64_t uFrom, uint64_t uCount )
 
    /// ### calculate to where memmory is moved and move it
    uint8_t* puMoveTo = puStartOfMoveBlock - uEraseDataSize;
-   memcpy( puMoveTo, puStartOfMoveBlock, uMoveSize );
+   memmove( puMoveTo, puStartOfMoveBlock, uMoveSize );                        // blocks overlap
 
    m_uRowCount -= uCount;
 }
@@ -4502,8 +4574,8 @@ void table_column_buffer::erase( uint64_t uFrom, uint64_t uCount )
 /** ---------------------------------------------------------------------------
  * Erases multiple rows from the table column buffer by their indices.
  * 
- * This method handles duplicate indices and ensures rows are erased in descending order
- * to prevent index invalidation problems that would occur with ascending order deletion.
+ * This method handles duplicate indices. Rows are compacted in one pass, each
+ * block of rows between erased rows is moved once to its new position.
  * 
  * @param puRowIndex Pointer to an array of row indices to be erased
  * @param uCount Number of indices in the puRowIndex array
@@ -4514,23 +4586,37 @@ uint64_t table_column_buffer::erase(const uint64_t* puRowIndex, uint64_t uCount)
    std::vector<uint64_t> vectorSorted(puRowIndex, puRowIndex + uCount);
 
    // ## Remove duplicates
-   //    Sort the vector in descending order to ensure that we can safely erase rows without invalidating indices.
-   std::sort(vectorSorted.begin(), vectorSorted.end(), [](uint64_t uLeft, uint64_t uRight){ return uLeft > uRight; });
-
+   std::sort(vectorSorted.begin(), vectorSorted.end());
    vectorSorted.erase( std::unique(vectorSorted.begin(), vectorSorted.end()), vectorSorted.end());
 
-   size_t uSize = size();
-   size_t uRemoved = 0;
+   uint64_t uRowCount = get_row_count();
+   uint64_t uMetaSize = size_row_meta();
+
+   // ## move block of rows, blocks may overlap
+   auto move_ = [this, uMetaSize]( uint64_t uTo, uint64_t uFrom, uint64_t uRows )
+   {
+      if( uTo == uFrom || uRows == 0 ) return;
+      memmove( m_puData + (uTo * m_uRowSize), m_puData + (uFrom * m_uRowSize), uRows * m_uRowSize );
+      if( m_puMetaData != nullptr ) { memmove( m_puMetaData + (uTo * uMetaSize), m_puMetaData + (uFrom * uMetaSize), uRows * uMetaSize ); }
+   };
+
+   uint64_t uWrite = 0;                                                        // next position for kept row
+   uint64_t uRead = 0;                                                         // first row not processed
+   uint64_t uRemoved = 0;
 
-   // ## Process from highest to lowest index (prevents invalidation problems)
    for(const uint64_t uIndex : vectorSorted)
    {
-      if(uIndex < uSize)
-      {
-         erase(uIndex, 1);                                                     // Remove the row
-         uRemoved++;
-      }
+      if(uIndex >= uRowCount) break;                                           // sorted, rest is out of bounds
+
+      move_( uWrite, uRead, uIndex - uRead );                                  // move kept rows before erased row
+      uWrite += uIndex - uRead;
+      uRead = uIndex + 1;
+      uRemoved++;
    }
+
+   move_( uWrite, uRead, uRowCount - uRead );                                  // rows after last erased row
+
+   m_uRowCount -= uRemoved;
                                                                                                    assert(uRemoved <= uCount);
    return uRemoved;                                                                                
 }
@@ -4562,6 +4648,37 @@ void table_column_buffer::erase(const uint64_t* puRowIndex, uint64_t uCount, tag
    }
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Remove reference values that are not used by any cell
+ *
+ * Values for reference columns are shared and kept when rows are erased or cells
+ * are set to new values. This collects index from all reference cells, removes values
+ * without users and updates cells with new index.
+ *
+ * @return number of removed values
+ */
+uint64_t table_column_buffer::reference_compact()
+{
+   if( m_references.empty() == true ) return 0;
+
+   uint64_t uReferenceCount = m_references.size();
+   std::vector<bool> vectorUsed( uReferenceCount, false );
+   auto for_each_ = [this]( auto&& callback_ ) {
+      for( const auto& column_ : m_vectorColumn )
+      {
+         if( column_.is_reference() == false ) continue;
+         for( uint64_t uRow = 0; uRow < get_row_count(); uRow++ ) { callback_( (uint64_t*)( row_get( uRow ) + column_.position() ) ); }
+      }
+   };
+
+   for_each_( [&vectorUsed, uReferenceCount]( uint64_t* puIndex ) { if( *puIndex < uReferenceCount ) vectorUsed[*puIndex] = true; } ); // null cells keep old index, value is kept
+
+   auto vectorMap = m_references.compact( vectorUsed );
+   for_each_( [&vectorMap, uReferenceCount]( uint64_t* puIndex ) { if( *puIndex < uReferenceCount ) *puIndex = vectorMap[*puIndex]; } );
+
+   return uReferenceCount - m_references.size();
+}
+
 static const std::byte* read_s( const std::byte* pFrom, void* pTo, std::size_t uSize);
 static std::byte* write_s( const void* pSource, std::byte* pBuffer, std::size_t uSize);
 
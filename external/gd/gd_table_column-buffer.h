@@ -872,6 +872,8 @@ public:
    ///@{
    /// Clears all rows in table (just set the row count to 0)
    void row_clear() { m_uRowCount = 0; }
+   /// Clears all rows and reference values in table, columns and allocated row memory are kept
+   void row_clear( tag_reference ) { m_uRowCount = 0; m_references.clear(); }
    ///@}
 
     /// @name row_delete
@@ -1177,13 +1179,20 @@ public:
 
    // ## @API [tag: sort, reorder] [description: sort is to reorder the rows in the table based on the values in a specific column]
    void swap( uint64_t uRow1, uint64_t uRow2 );
+   void reorder( const std::vector<uint64_t>& vectorIndex, uint64_t uFrom );
 
    // https://github.com/kevinhermawan/sortire
 
    void sort( unsigned uColumn, bool bAscending, uint64_t uFrom, uint64_t uCount, tag_sort_selection );
    void sort( unsigned uColumn, bool bAscending, uint64_t uFrom, uint64_t uCount, tag_sort_bubble );
 
-   void sort( unsigned uColumn, bool bAscending ) { sort( uColumn, bAscending, 0, get_row_count(), tag_sort_selection{} ); }
+   // ## typed sort on one or more keys, O(n log n) and stable
+   void sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount );
+   void sort( const std::vector<sort_key>& vectorKey ) { sort( vectorKey, 0, get_row_count() ); }
+   std::vector<uint64_t> sort( const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount, tag_sort_index ) const;
+   std::vector<uint64_t> sort( const std::vector<sort_key>& vectorKey, tag_sort_index ) const { return sort( vectorKey, 0, get_row_count(), tag_sort_index{} ); }
+
+   void sort( unsigned uColumn, bool bAscending ) { sort( { sort_key( uColumn, bAscending ) }, 0, get_row_count() ); }
 
    void sort_null(unsigned uColumn, bool bAscending, uint64_t uFrom, uint64_t uCount, tag_sort_bubble);
    void sort_null( unsigned uColumn, bool bAscending ) { sort_null( uColumn, bAscending, 0, get_row_count(), tag_sort_bubble{} ); }
@@ -1227,6 +1236,8 @@ public:
    uint64_t erase(const std::vector<uint64_t>& vectorRowIndex) { return erase(vectorRowIndex.data(), (uint64_t)vectorRowIndex.size()); }
    /// Erase selected rows, rows should be sorted in descending order
    void erase(const std::vector<uint64_t>& vectorRowIndex, tag_raw) { erase(vectorRowIndex.data(), (uint64_t)vectorRowIndex.size(), tag_raw{}); }
+   /// Remove reference values that no cell use, returns number of removed values
+   uint64_t reference_compact();
 
    // ## @API [tag: serialize] [description: read and write methods to store parts of the table and complete table as binary data]
 
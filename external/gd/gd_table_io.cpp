@@ -1,7 +1,13 @@
 // @FILE [tag: table, print, output] [description: Generate output from tables in different formats] [type: source] [name: gd_table_io.cpp]
 
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <memory>
 #include <numeric>
+#include <thread>
 
+#include "gd_file.h"
 #include "gd_parse.h"
 #include "gd_sql_value.h"
 
@@ -88,6 +94,321 @@ std::pair<bool, std::string> to_table( const std::string_view& stringTableData,
 }
 */
 
+// ## Serializer with column plans --------------------------------------------
+// Column types are checked once before rows are written. Fixed size numbers and
+// text with length are read directly from row buffer, values in reference columns
+// are read with `cell_get_variant_view`. Numbers are formatted with `std::to_chars`
+// directly into the output buffer.
+
+namespace {
+   constexpr size_t uWriteChunkSize_g = 0x10000;                              ///< buffer size that triggers sink when output is streamed
+
+   /// how value in column is written
+   enum enumWrite { eWriteValue, eWriteBool, eWriteInteger, eWriteUInteger, eWriteFloat, eWriteDouble, eWriteText };
+
+   /// write information for column, selected once for all rows
+   struct column_plan_
+   {
+      enumWrite m_eWrite;     ///< how to write column value
+      unsigned m_uTypeNumber; ///< type number for column, native type for values read from row
+      unsigned m_uPosition;   ///< offset to value in row
+      bool m_bRow;            ///< value is read from row buffer, false = read with `cell_get_variant_view`
+   };
+
+   /// select write method for type number, types without fast formatting are written as variant
+   enumWrite select_write_( unsigned uTypeNumber, bool bScientific )
+   {
+      switch( uTypeNumber )
+      {
+      case gd::types::eTypeNumberBool   : return eWriteBool;
+      case gd::types::eTypeNumberInt8   :
+      case gd::types::eTypeNumberInt16  :
+      case gd::types::eTypeNumberInt32  :
+      case gd::types::eTypeNumberInt64  : return eWriteInteger;
+      case gd::types::eTypeNumberUInt8  :
+      case gd::types::eTypeNumberUInt16 :
+      case gd::types::eTypeNumberUInt32 :
+      case gd::types::eTypeNumberUInt64 : return eWriteUInteger;
+      case gd::types::eTypeNumberFloat  : return bScientific == true ? eWriteValue : eWriteFloat;
+      case gd::types::eTypeNumberDouble : return bScientific == true ? eWriteValue : eWriteDouble;
+      case gd::types::eTypeNumberString :
+      case gd::types::eTypeNumberUtf8String : return eWriteText;
+      }
+      return eWriteValue;
+   }
+
+   /// build write plan for columns in table, reference columns are checked for each value
+   std::vector<column_plan_> plan_columns_( const dto::table& table, bool bScientific )
+   {
+      std::vector<column_plan_> vectorPlan;
+      vectorPlan.reserve( table.get_column_count() );
+      for( auto it = table.column_begin(), itEnd = table.column_end(); it != itEnd; it++ )
+      {
+         if( it->is_reference() == true ) { vectorPlan.push_back( { eWriteValue, it->ctype_number(), it->position(), false } ); continue; }
+
+         enumWrite eWrite = select_write_( it->ctype_number(), bScientific );
+         bool bRow = eWrite != eWriteValue && ( eWrite != eWriteText || it->is_length() == true ); // text in row begins with length
+         vectorPlan.push_back( { eWrite, it->ctype_number(), it->position(), bRow } );
+      }
+      return vectorPlan;
+   }
+
+   template<typename TYPE>
+   void write_number_( TYPE value_, std::string& stringOut )
+   {
+      char pbszBuffer[32];
+      auto result_ = std::to_chars( pbszBuffer, pbszBuffer + sizeof( pbszBuffer ), value_ );           assert( result_.ec == std::errc() );
+      stringOut.append( pbszBuffer, result_.ptr );
+   }
+
+   /// write float, same format as `std::to_string`
+   void write_float_( float fValue, std::string& stringOut )
+   {
+      char pbszBuffer[64];
+      auto result_ = std::to_chars( pbszBuffer, pbszBuffer + sizeof( pbszBuffer ), (double)fValue, std::chars_format::fixed, 6 );
+      if( result_.ec != std::errc() ) { stringOut += std::to_string( fValue ); return; }
+      stringOut.append( pbszBuffer, result_.ptr );
+   }
+
+   /// write double, same format as `variant_view::as_string`, fixed with trailing zeros removed or nine digits in exponent format
+   void write_double_( double dValue, std::string& stringOut )
+   {
+      char pbszBuffer[400];                                                    // max double in fixed format with 9 decimals
+      if( gd::variant::is_exponent_s( dValue, 15 ) == false )
+      {
+         auto result_ = std::to_chars( pbszBuffer, pbszBuffer + sizeof( pbszBuffer ), dValue, std::chars_format::fixed, 9 ); assert( result_.ec == std::errc() );
+         const char* pbszLast = result_.ptr - 1;
+         if( pbszLast != pbszBuffer )
+         {
+            while( *pbszLast == '0' && pbszLast > pbszBuffer ) pbszLast--;
+            if( *pbszLast != '.' ) pbszLast++;
+         }
+         stringOut.append( pbszBuffer, pbszLast - pbszBuffer );
+      }
+      else
+      {
+         auto result_ = std::to_chars( pbszBuffer, pbszBuffer + sizeof( pbszBuffer ), dValue, std::chars_format::general, 9 ); assert( result_.ec == std::errc() );
+         stringOut.append( pbszBuffer, result_.ptr );
+      }
+   }
+
+   /// write text escaped for json, scan for characters to escape is done 16 bytes at the time
+   void write_json_text_( std::string_view stringText, std::string& stringOut )
+   {
+      if( stringText.empty() == true ) return;
+      const char* pbsz = stringText.data();
+      const char* pbszEnd = pbsz + stringText.length();
+      while( true )
+      {
+         const char* pbszFind = gd::parse::next_any_character_or_end_g( pbsz, pbszEnd, std::string_view( "\"\\\b\t\n\f\r" ) );
+         stringOut.append( pbsz, pbszFind );
+         if( pbszFind == pbszEnd ) break;
+
+         stringOut += '\\';
+         switch( *pbszFind )
+         {
+         case '\b': stringOut += 'b'; break;
+         case '\t': stringOut += 't'; break;
+         case '\n': stringOut += 'n'; break;
+         case '\f': stringOut += 'f'; break;
+         case '\r': stringOut += 'r'; break;
+         default:   stringOut += *pbszFind; break;                           // `"` or `\`
+         }
+         pbsz = pbszFind + 1;
+      }
+   }
+
+   /// write text escaped for csv, `"` is doubled and new line is prefixed with `\` (same as `gd::parse::escape_g` for csv)
+   void write_csv_text_( std::string_view stringText, std::string& stringOut )
+   {
+      if( stringText.empty() == true ) return;
+      const char* pbsz = stringText.data();
+      const char* pbszEnd = pbsz + stringText.length();
+      while( true )
+      {
+         const char* pbszFind = gd::parse::next_any_character_or_end_g( pbsz, pbszEnd, std::string_view( "\"\n" ) );
+         stringOut.append( pbsz, pbszFind );
+         if( pbszFind == pbszEnd ) break;
+
+         if( *pbszFind == '"' ) stringOut += std::string_view( "\"\"" );
+         else                   stringOut += std::string_view( "\\\n" );
+         pbsz = pbszFind + 1;
+      }
+   }
+
+   /// settings for writing rows, text is formated with custom method if set
+   struct write_setting_
+   {
+      bool m_bJson;                                                           ///< json arrays, csv if false
+      bool m_bEscape;                                                         ///< escape json text (csv text is always escaped)
+      bool m_bScientific;                                                     ///< scientific format for decimal values
+      const std::function<bool( const std::string_view&, std::string& stringNew )>* m_pformat_text; ///< custom text format, may be null
+   };
+
+   /// write text value, quoted and escaped or formated by custom method
+   void write_text_( const write_setting_& setting_, std::string_view stringText, std::string& stringOut )
+   {
+      stringOut += '"';
+      if( setting_.m_pformat_text == nullptr )
+      {
+         if( setting_.m_bJson == false )    write_csv_text_( stringText, stringOut );
+         else if( setting_.m_bEscape == true ) write_json_text_( stringText, stringOut );
+         else                                stringOut += stringText;
+      }
+      else if( setting_.m_bJson == false )
+      {
+         std::string stringEscaped;
+         write_csv_text_( stringText, stringEscaped );
+         bool bOk = ( *setting_.m_pformat_text )( stringEscaped, stringOut );                     assert( bOk == true );
+      }
+      else
+      {
+         bool bOk = ( *setting_.m_pformat_text )( stringText, stringOut );                        assert( bOk == true );
+      }
+      stringOut += '"';
+   }
+
+   /// write cell value using column plan
+   void write_value_( const write_setting_& setting_, enumWrite eWrite, const gd::variant_view& value_, std::string& stringOut )
+   {
+      if( eWrite == eWriteValue ) eWrite = select_write_( value_.type_number(), setting_.m_bScientific );
+
+      switch( eWrite )
+      {
+      case eWriteBool     : stringOut += (bool)value_ == false ? '0' : '1'; break;
+      case eWriteInteger  : write_number_( value_.as_int64(), stringOut ); break;
+      case eWriteUInteger : write_number_( value_.as_uint64(), stringOut ); break;
+      case eWriteFloat    : write_float_( (float)value_, stringOut ); break;
+      case eWriteDouble   : write_double_( (double)value_, stringOut ); break;
+      case eWriteText     : write_text_( setting_, value_.as_string_view(), stringOut ); break;
+      default:
+         if( value_.is_string() == true ) { write_text_( setting_, value_.as_string(), stringOut ); }
+         else if( setting_.m_bScientific == true ) { stringOut += value_.as_string( gd::variant_type::tag_scientific{} ); }
+         else { stringOut += value_.as_string(); }
+      }
+   }
+
+   /// read fixed size number stored in row
+   template<typename TYPE>
+   TYPE read_number_( unsigned uTypeNumber, const uint8_t* puValue )
+   {
+      switch( uTypeNumber )
+      {
+      case gd::types::eTypeNumberInt8   : return (TYPE)*(const int8_t*)puValue;
+      case gd::types::eTypeNumberInt16  : return (TYPE)*(const int16_t*)puValue;
+      case gd::types::eTypeNumberInt32  : return (TYPE)*(const int32_t*)puValue;
+      case gd::types::eTypeNumberUInt8  : return (TYPE)*(const uint8_t*)puValue;
+      case gd::types::eTypeNumberUInt16 : return (TYPE)*(const uint16_t*)puValue;
+      case gd::types::eTypeNumberUInt32 : return (TYPE)*(const uint32_t*)puValue;
+      case gd::types::eTypeNumberUInt64 : return (TYPE)*(const uint64_t*)puValue;
+      default                           : return (TYPE)*(const int64_t*)puValue;
+      }
+   }
+
+   /// write value read from row buffer, only for columns where `column_plan_::m_bRow` is set
+   void write_row_value_( const write_setting_& setting_, const column_plan_& plan_, const uint8_t* puValue, std::string& stringOut )
+   {
+      switch( plan_.m_eWrite )
+      {
+      case eWriteBool     : stringOut += *puValue == 0 ? '0' : '1'; break;
+      case eWriteInteger  : write_number_( read_number_<int64_t>( plan_.m_uTypeNumber, puValue ), stringOut ); break;
+      case eWriteUInteger : write_number_( read_number_<uint64_t>( plan_.m_uTypeNumber, puValue ), stringOut ); break;
+      case eWriteFloat    : write_float_( *(const float*)puValue, stringOut ); break;
+      case eWriteDouble   : write_double_( *(const double*)puValue, stringOut ); break;
+      case eWriteText     : write_text_( setting_, std::string_view( (const char*)puValue + sizeof( uint32_t ), *(const uint32_t*)puValue ), stringOut ); break;
+      default: assert( false );
+      }
+   }
+
+   /**
+    * @brief Write rows in json or csv format, rows are separated with ",\n" and last row ends with new line
+    * @param puRow row indexes if rows are selected, null writes rows in range
+    * @param sink_ if set buffer is passed to sink when it grows above chunk size and at the end, buffer is cleared after each call
+    */
+   void write_rows_( const dto::table& table, uint64_t uBegin, uint64_t uCount, const uint64_t* puRow, const write_setting_& setting_, std::string& stringBuffer, const std::function<void( std::string_view )>& sink_ )
+   {
+      if( uCount == 0 ) return;
+
+      std::vector<column_plan_> vectorPlan = plan_columns_( table, setting_.m_bScientific );
+      const unsigned uColumnCount = (unsigned)vectorPlan.size();
+      const bool bNull = table.is_null();
+
+      for( uint64_t u = 0; u < uCount; u++ )
+      {
+         uint64_t uRow = puRow != nullptr ? puRow[u] : uBegin + u;                                assert( uRow < table.get_row_count() );
+         if( u != 0 ) stringBuffer += std::string_view( ",\n" );
+         if( setting_.m_bJson == true ) stringBuffer += '[';
+
+         for( unsigned uColumn = 0; uColumn < uColumnCount; uColumn++ )
+         {
+            if( uColumn > 0 ) stringBuffer += ',';
+            const column_plan_& plan_ = vectorPlan[uColumn];
+            if( plan_.m_bRow == true )
+            {
+               if( bNull == true && table.cell_is_null( uRow, uColumn ) == true ) { if( setting_.m_bJson == true ) stringBuffer += std::string_view( "null" ); }
+               else { write_row_value_( setting_, plan_, table.row_get( uRow ) + plan_.m_uPosition, stringBuffer ); }
+               continue;
+            }
+
+            auto value_ = table.cell_get_variant_view( uRow, uColumn );
+            if( value_.is_null() == true )
+            {
+               if( setting_.m_bJson == true ) stringBuffer += std::string_view( "null" );
+            }
+            else { write_value_( setting_, plan_.m_eWrite, value_, stringBuffer ); }
+         }
+
+         if( setting_.m_bJson == true ) stringBuffer += ']';
+
+         if( sink_ && stringBuffer.size() >= uWriteChunkSize_g )
+         {
+            sink_( stringBuffer );
+            stringBuffer.clear();
+         }
+      }
+
+      stringBuffer += '\n';
+      if( sink_ )
+      {
+         sink_( stringBuffer );
+         stringBuffer.clear();
+      }
+   }
+
+   write_setting_ write_setting_from_( const gd::argument::arguments& argumentsOption, const std::function<bool( const std::string_view&, std::string& stringNew )>& format_text_, bool bJson )
+   {
+      write_setting_ setting_{ bJson, false, argumentsOption["scientific"].is_true(), nullptr };
+      if( format_text_ ) setting_.m_pformat_text = &format_text_;
+      else if( bJson == true && argumentsOption["format"].as_string() == "escape" ) setting_.m_bEscape = true;
+      return setting_;
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Write table rows as json arrays to buffer or sink
+ *
+ * Same output as `to_string` for json, column types are checked once and values are
+ * formated directly into buffer. If sink is set the buffer is passed to sink in chunks
+ * and cleared, use this to stream large tables without holding all text in memory.
+ *
+ * @param table table rows are written from
+ * @param uBegin first row to write
+ * @param uCount number of rows to write
+ * @param argumentsOption options, "format": "escape" escapes text and "scientific": true for decimal values
+ * @param stringBuffer buffer text is appended to
+ * @param sink_ receives text in chunks if set, buffer holds all text if not set
+ */
+void write_g( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, std::string& stringBuffer, const std::function<void( std::string_view )>& sink_, tag_io_json )
+{                                                                                                  assert( uBegin + uCount <= table.get_row_count() );
+   write_rows_( table, uBegin, uCount, nullptr, write_setting_from_( argumentsOption, nullptr, true ), stringBuffer, sink_ );
+}
+
+/// Write table rows in csv format to buffer or sink, see json version for details
+void write_g( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, std::string& stringBuffer, const std::function<void( std::string_view )>& sink_, tag_io_csv )
+{                                                                                                  assert( uBegin + uCount <= table.get_row_count() );
+   write_rows_( table, uBegin, uCount, nullptr, write_setting_from_( argumentsOption, nullptr, false ), stringBuffer, sink_ );
+}
+
 /// convert table (both header and body) to json array
 void to_string(const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool(const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_header, tag_io_csv)
 {
@@ -139,76 +460,17 @@ void to_string(const dto::table& table, uint64_t uBegin, uint64_t uCount, const
 /// convert table to csv
 void to_string( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool(const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_csv )
 {
-   unsigned uOptions = 0;
-   std::function<bool(std::string_view, std::string& stringNew)> functionFormat( format_copy );
-   std::string stringResult;                    // result string with table data
-   std::vector<gd::variant_view> vectorValue;   // used to fetch values from table
-
-   if( format_text_ ) { functionFormat = format_text_; }
-
-   if( argumentsOption["scientific"].is_true() == true ) uOptions |= eOptionScientific;
-
-   auto uEnd = uBegin + uCount;
-   for( auto uRow = uBegin; uRow < uEnd; uRow++ )
-   {
-      if( uRow != uBegin ) stringResult += ",\n";                              // add comma separator between rows
-
-      vectorValue.clear();
-      table.row_get_variant_view( uRow, vectorValue );
-
-      unsigned uColumn = 0;
-      auto it = std::begin( vectorValue );
-      auto itEnd = std::end( vectorValue );
-      for( ; it < itEnd; it++ )
-      {
-         if( uColumn > 0 ) stringResult += ",";                                // add `,` to separate columns
-         auto value_ = *it;
-
-         if( value_.is_null() == true )
-         {
-            // pass, no value
-         }
-         else if( value_.is_string() == true )
-         {
-            stringResult += "\"";
-#ifdef _DEBUG
-            auto uLength_d = strlen((const char*)value_);                                          assert( uLength_d < 0x0010'0000 );
-            auto uChar_d = ((const char*)value_)[uLength_d];                                       assert( uChar_d == 0 );
-#endif // _DEBUG
-
-            std::string string_ = value_.as_string();
-            gd::parse::escape_g( string_, gd::parse::tag_csv{});
-            bool bOk = functionFormat(string_, stringResult);                                     assert( bOk == true );
-
-            //auto pbszValue = ( const char* )value_;
-            //auto [bOk, pbuszPosition] = gd::utf8::validate( pbszValue );
-            //if( bOk == true ) { gd::utf8::uri::convert_utf8_to_uri( (const uint8_t*)pbszValue, (const uint8_t*)pbszValue + value_.length(), stringResult ); }
-            //else
-            //{                                                               // Not valid utf8 text
-            //   // ## text is not valid utf8 format, convert to utf8
-            //   std::string stringUtf8;
-            //   gd::utf8::convert_ascii( pbszValue, stringUtf8 );
-            //   gd::utf8::uri::convert_utf8_to_uri( stringUtf8, stringResult );
-            //}
-            stringResult += "\"";
-         }
-         else
-         {
-            if( uOptions & eOptionScientific) stringResult += value_.as_string( gd::variant_type::tag_scientific{} );
-            else                              stringResult += value_.as_string();
-         }
-
-         uColumn++;
-      }
-   }
-   if( stringResult.empty() == false ) stringResult += "\n";                   // add new line
-
-   if( stringOut.empty() == true ) stringOut = std::move( stringResult );
-   else stringOut += stringResult;
+   write_rows_( table, uBegin, uCount, nullptr, write_setting_from_( argumentsOption, format_text_, false ), stringOut, nullptr );
 }
 
 void to_string( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, bool (*pformat_text_)(unsigned uColumn, unsigned uType, const gd::variant_view&, std::string& stringNew), std::string& stringOut, tag_io_csv )
 {
+   if( pformat_text_ == nullptr )                                              // no custom format, use column plan
+   {
+      write_rows_( table, uBegin, uCount, nullptr, write_setting_from_( argumentsOption, nullptr, false ), stringOut, nullptr );
+      return;
+   }
+
    unsigned uOptions = 0;
    std::string stringResult;                    // result string with table data
    std::vector<gd::variant_view> vectorValue;   // used to fetch values from table
@@ -499,150 +761,413 @@ std::pair<bool, const char*> read_g(dto::table& table, const std::string_view& s
 }
 
 
-std::pair<bool, const char*> read_g(std::vector<std::string>& vectorHeader, const std::string_view& stringCsv, char chSeparator, char chNewLine, tag_io_csv)
-{
-   gd::parse::csv csvRule( chSeparator, chNewLine );                           // csv rules used to parse values
-
-   return std::pair<bool, const char*>();
-}
-
-// std::pair< bool, std::string >
+namespace {
+   constexpr uint64_t uCsvChunkMinSize_g = 0x40000;                            // 256 KB, each thread need at least this much text
 
-/**  -------------------------------------------------------------------------- to_string
- * @brief Convert table rows to JSON array format
- * 
- * Converts a range of table rows into a JSON array string. Each row is represented
- * as a JSON array of values. Handles type conversion, null values, string escaping,
- * and scientific notation based on options.
- * 
- * @param table Table to convert
- * @param uBegin Starting row index (zero-based)
- * @param uCount Number of rows to convert
- * @param argumentsOption Options controlling output format (supports "format": "escape", "scientific": true)
- * @param format_text_ Optional custom text formatting function; if null uses default or "escape" based on options
- * @param stringOut Output string to append JSON data; if empty, content is moved instead of appended
- * @param tag_io_json Tag dispatch parameter for JSON format
- */
-void to_string( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool(const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_json )
-{
-   unsigned uOptions = 0;
-   std::function<bool(std::string_view, std::string& stringNew)> functionFormat( format_copy );
-   std::string stringResult;                    // result string with table data
-   std::vector<gd::variant_view> vectorValue;   // used to fetch values from table
+   /// call `callback_( u )` for each chunk, chunk 0 in calling thread and other chunks in threads. Exceptions are rethrown after all threads are joined
+   template<typename CALLBACK>
+   void run_parallel_( unsigned uCount, CALLBACK&& callback_ )
+   {
+      std::vector<std::exception_ptr> vectorError( uCount );
+      std::vector<std::thread> vectorThread;
+      vectorThread.reserve( uCount );
+      for( unsigned u = 1; u < uCount; u++ )
+      {
+         vectorThread.emplace_back( [&, u]() {
+            try { callback_( u ); }
+            catch( ... ) { vectorError[u] = std::current_exception(); }
+         } );
+      }
 
-   if( format_text_ ) { functionFormat = format_text_; }
-   else if( argumentsOption["format"].as_string() == "escape" ) { functionFormat = format_escape; } 
+      try { callback_( 0u ); }
+      catch( ... ) { vectorError[0] = std::current_exception(); }
 
-   if( argumentsOption["scientific"].is_true() == true ) uOptions |= eOptionScientific;
+      for( auto& thread_ : vectorThread ) { thread_.join(); }
+      for( auto& perror : vectorError ) { if( perror ) std::rethrow_exception( perror ); }
+   }
 
-   auto uEnd = uBegin + uCount;
-   for( auto uRow = uBegin; uRow < uEnd; uRow++ )
+   /// read number with `std::from_chars`, number has to fill text. Floating point falls back to `strtod` if library lacks it
+   template<typename TYPE>
+   bool read_number_( const char* pbsz, const char* pbszEnd, gd::variant_view& v_ )
    {
-      if( uRow != uBegin ) stringResult += ",\n";                              // add comma separator between rows
-      stringResult += "[";
+      if( *pbsz == '+' && pbsz + 1 < pbszEnd ) pbsz++;                         // from_chars do not accept leading plus sign
+      TYPE value_{};
+#if defined( __cpp_lib_to_chars )
+      auto result_ = std::from_chars( pbsz, pbszEnd, value_ );
+      if( result_.ec != std::errc() || result_.ptr != pbszEnd ) return false;
+#else
+      if constexpr( std::is_floating_point_v<TYPE> )
+      {
+         char pbszNumber[64];
+         size_t uLength = pbszEnd - pbsz;
+         if( uLength >= sizeof( pbszNumber ) ) return false;
+         std::memcpy( pbszNumber, pbsz, uLength );
+         pbszNumber[uLength] = '\0';
+         char* pbszRead = nullptr;
+         value_ = (TYPE)std::strtod( pbszNumber, &pbszRead );
+         if( pbszRead != pbszNumber + uLength ) return false;
+      }
+      else
+      {
+         auto result_ = std::from_chars( pbsz, pbszEnd, value_ );
+         if( result_.ec != std::errc() || result_.ptr != pbszEnd ) return false;
+      }
+#endif
+      v_ = gd::variant_view( value_ );
+      return true;
+   }
 
-      vectorValue.clear();
-      table.row_get_variant_view( uRow, vectorValue );
+   /// convert text to value with exact type for column, types that are not numbers or boolean are left as null
+   bool read_value_( unsigned uType, const char* pbsz, const char* pbszEnd, gd::variant_view& v_ )
+   {                                                                                               assert( pbsz < pbszEnd );
+      using namespace gd::types;
+      switch( gd::types::detail::type_number_g( uType ) )
+      {
+      case eTypeNumberBool   : v_ = gd::variant_view( !( *pbsz == '0' || *pbsz == 'f' || *pbsz == 'F' || *pbsz == 'n' || *pbsz == 'N' ) ); return true;
+      case eTypeNumberInt8   : return read_number_<int8_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberUInt8  : return read_number_<uint8_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberInt16  : return read_number_<int16_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberUInt16 : return read_number_<uint16_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberInt32  : return read_number_<int32_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberUInt32 : return read_number_<uint32_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberInt64  : return read_number_<int64_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberUInt64 : return read_number_<uint64_t>( pbsz, pbszEnd, v_ );
+      case eTypeNumberFloat  : return read_number_<float>( pbsz, pbszEnd, v_ );
+      case eTypeNumberDouble : return read_number_<double>( pbsz, pbszEnd, v_ );
+      default: return true;
+      }
+   }
 
-      unsigned uColumn = 0;
-      auto it = std::begin( vectorValue );
-      auto itEnd = std::end( vectorValue );
-      for( ; it < itEnd; it++ )
+   /** ------------------------------------------------------------------------
+    * @brief Read csv rows into table, text need to start at row start
+    *
+    * Unquoted values are found with `next_any_character_or_end_g` that scans 16 bytes
+    * at the time for separator or new line. Quoted values may hold separators, new
+    * lines and escaped quotes (`""`). Space, tab and carriage return around numbers
+    * and after quoted values are skipped, empty lines are skipped.
+    *
+    * Rows are cleared before values are set, missing or empty numbers are null in
+    * tables with null flags and zero in other tables.
+    *
+    * @return true if ok, false and position for value that could not be read
+    */
+   std::pair<bool, const char*> read_rows_( dto::table& table, const char* pbszPosition, const char* pbszEnd, const std::vector<unsigned>& vectorType, const gd::parse::csv& csv )
+   {
+      const char chSeparator = (char)csv.get_delimiter();
+      const char chNewLine = (char)csv.get_lineend();
+      const char chQuote = (char)csv.get_quote();
+      const char pbszStructural[] = { chSeparator, chNewLine };
+      const std::string_view stringStructural( pbszStructural, 2 );
+      const unsigned uColumnCount = (unsigned)vectorType.size();
+      const bool bNull = table.is_null();
+      std::string stringUnescape;                                              // quoted value with escaped quotes
+
+      auto is_space_ = []( char ch_ ) { return ch_ == ' ' || ch_ == '\t' || ch_ == '\r'; };
+
+      while( pbszPosition < pbszEnd )
       {
-         if( uColumn > 0 ) stringResult += ",";                                // add `,` to separate columns
-         auto value_ = *it;                                                    // active column value
+         while( pbszPosition < pbszEnd && ( is_space_( *pbszPosition ) == true || *pbszPosition == chNewLine ) ) pbszPosition++;
+         if( pbszPosition >= pbszEnd ) break;
 
-         if( value_.is_null() == true ) { stringResult += "null"; }           // for javascript null
-         else if( value_.is_string() == true )
+         uint64_t uRow = table.get_row_count();
+         table.row_add();
+         std::memset( table.row_get( uRow ), 0, table.size_row() );
+         if( bNull == true ) table.row_set_null( uRow );
+
+         bool bLineEnd = false;                                                // no more values on line, rest of columns are empty
+         for( unsigned uColumn = 0; uColumn < uColumnCount; uColumn++ )
          {
-            stringResult += "\"";
-#ifdef _DEBUG
-            auto uLength_d = strlen((const char*)value_);                                          assert( uLength_d < 0x0010'0000 );
-            auto uChar_d = ((const char*)value_)[uLength_d];                                       assert( uChar_d == 0 );
-#endif // _DEBUG
+            const char* pbszValue = pbszPosition;
+            std::string_view stringValue;
+            bool bQuoted = false;
 
-            const std::string_view text_ = value_.as_string_view();
-            bool bOk = functionFormat(text_, stringResult);                                        assert(bOk == true);
-            stringResult += "\"";
+            if( bLineEnd == false )
+            {
+               if( *pbszPosition == chQuote )
+               {
+                  // ## quoted value, ends at quote that is not followed by quote
+                  const char* pbszText = ++pbszPosition;
+                  bool bEscape = false;
+                  while( true )
+                  {
+                     pbszPosition = (const char*)std::memchr( pbszPosition, chQuote, pbszEnd - pbszPosition );
+                     if( pbszPosition == nullptr ) return { false, pbszValue };  // missing end quote
+                     if( pbszPosition + 1 < pbszEnd && pbszPosition[1] == chQuote ) { bEscape = true; pbszPosition += 2; continue; }
+                     break;
+                  }
+
+                  stringValue = std::string_view( pbszText, pbszPosition - pbszText );
+                  pbszPosition++;
+                  if( bEscape == true )
+                  {
+                     stringUnescape.clear();
+                     for( size_t u = 0; u < stringValue.length(); u++ )
+                     {
+                        stringUnescape += stringValue[u];
+                        if( stringValue[u] == chQuote ) u++;                   // skip second quote
+                     }
+                     stringValue = stringUnescape;
+                  }
+
+                  while( pbszPosition < pbszEnd && is_space_( *pbszPosition ) == true ) pbszPosition++;
+                  if( pbszPosition < pbszEnd && *pbszPosition != chSeparator && *pbszPosition != chNewLine ) return { false, pbszPosition };
+                  bQuoted = true;
+               }
+               else
+               {
+                  pbszPosition = gd::parse::next_any_character_or_end_g( pbszPosition, pbszEnd, stringStructural );
+                  const char* pbszValueEnd = pbszPosition;
+                  if( pbszValueEnd > pbszValue && pbszValueEnd[-1] == '\r' && ( pbszValueEnd == pbszEnd || *pbszValueEnd == chNewLine ) ) pbszValueEnd--;
+                  stringValue = std::string_view( pbszValue, pbszValueEnd - pbszValue );
+               }
+
+               if( pbszPosition < pbszEnd && *pbszPosition == chSeparator ) pbszPosition++;
+               else                                                         bLineEnd = true;
+            }
+
+            // ## set value in cell
+            unsigned uType = vectorType[uColumn];
+            if( uType & gd::types::eTypeGroupString )
+            {
+               table.cell_set( uRow, uColumn, gd::variant_view( stringValue ) );
+               continue;
+            }
+
+            if( bQuoted == false )
+            {
+               while( stringValue.empty() == false && is_space_( stringValue.front() ) == true ) stringValue.remove_prefix( 1 );
+               while( stringValue.empty() == false && is_space_( stringValue.back() ) == true ) stringValue.remove_suffix( 1 );
+            }
+            if( stringValue.empty() == true ) continue;                        // null or zero
+
+            gd::variant_view v_;
+            if( read_value_( uType, stringValue.data(), stringValue.data() + stringValue.length(), v_ ) == false ) return { false, pbszValue };
+            if( v_.is_null() == false ) table.cell_set( uRow, uColumn, v_ );
          }
-         else
+
+         // ## move to next line, values after last column are skipped
+         if( bLineEnd == false )
          {
-            if( uOptions & eOptionScientific) stringResult += value_.as_string( gd::variant_type::tag_scientific{} );
-            else                              stringResult += value_.as_string();
+            pbszPosition = (const char*)std::memchr( pbszPosition, chNewLine, pbszEnd - pbszPosition );
+            if( pbszPosition == nullptr ) pbszPosition = pbszEnd;
          }
-
-         uColumn++;
+         if( pbszPosition < pbszEnd ) pbszPosition++;                          // skip new line
       }
 
-      stringResult += ']' ;
+      return { true, pbszEnd };
    }
-   if( stringResult.empty() == false ) stringResult += "\n";                   // add new line
 
-   if( stringOut.empty() == true ) stringOut = std::move( stringResult );
-   else stringOut += stringResult;
-}
+   /** ------------------------------------------------------------------------
+    * @brief Split csv text in chunks at line ends that are outside quoted values
+    *
+    * Text is first split in equal parts and quotes in each part are counted in
+    * threads with `count_character_g`. Number of quotes before a split tells if
+    * the split is inside a quoted value, from there the split is moved to the
+    * first new line outside quotes.
+    *
+    * @return start for each chunk followed by end of text
+    */
+   std::vector<const char*> split_( const char* pbszBegin, const char* pbszEnd, char chNewLine, char chQuote, unsigned uChunkCount )
+   {                                                                                               assert( uChunkCount > 1 );
+      uint64_t uSize = pbszEnd - pbszBegin;
+      std::vector<const char*> vectorPart( uChunkCount + 1 );
+      for( unsigned u = 0; u < uChunkCount; u++ ) vectorPart[u] = pbszBegin + uSize * u / uChunkCount;
+      vectorPart[uChunkCount] = pbszEnd;
+
+      std::vector<uint64_t> vectorQuote( uChunkCount );
+      run_parallel_( uChunkCount, [&]( unsigned u ) { vectorQuote[u] = gd::parse::count_character_g( vectorPart[u], vectorPart[u + 1], chQuote ); } );
+
+      const char pbszStructural[] = { chQuote, chNewLine };
+      const std::string_view stringStructural( pbszStructural, 2 );
+      std::vector<const char*> vectorSplit{ pbszBegin };
+      uint64_t uQuoteCount = 0;
+      for( unsigned u = 1; u < uChunkCount; u++ )
+      {
+         uQuoteCount += vectorQuote[u - 1];
+         bool bQuoted = ( uQuoteCount & 1 ) != 0;                              // odd number of quotes before split, split is inside quoted value
+         const char* pbszPosition = vectorPart[u];
+         if( pbszPosition < vectorSplit.back() ) continue;                     // previous split moved past this part
 
-/// convert table to json array for selected rows
-void to_string( const dto::table& table, const std::vector<uint64_t>& vectorRow, const gd::argument::arguments& argumentsOption, const std::function<bool (const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_json )
-{
-   unsigned uOptions = 0;
-   std::function<bool(std::string_view, std::string& stringNew)> functionFormat( format_copy );
-   std::string stringResult;                    // result string with table data
-   std::vector<gd::variant_view> vectorValue;   // used to fetch values from table
+         while( pbszPosition < pbszEnd )
+         {
+            pbszPosition = gd::parse::next_any_character_or_end_g( pbszPosition, pbszEnd, stringStructural );
+            if( pbszPosition == pbszEnd ) break;
+            if( *pbszPosition == chQuote ) { bQuoted = !bQuoted; pbszPosition++; continue; }
+            if( bQuoted == false ) { pbszPosition++; break; }                  // new line outside quotes, chunk starts after it
+            pbszPosition++;
+         }
 
-   if( format_text_ ) { functionFormat = format_text_; }
+         if( pbszPosition < pbszEnd ) vectorSplit.push_back( pbszPosition );
+      }
 
-   if( argumentsOption["scientific"].is_true() == true ) uOptions |= eOptionScientific;
+      vectorSplit.push_back( pbszEnd );
+      return vectorSplit;
+   }
 
-   uint64_t uCount = 0;
-   for( auto uRow : vectorRow )
+   /// Append rows from table read by thread, reference values are added once and cells are set to new index
+   void append_( dto::table& table, const dto::table& tableRead )
    {
-      if( uCount > 0 ) stringResult += ",\n";                              // add comma separator between rows
-      stringResult += "[";
-
-      vectorValue.clear();
-      table.row_get_variant_view( uRow, vectorValue );
+      uint64_t uRowCount = tableRead.get_row_count();
+      if( uRowCount == 0 ) return;
 
-      unsigned uColumn = 0;
-      auto it = std::begin( vectorValue );
-      auto itEnd = std::end( vectorValue );
-      for( ; it < itEnd; it++ )
+      // ## add reference values and collect new index for them
+      std::vector<uint64_t> vectorIndex( tableRead.m_references.size() );
+      for( size_t u = 0; u < vectorIndex.size(); u++ )
       {
-         if( uColumn > 0 ) stringResult += ",";                                // add `,` to separate columns
-         auto value_ = *it;                                                    // active column value
+         const reference* preference = tableRead.m_references.at( u );
+         gd::variant_view v_( preference->ctype(), preference->data(), preference->length() );
+         int64_t iIndex = table.is_duplicated_strings() == false ? table.m_references.find( v_ ) : -1;
+         vectorIndex[u] = iIndex != -1 ? (uint64_t)iIndex : table.m_references.add( v_ );
+      }
 
-         if( value_.is_null() == true )
-         {
-            stringResult += "null";                                            // for javascript null
-         }
-         else if( value_.is_string() == true )
-         {
-            stringResult += "\"";
-#ifdef _DEBUG
-            auto uLength_d = strlen((const char*)value_);                                          assert( uLength_d < 0x0010'0000 );
-            auto uChar_d = ((const char*)value_)[uLength_d];                                       assert( uChar_d == 0 );
-#endif // _DEBUG
+      // ## copy rows and meta data, tables have same columns
+      uint64_t uFirstRow = table.get_row_count();
+      table.row_add( uRowCount );
+      std::memcpy( table.row_get( uFirstRow ), tableRead.row_get( 0 ), uRowCount * table.size_row() );
+      if( table.size_row_meta() > 0 ) std::memcpy( table.row_get_meta( uFirstRow ), tableRead.row_get_meta( 0 ), uRowCount * table.size_row_meta() );
 
-            const std::string_view text_ = value_.as_string_view();
-            bool bOk = functionFormat( text_, stringResult );
-            stringResult += "\"";
-         }
-         else
+      for( const auto& column_ : table.m_vectorColumn )
+      {
+         if( column_.is_reference() == false ) continue;
+         for( uint64_t uRow = uFirstRow, uEnd = uFirstRow + uRowCount; uRow < uEnd; uRow++ )
          {
-            if( uOptions & eOptionScientific) stringResult += value_.as_string( gd::variant_type::tag_scientific{} );
-            else                              stringResult += value_.as_string();
+            uint64_t* puIndex = (uint64_t*)( table.row_get( uRow ) + column_.position() );
+            if( *puIndex < vectorIndex.size() ) *puIndex = vectorIndex[*puIndex]; // null cells may have any index
          }
-
-         uColumn++;
       }
+   }
+}
 
-      stringResult += ']';
-      uCount++;
+/** ---------------------------------------------------------------------------
+ * @brief Read csv formated text into table, text is parsed by threads
+ *
+ * Text is split in chunks at new lines outside quotes (see `split_`). First chunk
+ * is read into table and other chunks into tables with same columns, these are
+ * appended in order when all threads are done. Numbers are parsed with
+ * `std::from_chars` into the exact column type.
+ *
+ * Quoted values follow RFC 4180, `""` in quoted value is one quote. Text below
+ * `uCsvChunkMinSize_g` for each thread is read in calling thread.
+ *
+ * @code
+ * gd::table::dto::table table_( 0u, { { "int64", 0, "id" }, { "rstring", 0, "name" }, { "double", 0, "value" } }, gd::table::tag_prepare{} );
+ * auto result_ = gd::table::read_g( table_, stringCsv, ',', '\n', gd::table::tag_io_csv{}, gd::table::tag_parallel{} );
+ * @endcode
+ *
+ * @param table table rows are added to, table need to be prepared
+ * @param stringCsv text formated as csv
+ * @param chSeparator character used to separate csv values
+ * @param chNewLine separate each row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return true if ok, false and position for value that could not be read. Rows before error are added
+ */
+std::pair<bool, const char*> read_g( dto::table& table, const std::string_view& stringCsv, char chSeparator, char chNewLine, tag_io_csv, tag_parallel, unsigned uThreadCount )
+{
+   const char* pbszBegin = stringCsv.data();
+   const char* pbszEnd = pbszBegin + stringCsv.length();
+   if( stringCsv.empty() == true ) return { true, pbszEnd };
+
+   gd::parse::csv csvRule( chSeparator, chNewLine );                           // csv rules used to parse values
+   auto vectorType = table.column_get_type();
+
+   if( uThreadCount == 0 ) { uThreadCount = std::thread::hardware_concurrency(); }
+   uint64_t uMaxThread = stringCsv.length() / uCsvChunkMinSize_g;
+   if( uMaxThread < uThreadCount ) { uThreadCount = uMaxThread > 1 ? (unsigned)uMaxThread : 1; }
+
+   if( uThreadCount <= 1 )
+   {
+      table.row_reserve_add( gd::parse::count_character_g( pbszBegin, pbszEnd, chNewLine ) + 1 );
+      return read_rows_( table, pbszBegin, pbszEnd, vectorType, csvRule );
    }
-   if( stringResult.empty() == false ) stringResult += "\n";                   // add new line
 
-   if( stringOut.empty() == true ) stringOut = std::move( stringResult );
-   else stringOut += stringResult;
+   auto vectorSplit = split_( pbszBegin, pbszEnd, chNewLine, (char)csvRule.get_quote(), uThreadCount );
+   unsigned uChunkCount = (unsigned)vectorSplit.size() - 1;
+
+   std::vector< std::unique_ptr<dto::table> > vectorTable( uChunkCount );      // first chunk is read into table
+   std::vector< std::pair<bool, const char*> > vectorResult( uChunkCount, { true, nullptr } );
+   for( unsigned u = 1; u < uChunkCount; u++ ) { vectorTable[u] = std::make_unique<dto::table>( table, tag_columns{} ); }
+
+   run_parallel_( uChunkCount, [&]( unsigned u ) {
+      dto::table& table_ = u == 0 ? table : *vectorTable[u];
+      table_.row_reserve_add( gd::parse::count_character_g( vectorSplit[u], vectorSplit[u + 1], chNewLine ) + 1 );
+      vectorResult[u] = read_rows_( table_, vectorSplit[u], vectorSplit[u + 1], vectorType, csvRule );
+   } );
+
+   // ## append rows in text order, stop at first chunk with error
+   uint64_t uRowCount = 0;
+   for( unsigned u = 1; u < uChunkCount; u++ ) { uRowCount += vectorTable[u]->get_row_count(); }
+   if( table.get_row_count() + uRowCount > table.get_reserved_row_count() ) table.row_reserve_add( uRowCount );
+
+   for( unsigned u = 0; u < uChunkCount; u++ )
+   {
+      if( u > 0 ) { append_( table, *vectorTable[u] ); vectorTable[u].reset(); }
+      if( vectorResult[u].first == false ) return vectorResult[u];
+   }
+
+   return { true, pbszEnd };
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Read csv file into table, file is parsed by threads
+ *
+ * Files above `gd::file::map::m_uMapLimit_s` are memory mapped and parsed in place,
+ * no copy of file is made.
+ *
+ * @param table table rows are added to, table need to be prepared
+ * @param stringFileName csv file
+ * @param chSeparator character used to separate csv values
+ * @param chNewLine separate each row
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ * @return true if ok, false and error information on error
+ */
+std::pair<bool, std::string> read_file_g( dto::table& table, const std::string_view& stringFileName, char chSeparator, char chNewLine, tag_io_csv, tag_parallel, unsigned uThreadCount )
+{
+   gd::file::map map_;
+   auto result_ = map_.open( stringFileName );
+   if( result_.first == false ) return result_;
+
+   auto resultRead = read_g( table, map_.string_view(), chSeparator, chNewLine, tag_io_csv{}, tag_parallel{}, uThreadCount );
+   if( resultRead.first == false ) return { false, "Failed to read csv value at offset " + std::to_string( resultRead.second - map_.data() ) + " in " + std::string( stringFileName ) };
+
+   return { true, "" };
+}
+
+
+std::pair<bool, const char*> read_g(std::vector<std::string>& vectorHeader, const std::string_view& stringCsv, char chSeparator, char chNewLine, tag_io_csv)
+{
+   gd::parse::csv csvRule( chSeparator, chNewLine );                           // csv rules used to parse values
+
+   return std::pair<bool, const char*>();
+}
+
+// std::pair< bool, std::string >
+
+/**  -------------------------------------------------------------------------- to_string
+ * @brief Convert table rows to JSON array format
+ * 
+ * Converts a range of table rows into a JSON array string. Each row is represented
+ * as a JSON array of values. Handles type conversion, null values, string escaping,
+ * and scientific notation based on options.
+ * 
+ * @param table Table to convert
+ * @param uBegin Starting row index (zero-based)
+ * @param uCount Number of rows to convert
+ * @param argumentsOption Options controlling output format (supports "format": "escape", "scientific": true)
+ * @param format_text_ Optional custom text formatting function; if null uses default or "escape" based on options
+ * @param stringOut Output string JSON data is appended to
+ * @param tag_io_json Tag dispatch parameter for JSON format
+ */
+void to_string( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool(const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_json )
+{
+   write_rows_( table, uBegin, uCount, nullptr, write_setting_from_( argumentsOption, format_text_, true ), stringOut, nullptr );
+}
+
+/// convert table to json array for selected rows
+void to_string( const dto::table& table, const std::vector<uint64_t>& vectorRow, const gd::argument::arguments& argumentsOption, const std::function<bool (const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_json )
+{
+   write_setting_ setting_ = write_setting_from_( argumentsOption, format_text_, true );
+   setting_.m_bEscape = false;                                                 // selected rows do not read "format" option, text is copied as is
+   write_rows_( table, 0, vectorRow.size(), vectorRow.data(), setting_, stringOut, nullptr );
 }
 
 /** ---------------------------------------------------------------------------
@@ -130,6 +130,9 @@ inline void to_string(const dto::table& table, uint64_t uBegin, uint64_t uCount,
    return to_string( table, uBegin, uCount, gd::argument::arguments(), pformat_text_, stringOut, tag_io_csv{});
 }
 
+/// write rows in csv format to buffer, if `sink_` is set buffer is passed to sink in chunks and cleared
+void write_g( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, std::string& stringBuffer, const std::function<void( std::string_view )>& sink_, tag_io_csv );
+
 // ### `table`
 void to_string( const table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool (const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_csv );
 void to_string( const table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool (const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_header, tag_io_csv );
@@ -151,6 +154,10 @@ inline void to_string(const table& table, uint64_t uBegin, uint64_t uCount, bool
 // ### read csv information into table
 std::pair<bool, const char*> read_g( dto::table& table, const std::string_view& stringCsv, char chSeparator, char chNewLine, tag_io_csv );
 std::pair<bool, const char*> read_g( dto::table& table, const std::string_view& stringCsv, const std::vector<unsigned>& vectorColumn, char chSeparator, char chNewLine, tag_io_csv );
+/// read csv in chunks parsed by threads into separate tables that are appended in order, uThreadCount = 0 uses hardware concurrency
+std::pair<bool, const char*> read_g( dto::table& table, const std::string_view& stringCsv, char chSeparator, char chNewLine, tag_io_csv, tag_parallel, unsigned uThreadCount = 0 );
+/// read csv file in parallel, large files are memory mapped and parsed in place
+std::pair<bool, std::string> read_file_g( dto::table& table, const std::string_view& stringFileName, char chSeparator, char chNewLine, tag_io_csv, tag_parallel, unsigned uThreadCount = 0 );
 
 // ### read csv information into vector
 std::pair<bool, const char*> read_g( std::vector<std::string>& vectorHeader, const std::string_view& stringCsv, char chSeparator, char chNewLine, tag_io_csv );
@@ -166,6 +173,9 @@ void to_string( const dto::table& table, const std::vector<uint64_t>& vectorRow,
 
 void to_string( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, const std::function<bool(const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_object, tag_io_json );
 
+/// write rows as json arrays to buffer, if `sink_` is set buffer is passed to sink in chunks and cleared
+void write_g( const dto::table& table, uint64_t uBegin, uint64_t uCount, const gd::argument::arguments& argumentsOption, std::string& stringBuffer, const std::function<void( std::string_view )>& sink_, tag_io_json );
+
 inline void to_string(const dto::table& table, uint64_t uBegin, uint64_t uCount, const std::function<bool(const std::string_view&, std::string& stringNew)>& format_text_, std::string& stringOut, tag_io_json) {
    return to_string( table, uBegin, uCount, gd::argument::arguments(), format_text_, stringOut, tag_io_json{});
 }
@@ -0,0 +1,255 @@
+// @FILE [tag: table, sort] [description: Typed sort engine for tables, builds row permutation] [type: header] [name: gd_table_sort.h]
+
+/**
+ * \file gd_table_sort.h
+ *
+ * \brief Sort logic for tables that builds a permutation of row indexes
+ *
+ * Values for each sort key are read once from table into typed vectors
+ * (signed, unsigned, decimal or text), comparing values is then done on these
+ * vectors without creating any `variant_view` objects. Sort is stable so rows
+ * with equal keys keep their order.
+ *
+ * Tables that use this logic apply the permutation and move all rows in one pass.
+ *
+ | Function             | Description                                                                            |
+ |----------------------|----------------------------------------------------------------------------------------|
+ | sort_index_g(...)    | Build sorted permutation for rows in table, rows are not moved                         |
+ *
+ \code
+gd::table::dto::table table_( gd::table::dto::table::eTableFlagNull32, { { "int32", 0, "key"}, { "string", 20, "name"} }, gd::table::tag_prepare{} );
+// ... add rows
+auto vectorIndex = table_.sort( { gd::table::sort_key( 1 ), gd::table::sort_key( 0, false ) }, gd::table::tag_sort_index{} );
+for( auto uRow : vectorIndex ) { std::cout << table_.cell_get_variant_view( uRow, 1 ).as_string() << "\n"; }
+ \endcode
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+#include "gd/gd_table.h"
+
+#ifndef _GD_TABLE_BEGIN
+#  define _GD_TABLE_BEGIN namespace gd { namespace table {
+#  define _GD_TABLE_END } }
+#endif
+
+_GD_TABLE_BEGIN
+
+namespace detail {
+
+/** ===========================================================================
+ * \brief Values for one sort key extracted from table, stored in typed vector
+ *
+ * Only one of the value vectors is used and that depends on column type.
+ * Index in vectors is relative to first row that is sorted.
+ */
+struct sort_column
+{
+   enum enumKind
+   {
+      eKindSigned,      ///< all signed integer types
+      eKindUnsigned,    ///< all unsigned integer types and boolean
+      eKindDecimal,     ///< float and double
+      eKindText,        ///< string and utf8 string
+      eKindVariant,     ///< other types, compared with variant_view
+   };
+
+   /// compare values for two rows, returns negative if left is before right, 0 if equal and positive if after
+   int compare( uint64_t uLeft, uint64_t uRight ) const noexcept
+   {
+      if( m_vectorNull.empty() == false )
+      {
+         bool bLeftNull = m_vectorNull[uLeft] != 0;
+         bool bRightNull = m_vectorNull[uRight] != 0;
+         if( bLeftNull == true || bRightNull == true )
+         {
+            if( bLeftNull == bRightNull ) return 0;
+            return ( bLeftNull == m_bNullFirst ) ? -1 : 1;
+         }
+      }
+
+      int iCompare = 0;
+      switch( m_eKind )
+      {
+      case eKindSigned: iCompare = compare_s( m_vectorSigned[uLeft], m_vectorSigned[uRight] ); break;
+      case eKindUnsigned: iCompare = compare_s( m_vectorUnsigned[uLeft], m_vectorUnsigned[uRight] ); break;
+      case eKindDecimal: iCompare = compare_s( m_vectorDecimal[uLeft], m_vectorDecimal[uRight] ); break;
+      case eKindText: iCompare = m_vectorText[uLeft].compare( m_vectorText[uRight] ); break;
+      case eKindVariant:
+         if( m_vectorVariant[uLeft].less( m_vectorVariant[uRight] ) == true ) iCompare = -1;
+         else if( m_vectorVariant[uRight].less( m_vectorVariant[uLeft] ) == true ) iCompare = 1;
+         break;
+      }
+
+      return m_bAscending == true ? iCompare : -iCompare;
+   }
+
+   template<typename TYPE>
+   static int compare_s( TYPE v1_, TYPE v2_ ) noexcept { return ( v1_ < v2_ ) ? -1 : ( ( v2_ < v1_ ) ? 1 : 0 ); }
+
+   enumKind m_eKind = eKindVariant;
+   bool m_bAscending = true;
+   bool m_bNullFirst = true;
+   std::vector<uint8_t> m_vectorNull;           ///< null flags for rows, empty if table do not have null values
+   std::vector<int64_t> m_vectorSigned;
+   std::vector<uint64_t> m_vectorUnsigned;
+   std::vector<double> m_vectorDecimal;
+   std::vector<std::string_view> m_vectorText;
+   std::vector<gd::variant_view> m_vectorVariant;
+};
+
+/** ---------------------------------------------------------------------------
+ * @brief Read values for sort key into typed vector in sort_column
+ * @param table_ table values are read from
+ * @param sortkey_ key with column to read values from
+ * @param uFrom first row to read
+ * @param uCount number of rows to read
+ * @param sortcolumn_ object values are placed in
+ */
+template<typename TABLE>
+void sort_read_column_g( const TABLE& table_, const sort_key& sortkey_, uint64_t uFrom, uint64_t uCount, sort_column& sortcolumn_ )
+{
+   using namespace gd::types;
+   const unsigned uColumn = sortkey_.m_uColumn;
+   const unsigned uType = table_.column_get_ctype( uColumn ) & 0x0000'00ff;
+   const bool bHasNull = table_.is_null();
+
+   sortcolumn_.m_bAscending = sortkey_.m_bAscending;
+   sortcolumn_.m_bNullFirst = sortkey_.m_bNullFirst;
+
+   switch( uType )
+   {
+   case eTypeNumberInt8: case eTypeNumberInt16: case eTypeNumberInt32: case eTypeNumberInt64:
+      sortcolumn_.m_eKind = sort_column::eKindSigned; sortcolumn_.m_vectorSigned.resize( uCount ); break;
+   case eTypeNumberBool: case eTypeNumberUInt8: case eTypeNumberUInt16: case eTypeNumberUInt32: case eTypeNumberUInt64:
+      sortcolumn_.m_eKind = sort_column::eKindUnsigned; sortcolumn_.m_vectorUnsigned.resize( uCount ); break;
+   case eTypeNumberFloat: case eTypeNumberDouble:
+      sortcolumn_.m_eKind = sort_column::eKindDecimal; sortcolumn_.m_vectorDecimal.resize( uCount ); break;
+   case eTypeNumberString: case eTypeNumberUtf8String:
+      sortcolumn_.m_eKind = sort_column::eKindText; sortcolumn_.m_vectorText.resize( uCount ); break;
+   default:
+      sortcolumn_.m_eKind = sort_column::eKindVariant; sortcolumn_.m_vectorVariant.resize( uCount ); break;
+   }
+
+   if( bHasNull == true ) sortcolumn_.m_vectorNull.resize( uCount, 0 );
+
+   for( uint64_t u = 0; u < uCount; u++ )
+   {
+      uint64_t uRow = uFrom + u;
+      if( bHasNull == true && table_.cell_is_null( uRow, uColumn ) == true ) { sortcolumn_.m_vectorNull[u] = 1; continue; }
+
+      // ## fixed values are read directly from row buffer, small types are stored in 32 bit slot
+      const uint8_t* puValue = table_.cell_get( uRow, uColumn );
+      switch( uType )
+      {
+      case eTypeNumberInt8: sortcolumn_.m_vectorSigned[u] = *(const int8_t*)puValue; break;
+      case eTypeNumberInt16: sortcolumn_.m_vectorSigned[u] = *(const int16_t*)puValue; break;
+      case eTypeNumberInt32: sortcolumn_.m_vectorSigned[u] = *(const int32_t*)puValue; break;
+      case eTypeNumberInt64: sortcolumn_.m_vectorSigned[u] = *(const int64_t*)puValue; break;
+      case eTypeNumberBool: case eTypeNumberUInt8: sortcolumn_.m_vectorUnsigned[u] = *(const uint8_t*)puValue; break;
+      case eTypeNumberUInt16: sortcolumn_.m_vectorUnsigned[u] = *(const uint16_t*)puValue; break;
+      case eTypeNumberUInt32: sortcolumn_.m_vectorUnsigned[u] = *(const uint32_t*)puValue; break;
+      case eTypeNumberUInt64: sortcolumn_.m_vectorUnsigned[u] = *(const uint64_t*)puValue; break;
+      case eTypeNumberFloat: sortcolumn_.m_vectorDecimal[u] = *(const float*)puValue; break;
+      case eTypeNumberDouble: sortcolumn_.m_vectorDecimal[u] = *(const double*)puValue; break;
+      case eTypeNumberString: case eTypeNumberUtf8String:                      // text may be stored with length prefix or as reference, table knows how
+         sortcolumn_.m_vectorText[u] = table_.cell_get_variant_view( uRow, uColumn ).as_string_view(); break;
+      default:
+         sortcolumn_.m_vectorVariant[u] = table_.cell_get_variant_view( uRow, uColumn ); break;
+      }
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Sort permutation on one typed vector, null rows are placed first or last
+ * @param vectorValue values for rows, index is relative to `uFrom`
+ * @param vectorNull null flags for rows (may be empty)
+ * @param uFrom first row sorted
+ * @param bAscending sort order
+ * @param bNullFirst if null values are placed first
+ * @param vectorIndex sorted row indexes are placed in this vector
+ */
+template<typename TYPE>
+void sort_index_single_g( const std::vector<TYPE>& vectorValue, const std::vector<uint8_t>& vectorNull, uint64_t uFrom, bool bAscending, bool bNullFirst, std::vector<uint64_t>& vectorIndex )
+{
+   // ## pair value and row to keep memory access linear when sorting
+   std::vector< std::pair<TYPE, uint64_t> > vectorPair;
+   vectorPair.reserve( vectorValue.size() );
+   std::vector<uint64_t> vectorNullRow;
+   for( uint64_t u = 0; u < (uint64_t)vectorValue.size(); u++ )
+   {
+      if( vectorNull.empty() == false && vectorNull[u] != 0 ) { vectorNullRow.push_back( uFrom + u ); continue; }
+      vectorPair.emplace_back( vectorValue[u], uFrom + u );
+   }
+
+   if( bAscending == true ) std::stable_sort( vectorPair.begin(), vectorPair.end(), []( const auto& l_, const auto& r_ ) { return l_.first < r_.first; } );
+   else                     std::stable_sort( vectorPair.begin(), vectorPair.end(), []( const auto& l_, const auto& r_ ) { return r_.first < l_.first; } );
+
+   vectorIndex.clear();
+   vectorIndex.reserve( vectorValue.size() );
+   if( bNullFirst == true ) vectorIndex.insert( vectorIndex.end(), vectorNullRow.begin(), vectorNullRow.end() );
+   for( const auto& it : vectorPair ) vectorIndex.push_back( it.second );
+   if( bNullFirst == false ) vectorIndex.insert( vectorIndex.end(), vectorNullRow.begin(), vectorNullRow.end() );
+}
+
+} // namespace detail
+
+
+/** ---------------------------------------------------------------------------
+ * @brief Build sorted permutation for rows in table, rows in table are not moved
+ *
+ * Values for each key are read once into typed vectors and compared with typed
+ * comparators. Sort is stable, rows with equal values keep their order.
+ *
+ * @param table_ table with rows to sort
+ * @param vectorKey keys to sort on, first key is most significant
+ * @param uFrom first row to sort
+ * @param uCount number of rows to sort
+ * @param vectorIndex gets absolute row indexes in sorted order, size is `uCount`
+ */
+template<typename TABLE>
+void sort_index_g( const TABLE& table_, const std::vector<sort_key>& vectorKey, uint64_t uFrom, uint64_t uCount, std::vector<uint64_t>& vectorIndex )
+{                                                                                                  assert( (uFrom + uCount) <= table_.get_row_count() );
+   vectorIndex.resize( uCount );
+   std::iota( vectorIndex.begin(), vectorIndex.end(), uFrom );
+   if( uCount < 2 || vectorKey.empty() == true ) return;
+
+   std::vector<detail::sort_column> vectorColumn( vectorKey.size() );
+   for( size_t u = 0; u < vectorKey.size(); u++ )
+   {                                                                                               assert( vectorKey[u].m_uColumn < table_.get_column_count() );
+      detail::sort_read_column_g( table_, vectorKey[u], uFrom, uCount, vectorColumn[u] );
+   }
+
+   // ## one key, sort on values with the type for column
+   if( vectorColumn.size() == 1 )
+   {
+      const auto& c_ = vectorColumn[0];
+      switch( c_.m_eKind )
+      {
+      case detail::sort_column::eKindSigned: detail::sort_index_single_g( c_.m_vectorSigned, c_.m_vectorNull, uFrom, c_.m_bAscending, c_.m_bNullFirst, vectorIndex ); return;
+      case detail::sort_column::eKindUnsigned: detail::sort_index_single_g( c_.m_vectorUnsigned, c_.m_vectorNull, uFrom, c_.m_bAscending, c_.m_bNullFirst, vectorIndex ); return;
+      case detail::sort_column::eKindDecimal: detail::sort_index_single_g( c_.m_vectorDecimal, c_.m_vectorNull, uFrom, c_.m_bAscending, c_.m_bNullFirst, vectorIndex ); return;
+      case detail::sort_column::eKindText: detail::sort_index_single_g( c_.m_vectorText, c_.m_vectorNull, uFrom, c_.m_bAscending, c_.m_bNullFirst, vectorIndex ); return;
+      default: break;
+      }
+   }
+
+   // ## multiple keys, compare key by key until values differ
+   std::stable_sort( vectorIndex.begin(), vectorIndex.end(), [&vectorColumn, uFrom]( uint64_t uLeft, uint64_t uRight ) {
+      for( const auto& it : vectorColumn )
+      {
+         int iCompare = it.compare( uLeft - uFrom, uRight - uFrom );
+         if( iCompare != 0 ) return iCompare < 0;
+      }
+      return false;
+   });
+}
+
+_GD_TABLE_END
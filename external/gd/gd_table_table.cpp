@@ -3884,6 +3884,37 @@ void table::erase(const uint64_t* puRowIndex, uint64_t uCount, tag_raw )
    }
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Remove reference values that are not used by any cell
+ *
+ * Values for reference columns are shared and kept when rows are erased or cells
+ * are set to new values. This collects index from all reference cells, removes values
+ * without users and updates cells with new index.
+ *
+ * @return number of removed values
+ */
+uint64_t table::reference_compact()
+{
+   if( m_references.empty() == true ) return 0;
+
+   uint64_t uReferenceCount = m_references.size();
+   std::vector<bool> vectorUsed( uReferenceCount, false );
+   auto for_each_ = [this]( auto&& callback_ ) {
+      for( auto it = m_pcolumns->begin(), itEnd = m_pcolumns->end(); it != itEnd; it++ )
+      {
+         if( it->is_reference() == false ) continue;
+         for( uint64_t uRow = 0; uRow < get_row_count(); uRow++ ) { callback_( (uint64_t*)( row_get( uRow ) + it->position() ) ); }
+      }
+   };
+
+   for_each_( [&vectorUsed, uReferenceCount]( uint64_t* puIndex ) { if( *puIndex < uReferenceCount ) vectorUsed[*puIndex] = true; } ); // null cells keep old index, value is kept
+
+   auto vectorMap = m_references.compact( vectorUsed );
+   for_each_( [&vectorMap, uReferenceCount]( uint64_t* puIndex ) { if( *puIndex < uReferenceCount ) *puIndex = vectorMap[*puIndex]; } );
+
+   return uReferenceCount - m_references.size();
+}
+
 
 
 
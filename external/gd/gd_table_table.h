@@ -938,6 +938,8 @@ public:
    uint64_t erase(const std::vector<uint64_t>& vectorRowIndex) { return erase(vectorRowIndex.data(), (uint64_t)vectorRowIndex.size()); }
    /// Erase selected rows, rows should be sorted in descending order
    void erase(const std::vector<uint64_t>& vectorRowIndex, tag_raw) { erase(vectorRowIndex.data(), (uint64_t)vectorRowIndex.size(), tag_raw{}); }
+   /// Remove reference values that no cell use, returns number of removed values
+   uint64_t reference_compact();
    //@}
 
 
@@ -1,11 +1,119 @@
 // @FILE {tag: find, pattern} [summary: Optimized string pattern matching] [type: source]
 
 #include <algorithm>
+#include <deque>
 
 #include "gd_parse_match_pattern.h"
 
 _GD_PARSE_BEGIN
 
+/** ---------------------------------------------------------------------------
+ * @brief Patterns compiled to Aho-Corasick automaton, all patterns are found in one pass over text
+ *
+ * Transitions are stored as a complete table (no failure links followed while scanning)
+ * with one column for each byte class. Bytes that are not used in any pattern share
+ * class 0, that keeps the table small also for large pattern sets. Ascii letters are
+ * folded to lower case, the automaton finds candidates and pattern flags (case and
+ * whole word) are checked with `pattern::compare` for each candidate.
+ */
+struct patterns::automaton
+{
+   /// compile patterns, index in automaton is same as index in pattern vector
+   void build( const std::vector<pattern>& vectorPattern );
+
+   static uint8_t fold_s( uint8_t u_ ) { return ( u_ >= 'A' && u_ <= 'Z' ) ? uint8_t( u_ + ( 'a' - 'A' ) ) : u_; }
+
+   std::array<uint8_t, 256> m_arrayClass;       ///< byte class for each byte
+   uint32_t m_uClassCount = 1;                  ///< number of byte classes, row size in transition table
+   std::vector<uint32_t> m_vectorNext;          ///< transition table, state * class count + class
+   std::vector<uint32_t> m_vectorHit;           ///< first state in failure chain (state included) that ends patterns, 0 = none
+   std::vector<uint32_t> m_vectorHitNext;       ///< next state in failure chain after state that ends patterns
+   std::vector<uint32_t> m_vectorMatchBegin;    ///< position in m_vectorMatch for state, one extra at end
+   std::vector<uint32_t> m_vectorMatch;         ///< pattern indexes for patterns ending in state, sorted
+   std::vector<uint32_t> m_vectorLength;        ///< length for each pattern
+   size_t m_uMaxLength = 0;                     ///< longest pattern
+};
+
+void patterns::automaton::build( const std::vector<pattern>& vectorPattern )
+{
+   // ## byte classes, each byte used in pattern (after folding) gets its own class
+   m_arrayClass = { 0 };
+   std::array<uint8_t, 256> arrayUsed = { 0 };
+   for( const auto& it : vectorPattern ) { for( char ch_ : it.get_pattern() ) arrayUsed[fold_s( (uint8_t)ch_ )] = 1; }
+   m_uClassCount = 1;
+   for( unsigned u = 0; u < 256; u++ ) { if( arrayUsed[u] != 0 ) m_arrayClass[u] = (uint8_t)m_uClassCount++; }
+   if( m_uClassCount > 255 ) { for( unsigned u = 0; u < 256; u++ ) m_arrayClass[u] = (uint8_t)u; m_uClassCount = 256; } // all bytes used, no compression
+   for( unsigned u = 'A'; u <= 'Z'; u++ ) m_arrayClass[u] = m_arrayClass[fold_s( (uint8_t)u )];
+
+   // ## trie, state 0 is root and 0 in table is used for missing transition while building
+   const uint32_t uClassCount = m_uClassCount;
+   m_vectorNext.assign( uClassCount, 0 );
+   std::vector< std::vector<uint32_t> > vectorEnd( 1 );                        // patterns ending in state
+   m_vectorLength.assign( vectorPattern.size(), 0 );
+   m_uMaxLength = 0;
+   for( size_t uPattern = 0; uPattern < vectorPattern.size(); uPattern++ )
+   {
+      const std::string& stringPattern = vectorPattern[uPattern].get_pattern();
+      if( stringPattern.empty() == true ) continue;
+      uint32_t uState = 0;
+      for( char ch_ : stringPattern )
+      {
+         uint32_t& uNext = m_vectorNext[uState * uClassCount + m_arrayClass[(uint8_t)ch_]];
+         if( uNext == 0 )
+         {
+            uNext = (uint32_t)vectorEnd.size();
+            vectorEnd.emplace_back();
+            m_vectorNext.resize( m_vectorNext.size() + uClassCount, 0 );     // uNext is invalid after this
+         }
+         uState = m_vectorNext[uState * uClassCount + m_arrayClass[(uint8_t)ch_]];
+      }
+      vectorEnd[uState].push_back( (uint32_t)uPattern );
+      m_vectorLength[uPattern] = (uint32_t)stringPattern.length();
+      m_uMaxLength = std::max( m_uMaxLength, stringPattern.length() );
+   }
+
+   // ## failure links in breadth first order, missing transitions are filled from failure state
+   const size_t uStateCount = vectorEnd.size();
+   std::vector<uint32_t> vectorFail( uStateCount, 0 );
+   m_vectorHit.assign( uStateCount, 0 );
+   m_vectorHitNext.assign( uStateCount, 0 );
+   std::deque<uint32_t> dequeState;
+   for( uint32_t uClass = 0; uClass < uClassCount; uClass++ )
+   {
+      uint32_t uChild = m_vectorNext[uClass];
+      if( uChild != 0 ) dequeState.push_back( uChild );                       // failure for first level is root
+   }
+
+   while( dequeState.empty() == false )
+   {
+      uint32_t uState = dequeState.front();
+      dequeState.pop_front();
+      uint32_t uFail = vectorFail[uState];
+      m_vectorHit[uState] = vectorEnd[uState].empty() == false ? uState : m_vectorHit[uFail];
+      m_vectorHitNext[uState] = m_vectorHit[uFail];
+      for( uint32_t uClass = 0; uClass < uClassCount; uClass++ )
+      {
+         uint32_t& uNext = m_vectorNext[uState * uClassCount + uClass];
+         if( uNext != 0 )
+         {
+            vectorFail[uNext] = m_vectorNext[uFail * uClassCount + uClass];
+            dequeState.push_back( uNext );
+         }
+         else { uNext = m_vectorNext[uFail * uClassCount + uClass]; }
+      }
+   }
+
+   // ## flatten pattern lists
+   m_vectorMatchBegin.assign( uStateCount + 1, 0 );
+   m_vectorMatch.clear();
+   for( size_t u = 0; u < uStateCount; u++ )
+   {
+      m_vectorMatchBegin[u] = (uint32_t)m_vectorMatch.size();
+      m_vectorMatch.insert( m_vectorMatch.end(), vectorEnd[u].begin(), vectorEnd[u].end() );
+   }
+   m_vectorMatchBegin[uStateCount] = (uint32_t)m_vectorMatch.size();
+}
+
 /// @brief Construct patterns with a vector of strings
 patterns::patterns(const std::vector<std::string>& vectorPattern)
 {
@@ -20,14 +128,24 @@ patterns::patterns(const std::vector<std::string>& vectorPattern)
 /// sort vector with patterns based on length and start with the longest pattern
 void patterns::sort()
 {
+   m_pautomaton.reset();                                                       // pattern indexes change, call prepare after sort
+
    std::sort(m_vectorPattern.begin(), m_vectorPattern.end(), [](const pattern& a_, const pattern& b_) {
       return a_.get_pattern().length() > b_.get_pattern().length();
    });
 }
 
-/// prepare marker hint array based on patterns in vector
-void patterns::prepare()
+/// prepare marker hint array based on patterns in vector, automaton is compiled if selected engine use it
+void patterns::prepare(enumEngine eEngine)
 {
+   m_pautomaton.reset();
+   if( eEngine == eEngineAutomaton || ( eEngine == eEngineAuto && m_vectorPattern.size() >= m_uAutomatonMin_s ) )
+   {
+      auto pautomaton = std::make_shared<automaton>();
+      pautomaton->build( m_vectorPattern );
+      m_pautomaton = std::move( pautomaton );
+   }
+
    m_arrayMarkerHint = { 0 };
    for( const auto& it : m_vectorPattern )
    {
@@ -57,6 +175,8 @@ void patterns::prepare()
 /// Finds first pattern in list of internal patterns and if any is found return index to that pattern
 int patterns::find_pattern(const char* piText, size_t uLength, uint64_t* puOffset ) const
 {
+   if( m_pautomaton != nullptr ) return find_automaton_( piText, piText, piText + uLength, puOffset );
+
    decltype( piText ) piTextEnd = piText + uLength;
    for( const auto* p_ = piText; p_ != piTextEnd; p_++ )
    {
@@ -76,6 +196,8 @@ int patterns::find_pattern(const char* piText, size_t uLength, uint64_t* puOffse
 /// Finds first pattern in list of internal patterns and if any is found return index to that pattern
 int patterns::find_pattern(const char* piText, size_t uLength, uint64_t uOffset, uint64_t* puOffset ) const
 {                                                                                                  assert(uLength >= uOffset);
+   if( m_pautomaton != nullptr ) return find_automaton_( piText + uOffset, piText, piText + uLength, puOffset );
+
    const char* piPosition = piText + uOffset;
    decltype( piPosition ) piTextEnd = piText + uLength;
    for( const auto* p_ = piPosition; p_ != piTextEnd; p_++ )
@@ -133,6 +255,52 @@ int patterns::find_(const uint8_t* puPosition, const uint8_t* puBegin, const uin
    return -1;
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Find first pattern with automaton, same result as scanning with marker hint
+ *
+ * Result is the match that starts first and if several patterns match at that
+ * position the one with lowest index. Automaton reports matches where they end so
+ * scan continues until no pattern can start before the best match found.
+ *
+ * @param piPosition position to start search from
+ * @param piBegin start of text, used for word boundary check and returned offset
+ * @param piEnd end of text
+ * @param puOffset receives offset from `piBegin` to match
+ * @return index for pattern found or -1 if no pattern is found
+ */
+int patterns::find_automaton_(const char* piPosition, const char* piBegin, const char* piEnd, uint64_t* puOffset) const
+{                                                                                                  assert( m_pautomaton != nullptr );
+   const automaton& automaton_ = *m_pautomaton;
+   const uint32_t* puNext = automaton_.m_vectorNext.data();
+   const uint32_t uClassCount = automaton_.m_uClassCount;
+
+   int iBest = -1;
+   const uint8_t* puBest = nullptr;
+   const uint8_t* puStop = reinterpret_cast<const uint8_t*>( piEnd );
+   uint32_t uState = 0;
+   for( const uint8_t* pu_ = reinterpret_cast<const uint8_t*>( piPosition ); pu_ < puStop; pu_++ )
+   {
+      uState = puNext[uState * uClassCount + automaton_.m_arrayClass[*pu_]];
+      for( uint32_t uHit = automaton_.m_vectorHit[uState]; uHit != 0; uHit = automaton_.m_vectorHitNext[uHit] )
+      {
+         for( uint32_t u = automaton_.m_vectorMatchBegin[uHit], uEnd = automaton_.m_vectorMatchBegin[uHit + 1]; u < uEnd; u++ )
+         {
+            uint32_t uPattern = automaton_.m_vectorMatch[u];
+            const uint8_t* puStart = pu_ + 1 - automaton_.m_vectorLength[uPattern];
+            if( puBest != nullptr && ( puStart > puBest || ( puStart == puBest && (int)uPattern > iBest ) ) ) continue;
+            if( m_vectorPattern[uPattern].compare( reinterpret_cast<const char*>( puStart ), piBegin ) == false ) continue; // case or word boundary do not match
+
+            puBest = puStart;
+            iBest = (int)uPattern;
+            if( (size_t)( reinterpret_cast<const uint8_t*>( piEnd ) - puBest ) > automaton_.m_uMaxLength ) puStop = puBest + automaton_.m_uMaxLength; // matches ending after this can not start before best
+         }
+      }
+   }
+
+   if( iBest != -1 && puOffset != nullptr ) *puOffset = puBest - reinterpret_cast<const uint8_t*>( piBegin );
+   return iBest;
+}
+
 /** ---------------------------------------------------------------------------
  * @brief Compares a substring of text to the stored pattern, considering case sensitivity and word boundaries as specified by the pattern's flags.
  * @param piText Pointer to the start of the substring in the text to compare against the pattern.
@@ -15,6 +15,7 @@
 #include <array>
 #include <cassert>
 #include <cstring>
+#include <memory>
 #if GD_COMPILER_HAS_CPP20_SUPPORT
 #include <span>
 #endif
@@ -49,6 +50,8 @@ _GD_PARSE_BEGIN
  * - Efficient lookup with character hint array
  * - Support for escaped sequences
  * - Methods to check if text matches any stored pattern
+ * - Large pattern sets are compiled to automaton (Aho-Corasick) in `prepare`, text is
+ *   scanned once for all patterns instead of comparing each pattern at each hint
  */
 class patterns
 {
@@ -59,6 +62,16 @@ public:
       eMatchIgnoreCase = 0x01, ///< matched a pattern
 		eMatchWord = 0x02 ///< matched a whole word
 	};
+
+   /// engine used by `find_pattern`, selected in `prepare`
+   enum enumEngine
+   {
+      eEngineAuto = 0,        ///< automaton when there are `m_uAutomatonMin_s` patterns or more
+      eEngineScan = 1,        ///< check hint for each character and compare patterns in order
+      eEngineAutomaton = 2,   ///< compile patterns to automaton
+   };
+
+   struct automaton;
 public:
    /**
     * @struct pattern
@@ -174,10 +187,12 @@ private:
    void common_construct(const patterns& o) {
        m_vectorPattern = o.m_vectorPattern;
        m_arrayMarkerHint = o.m_arrayMarkerHint;
+       m_pautomaton = o.m_pautomaton;
    }
    void common_construct(patterns&& o) noexcept {
        m_vectorPattern = std::move(o.m_vectorPattern);
        m_arrayMarkerHint = std::move(o.m_arrayMarkerHint);
+       m_pautomaton = std::move(o.m_pautomaton);
    }
 
 // ## operator -----------------------------------------------------------------
@@ -199,16 +214,18 @@ public:
 /** \name OPERATION
 *///@{
    // ## add patterns
-   void add(const pattern& o) { m_vectorPattern.push_back(o); add_marker_hint(o); } ///< add pattern to vector
+   void add(const pattern& o) { m_vectorPattern.push_back(o); add_marker_hint(o); m_pautomaton.reset(); } ///< add pattern to vector
    
    void add(const std::string_view& stringPattern) {
       m_vectorPattern.emplace_back(pattern(stringPattern));
       add_marker_hint(stringPattern[0]);
+      m_pautomaton.reset();
    }
    
    void add(const std::string_view& stringPattern, const std::string_view& stringEscape) {
       m_vectorPattern.emplace_back(pattern(stringPattern, stringEscape));
       add_marker_hint(stringPattern[0]);
+      m_pautomaton.reset();
    }
 
    /// Return pattern string at index
@@ -216,9 +233,12 @@ public:
 
    void sort(); ///< sort vector of patterns based on length
 
-   void prepare(); ///< prepare marker hint array based on patterns in vector
+   void prepare() { prepare(eEngineAuto); } ///< prepare marker hint array based on patterns in vector
+   void prepare(enumEngine eEngine); ///< prepare marker hint array and compile automaton if engine use it
+
+   bool is_automaton() const { return m_pautomaton != nullptr; } ///< check if `find_pattern` use automaton
 
-   void clear() { m_vectorPattern.clear(); m_arrayMarkerHint = { 0 }; } ///< clear vector of patterns
+   void clear() { m_vectorPattern.clear(); m_arrayMarkerHint = { 0 }; m_pautomaton.reset(); } ///< clear vector of patterns
    bool empty() const { return m_vectorPattern.empty(); } ///< check if vector of patterns is empty
    size_t size() const { return m_vectorPattern.size(); } ///< get size of vector of patterns
 
@@ -262,12 +282,16 @@ private:
    int find_(const char* piBegin, const char* piEnd) const { return find_(reinterpret_cast<const uint8_t*>( piBegin ), reinterpret_cast<const uint8_t*>( piEnd ) ); } ///< find pattern in text, not optimized  
    int find_(const uint8_t* puPosition, const uint8_t* puBegin, const uint8_t* puEnd ) const; ///< find pattern in text
    int find_(const char* piPosition, const char* piBegin, const char* piEnd) const { return find_(reinterpret_cast<const uint8_t*>( piPosition ), reinterpret_cast<const uint8_t*>( piBegin ), reinterpret_cast<const uint8_t*>( piEnd )); } ///< find pattern in text
+   int find_automaton_(const char* piPosition, const char* piBegin, const char* piEnd, uint64_t* puOffset) const; ///< find pattern with automaton
 
 // ## attributes ----------------------------------------------------------------
 public:
    /// Characters to look for to investigate if they are part of pattern changing markers
    std::array<uint8_t, 256> m_arrayMarkerHint;
    std::vector<pattern> m_vectorPattern; ///< vector of patterns to use when matching strings
+   std::shared_ptr<const automaton> m_pautomaton; ///< compiled patterns, shared between copies because it is not changed after `prepare`
+
+   inline static size_t m_uAutomatonMin_s = 16; ///< `eEngineAuto` compiles automaton for this many patterns or more
 };
 
 /// set to ignore case for all patterns
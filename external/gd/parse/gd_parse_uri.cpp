@@ -378,8 +378,24 @@ std::pair<std::vector<std::string_view>, gd::argument::arguments> parse_path_and
 {
    std::vector<std::string_view> vectorSegments;
    gd::argument::arguments argumentsQuery;
-   
-   if( stringPathAndQuery.empty() == true ) { return { vectorSegments, argumentsQuery }; }
+   parse_path_and_query( stringPathAndQuery, vectorSegments, argumentsQuery );
+   return { vectorSegments, argumentsQuery };
+}
+
+/** --------------------------------------------------------------------------
+ * \brief Parse path and query string into segments and arguments owned by caller
+ * 
+ * Same as `parse_path_and_query( stringPathAndQuery )`, use this when arguments
+ * has a prepared buffer (stack or arena) to avoid heap allocations.
+ * 
+ * @param stringPathAndQuery The path and query string (e.g., "/path/to/resource?arg=value")
+ * @param vectorSegments Output vector for path segments
+ * @param argumentsQuery Output arguments for query parameters
+ * @return Pair of success flag and error message
+ */
+std::pair<bool, std::string> parse_path_and_query( std::string_view stringPathAndQuery, std::vector<std::string_view>& vectorSegments, gd::argument::arguments& argumentsQuery )
+{
+   if( stringPathAndQuery.empty() == true ) { return { true, "" }; }
    
    const char* piStart = stringPathAndQuery.data(); // start of path and query string
    const char* piEnd = stringPathAndQuery.data() + stringPathAndQuery.size(); // end of path and query string
@@ -417,7 +433,7 @@ std::pair<std::vector<std::string_view>, gd::argument::arguments> parse_path_and
    }
    else { parse_path( stringPathAndQuery, vectorSegments ); }
    
-   return { vectorSegments, argumentsQuery };
+   return { true, "" };
 }
 
 _GD_PARSE_URI_END
@@ -81,6 +81,7 @@ std::pair<bool, std::string> parse_query_from_uri( const ARGUMENTS_IN& arguments
 }
 
 std::pair< std::vector<std::string_view>, gd::argument::arguments > parse_path_and_query( std::string_view stringPathAndQuery );
+std::pair<bool, std::string> parse_path_and_query( std::string_view stringPathAndQuery, std::vector<std::string_view>& vectorSegments, gd::argument::arguments& argumentsQuery );
 
 
 _GD_PARSE_URI_END
@@ -3,6 +3,7 @@
 #include "gd/gd_arguments_shared.h"
 
 #include "gd/gd_arguments_common.h"
+#include "gd/gd_arguments_index.h"
 
 #include "main.h"
 
@@ -140,4 +141,30 @@ TEST_CASE( "[arguments] add shared variables", "[arguments]" ) {
    //AV_["dump"] = stringDump;
 
    //gd::com::pointer
-}
\ No newline at end of file
+}
+
+TEST_CASE( "[arguments] index name lookup", "[arguments]" ) {
+   gd::argument::arguments arguments_;
+   for( int i = 0; i < 50; i++ ) { arguments_.append( "key" + std::to_string( i ), i ); }
+   arguments_.append( "key7", 700 );                                           // duplicate name, first value is found
+
+   gd::argument::arguments_index_t index_( arguments_ );
+   REQUIRE( index_.m_vectorHash.empty() == false );
+   for( int i = 0; i < 50; i++ )
+   {
+      std::string stringName = "key" + std::to_string( i );
+      REQUIRE( arguments_[index_[stringName]].as_int() == i );
+      REQUIRE( index_.get_index( stringName ) == i );
+   }
+   REQUIRE( arguments_[index_["missing"]].is_null() == true );
+
+   gd::argument::shared::arguments argumentsShared;
+   gd::argument::arguments_index_shared_t indexShared;
+   for( int i = 0; i < 20; i++ )
+   {
+      argumentsShared.append( "key" + std::to_string( i ), i );
+      indexShared.build( argumentsShared );                                    // buffer may move, build again after append
+   }
+   REQUIRE( argumentsShared[indexShared["key19"]].as_int() == 19 );
+   REQUIRE( indexShared.exists( "key20" ) == false );
+}
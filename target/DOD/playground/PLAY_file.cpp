@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <memory>
 
 #include "gd/console/gd_console_style.h"
 #include "gd/console/gd_console_print.h"
@@ -6,6 +9,7 @@
 #include "gd/gd_arguments.h"
 #include "gd/gd_variant.h"
 #include "gd/gd_utf8.h"
+#include "gd/gd_parse.h"
 
 #include "Windows.h"
 
@@ -118,3 +122,80 @@ TEST_CASE("Path Methods", "[path]") {
    { path p("test/path"); p.clear(); REQUIRE(p.empty()); }
    { path p("test/path"); std::string result; for (auto it = p.begin(); it != p.end(); ++it) { result += *it; } REQUIRE(path(result) == "test/path"); }
 }
+
+TEST_CASE("[file] count and find characters at block boundaries", "[file]") {
+   // ## text is placed in buffer with exact size, reads past end are found by address sanitizer
+   for( size_t uLength : { 0, 1, 15, 16, 17, 31, 32, 33, 255 * 16, 255 * 16 + 17, 256 * 16 + 5 } )
+   {
+      INFO( "length: " << uLength );
+      std::unique_ptr<char[]> pbszText( new char[uLength + 1] );
+      char* pbszBegin = pbszText.get();
+      char* pbszEnd = pbszBegin + uLength;
+      for( size_t u = 0; u < uLength; u++ ) pbszBegin[u] = u % 3 == 0 ? '\n' : 'a';
+      REQUIRE( gd::parse::count_character_g( pbszBegin, pbszEnd, '\n' ) == (uint64_t)std::count( pbszBegin, pbszEnd, '\n' ) );
+
+      std::fill( pbszBegin, pbszEnd, '\n' );                                  // all match, byte counters are folded before overflow
+      REQUIRE( gd::parse::count_character_g( pbszBegin, pbszEnd, '\n' ) == uLength );
+      REQUIRE( gd::parse::count_character_g( std::string_view( pbszBegin, uLength ), 'a' ) == 0 );
+
+      std::fill( pbszBegin, pbszEnd, 'a' );
+      REQUIRE( gd::parse::next_any_character_or_end_g( pbszBegin, pbszEnd, "/\"" ) == pbszEnd );
+      REQUIRE( gd::parse::next_any_character_or_end_g( pbszBegin, pbszEnd, "" ) == pbszEnd );
+      for( size_t uPosition = 0; uPosition < uLength && uPosition < 40; uPosition++ )
+      {
+         pbszBegin[uPosition] = '"';
+         REQUIRE( gd::parse::next_any_character_or_end_g( pbszBegin, pbszEnd, "/\"" ) == pbszBegin + uPosition );
+         pbszBegin[uPosition] = 'a';
+      }
+      if( uLength > 0 )
+      {
+         pbszEnd[-1] = '/';                                                    // last character, found in tail after blocks
+         REQUIRE( gd::parse::next_any_character_or_end_g( pbszBegin, pbszEnd, "/\"" ) == pbszEnd - 1 );
+      }
+   }
+}
+
+TEST_CASE("[file] map file", "[file]") {
+   std::filesystem::path pathFolder = std::filesystem::temp_directory_path() / "play-file-map";
+   std::filesystem::create_directories( pathFolder );
+
+   auto write_ = [&pathFolder]( uint64_t uSize ) {
+      std::string stringText( uSize, 'x' );
+      for( uint64_t u = 0; u < uSize; u += 7 ) stringText[u] = '\n';
+      std::string stringFile = ( pathFolder / ( std::to_string( uSize ) + ".txt" ) ).string();
+      std::ofstream ofstream_( stringFile, std::ios::binary );
+      ofstream_ << stringText;
+      return std::pair<std::string, std::string>( stringFile, stringText );
+   };
+
+   // ## map limit is a multiple of page size, sizes below and above limit and exact page multiples
+   const uint64_t uLimit = gd::file::map::m_uMapLimit_s;
+   gd::file::map map_;
+   for( uint64_t uSize : { uint64_t(0), uint64_t(1), uint64_t(15), uint64_t(16), uint64_t(17), uLimit - 1, uLimit, uLimit + 17, uLimit * 2, uLimit * 8 } )
+   {
+      INFO( "size: " << uSize );
+      auto [stringFile, stringText] = write_( uSize );
+
+      auto result_ = map_.open( stringFile );                                                        REQUIRE( result_.first == true );
+      REQUIRE( map_.size() == uSize );
+      REQUIRE( map_.string_view() == stringText );
+      REQUIRE( map_.is_mapped() == ( uSize >= uLimit ) );
+      REQUIRE( gd::parse::count_character_g( map_.string_view(), '\n' ) == (uint64_t)std::count( stringText.begin(), stringText.end(), '\n' ) );
+
+      result_ = map_.open( stringFile, gd::file::map::eFlagTerminate );                             REQUIRE( result_.first == true );
+      REQUIRE( map_.string_view() == stringText );
+      REQUIRE( map_.data()[uSize] == '\0' );
+      if( uSize % uLimit == 0 && uSize > 0 ) { REQUIRE( map_.is_mapped() == false ); }             // no space after last page, read into buffer
+
+      map_.close();
+      REQUIRE( map_.empty() == true );
+      REQUIRE( map_.m_uBufferCapacity <= gd::file::map::m_uBufferKeepLimit_s );                   // large buffer is released
+   }
+
+   map_.open( write_( 100 ).first );
+   map_.close();
+   REQUIRE( map_.m_uBufferCapacity > 0 );                                     // small buffer is kept for next file
+
+   REQUIRE( map_.open( ( pathFolder / "missing.txt" ).string() ).first == false );
+   std::filesystem::remove_all( pathFolder );
+}
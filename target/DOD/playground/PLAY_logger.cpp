@@ -2,6 +2,10 @@
 #include <chrono>
 #include <memory>
 #include <ranges>
+#include <filesystem>
+#include <fstream>
+#include <atomic>
+#include <thread>
 
 #include "gd/gd_cli_options.h"
 #include "gd/gd_arguments.h"
@@ -18,6 +22,7 @@
 #include "gd/gd_log_logger_define.h"
 #include "gd/gd_log_logger_printer.h"
 #include "gd/gd_log_logger_printer2.h"
+#include "gd/gd_log_logger_binary.h"
 
 
 using namespace gd::log;
@@ -222,3 +227,205 @@ TEST_CASE( "[logging] extra columns", "[logging]" ) {
 
    LOG_DEBUG_RAW("DEBUG, testing writing number to column?rows=1");
 }
+
+TEST_CASE( "[logging] binary", "[logging]" ) {
+   gd::log::logger<0>* plogger = gd::log::get_s();
+   plogger->clear();
+
+   std::string stringFilePath = mainarguments_g.m_ppbszArgumentValue[0];
+   auto position_ = stringFilePath.find_last_of("\\/");
+   if( position_ != std::string::npos ) { stringFilePath = stringFilePath.substr( 0, position_ + 1 ); }
+   stringFilePath += "binary.glog";
+   std::filesystem::remove( stringFilePath );
+
+   plogger->append( std::make_unique<gd::log::printer_binary>( stringFilePath ) );
+   plogger->set_severity( eSeverityNumberVerbose );
+   plogger->async_start();
+
+   std::string stringName = "name";
+   LOG_DEBUG_BINARY( "{} = {}, {} {{}}", stringName, 10, 2.5 );
+   LOG_DEBUG_BINARY( "no values" );
+   LOG_DEBUG_RAW( "text" );
+   plogger->set_severity( eSeverityNumberWarning );
+   LOG_DEBUG_BINARY( "filtered {}", 1 );
+   plogger->clear();                                                           // stops async and closes file
+
+   std::ifstream ifstreamLog( stringFilePath, std::ios::binary );
+   std::string stringData( ( std::istreambuf_iterator<char>( ifstreamLog ) ), std::istreambuf_iterator<char>() );
+   std::vector<std::string> vectorText;
+   auto result_ = gd::log::binary_decode_g( stringData, [&vectorText]( const auto& record_ ) { vectorText.push_back( record_.m_stringText ); return true; } );
+   REQUIRE( result_.first == true );
+   REQUIRE( vectorText.size() == 3 );
+   REQUIRE( vectorText[0] == "name = 10, 2.5 {}" );
+   REQUIRE( vectorText[1] == "no values" );
+   REQUIRE( vectorText[2] == "text" );
+}
+
+namespace {
+   /// Printer that collects text for printed messages, used to check what async logger prints
+   struct printer_collect : public gd::log::i_printer
+   {
+      bool print( const gd::log::message& message_ ) override
+      {
+         std::lock_guard<std::mutex> lock_( m_mutex );
+         const char* pbszText = message_.get_text();
+         m_vectorText.push_back( pbszText != nullptr ? pbszText : "" );
+         if( m_bLog == true )                                                   // log from consumer thread, like a printer reporting its own errors
+         {
+            m_bLog = false;
+            for( unsigned u = 0; u < 500; u++ ) { plogger->print( gd::log::message( eSeverityError, "from printer" ), false ); }
+         }
+         return true;
+      }
+      size_t size() { std::lock_guard<std::mutex> lock_( m_mutex ); return m_vectorText.size(); }
+
+      std::mutex m_mutex;
+      std::vector<std::string> m_vectorText;
+      bool m_bLog = false;
+   };
+
+   /// Queue where consumer waits in first print until released, used to fill ring buffer
+   struct blocked_queue
+   {
+      blocked_queue( unsigned uOverflow ): m_queue( uOverflow, 4096,
+         [this]( const gd::log::message& message_, unsigned ) {
+            m_bWaiting = true;
+            while( m_bRelease == false ) std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+            m_uPrinted++;
+         },
+         []( const gd::log::binary_view& ) {},
+         []( bool ) {} )
+      {
+         m_queue.push( gd::log::message( eSeverityInformation, "first" ), 0 );
+         while( m_bWaiting == false ) std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+      }
+
+      std::atomic<bool> m_bWaiting{ false };
+      std::atomic<bool> m_bRelease{ false };
+      std::atomic<uint64_t> m_uPrinted{ 0 };
+      gd::log::async_queue m_queue;
+   };
+}
+
+TEST_CASE( "[logging] async ring wraparound", "[logging]" ) {
+   gd::log::async_queue::ring ring_( 4096 );
+   std::vector<std::string> vectorPushed, vectorRead;
+   auto pop_ = [&]() {
+      ring_.pop( [&]( const gd::log::async_queue::record& record_, const char* pbszText ) {
+         if( record_.m_uLength == 0 ) { vectorRead.push_back( "<empty>" ); return; }
+         REQUIRE( std::strlen( pbszText ) == record_.m_uLength - 1 );
+         vectorRead.push_back( pbszText );
+      });
+   };
+
+   // ## messages with different lengths, records are skipped to start when they do not fit at end
+   std::mt19937 random_( 7 );
+   for( unsigned u = 0; u < 2000; u++ )
+   {
+      std::string stringText = std::to_string( u ) + std::string( random_() % 300, 'x' );
+      gd::log::async_queue::record record_{ (uint32_t)stringText.length() + 1, 0, 0, 0, gd::log::async_queue::eRecordText };
+      if( u % 100 == 0 ) { record_.m_uLength = 0; stringText = "<empty>"; }
+      while( ring_.push( record_, stringText.c_str() ) == false ) { pop_(); }
+      vectorPushed.push_back( stringText );
+   }
+   pop_();
+   REQUIRE( vectorRead == vectorPushed );
+   REQUIRE( ring_.size() == 0 );
+   REQUIRE( ring_.m_uHead.load() > 4096 * 50 );                                // wrapped many times
+
+   // ## data in two parts, like deferred messages
+   std::string stringFirst = "12345678", stringSecond( 1500, 's' );
+   gd::log::async_queue::record record_{ (uint32_t)( stringFirst.length() + stringSecond.length() + 1 ), 0, 0, 0, gd::log::async_queue::eRecordBinary };
+   REQUIRE( ring_.push( record_, stringFirst.data(), (uint32_t)stringFirst.length(), stringSecond.data(), (uint32_t)stringSecond.length() ) == true );
+   REQUIRE( ring_.push( record_, stringFirst.data(), (uint32_t)stringFirst.length(), stringSecond.data(), (uint32_t)stringSecond.length() ) == true );
+   REQUIRE( ring_.push( record_, stringFirst.data(), (uint32_t)stringFirst.length(), stringSecond.data(), (uint32_t)stringSecond.length() ) == false ); // full
+   vectorRead.clear();
+   pop_();
+   REQUIRE( vectorRead.size() == 2 );
+   REQUIRE( vectorRead[1] == stringFirst + stringSecond );
+}
+
+TEST_CASE( "[logging] async overflow", "[logging]" ) {
+   using namespace gd::log;
+   const unsigned uCount = 1000;
+
+   SECTION( "drop" ) {
+      blocked_queue blocked_( eOverflowDrop );
+      unsigned uQueued = 0;
+      for( unsigned u = 0; u < uCount; u++ ) { if( blocked_.m_queue.push( message( eSeverityInformation, "drop" ), 0 ) == true ) uQueued++; }
+      REQUIRE( uQueued > 0 );
+      REQUIRE( uQueued < uCount );
+      REQUIRE( blocked_.m_queue.get_dropped() == uCount - uQueued );
+
+      blocked_.m_bRelease = true;
+      blocked_.m_queue.flush();
+      REQUIRE( blocked_.m_uPrinted == 1 + uQueued + 1 );                       // first, queued and message with number of dropped messages
+   }
+
+   SECTION( "sample" ) {
+      blocked_queue blocked_( eOverflowSample );
+      // ## ring has room for 170 messages, above 3/4 (128 messages) only every n:th message is kept
+      unsigned uQueued = 0;
+      for( unsigned u = 0; u < 150; u++ ) { if( blocked_.m_queue.push( message( eSeverityInformation, "sample" ), 0 ) == true ) uQueued++; }
+      REQUIRE( uQueued > 100 );
+      REQUIRE( uQueued < 150 );                                                // ring is not full, drop policy would keep all
+      REQUIRE( blocked_.m_queue.get_dropped() == 150 - uQueued );
+
+      // ### error messages are never sampled or dropped, producer waits for room
+      for( unsigned u = 0; u < uCount; u++ ) { blocked_.m_queue.push( message( eSeverityInformation, "sample" ), 0 ); } // fill ring
+      uint64_t uDropped = blocked_.m_queue.get_dropped();
+      std::thread threadRelease( [&blocked_]() { std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) ); blocked_.m_bRelease = true; } );
+      REQUIRE( blocked_.m_queue.push( message( eSeverityError, "error" ), 0 ) == true );
+      REQUIRE( blocked_.m_bRelease == true );                                  // returned after consumer made room
+      threadRelease.join();
+      REQUIRE( blocked_.m_queue.get_dropped() == uDropped );
+   }
+
+   SECTION( "block" ) {
+      blocked_queue blocked_( eOverflowBlock );
+      std::atomic<unsigned> uQueued{ 0 };
+      std::thread thread_( [&]() { for( unsigned u = 0; u < uCount; u++ ) { blocked_.m_queue.push( message( eSeverityInformation, "block" ), 0 ); uQueued++; } } );
+      std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+      REQUIRE( uQueued < uCount );                                             // producer waits for room
+      blocked_.m_bRelease = true;
+      thread_.join();
+      blocked_.m_queue.flush();
+      REQUIRE( blocked_.m_queue.get_dropped() == 0 );
+      REQUIRE( blocked_.m_uPrinted == 1 + uCount );
+   }
+}
+
+TEST_CASE( "[logging] async flush barrier", "[logging]" ) {
+   plogger->clear();
+   plogger->append( std::make_unique<printer_collect>() );
+   auto* pprinter = (printer_collect*)plogger->get( 0 );
+   plogger->set_severity( eSeverityNumberVerbose );
+   plogger->async_start( gd::log::eOverflowBlock, 4096 );
+
+   // ## all messages logged before flush are printed when flush returns
+   std::vector<std::thread> vectorThread;
+   for( unsigned uThread = 0; uThread < 4; uThread++ )
+   {
+      vectorThread.emplace_back( []() {
+         for( unsigned u = 0; u < 500; u++ ) { plogger->print( gd::log::message( eSeverityInformation, "thread" ), false ); }
+         plogger->flush();
+      });
+   }
+   for( auto& thread_ : vectorThread ) thread_.join();
+   plogger->flush();
+   REQUIRE( pprinter->size() == 2000 );
+
+   // ## printer that logs on consumer thread when its ring is full do not wait for itself
+   pprinter->m_bLog = true;
+   plogger->print( gd::log::message( eSeverityInformation, "log from printer" ), false );
+   plogger->flush();
+   plogger->flush();                                                           // messages from printer are printed in next batch
+   REQUIRE( pprinter->size() > 2001 );
+   REQUIRE( pprinter->size() <= 2001 + 500 + 1 );
+
+   plogger->async_stop();
+   REQUIRE( plogger->is_async() == false );
+   plogger->print( gd::log::message( eSeverityInformation, "sync" ), false );  // printed on calling thread
+   REQUIRE( pprinter->m_vectorText.back() == "sync" );
+   plogger->clear();
+}
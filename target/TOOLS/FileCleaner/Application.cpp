@@ -134,6 +134,7 @@ CApplication::~CApplication()
 {
    m_vectorDocument.clear();                                                  // Clear the document vector
    m_vectorIgnore.clear();                                                    // Clear the ignore vector
+   m_ignorematch.Clear();
    m_vectorProperty.clear();                                                  // Clear the property vector
    m_argumentsFolder.clear();                                                 // Clear the arguments folder
    m_argumentsVersion.clear();                                                // Clear the arguments version
@@ -647,6 +648,8 @@ std::pair<bool, std::string> CApplication::Exit()
    // Example: Clear documents
    DOCUMENT_Clear();
 
+   m_pscheduler.reset();                                                      // stop worker threads
+
    std::string stringArguments = PROPERTY_Get("arguments").as_string();
 
    //HistorySaveArguments_s(stringArguments);
@@ -1638,6 +1641,7 @@ void CApplication::IGNORE_Add(const std::vector<std::string> vectorIgnore)     /
          std::string string_( stringValue );
          std::replace(string_.begin(), string_.end(), '\\', '/');
          m_vectorIgnore.push_back( { uType, string_ } );
+         m_ignorematch.Add( uType, string_ );
       }
    }
 }
@@ -1656,19 +1660,16 @@ void CApplication::IGNORE_AddFolder(const std::string_view& stringFolder)
 
    std::replace(string_.begin(), string_.end(), '\\', '/');
    m_vectorIgnore.push_back( { unsigned(ignore::eTypeFolder), string_ } );
+   m_ignorematch.Add( unsigned(ignore::eTypeFolder), string_ );
 }
 
 /// ---------------------------------------------------------------------------
-/// Checks if the given file path matches any ignore pattern in m_vectorIgnore.
-/// Normalizes the path to use forward slashes. Uses os_fnmatch for pattern matching.
+/// Checks if the given folder path matches any folder ignore rule.
+/// Root is removed from path (compared ignoring case) and each folder name below root is
+/// matched against compiled rules in `m_ignorematch`, see `CIgnoreMatch::MatchFolder`.
 /// Returns true if the path should be ignored, false otherwise.
 bool CApplication::IGNORE_Match(const std::string_view& stringPath, const std::string_view& stringRoot) const
 {                                                                                                  assert(stringPath.empty() == false); // Ensure the path is not empty
-   auto normalize_ = [](std::string s_) -> std::string {
-      std::replace(s_.begin(), s_.end(), '\\', '/');
-      return s_;
-      };
-
    std::string_view stringRoot_ = stringRoot;
 
    if( stringRoot_.empty() == true )
@@ -1676,78 +1677,18 @@ bool CApplication::IGNORE_Match(const std::string_view& stringPath, const std::s
       stringRoot_ = PROPERTY_Get("folder-current").as_string_view(); // if no root is given, use current folder
    }
 
-   /// ## Generate paht that works like the project path
-   //     This is used to match against ignore patterns
-   std::string stringProjectPath;
-   auto uRootLength = stringRoot_.length();
-   if( stringRoot_.back() != '/' && stringRoot_.back() != '\\' ) uRootLength++;
-   if( uRootLength < stringPath.length() )
-   {
-      // covert to lowercase ant match beginning of the path with the root
-      std::string stringPathLower( stringPath );
-      // convert root to lowercase and match beginning of the path with the root
-      std::transform(stringPathLower.begin(), stringPathLower.end(), stringPathLower.begin(), ::tolower);
-
-      std::string stringRootLower(stringRoot_);
-      std::transform(stringRootLower.begin(), stringRootLower.end(), stringRootLower.begin(), ::tolower);
-
-      if( stringPathLower.find(stringRootLower) == 0 )
-      {
-         stringProjectPath = stringPath.substr(uRootLength);                  // remove root from path
-      }
-      else
-      {
-         stringProjectPath = stringPath;                                      // if root is not found in path, use the whole path
-      }
-   }
-   else
-   {
-      stringProjectPath = stringPath;                                         // if root is longer than path, use the whole path
-   }
-
-   stringProjectPath = normalize_(stringProjectPath);                         // normalize path to use forward slashes
-   auto vectorFolder = gd::utf8::split(stringProjectPath, '/'); // split path into parts
-
-   for( const auto& ignore_ : m_vectorIgnore )
-   {
-      std::string_view stringMatch = ignore_;
-
-      if( ignore_.is_folder() == true )
-      {
-         if( ignore_.is_root() == true )
-         {
-            if( vectorFolder[0] == stringMatch ) return true;                  // if root is matched, ignore the path
-         }
-         else
-         {  // match any folder in the path
-            for( const auto& folder_ : vectorFolder )
-            {
-               if( folder_ == stringMatch ) return true;                       // if any part matches, ignore the path
-            }
-         }
-      }
-   }
-   return false;
+   return m_ignorematch.MatchFolder( stringPath, stringRoot_ );
 }
 
 /** ---------------------------------------------------------------------------
- * @brief Checks if the given file name matches any ignore pattern in m_vectorIgnore.
- * Normalizes the file name to use forward slashes. Uses gd::ascii::strcmp for wildcard matching.
+ * @brief Checks if the given file name matches any file ignore rule.
+ * Rules are matched with same wildcard logic as gd::ascii::strcmp, exact names and simple
+ * prefix or suffix rules are found with hash lookups.
  * Returns true if the file name should be ignored, false otherwise.
  */
 bool CApplication::IGNORE_MatchFilename(const std::string_view& stringFileName) const
 {
-   for( const auto& ignore_ : m_vectorIgnore )
-   {
-      if( ignore_.is_file() == true )
-      {
-         std::string_view stringMatch = ignore_;
-         bool bMatch = gd::ascii::strcmp( stringFileName, stringMatch, gd::utf8::tag_wildcard{});
-         if( bMatch == true ) return true;                                  // if file name matches the ignore pattern, ignore the path      }
-      }
-   }
-
-   return false;
+   return m_ignorematch.MatchFile( stringFileName );
 }
 
 
@@ -2337,6 +2278,21 @@ gd::variant_view CApplication::CONFIG_Get( std::string_view stringGroup, const s
 }
 
 
+/** ---------------------------------------------------------------------------
+ * @brief Get scheduler with worker threads used to process files in parallel
+ *
+ * Threads are started on first call and kept until application exits, commands
+ * that process files reuse them instead of starting new threads for each pass.
+ *
+ * @return CScheduler* pointer to scheduler owned by application
+ */
+CScheduler* CApplication::SCHEDULER_Get()
+{
+   std::lock_guard<std::mutex> lock_( m_mutexScheduler );
+   if( m_pscheduler == nullptr ) { m_pscheduler = std::make_unique<CScheduler>( std::thread::hardware_concurrency() ); }
+   return m_pscheduler.get();
+}
+
 /** ---------------------------------------------------------------------------
  * @brief Add error to internal list of errors
  * @param stringError error information
@@ -2491,6 +2447,7 @@ void CApplication::Prepare_s(gd::cli::options& optionsApplication)
       optionsCommand.add({ "rpattern", "Use a **regular expression pattern** to search for more complex text matches within file content."});
       optionsCommand.add({ "ignore", "Folder(s) to ignore searching for files"});
       optionsCommand.add({ "segment", "type of segment in code to search in"});
+      optionsCommand.add({ "cache", "Cache file with counters from earlier runs, files with same size and modified time are not read again"});
       optionsCommand.add({ "page", "Index for page to print and if page-size is not set then default page-size is 10" });
       optionsCommand.add({ "page-size", "Max number of rows in each page" });
       optionsCommand.add({ "sort", "Sorts result on selected column name" });
@@ -54,6 +54,8 @@
 
 #include "application/database/Metadata_Statements.h"
 #include "Document.h"
+#include "IgnoreMatch.h"
+#include "Scheduler.h"
 
 
 #include "application/ApplicationBasic.h"
@@ -315,8 +317,8 @@ public:
 
    // ## @API [tag: ignore] [description: Manage folders in the ignore list]
 
-   void IGNORE_Add( unsigned uType, const std::string_view& stringIgnore ) { m_vectorIgnore.push_back( { uType, std::string( stringIgnore ) } ); }
-   void IGNORE_Add( const std::vector<ignore>& vectorIgnore ) { m_vectorIgnore.insert( m_vectorIgnore.end(), vectorIgnore.begin(), vectorIgnore.end() ); }
+   void IGNORE_Add( unsigned uType, const std::string_view& stringIgnore ) { m_vectorIgnore.push_back( { uType, std::string( stringIgnore ) } ); m_ignorematch.Add( uType, stringIgnore ); }
+   void IGNORE_Add( const std::vector<ignore>& vectorIgnore ) { m_vectorIgnore.insert( m_vectorIgnore.end(), vectorIgnore.begin(), vectorIgnore.end() ); for( const auto& it : vectorIgnore ) m_ignorematch.Add( it.m_uType, it.m_stringIgnore ); }
    void IGNORE_Add( const std::vector<std::string> vectorIgnore );
    void IGNORE_AddFolder(const std::string_view& stringFolder);
 
@@ -330,7 +332,7 @@ public:
    /// Check if ignore list is empty
    bool IGNORE_Empty() const { return m_vectorIgnore.empty(); }
    /// Clear ignore list
-   void IGNORE_Clear() { m_vectorIgnore.clear(); }
+   void IGNORE_Clear() { m_vectorIgnore.clear(); m_ignorematch.Clear(); }
 
 
 
@@ -365,6 +367,11 @@ public:
    std::pair<bool, std::string> HISTORY_SaveCommand(const std::string_view& stringFileLocation);
 //@}
 
+// @API [tag: scheduler] [description: Worker threads shared by commands that process files in parallel]
+
+   /// Get scheduler, worker threads are started on first call
+   CScheduler* SCHEDULER_Get();
+
 // @API [tag: error] [description: Application are able to collect error information, for example doing a larger operation where some tasks fail bit it isn't fatal, then store error in application for later display]
 
 /// Add error to internal list of errors
@@ -397,6 +404,7 @@ public:
    std::vector<std::unique_ptr<CDocument>> m_vectorDocument;
 
    std::vector<ignore> m_vectorIgnore;             ///< Strings with patterns for folders to ignore
+   CIgnoreMatch m_ignorematch;                     ///< rules in `m_vectorIgnore` compiled for matching, updated when rules are added
 
    //std::vector< gd::database::database_i* > m_vectorDatabase; ///< list of connected databases
    //gd::database::database_i* m_pdatabase = nullptr;///< active database connection
@@ -413,6 +421,9 @@ public:
    std::unique_ptr<jsoncons::json> m_pjsonConfig;  ///< JSON configuration object
    std::unique_ptr<gd::table::table> m_ptableConfig; ///< Table used to store configuration data
 
+   std::mutex m_mutexScheduler;                    ///< guards creation of scheduler
+   std::unique_ptr<CScheduler> m_pscheduler;       ///< worker threads used to process files in parallel, created on first use
+
 // ## free functions ------------------------------------------------------------
 public:
    // ## Constants
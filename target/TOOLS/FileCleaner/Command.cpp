@@ -13,6 +13,7 @@
 #include <iterator>
 
 #include "gd/gd_file.h"
+#include "gd/gd_parse.h"
 #include "gd/gd_table_io.h"
 #include "gd/gd_table_aggregate.h"
 #include "gd/gd_utf8.h"
@@ -28,6 +29,8 @@
 #include "automation/code-analysis/Run.h"
 
 #include "Command.h"
+#include "Harvest.h"
+#include "RegexFilter.h"
 
 namespace detail {
 
@@ -194,6 +197,25 @@ namespace detail {
       return true;                                                             // match, return true
    }
 
+   /// file map for each thread, buffer for small files is reused for all files read in thread
+   gd::file::map& file_map()
+   {
+      thread_local gd::file::map map_;
+      return map_;
+   }
+
+   /// get characters that may start a state marker, used to skip text that can not hold markers
+   std::string marker_characters(const gd::expression::parse::state& state_)
+   {
+      std::string stringMarker;
+      const auto& arrayHint = state_.get_marker_hint();
+      for( unsigned u = 0; u < arrayHint.size(); u++ )
+      {
+         if( arrayHint[u] != 0 ) stringMarker += (char)u;
+      }
+      return stringMarker;
+   }
+
 }
 
 
@@ -214,9 +236,10 @@ namespace detail {
   *         - `bool`: `true` if the harvesting was successful, `false` otherwise.
   *         - `std::string`: An empty string on success, or an error message on failure.
   *
-  * @note The method uses `std::filesystem` for directory traversal and file operations.
-  *       If an error occurs during traversal (e.g., permission issues), the method will 
-  *       return `false` along with the error message.
+  * @note Directories are read by worker threads (see `CHarvest`), each worker adds files to its
+  *       own table and these are appended to `ptable_` when done. Row order do not follow the
+  *       directory order. If an error occurs during traversal (e.g., permission issues), the
+  *       method will return `false` along with the error message.
   *
   * @example
   * @code
@@ -268,34 +291,10 @@ std::pair<bool, std::string> FILES_Harvest_g(const gd::argument::arguments& argu
       return { true, "" };
    }
 
-   bool bAddFile = true;
-   // ## Check if this directory matches the path filter (if provided)
-   //    If stringPathFilter is not empty, we need to check if the current directory matches the filter pattern
-
-   if( stringPathFilter.empty() == false )
-   {
-      auto stringDirectory = stringPath;
-               
-      std::replace( stringDirectory.begin(), stringDirectory.end(), '\\', '/' );  // convert to forward slashes for consistency
-
-      // Split string into multiple folder names
-      auto vectorDirectory = gd::utf8::split( stringDirectory, '/' );
-      auto vectorFilter = gd::utf8::split( stringPathFilter, ';' );
-
-      // ## Check if any of the filter patterns match the directory path
-               
-      bool bMatch = false; // flag to indicate if we found a match
-      for( const auto& filter_ : vectorFilter )
-      {
-         for( const auto& directory_ : vectorDirectory )
-         {
-            bMatch = gd::ascii::strcmp( directory_, filter_, gd::utf8::tag_wildcard{} );
-            if( bMatch == true ) { break; } // this part of the path matches the filter, check next part
-         }
-      }
+   CHarvest harvest_( stringWildcard, stringPathFilter, bSize );              // filters are prepared once and shared by all workers
 
-      if( bMatch == false ) bAddFile = false;                                  // no match found for this directory, skip it
-   }
+   // ## Check if this directory matches the path filter (if provided), files are only added from matching directories
+   bool bAddFile = harvest_.IsMatchPathFilter( stringPath );
 
    try
    {
@@ -319,57 +318,6 @@ std::pair<bool, std::string> FILES_Harvest_g(const gd::argument::arguments& argu
             return { false, "Path is not a directory or file: " + stringPath };
          }
       }
-
-      for( const auto& it : std::filesystem::directory_iterator(stringPath) )
-      {
-         if( it.is_directory() == true )                                      // is file directory
-         {
-            // ## Check if we should ignore this directory based on application state and ignore patterns
-
-            if( papplication_g->IsState( CApplication::eApplicationStateCheckIgnoreFolder ) == true )
-            {
-               auto stringDirectory = it.path().string();
-               // convert to forward slashes for consistency
-               std::replace(stringDirectory.begin(), stringDirectory.end(), '\\', '/');
-
-               bool bIgnore = papplication_g->IGNORE_Match( stringDirectory );
-               if( bIgnore == true ) continue;                                // ignore this directory
-            }
-
-            // ## If depth allows, recursively harvest files in this subdirectory
-            if( uDepth > 0 )
-            {
-               std::string stringChildPath = it.path().string();
-               gd::argument::arguments argumentsPath( {{"path", stringChildPath}, {"depth", uDepth - 1}, {"size", bSize}} );
-               if( stringWildcard.empty() == false ) argumentsPath["wildcard"] = stringWildcard;
-               if( stringPathFilter.empty() == false ) argumentsPath["path-filter"] = stringPathFilter;
-               auto [bOk, stringError] = FILES_Harvest_g( argumentsPath, ptable_ );// recursive call to harvest files in subdirectories
-               if( bOk == false ) return { false, stringError };               // error in recursive call
-            }
-         }
-         else
-         {
-            if( it.is_regular_file() == true && bAddFile == true )
-            {
-               try
-               {
-                  gd::file::path path_(it);
-                  if( papplication_g->IsState( CApplication::eApplicationStateCheckIgnoreFile ) == true )
-                  {
-                     std::string string_ = path_.filename().string();
-                     bool bIgnore = papplication_g->IGNORE_MatchFilename( string_ );
-                     if( bIgnore == true ) continue;
-                  }
-
-                  detail::add_file_to_table(path_, stringWildcard, ptable_, bSize);
-               }
-               catch( const std::exception& e )
-               {
-                  papplication_g->ERROR_AddWarning("Error reading file: " + std::string(e.what()));
-               }
-            }
-         }
-      }
    }
    catch( const std::filesystem::filesystem_error& e )
    {
@@ -377,7 +325,18 @@ std::pair<bool, std::string> FILES_Harvest_g(const gd::argument::arguments& argu
       return { false, stringError };
    }
 
-   return { true, "" };
+   // ## Check if we should ignore directories and files based on application state and ignore patterns
+   if( papplication_g->IsState( CApplication::eApplicationStateCheckIgnoreFolder ) == true )
+   {
+      harvest_.m_callbackIgnoreFolder = []( std::string_view stringDirectory ) { return papplication_g->IGNORE_Match( stringDirectory ); };
+   }
+
+   if( papplication_g->IsState( CApplication::eApplicationStateCheckIgnoreFile ) == true )
+   {
+      harvest_.m_callbackIgnoreFile = []( std::string_view stringFileName ) { return papplication_g->IGNORE_MatchFilename( stringFileName ); };
+   }
+
+   return harvest_.Run( stringPath, uDepth, ptable_ );                        // walk directories with worker threads
 }
 
 /** ---------------------------------------------------------------------------
@@ -898,31 +857,13 @@ std::pair<bool, std::string> COMMAND_CountRows(const gd::argument::shared::argum
 {
    std::string stringFile = argumentsPath["source"].as_string();                                   assert(stringFile.empty() == false);
 
-   // ## Open file
-   std::ifstream file_(stringFile, std::ios::binary);
-   if( file_.is_open() == false ) return { false, "Failed to open file: " + stringFile };
-
-   gd::parse::window::line line_(64 * 64, gd::types::tag_create{});           // 64 * 64 = 4096 bytes = 64 cache lines
+   // ## Open file, large files are memory mapped
+   gd::file::map& map_ = detail::file_map();
+   auto result_ = map_.open(stringFile);
+   if( result_.first == false ) return { false, "Failed to open file: " + stringFile };
 
-   // Read the file into the buffer
-   auto uAvailable = line_.available();
-   file_.read((char*)line_.buffer(), uAvailable);  
-   auto uSize = file_.gcount();
-   line_.update(uSize);
-
-   uint64_t uCountNewLine = 0;
-
-   // ## Process the file
-   while(line_.eof() == false)
-   {
-      uCountNewLine += line_.count('\n');                                      // count new lines in buffer
-
-      // ## Rotate the buffer and read more data
-      line_.rotate();                                                          // "rotate" data, move data from end of buffer to start of buffer
-      file_.read((char*)line_.buffer(), line_.available());                    // fill buffer with data from file
-      uSize = file_.gcount();
-      line_.update(uSize);                                                     // update used size of internal buffer
-   }
+   uint64_t uCountNewLine = gd::parse::count_character_g(map_.begin(), map_.end(), '\n'); // count new lines in file
+   map_.close();
 
    argumentsResult.set("count", uCountNewLine);                                // set count of new lines in result
 
@@ -984,12 +925,7 @@ std::pair<bool, std::string> COMMAND_CollectFileStatistics(const gd::argument::s
    // get file from "source" argument
    std::string stringFile = argumentsPath["source"].as_string();                                   assert(stringFile.empty() == false);
 
-   // ### Open file
    if( std::filesystem::is_regular_file(stringFile) == false ) return { false, "File not found: " + stringFile };
-   std::ifstream file_(stringFile, std::ios::binary);
-   if( file_.is_open() == false ) return { false, "Failed to open file: " + stringFile };
-
-   gd::parse::window::line lineBuffer(4096, gd::types::tag_create{});         // create line buffer 64 * 64 = 4096 bytes = 64 cache lines
 
    // ## counters
    //    Lots of counters to count different things in the file, this is not easy to follow so be careful
@@ -1002,8 +938,6 @@ std::pair<bool, std::string> COMMAND_CollectFileStatistics(const gd::argument::s
 
    uint64_t uRowCharacterCodeCount = 0; // number of characters of code in current row (helper variable)
 
-   std::string stringSourceCode;    // gets source code for analysis
-
    gd::expression::parse::state state_; //
    auto result_ = CApplication::PrepareState_s( {{"source",stringFile}}, state_);
    if( result_.first == false ) return result_;                                // error in state preparation
@@ -1011,91 +945,83 @@ std::pair<bool, std::string> COMMAND_CollectFileStatistics(const gd::argument::s
    // if no states are defined, count rows in file
    if( state_.empty() == true ) { return COMMAND_CountRows(argumentsPath, argumentsResult); } 
 
-   // ## Read the file into the buffer
-   auto uAvailable = lineBuffer.available();
-   file_.read((char*)lineBuffer.buffer(), uAvailable);
-   auto uReadSize = file_.gcount();                                           // get number of valid bytes read
-   lineBuffer.update(uReadSize);                                              // Update valid size in line buffer
+   // ### Open file, terminated because marker compare may read past last character
+   gd::file::map& map_ = detail::file_map();
+   result_ = map_.open(stringFile, gd::file::map::eFlagTerminate);
+   if( result_.first == false ) return { false, "Failed to open file: " + stringFile };
 
-   uint8_t uCharacter = 0;                                                    // character to hold current character
+   const char* piPosition = map_.begin();
+   const char* piEnd = map_.end();
+   const std::string stringMarker = detail::marker_characters(state_);        // characters that may start state
 
-   // ## Process the file
-   while(lineBuffer.eof() == false)
-   {
-      uCountNewLine += lineBuffer.count('\n');                                // count all new lines in buffer
+   uCountNewLine = gd::parse::count_character_g(piPosition, piEnd, '\n');    // count all new lines in file
 
-      auto [first_, last_] = lineBuffer.range(gd::types::tag_pair{});
+   // ## count code character, new line ends row and if there are code characters in row it is a code line
+   auto code_ = [&](uint8_t uCharacter) {
+      if( uCharacter == '\n' ) 
+      { 
+         if( uRowCharacterCodeCount ) uCountCodeLines++;                      // count code lines if there are characters in the line
+         uRowCharacterCodeCount = 0;                                          // reset code character count for next line
+      }
+      else if( gd::expression::is_code_g( uCharacter ) != 0 ) 
+      { 
+         uRowCharacterCodeCount++;                                            // count all code characters in line
+         uCountCodeCharacters++;                                              // count all code characters in file
+      }
+   };
 
-      for(auto it = first_; it < last_; it++ ) 
+   // ## Process the file
+   while( piPosition < piEnd )
+   {
+      if( state_.in_state() == false )                                        // not in a state? that means we are reading source code
       {
-         uCharacter = *it;                                                    // get current character
+         // ## skip to next character that may start state, all characters before are code
+         const char* piMarker = gd::parse::next_any_character_or_end_g(piPosition, piEnd, stringMarker);
+         for( ; piPosition < piMarker; piPosition++ ) code_( (uint8_t)*piPosition );
+         if( piPosition == piEnd ) break;
 
-         if( state_.in_state() == false )                                     // not in a state? that means we are reading source code
+         // ## check if we have found state
+         if( state_.exists( piPosition ) == true )
          {
-            // ## check if we have found state
-            if( state_[uCharacter] != 0 && state_.exists( it ) == true )
-            {
-               stringSourceCode.clear();                                      // clear source code
-               auto uLength = state_.activate(it);                            // activate state
-               if( uLength > 1 ) it += ( uLength - 1 );                       // skip to end of state marker and if it is more than 1 character, skip to end of state
+            auto uLength = state_.activate(piPosition);                       // activate state
+            piPosition += std::max<size_t>( uLength, 1 );                     // skip state marker
 
-               
-               // If multiline and `uRowCharacterCodeCount` is not 0 that means that there are characters in the code section before multiline
-               if( uRowCharacterCodeCount > 0 && state_.is_multiline() == false ) 
-               { 
-                  uCountCodeLines++; 
-                  uRowCharacterCodeCount = 0;
-               }
+            // If multiline and `uRowCharacterCodeCount` is not 0 that means that there are characters in the code section before multiline
+            if( uRowCharacterCodeCount > 0 && state_.is_multiline() == false ) 
+            { 
+               uCountCodeLines++; 
+               uRowCharacterCodeCount = 0;
+            }
 
-               // ## check type of state that was activated
+            // ## check type of state that was activated
 #ifndef NDEBUG
-               std::string_view stringState_d = gd::expression::parse::state::get_string_s( state_.get_state() );
+            std::string_view stringState_d = gd::expression::parse::state::get_string_s( state_.get_state() );
 #endif // !NDEBUG
 
-               if( state_.is_comment() == true ) uCountComment++;             // count comment sections
-               else if( state_.is_string() == true ) uCountString++;          // count string sections
-
+            if( state_.is_comment() == true ) uCountComment++;                // count comment sections
+            else if( state_.is_string() == true ) uCountString++;             // count string sections
 
-               continue;
-            }
-
-            stringSourceCode += uCharacter;                                   // add character to source code
-            if( uCharacter == '\n' ) 
-            { 
-               if( uRowCharacterCodeCount ) uCountCodeLines++;                // count code lines if there are characters in the line
-               uRowCharacterCodeCount = 0;                                    // reset code character count for next line
-            }
-            else if( gd::expression::is_code_g( uCharacter ) != 0 ) 
-            { 
-               uRowCharacterCodeCount++;                                      // count all code characters in line
-               uCountCodeCharacters++;                                        // count all code characters in file
-            }
-         }
-         else
-         {
-            // ## check if we have found end of state
-            unsigned uLength;
-            if( state_.deactivate( it, &uLength ) == true ) 
-            {
-               if( uLength > 1 ) it += (uLength - 1);                         // skip to end of state marker and if it is more than 1 character, skip to end of state
-               continue;
-            }
+            continue;
          }
-      }
-
-      lineBuffer.rotate();                                                    // rotate buffer
 
-      if( uReadSize > 0 )                                                     // was it possible to read data last read, then more data is available
+         code_( (uint8_t)*piPosition );
+         piPosition++;
+      }
+      else
       {
-         auto uAvailable = lineBuffer.available();                            // get available space in buffer to be filled
-         file_.read((char*)lineBuffer.buffer(), lineBuffer.available());      // read more data into available space in buffer
-         uReadSize = file_.gcount();
-         lineBuffer.update(uReadSize);                                        // update valid size in line buffer
+         // ## skip to next character that may end state and check if we have found end of state
+         const std::string& stringEnd = state_.get_active_rule().get_end();
+         if( stringEnd.empty() == false ) piPosition = gd::parse::next_any_character_or_end_g(piPosition, piEnd, std::string_view( stringEnd.data(), 1 ));
+         if( piPosition == piEnd ) break;
+
+         unsigned uLength = 0;
+         if( state_.deactivate( piPosition, &uLength ) == true ) piPosition += std::max( uLength, 1u ); // skip end marker
+         else                                                    piPosition++;
       }
-
    }
 
-   if( uCharacter != 0 && uCharacter != '\n' ) uCountNewLine++;               // if last character is not newline, count it as code line
+   if( map_.empty() == false && *(piEnd - 1) != '\n' ) uCountNewLine++;     // if last character is not newline, count it as code line
+   map_.close();
 
    argumentsResult.set("count", uCountNewLine);                               // set count of new lines in result
    argumentsResult.set("code", uCountCodeLines);                              // set count of code lines in result
@@ -1159,46 +1085,44 @@ std::pair<bool, std::string> COMMAND_CollectPatternStatistics(const gd::argument
    if( argumentsPath.exists("word") == true ) { patternsFind.set_word(true); } // Set to match whole words only if specified
 
    patternsFind.sort();                                                       // Sort patterns by length, longest first
-   patternsFind.prepare();
+   patternsFind.prepare();                                                    // many patterns are compiled to automaton
+
+   // ## map sorted pattern index to position in vectorPattern (first equal pattern)
+   std::vector<size_t> vectorCountIndex( patternsFind.size() );
+   for( size_t u = 0; u < patternsFind.size(); u++ )
+   {
+      auto it = std::find( vectorPattern.begin(), vectorPattern.end(), patternsFind.get_pattern( u ).get_pattern() ); assert( it != vectorPattern.end() );
+      vectorCountIndex[u] = std::distance( vectorPattern.begin(), it );
+   }
 
    // ## Prepare source file
    std::string stringFile = argumentsPath["source"].as_string();                                   assert(stringFile.empty() == false);
 
    // ### Open file
    if( std::filesystem::is_regular_file(stringFile) == false ) return { false, "File not found: " + stringFile };
-   std::ifstream file_(stringFile, std::ios::binary);
-   if(file_.is_open() == false) return { false, "Failed to open file: " + stringFile };
-
-   gd::parse::window::line lineBuffer(48 * 64, 64 * 64, gd::types::tag_create{});  // create line buffer 64 * 64 = 4096 bytes = 64 cache lines
 
    gd::expression::parse::state state_; // state is used to check what type of code part we are in
    auto result_ = CApplication::PrepareState_s( {{"source",stringFile}}, state_);
    if( result_.first == false ) return result_;                                // error in state preparation
 
+   gd::file::map& map_ = detail::file_map();
+   result_ = map_.open(stringFile, gd::file::map::eFlagTerminate);            // terminated because marker compare may read past last character
+   if( result_.first == false ) return { false, "Failed to open file: " + stringFile };
+
    // ## count occurrences of each pattern in the source code
-   auto count_ = [&patternsFind, &vectorPattern, &vectorCount](const std::string& stringText) // count method that counts occurrences of each pattern in the source code
+   auto count_ = [&patternsFind, &vectorCountIndex, &vectorCount](std::string_view stringText) // count method that counts occurrences of each pattern in the source code
       {
          // ## Count occurrences of each pattern in text
 
-         const char* piPosition = stringText.c_str();
+         const char* piPosition = stringText.data();
          const char* piEnd = piPosition + stringText.length();
          uint64_t uOffset = 0;
          int64_t iPattern = 0;
          while( (iPattern = patternsFind.find_pattern(piPosition, piEnd, &uOffset)) != -1 ) // find pattern in text
          {
             piPosition += uOffset;                                             // Move to position
-            const std::string_view stringPattern = patternsFind.get_pattern(iPattern);  // get pattern from patternsFind
-
-            ///## find pattern in vector
-            for( auto it = vectorPattern.begin(); it != vectorPattern.end(); it++ ) // find pattern in vector
-            {
-               if( *it == stringPattern )
-               {
-                  vectorCount[std::distance( vectorPattern.begin(), it )]++;
-                  piPosition += stringPattern.length();                        // Move past the current match
-                  break;
-               }
-            }
+            vectorCount[vectorCountIndex[iPattern]]++;
+            piPosition += patternsFind.get_pattern(iPattern).length();         // Move past the current match
          }
       };
 
@@ -1207,94 +1131,90 @@ std::pair<bool, std::string> COMMAND_CollectPatternStatistics(const gd::argument
    vectorCount.clear();                                                        // clear any previous counts
    vectorCount.resize(vectorPattern.size(), 0);
 
-   std::string stringSourceCode; // gets source code for analysis
-   std::string stringText;       // gets text for analysis
+   const char* piPosition = map_.begin();
+   const char* piEnd = map_.end();
+   const char* piSourceCode = piPosition; // start of source code in current row, source code is counted when row ends or state starts
+   const char* piText = piPosition;       // start of text in active state
+   const std::string stringMarker = detail::marker_characters(state_);        // characters that may start state
    uint64_t uRowCharacterCodeCount = 0; // number of characters of code in current row (helper variable)
 
-   // ## Read the file into the buffer
-   auto uAvailable = lineBuffer.available();
-   file_.read((char*)lineBuffer.buffer(), uAvailable);
-   auto uReadSize = file_.gcount();                                           // get number of valid bytes read
-   lineBuffer.update(uReadSize);                                              // Update valid size in line buffer
+   // ## code character, patterns in row are counted when row ends if row has code characters
+   auto code_ = [&](const char* piCharacter) {
+      if( *piCharacter == '\n' ) 
+      { 
+         if( (uRowCharacterCodeCount > 0) && (uFindInState & eStateCode) ) count_(std::string_view(piSourceCode, piCharacter + 1)); // count patterns in source code
+         piSourceCode = piCharacter + 1;
+         uRowCharacterCodeCount = 0;                                          // reset code character count for next line
+      }
+      else if( gd::expression::is_code_g( *piCharacter ) != 0 ) 
+      { 
+         uRowCharacterCodeCount++;                                            // count all code characters in line
+      }
+   };
 
    // ## Process the file
-   while(lineBuffer.eof() == false)
+   while( piPosition < piEnd )
    {
-      auto [first_, last_] = lineBuffer.range(gd::types::tag_pair{});
-
-      for(auto it = first_; it < last_; it++ ) 
+      if( state_.in_state() == false )                                        // not in a state? that means we are reading source code
       {
-         if( state_.in_state() == false )                                     // not in a state? that means we are reading source code
+         // ## go through code up to next character that may start state
+         const char* piMarker = gd::parse::next_any_character_or_end_g(piPosition, piEnd, stringMarker);
+         for( ; piPosition < piMarker; piPosition++ ) code_( piPosition );
+         if( piPosition == piEnd ) break;
+
+         // ## check if we have found state
+         if( state_.exists( piPosition ) == true )
          {
-            // ## check if we have found state
-            if( state_[*it] != 0 && state_.exists( it ) == true )
-            {
-               if( (uRowCharacterCodeCount > 0) && (uFindInState & eStateCode) ) count_(stringSourceCode); // count patterns in source code
-               stringSourceCode.clear();                                      // clear source code
-               auto uLength = state_.activate(it);                            // activate state
-               if( uLength > 1 ) it += ( uLength - 1 );                       // skip to end of state marker and if it is more than 1 character, skip to end of state
+            if( (uRowCharacterCodeCount > 0) && (uFindInState & eStateCode) ) count_(std::string_view(piSourceCode, piPosition)); // count patterns in source code
+            auto uLength = state_.activate(piPosition);                       // activate state
+            piPosition += std::max<size_t>( uLength, 1 );                     // skip state marker
+            piSourceCode = piPosition;
+            piText = piPosition;
 
+            // If multiline and `uRowCharacterCodeCount` is not 0 that means that there are characters in the code section before multiline
+            if( uRowCharacterCodeCount > 0 && state_.is_multiline() == false ) uRowCharacterCodeCount = 0;
 
-               // If multiline and `uRowCharacterCodeCount` is not 0 that means that there are characters in the code section before multiline
-               if( uRowCharacterCodeCount > 0 && state_.is_multiline() == false ) 
-               { 
-                  if( (uRowCharacterCodeCount > 0) && (uFindInState & eStateCode) ) count_(stringSourceCode); // count patterns in source code
-                  stringSourceCode.clear();
-                  uRowCharacterCodeCount = 0;
-               }
+            continue;
+         }
 
-               continue;
-            }
+         code_( piPosition );
+         piPosition++;
+      }
+      else
+      {
+         // ## skip to next character that may end state and check if we have found end of state
+         const std::string& stringEnd = state_.get_active_rule().get_end();
+         if( stringEnd.empty() == false ) piPosition = gd::parse::next_any_character_or_end_g(piPosition, piEnd, std::string_view( stringEnd.data(), 1 ));
+         if( piPosition == piEnd ) break;
 
-            stringSourceCode += *it;                                          // add character to source code
-            if( *it == '\n' ) 
-            { 
-               if( (uRowCharacterCodeCount > 0) && (uFindInState & eStateCode) ) count_(stringSourceCode); // count patterns in source code
-               stringSourceCode.clear();
-               uRowCharacterCodeCount = 0;                                    // reset code character count for next line
-            }
-            else if( gd::expression::is_code_g( *it ) != 0 ) 
-            { 
-               uRowCharacterCodeCount++;                                      // count all code characters in line
-            }
-         }
-         else
+         unsigned uLength = 0;
+         if( state_.deactivate( piPosition, &uLength, gd::expression::parse::state::tag_manual{}) == true ) 
          {
-            stringText += *it;                                                // add character to text for analysis
-            // ## check if we have found end of state
-            unsigned uLength;
-            if( state_.deactivate( it, &uLength, gd::expression::parse::state::tag_manual{}) == true ) 
+            if( uFindInState & (eStateComment|eStateString) )
             {
-               if( uFindInState & (eStateComment|eStateString) )
+               std::string_view stringText(piText, piPosition + 1);           // text in state and first character in end marker
+               if( state_.is_comment() == true && (uFindInState & eStateComment) )
                {
-                  if( state_.is_comment() == true && (uFindInState & eStateComment) )
-                  {
-                     count_(stringText);
-                  }
-                  else if( state_.is_string() == true && ( uFindInState & eStateString ) )
-                  {
-                     count_(stringText);
-                  }
+                  count_(stringText);
+               }
+               else if( state_.is_string() == true && ( uFindInState & eStateString ) )
+               {
+                  count_(stringText);
                }
-               state_.clear_state();                                           // clear state
-               stringText.clear();                                             // clear text for analysis
-               
-               if( uLength > 1 ) it += ( uLength - 1 );                       // skip to end of state marker and if it is more than 1 character, skip to end of state
-               continue;
             }
-         }
-      }
+            state_.clear_state();                                              // clear state
 
-      lineBuffer.rotate();                                                    // rotate buffer
+            piPosition += std::max( uLength, 1u );                             // skip end marker
+            piSourceCode = piPosition;
+            continue;
+         }
 
-      if( uReadSize > 0 )                                                     // was it possible to read data last read, then more data is available
-      {
-         file_.read((char*)lineBuffer.buffer(), lineBuffer.available());      // read more data into available space in buffer
-         uReadSize = file_.gcount();
-         lineBuffer.update(uReadSize);                                        // update valid size in line buffer
+         piPosition++;
       }
    }
 
+   map_.close();
+
    return { true, "" };
 }
 
@@ -1359,10 +1279,12 @@ std::pair<bool, std::string> COMMAND_CollectPatternStatistics(const gd::argument
    auto result_ = CApplication::PrepareState_s( {{"source",stringFile}}, state_);
    if( result_.first == false ) return result_;                                // error in state preparation
 
-   // ## count occurrences of each pattern in the source code
-   auto count_pattern_ = [&vectorRegexPatterns, &vectorCount](const std::string& stringText) -> void {
+   // ## count occurrences of each pattern in the source code, text without literal that regex requires is skipped
+   CRegexFilter filter_( vectorRegexPatterns );
+   auto count_pattern_ = [&vectorRegexPatterns, &vectorCount, &filter_](const std::string& stringText) -> void {
       for(size_t u = 0; u < vectorRegexPatterns.size(); ++u)
       {
+         if( filter_.IsCandidate( u, stringText ) == false ) continue;
          boost::smatch smatch_;
          if(boost::regex_search(stringText, smatch_, vectorRegexPatterns[u].first)) 
          {
@@ -1808,9 +1730,11 @@ std::pair<bool, std::string> COMMAND_ListLinesWithPattern(const gd::argument::sh
    uint64_t uCountNewLine = 0;                                                // counts all new lines in file (all '\n' characters)
 
    // ## find pattern in code using regex, returns index to matched regex in regexPatterns if match, otherwise -1
-   auto find_pattern_ = [&vectorRegexPatterns](const std::string& stringText, uint64_t* puColumn) -> int {
+   CRegexFilter filter_( vectorRegexPatterns );                               // text without literal that regex requires is not passed to regex
+   auto find_pattern_ = [&vectorRegexPatterns, &filter_](const std::string& stringText, uint64_t* puColumn) -> int {
       for(size_t u = 0; u < vectorRegexPatterns.size(); ++u)
       {
+         if( filter_.IsCandidate( u, stringText ) == false ) continue;
          boost::smatch smatch_;
          if(boost::regex_search(stringText, smatch_, vectorRegexPatterns[u].first)) 
          {
@@ -2134,9 +2058,13 @@ std::pair<bool, std::string> COMMAND_FindPattern_g(const std::string& stringCode
          return static_cast<uint64_t>(std::count(stringCode.begin(), stringCode.begin() + pos, '\n'));
       };
 
-      // ## Search for each regex pattern in the entire buffer
-      for(const auto& pattern : vectorRegexPatterns) 
+      // ## Search for each regex pattern in the entire buffer, regex is skipped if buffer is missing literal that regex requires
+      CRegexFilter filter_( vectorRegexPatterns );
+      for(size_t uRegex = 0; uRegex < vectorRegexPatterns.size(); uRegex++) 
       {
+         const auto& pattern = vectorRegexPatterns[uRegex];
+         if( filter_.IsCandidate( uRegex, stringCode ) == false ) continue;
+
          boost::sregex_iterator itRegex(stringCode.begin(),stringCode.end(), pattern.first);
          boost::sregex_iterator itEnd;
 
@@ -2335,9 +2263,13 @@ std::pair<bool, std::string> COMMAND_FindPattern_g(const std::string& stringCode
          return static_cast<uint64_t>(std::count(stringCode.begin(), stringCode.begin() + pos, '\n'));
       };
 
-      // ## Search for each regex pattern in the entire buffer
-      for(const auto& pattern : vectorRegexPatterns) 
+      // ## Search for each regex pattern in the entire buffer, regex is skipped if buffer is missing literal that regex requires
+      CRegexFilter filter_( vectorRegexPatterns );
+      for(size_t uRegex = 0; uRegex < vectorRegexPatterns.size(); uRegex++) 
       {
+         const auto& pattern = vectorRegexPatterns[uRegex];
+         if( filter_.IsCandidate( uRegex, stringCode ) == false ) continue;
+
          boost::sregex_iterator itRegex(stringCode.begin(),stringCode.end(), pattern.first);
          boost::sregex_iterator itEnd;
 
@@ -2443,11 +2375,16 @@ std::pair<bool, std::string> COMMAND_ReadSnippet_g( const std::string& stringCod
 std::pair<bool, std::string> TABLE_AddSumRow(gd::table::dto::table* ptable_, const std::vector<unsigned>& vectorColumnIndex)
 {                                                                                                  assert(ptable_ != nullptr);
    auto uRow = ptable_->get_row_count(); 
+
+   // ## sum all columns in one scan, large tables are split between threads
+   std::vector<gd::table::aggregate_summary> vectorSummary;
+   gd::table::aggregate aggregate_( ptable_ );
+   aggregate_.summary( vectorColumnIndex, 0, uRow, vectorSummary, gd::table::tag_parallel{} );
+
    ptable_->row_add( gd::table::tag_null{} );
-   for( unsigned uColumnIndex : vectorColumnIndex )
-   {                                                                                               assert( uColumnIndex < ptable_->get_column_count() );
-      auto uSum = gd::table::sum<uint64_t>(*ptable_, uColumnIndex, 0, uRow);
-      ptable_->cell_set(uRow, uColumnIndex, uSum, gd::table::tag_convert{});
+   for( size_t u = 0; u < vectorColumnIndex.size(); u++ )
+   {                                                                                               assert( vectorColumnIndex[u] < ptable_->get_column_count() );
+      ptable_->cell_set(uRow, vectorColumnIndex[u], vectorSummary[u].sum<uint64_t>(), gd::table::tag_convert{});
    }
 
    return { true, "" };
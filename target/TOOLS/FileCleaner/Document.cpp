@@ -14,6 +14,7 @@
 #include <mutex>
 #include <shared_mutex>
 #include <thread>
+#include <unordered_map>
 
 #include "pugixml/pugixml.hpp"
 
@@ -29,9 +30,70 @@
 
 #include "Command.h"
 #include "Application.h"
+#include "ScanCache.h"
 
 #include "Document.h"
 
+namespace {
+
+/// Callback returning size for file in row, scheduler use size to place large files first and batch small files
+std::function<uint64_t( uint64_t )> file_size_( const gd::table::dto::table* ptableFile )
+{
+   int iSize = ptableFile->column_find_index("size");
+   if( iSize != -1 ) { return [ptableFile, iSize]( uint64_t uRow ) { return ptableFile->cell_get_variant_view( uRow, (unsigned)iSize ).as_uint64(); }; }
+
+   return [ptableFile]( uint64_t uRow ) -> uint64_t
+   {
+      gd::file::path pathFile;
+      if( ptableFile->column_exists("path") == true ) { pathFile = gd::file::path( ptableFile->cell_get_variant_view(uRow, "path").as_string() ); }
+      else { pathFile = gd::file::path( ptableFile->cell_get_variant_view(uRow, "folder").as_string() ) / ptableFile->cell_get_variant_view(uRow, "filename").as_string(); }
+
+      std::error_code errorcode;
+      auto uSize = std::filesystem::file_size( pathFile.string(), errorcode );
+      return errorcode ? 0 : (uint64_t)uSize;
+   };
+}
+
+/// Number of workers for parallel pass, thread count 0 or above limit returns limit
+unsigned worker_count_( int iThreadCount, unsigned uLimit )
+{
+   if( iThreadCount <= 0 || (unsigned)iThreadCount > uLimit ) return uLimit;
+   return (unsigned)iThreadCount;
+}
+
+/// Full path for file in row, same path is used as key in scan cache
+std::string file_path_( const gd::table::dto::table* ptableFile, uint64_t uRow )
+{
+   gd::file::path pathFile( ptableFile->cell_get_variant_view(uRow, "folder").as_string() );
+   pathFile += ptableFile->cell_get_variant_view(uRow, "filename").as_string();
+   return pathFile.string();
+}
+
+/// Scan cache for section if document has `scan-cache` property with cache file, nullptr if cache is not used
+std::unique_ptr<CScanCache> scan_cache_( CDocument* pdocument, std::string_view stringSection, uint64_t uConfig, unsigned uValueCount )
+{
+   std::string stringPath = pdocument->PROPERTY_Get("scan-cache", gd::variant_view("")).as_string();
+   if( stringPath.empty() == true ) return nullptr;
+
+   auto pscancache = std::make_unique<CScanCache>( stringSection, uConfig, uValueCount );
+   auto result_ = pscancache->Load( stringPath );
+   if( result_.first == false ) { pdocument->ERROR_AddWarning( result_.second ); return nullptr; }
+   return pscancache;
+}
+
+/// Configuration hash for pattern counts, patterns and flags that change the count
+uint64_t pattern_config_( std::string_view stringKind, const std::vector<std::string_view>& vectorPattern, const gd::argument::shared::arguments& argumentsPattern )
+{
+   uint64_t uConfig = CScanCache::Hash_s( stringKind );
+   for( auto stringPattern : vectorPattern ) { uConfig = CScanCache::Hash_s( stringPattern, CScanCache::Hash_s( "\n", uConfig ) ); }
+   uConfig = CScanCache::Hash_s( argumentsPattern["segment"].as_string(), CScanCache::Hash_s( "\nsegment:", uConfig ) );
+   if( argumentsPattern.exists("icase") == true ) uConfig = CScanCache::Hash_s( "\nicase", uConfig );
+   if( argumentsPattern.exists("word") == true ) uConfig = CScanCache::Hash_s( "\nword", uConfig );
+   return uConfig;
+}
+
+}
+
 void CDocument::common_construct(const CDocument& o)
 {
    m_arguments = o.m_arguments;
@@ -322,146 +384,164 @@ std::pair<bool, std::string> CDocument::FILE_FilterBinaries()
  *
  * @note This method assumes that the `COUNT_Row` function is responsible for counting
  *       the rows (lines) in a file and returning the result in the `argumentsResult` object.
+ * @note If document has the `scan-cache` property (cache file) counters for files with same
+ *       size and modified time as in cache are reused, only changed files are read.
  */
 std::pair<bool, std::string> CDocument::FILE_UpdateRowCounters( int iThreadCount )
 {
    auto* ptableFile = CACHE_Get("file");                                                           assert( ptableFile != nullptr );
    auto* ptableFileCount = CACHE_Get("file-count");                                                assert( ptableFileCount != nullptr );
    unsigned uDetailLevel = PROPERTY_Get("detail").as_uint();
+   bool bDetail = CApplication::IsDetailLevel_s( uDetailLevel, "BASIC") == false; // if set to BASIC then only count is calculated
 
    auto uFileCount = ptableFile->get_row_count();                             // Total number of files to process
+   auto* pscheduler = m_papplication->SCHEDULER_Get();
+
+   /// statistics for file, collected by worker and written to file-count table when all files are processed
+   struct file_count
+   {
+      uint64_t m_uRow;                                                         ///< row in file table
+      uint64_t m_uCount;
+      uint64_t m_uCode;
+      uint64_t m_uCharacters;
+      uint64_t m_uComment;
+      uint64_t m_uString;
+      bool m_bDetail;                                                          ///< code, characters, comment and string are set
+      bool m_bState = false;                                                   ///< file type has states, code, characters, comment and string are counted
+      std::string m_stringFile;                                                ///< file path if counters are added to or read from scan cache
+      bool m_bCache = false;                                                   ///< counters are read from scan cache
+      uint64_t m_uSize = 0;                                                    ///< file size for scan cache
+      int64_t m_iTime = 0;                                                     ///< file time for scan cache
+   };
 
-   std::atomic<uint64_t> uAtomicFileIndex(0);  // Current file being processed
-   std::atomic<uint64_t> uAtomicProcessedCount(0); // Count of processed files
-   std::mutex mutexTableCount; // Mutex to protect access to file-count table
-   std::mutex mutexProgress; // Mutex to protect progress updates
-   std::vector<std::string> vectorError; // Collect errors from all threads
-   std::mutex mutexErrors;  // Mutex to protect access to vectorError
+   enum { eCacheCount, eCacheCode, eCacheCharacters, eCacheComment, eCacheString, eCacheState, eCacheValueCount }; // values stored for each file in scan cache
+   std::unique_ptr<CScanCache> pscancache = scan_cache_( this, "count", CScanCache::Hash_s( "count" ), eCacheValueCount );
 
-   // ## Worker function to process files in parallel .........................
-   auto process_ = [&](int iThreadId) -> void
+   std::vector< std::vector<file_count> > vectorResult( pscheduler->Size() ); // results for each worker
+   std::vector< std::vector<std::string> > vectorError( pscheduler->Size() ); // errors for each worker
+
+   // ## Worker function, called for each file ...............................
+   auto process_ = [&]( unsigned uWorker, uint64_t uRowIndex ) -> void
    {
-      while( true )
+      try
       {
-         // Get next file index to process
-         uint64_t uRowIndex = uAtomicFileIndex.fetch_add(1);                  // get thread safe current index and increment it
-         if(uRowIndex >= uFileCount) { break; }
-         
-         try
-         {
-            // STEP 1: Get file info (no mutex needed - ptableFile is read-only)
-            uint64_t uFileKey = ptableFile->cell_get_variant_view(uRowIndex, "key"); // Key for file
-            auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
-            auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
-
-            // STEP 2: Build full file path (no mutex needed)
-            gd::file::path pathFile(stringFolder);
-            pathFile += stringFilename;
-            std::string stringFile = pathFile.string();
+         // STEP 1: Get file info and build full file path (ptableFile is read-only)
+         auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
+         auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
 
-            // STEP 3: Process file statistics (SLOW operation - no mutex needed, thread-safe)
-            gd::argument::shared::arguments argumentsResult;
-            auto result_ = COMMAND_CollectFileStatistics({{"source", stringFile}}, argumentsResult);
+         gd::file::path pathFile(stringFolder);
+         pathFile += stringFilename;
+         std::string stringFile = pathFile.string();
 
-            if(result_.first == false)
+         // STEP 2: Reuse counters from scan cache if file is unchanged (cache is read-only while workers run)
+         uint64_t uSize = 0;
+         int64_t iTime = 0;
+         bool bStat = pscancache != nullptr && CScanCache::Stat_s( stringFile, uSize, iTime ) == true;
+         if( bStat == true )
+         {
+            const uint64_t* puValue = pscancache->Find( stringFile, uSize, iTime );
+            if( puValue != nullptr )
             {
-               std::lock_guard<std::mutex> lockErrors(mutexErrors);
-               vectorError.push_back("File: " + stringFile + " - " + result_.second);
-
-               // Update progress even on failure
-               uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-               if(uProcessed % 10 == 0)
-               {
-                  std::lock_guard<std::mutex> lockProgress(mutexProgress);
-                  uint64_t uPercent = (uProcessed * 100) / uFileCount;
-                  MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Scan files"}, {"sticky", true}});
-               }
-               continue;                                                       // Skip to next file on error
+               bool bState = puValue[eCacheState] != 0;
+               file_count filecount{ uRowIndex, puValue[eCacheCount], puValue[eCacheCode], puValue[eCacheCharacters], puValue[eCacheComment], puValue[eCacheString], bState && bDetail, bState };
+               filecount.m_stringFile = std::move( stringFile );
+               filecount.m_bCache = true;
+               vectorResult[uWorker].push_back( std::move( filecount ) );
+               return;
             }
+         }
 
-            // STEP 4: Update table (FAST operation - mutex needed due to potential reallocation)
-            {
-               std::lock_guard<std::mutex> lockFileCount(mutexTableCount);    // ✅ FIXED: Minimal mutex scope
+         // STEP 3: Process file statistics (SLOW operation)
+         gd::argument::shared::arguments argumentsResult;
+         auto result_ = COMMAND_CollectFileStatistics({{"source", stringFile}}, argumentsResult);
+         if(result_.first == false) { vectorError[uWorker].push_back("File: " + stringFile + " - " + result_.second); return; }
 
-               int64_t iRowIndexCount = -1;                                   // Index for file-count table, -1 means not found
+         // STEP 4: Store result in worker list, table is updated after all files are processed
+         file_count filecount{ uRowIndex, argumentsResult["count"].as_uint64(), 0, 0, 0, 0, false };
+         if(argumentsResult["code"].is_null() == false)
+         {
+            filecount.m_uCode = argumentsResult["code"].as_uint64();
+            filecount.m_uCharacters = argumentsResult["characters"].as_uint64();
+            filecount.m_uComment = argumentsResult["comment"].as_uint64();
+            filecount.m_uString = argumentsResult["string"].as_uint64();
+            filecount.m_bDetail = bDetail;
+            filecount.m_bState = true;
+         }
+         if( bStat == true ) { filecount.m_stringFile = std::move( stringFile ); filecount.m_uSize = uSize; filecount.m_iTime = iTime; }
+         vectorResult[uWorker].push_back( std::move( filecount ) );
+      }
+      catch(const std::exception& exception_)
+      {
+         vectorError[uWorker].push_back(std::string("Thread ") + std::to_string(uWorker) + " error: " + exception_.what());
+      }
+   };
 
-               // Check if file key exists in file-count table
-               for(auto itRowCount = ptableFileCount->begin(); itRowCount != ptableFileCount->end(); ++itRowCount)
-               {
-                  uint64_t uFKFileKey = itRowCount.cell_get_variant_view("file-key");
-                  if(uFKFileKey == uFileKey) 
-                  { 
-                     iRowIndexCount = itRowCount.get_row(); 
-                     break;                                                   // Found matching key
-                  }
-               }
+   auto progress_ = [this]( uint64_t uDone, uint64_t uTotal ) { MESSAGE_Progress("", {{"percent", (uDone * 100) / uTotal}, {"label", "Scan files"}, {"sticky", true}}); };
 
-               // Add new row if doesn't exist
-               if(iRowIndexCount == -1)
-               {
-                  iRowIndexCount = ptableFileCount->get_row_count();
-                  ptableFileCount->row_add(gd::table::tag_null{});           // Can cause reallocation
-                  ptableFileCount->cell_set(iRowIndexCount, "key", uint64_t(iRowIndexCount + 1));
-                  ptableFileCount->cell_set(iRowIndexCount, "file-key", uFileKey);
-                  ptableFileCount->cell_set(iRowIndexCount, "filename", stringFilename);
-               }
+   // ## Run files in scheduler, limit to 8 threads for performance and resource management
+   pscheduler->Run( uFileCount, file_size_( ptableFile ), process_, progress_, worker_count_( iThreadCount, 8 ) );
 
-               // Update the statistics in the file-count table
-               uint64_t uCount = argumentsResult["count"].as_uint64();
-               ptableFileCount->cell_set(iRowIndexCount, "count", uCount);
+   MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
 
-               // Update additional statistics if available
-               // Detail level check because if set to BASIC then only count is calculated
-               if(argumentsResult["code"].is_null() == false && CApplication::IsDetailLevel_s( uDetailLevel, "BASIC") == false)                  
-               {
-                  ptableFileCount->cell_set(iRowIndexCount, "code", argumentsResult["code"].as_uint64());
-                  ptableFileCount->cell_set(iRowIndexCount, "characters", argumentsResult["characters"].as_uint64());
-                  ptableFileCount->cell_set(iRowIndexCount, "comment", argumentsResult["comment"].as_uint64());
-                  ptableFileCount->cell_set(iRowIndexCount, "string", argumentsResult["string"].as_uint64());
-               }
-            }
+   // ## Merge worker results into file-count table ...........................
 
-            // Update progress (thread-safe)
-            uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-            if(uProcessed % 10 == 0)                                           // Show progress every 10 files
-            {
-               std::lock_guard<std::mutex> lockProgress(mutexProgress);
-               uint64_t uPercent = (uProcessed * 100) / uFileCount;
-               MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Scan files"}, {"sticky", true}});
-            }
-         }
-         catch(const std::exception& exception_)
-         {
-            std::lock_guard<std::mutex> lockErrors(mutexErrors);
-            vectorError.push_back(std::string("Thread ") + std::to_string(iThreadId) + " error: " + exception_.what());
-         }      
-      }
-   };
+   std::vector<file_count> vectorCount;
+   for( auto& vector_ : vectorResult ) { vectorCount.insert( vectorCount.end(), vector_.begin(), vector_.end() ); }
+   std::sort( vectorCount.begin(), vectorCount.end(), []( const file_count& c1, const file_count& c2 ) { return c1.m_uRow < c2.m_uRow; } ); // same order as file table
 
-   // ## Prepare and run threads ..............................................
-
-   if( iThreadCount <= 0 ) { iThreadCount = std::thread::hardware_concurrency(); } // Use hardware concurrency if no thread count is specified
-   if(iThreadCount <= 0) { iThreadCount = 1; }                                 // Fallback to single thread if hardware_concurrency returns 0
-   if( iThreadCount > 8 ) { iThreadCount = 8; }                                // Limit to 8 threads for performance and resource management
+   std::unordered_map<uint64_t, uint64_t> mapRow;                             // file key -> row in file-count table
+   for(auto itRowCount = ptableFileCount->begin(); itRowCount != ptableFileCount->end(); ++itRowCount)
+   {
+      mapRow.emplace( itRowCount.cell_get_variant_view("file-key").as_uint64(), itRowCount.get_row() );
+   }
 
-   // Create and launch worker threads
-   std::vector<std::thread> vectorCountThread;
-   vectorCountThread.reserve(iThreadCount);
+   for( const auto& filecount : vectorCount )
+   {
+      uint64_t uFileKey = ptableFile->cell_get_variant_view(filecount.m_uRow, "key").as_uint64();
 
-   for(int i = 0; i < iThreadCount; ++i) { vectorCountThread.emplace_back(process_, i); }
+      uint64_t uRowIndexCount;
+      auto itRow = mapRow.find( uFileKey );
+      if( itRow != mapRow.end() ) { uRowIndexCount = itRow->second; }
+      else                                                                     // Add new row if doesn't exist
+      {
+         uRowIndexCount = ptableFileCount->get_row_count();
+         ptableFileCount->row_add(gd::table::tag_null{});
+         ptableFileCount->cell_set(uRowIndexCount, "key", uint64_t(uRowIndexCount + 1));
+         ptableFileCount->cell_set(uRowIndexCount, "file-key", uFileKey);
+         ptableFileCount->cell_set(uRowIndexCount, "filename", ptableFile->cell_get_variant_view(filecount.m_uRow, "filename"));
+         mapRow.emplace( uFileKey, uRowIndexCount );
+      }
 
-   // Wait for all threads to complete
-   for(auto& threadWorker : vectorCountThread) { threadWorker.join(); }       // Wait for all threads to complete
+      ptableFileCount->cell_set(uRowIndexCount, "count", filecount.m_uCount);
+      if( filecount.m_bDetail == true )
+      {
+         ptableFileCount->cell_set(uRowIndexCount, "code", filecount.m_uCode);
+         ptableFileCount->cell_set(uRowIndexCount, "characters", filecount.m_uCharacters);
+         ptableFileCount->cell_set(uRowIndexCount, "comment", filecount.m_uComment);
+         ptableFileCount->cell_set(uRowIndexCount, "string", filecount.m_uString);
+      }
+   }
 
-   MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
+   // ## Add counters for files that were read to scan cache ..................
 
-   // ### Handle any collected errors
-   if(!vectorError.empty())
+   if( pscancache != nullptr )
    {
-      for(const auto& stringError : vectorError)
+      for( const auto& filecount : vectorCount )
       {
-         ERROR_Add(stringError);
+         if( filecount.m_stringFile.empty() == true ) continue;                // file information is missing
+         if( filecount.m_bCache == true ) { pscancache->Keep( filecount.m_stringFile ); continue; } // only folders for scanned files are pruned
+         const uint64_t puValue[eCacheValueCount] = { filecount.m_uCount, filecount.m_uCode, filecount.m_uCharacters, filecount.m_uComment, filecount.m_uString, (uint64_t)filecount.m_bState };
+         pscancache->Set( filecount.m_stringFile, filecount.m_uSize, filecount.m_iTime, puValue );
       }
+
+      auto result_ = pscancache->Save();
+      if( result_.first == false ) { ERROR_AddWarning( result_.second ); }
+   }
+
+   // ### Handle any collected errors
+   for( const auto& vector_ : vectorError )
+   {
+      for(const auto& stringError : vector_) { ERROR_Add(stringError); }
    }
 
    return { true, "" };
@@ -476,19 +556,20 @@ std::pair<bool, std::string> CDocument::FILE_UpdateRowCounters( int iThreadCount
  *
  * @param argumentsPattern Arguments for pattern collection (e.g., segment specification)
  * @param vectorPattern A vector of strings representing the patterns to search for.
- *                      The vector must not be empty and can contain a maximum of 64 patterns.
+ *                      The vector must not be empty, large pattern sets are compiled to automaton.
  * @param iThreadCount Number of threads to use (0 = auto-detect)
  * @return A pair containing:
  *         - `bool`: `true` if the operation was successful, `false` otherwise.
  *         - `std::string`: An empty string on success, or an error message on failure.
  *
- * @pre The `vectorPattern` must not be empty and must contain fewer than 64 patterns.
+ * @pre The `vectorPattern` must not be empty.
  * @post The "file-pattern" cache table is updated with the pattern counts for each file.
  *
  * @note COMMAND_CollectPatternStatistics must be thread-safe.
+ * @note Counts are reused from scan cache (`scan-cache` property) for unchanged files if patterns and flags are the same.
  */
 std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::argument::shared::arguments& argumentsPattern, const std::vector<std::string>& vectorPattern, int iThreadCount)
-{                                                                                                  assert( vectorPattern.empty() == false ); assert( vectorPattern.size() < 64 ); // max 64 patterns
+{                                                                                                  assert( vectorPattern.empty() == false );
    using namespace gd::table::dto;
    constexpr unsigned uTableStyle = (table::eTableFlagNull64|table::eTableFlagRowStatus);
    // file-pattern table: key | file-key | folder | filename | pattern1 | pattern2 | ...
@@ -525,107 +606,88 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::arg
       ptableFilePattern->cell_set( u, "filename", ptableFile->cell_get_variant_view(u, "filename") );
    }
 
-   std::atomic<uint64_t> uAtomicFileIndex(0);                                 // Current file being processed
-   std::atomic<uint64_t> uAtomicProcessedCount(0);                            // Count of processed files
-   std::mutex mutexProgress;                                                  // Mutex to protect progress updates
-   std::vector<std::string> vectorError;                                      // Collect errors from all threads
-   std::mutex mutexErrors;                                                    // Mutex to protect access to vectorError
+   auto* pscheduler = m_papplication->SCHEDULER_Get();
+   const size_t uPatternCount = vectorPattern.size();
+   std::vector<uint8_t> vectorDone( uFileCount, 0 );                          // set for files that are counted, 2 if counted and added to scan cache, 3 if read from scan cache
 
-   // ## Worker function to process files in parallel .........................
-   auto process_ = [&](int iThreadId) -> void
-   {
-      std::vector<uint64_t> vectorCount;                                      // Thread-local vector for pattern counts
-      
-      while( true )
-      {
-         // Get next file index to process
-         uint64_t uRowIndex = uAtomicFileIndex.fetch_add(1);                  // get thread safe current index and increment it
-         if(uRowIndex >= uFileCount) { break; }
-         
-         try
-         {
-            // ## STEP 1: Get file info (no mutex needed - ptableFile is read-only)
-            auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
-            auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
-
-            // ## STEP 2: Build full file path (no mutex needed)
-            gd::file::path pathFile(stringFolder);
-            pathFile += stringFilename;
-            std::string stringFile = pathFile.string();
-
-            // ## STEP 3: Process pattern statistics (SLOW operation - no mutex needed, thread-safe)
-            gd::argument::shared::arguments argumentsPattern_({ {"source", stringFile} });
-            if( argumentsPattern.exists("segment") == true ) { argumentsPattern_.set("segment", argumentsPattern["segment"].as_string_view()); } // set the segment (code, comment, string) to search in
-            argumentsPattern_.append(argumentsPattern,{ "icase", "word" }); // set the patterns to search for
-
-            auto result_ = COMMAND_CollectPatternStatistics( argumentsPattern_, vectorPattern, vectorCount );
-
-            if(result_.first == false)
-            {
-               std::lock_guard<std::mutex> lockErrors(mutexErrors);
-               vectorError.push_back("File: " + stringFile + " - " + result_.second);
+   // ## Set counts for file, rows are allocated before workers start and each worker only writes to the row for its file (columns 0-3 are key, file-key, folder, filename)
+   auto set_count_ = [ptableFilePattern, uPatternCount]( uint64_t uRowIndex, const uint64_t* puCount, size_t uCount ) {
+      for( unsigned u = 0; u < uPatternCount; u++ ) { ptableFilePattern->cell_set( uRowIndex, u + 4, u < uCount ? puCount[u] : uint64_t(0) ); }
+   };
 
-               // Update progress even on failure
-               uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-               if(uProcessed % 10 == 0)
-               {
-                  std::lock_guard<std::mutex> lockProgress(mutexProgress);
-                  uint64_t uPercent = (uProcessed * 100) / uFileCount;
-                  MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Pattern scan"}, {"sticky", true}});
-               }
-               continue;                                                       // Skip to next file on error
-            }
+   auto pscancache = scan_cache_( this, "pattern", pattern_config_( "pattern", std::vector<std::string_view>( vectorPattern.begin(), vectorPattern.end() ), argumentsPattern ), (unsigned)uPatternCount );
+   std::vector< std::pair<uint64_t, int64_t> > vectorStat( pscancache != nullptr ? uFileCount : 0 ); // file size and time for files added to scan cache
+   std::vector< std::vector<std::string> > vectorError( pscheduler->Size() ); // errors for each worker
 
-            // ## STEP 4: Update table (FAST operation - no mutex needed, pre-allocated memory)
-            for( unsigned u = 0; u < vectorCount.size(); u++ )
-            {
-               ptableFilePattern->cell_set(uRowIndex, u + 4, vectorCount[u]); // set pattern count in table (columns 0-3 are key, file-key, folder, filename)
-            }
+   // ## Worker function, called for each file ...............................
+   auto process_ = [&]( unsigned uWorker, uint64_t uRowIndex ) -> void
+   {
+      try
+      {
+         // ## STEP 1: Get file info and build full file path (ptableFile is read-only)
+         auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
+         auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
 
-            // Clear counts for next iteration
-            std::fill(vectorCount.begin(), vectorCount.end(), 0);
+         gd::file::path pathFile(stringFolder);
+         pathFile += stringFilename;
+         std::string stringFile = pathFile.string();
 
-            // Update progress (thread-safe)
-            uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-            if(uProcessed % 10 == 0)                                           // Show progress every 10 files
-            {
-               std::lock_guard<std::mutex> lockProgress(mutexProgress);
-               uint64_t uPercent = (uProcessed * 100) / uFileCount;
-               MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Pattern scan"}, {"sticky", true}});
-            }
-         }
-         catch(const std::exception& exception_)
+         // ## STEP 2: Reuse counts from scan cache if file is unchanged
+         uint64_t uSize = 0;
+         int64_t iTime = 0;
+         bool bStat = pscancache != nullptr && CScanCache::Stat_s( stringFile, uSize, iTime ) == true;
+         if( bStat == true )
          {
-            std::lock_guard<std::mutex> lockErrors(mutexErrors);
-            vectorError.push_back(std::string("Thread ") + std::to_string(iThreadId) + " error: " + exception_.what());
-         }      
+            const uint64_t* puValue = pscancache->Find( stringFile, uSize, iTime );
+            if( puValue != nullptr ) { set_count_( uRowIndex, puValue, uPatternCount ); vectorDone[uRowIndex] = 3; return; }
+            vectorStat[uRowIndex] = { uSize, iTime };
+         }
+
+         // ## STEP 3: Process pattern statistics (SLOW operation)
+         gd::argument::shared::arguments argumentsPattern_({ {"source", stringFile} });
+         if( argumentsPattern.exists("segment") == true ) { argumentsPattern_.set("segment", argumentsPattern["segment"].as_string_view()); } // set the segment (code, comment, string) to search in
+         argumentsPattern_.append(argumentsPattern,{ "icase", "word" }); // set the patterns to search for
+         std::vector<uint64_t> vectorCount;
+         auto result_ = COMMAND_CollectPatternStatistics( argumentsPattern_, vectorPattern, vectorCount );
+         if(result_.first == false) { vectorError[uWorker].push_back("File: " + stringFile + " - " + result_.second); return; }
+
+         // ## STEP 4: Store counts in row for file
+         set_count_( uRowIndex, vectorCount.data(), vectorCount.size() );
+         vectorDone[uRowIndex] = bStat == true ? 2 : 1;
+      }
+      catch(const std::exception& exception_)
+      {
+         vectorError[uWorker].push_back(std::string("Thread ") + std::to_string(uWorker) + " error: " + exception_.what());
       }
    };
 
-   // ## Prepare and run threads ..............................................
+   auto progress_ = [this]( uint64_t uDone, uint64_t uTotal ) { MESSAGE_Progress("", {{"percent", (uDone * 100) / uTotal}, {"label", "Pattern scan"}, {"sticky", true}}); };
 
-   if( iThreadCount <= 0 ) { iThreadCount = std::thread::hardware_concurrency(); } // Use hardware concurrency if no thread count is specified
-   if(iThreadCount <= 0) { iThreadCount = 1; }                                 // Fallback to single thread if hardware_concurrency returns 0
-   if( iThreadCount > 8 ) { iThreadCount = 8; }                                // Limit to 8 threads for performance and resource management
-
-   // Create and launch worker threads
-   std::vector<std::thread> vectorPatternThread;
-   vectorPatternThread.reserve(iThreadCount);
-
-   for(int i = 0; i < iThreadCount; ++i) { vectorPatternThread.emplace_back(process_, i); }
-
-   // Wait for all threads to complete
-   for(auto& threadWorker : vectorPatternThread) { threadWorker.join(); }
+   // ## Run files in scheduler, limit to 8 threads for performance and resource management
+   pscheduler->Run( uFileCount, file_size_( ptableFile ), process_, progress_, worker_count_( iThreadCount, 8 ) );
 
    MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
 
-   // ### Handle any collected errors
-   if(!vectorError.empty())
+   if( pscancache != nullptr )
    {
-      for(const auto& stringError : vectorError)
+      // ## Add counted files to scan cache, counts are read from the file-pattern table
+      std::vector<uint64_t> vectorCount_( uPatternCount );
+      for( uint64_t uRow = 0; uRow < uFileCount; uRow++ )
       {
-         ERROR_AddWarning(stringError);
+         if( vectorDone[uRow] == 3 ) { pscancache->Keep( file_path_( ptableFile, uRow ) ); continue; } // only folders for scanned files are pruned
+         if( vectorDone[uRow] != 2 ) continue;
+         for( unsigned u = 0; u < uPatternCount; u++ ) { vectorCount_[u] = ptableFilePattern->cell_get_variant_view( uRow, u + 4 ).as_uint64(); }
+         pscancache->Set( file_path_( ptableFile, uRow ), vectorStat[uRow].first, vectorStat[uRow].second, vectorCount_.data() );
       }
+
+      auto result_ = pscancache->Save();
+      if( result_.first == false ) { ERROR_AddWarning( result_.second ); }
+   }
+
+   // ### Handle any collected errors
+   for( const auto& vector_ : vectorError )
+   {
+      for(const auto& stringError : vector_) { ERROR_AddWarning(stringError); }
    }
 
    return { true, "" };
@@ -650,6 +712,7 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::arg
  * @post The `file-pattern` table is created and populated with pattern counters.
  *
  * @note COMMAND_CollectPatternStatistics must be thread-safe.
+ * @note Counts are reused from scan cache (`scan-cache` property) for unchanged files if patterns and flags are the same.
  */
 std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::argument::shared::arguments& argumentsPattern, const std::vector< std::pair<boost::regex, std::string> >& vectorRegexPatterns, int iThreadCount)
 {                                                                                                  assert( vectorRegexPatterns.empty() == false ); assert( vectorRegexPatterns.size() < 64 ); // max 64 patterns
@@ -688,110 +751,89 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::arg
       ptableFilePattern->cell_set( u, "filename", ptableFile->cell_get_variant_view(u, "filename") );
    }
 
-   std::atomic<uint64_t> uAtomicFileIndex(0);                                 // Current file being processed
-   std::atomic<uint64_t> uAtomicProcessedCount(0);                           // Count of processed files
-   //std::mutex mutexTablePattern;                                              // Mutex to protect access to file-pattern table
-   std::mutex mutexProgress;                                                  // Mutex to protect progress updates
-   std::vector<std::string> vectorError;                                     // Collect errors from all threads
-   std::mutex mutexErrors;                                                    // Mutex to protect access to vectorError
-
-   // ## Worker function to process files in parallel .........................
-   auto process_ = [&](int iThreadId) -> void
-   {
-      std::vector<uint64_t> vectorCount;                                      // Thread-local vector for pattern counts
-      
-      while( true )
-      {
-         // Get next file index to process
-         uint64_t uRowIndex = uAtomicFileIndex.fetch_add(1);                  // get thread safe current index and increment it
-         if(uRowIndex >= uFileCount) { break; }
-         
-         try
-         {
-            // ## STEP 1: Get file info (no mutex needed - ptableFile is read-only)
-            auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
-            auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
+   auto* pscheduler = m_papplication->SCHEDULER_Get();
+   const size_t uPatternCount = vectorRegexPatterns.size();
+   std::vector<uint8_t> vectorDone( uFileCount, 0 );                          // set for files that are counted, 2 if counted and added to scan cache, 3 if read from scan cache
 
-            // ## STEP 2: Build full file path (no mutex needed)
-            gd::file::path pathFile(stringFolder);
-            pathFile += stringFilename;
-            std::string stringFile = pathFile.string();
+   // ## Set counts for file, rows are allocated before workers start and each worker only writes to the row for its file (columns 0-3 are key, file-key, folder, filename)
+   auto set_count_ = [ptableFilePattern, uPatternCount]( uint64_t uRowIndex, const uint64_t* puCount, size_t uCount ) {
+      for( unsigned u = 0; u < uPatternCount; u++ ) { ptableFilePattern->cell_set( uRowIndex, u + 4, u < uCount ? puCount[u] : uint64_t(0) ); }
+   };
 
-            // ## STEP 3: Process pattern statistics (SLOW operation - no mutex needed, thread-safe)
-            gd::argument::shared::arguments argumentsPattern_(argumentsPattern);  // Copy base arguments
-            argumentsPattern_.set("source", stringFile);
-            
-            auto result_ = COMMAND_CollectPatternStatistics( argumentsPattern_, vectorRegexPatterns, vectorCount );
+   std::vector<std::string_view> vectorPatternText;
+   for( const auto& it : vectorRegexPatterns ) { vectorPatternText.push_back( it.second ); }
+   auto pscancache = scan_cache_( this, "rpattern", pattern_config_( "rpattern", vectorPatternText, argumentsPattern ), (unsigned)uPatternCount );
+   std::vector< std::pair<uint64_t, int64_t> > vectorStat( pscancache != nullptr ? uFileCount : 0 ); // file size and time for files added to scan cache
+   std::vector< std::vector<std::string> > vectorError( pscheduler->Size() ); // errors for each worker
 
-            if(result_.first == false)
-            {
-               std::lock_guard<std::mutex> lockErrors(mutexErrors);
-               vectorError.push_back("File: " + stringFile + " - " + result_.second);
+   // ## Worker function, called for each file ...............................
+   auto process_ = [&]( unsigned uWorker, uint64_t uRowIndex ) -> void
+   {
+      try
+      {
+         // ## STEP 1: Get file info and build full file path (ptableFile is read-only)
+         auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
+         auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
 
-               // Update progress even on failure
-               uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-               if(uProcessed % 10 == 0)
-               {
-                  std::lock_guard<std::mutex> lockProgress(mutexProgress);
-                  uint64_t uPercent = (uProcessed * 100) / uFileCount;
-                  MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Pattern scan"}, {"sticky", true}});
-               }
-               continue;                                                       // Skip to next file on error
-            }
+         gd::file::path pathFile(stringFolder);
+         pathFile += stringFilename;
+         std::string stringFile = pathFile.string();
 
-            // ## STEP 4: Update table (FAST operation - mutex needed for thread safety)
-            {
-               // ### Update pattern counters in the file-pattern table
-               for( unsigned u = 0; u < vectorCount.size(); u++ )
-               {
-                  ptableFilePattern->cell_set(uRowIndex, u + 4, vectorCount[u]); // set pattern count in table (columns 0-3 are key, file-key, folder, filename)
-               }
-            }
+         // ## STEP 2: Reuse counts from scan cache if file is unchanged
+         uint64_t uSize = 0;
+         int64_t iTime = 0;
+         bool bStat = pscancache != nullptr && CScanCache::Stat_s( stringFile, uSize, iTime ) == true;
+         if( bStat == true )
+         {
+            const uint64_t* puValue = pscancache->Find( stringFile, uSize, iTime );
+            if( puValue != nullptr ) { set_count_( uRowIndex, puValue, uPatternCount ); vectorDone[uRowIndex] = 3; return; }
+            vectorStat[uRowIndex] = { uSize, iTime };
+         }
 
-            // Clear counts for next iteration
-            std::fill(vectorCount.begin(), vectorCount.end(), 0);
+         // ## STEP 3: Process pattern statistics (SLOW operation)
+         gd::argument::shared::arguments argumentsPattern_(argumentsPattern);  // Copy base arguments
+         argumentsPattern_.set("source", stringFile);
+         std::vector<uint64_t> vectorCount;
+         auto result_ = COMMAND_CollectPatternStatistics( argumentsPattern_, vectorRegexPatterns, vectorCount );
+         if(result_.first == false) { vectorError[uWorker].push_back("File: " + stringFile + " - " + result_.second); return; }
 
-            // Update progress (thread-safe)
-            uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-            if(uProcessed % 10 == 0)                                           // Show progress every 10 files
-            {
-               std::lock_guard<std::mutex> lockProgress(mutexProgress);
-               uint64_t uPercent = (uProcessed * 100) / uFileCount;
-               MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Pattern scan"}, {"sticky", true}});
-            }
-         }
-         catch(const std::exception& exception_)
-         {
-            std::lock_guard<std::mutex> lockErrors(mutexErrors);
-            vectorError.push_back(std::string("Thread ") + std::to_string(iThreadId) + " error: " + exception_.what());
-         }      
+         // ## STEP 4: Store counts in row for file
+         set_count_( uRowIndex, vectorCount.data(), vectorCount.size() );
+         vectorDone[uRowIndex] = bStat == true ? 2 : 1;
+      }
+      catch(const std::exception& exception_)
+      {
+         vectorError[uWorker].push_back(std::string("Thread ") + std::to_string(uWorker) + " error: " + exception_.what());
       }
    };
 
-   // ## Prepare and run threads ..............................................
-
-   if( iThreadCount <= 0 ) { iThreadCount = std::thread::hardware_concurrency(); } // Use hardware concurrency if no thread count is specified
-   if( iThreadCount <= 0) { iThreadCount = 1; }                               // Fallback to single thread if hardware_concurrency returns 0
-   if( iThreadCount > 8 ) { iThreadCount = 8; }                               // Limit to 8 threads for performance and resource management
+   auto progress_ = [this]( uint64_t uDone, uint64_t uTotal ) { MESSAGE_Progress("", {{"percent", (uDone * 100) / uTotal}, {"label", "Pattern scan"}, {"sticky", true}}); };
 
-   // Create and launch worker threads
-   std::vector<std::thread> vectorPatternThread;
-   vectorPatternThread.reserve(iThreadCount);
-
-   for(int i = 0; i < iThreadCount; ++i) { vectorPatternThread.emplace_back(process_, i); }
-
-   // Wait for all threads to complete
-   for(auto& threadWorker : vectorPatternThread) { threadWorker.join(); }
+   // ## Run files in scheduler, limit to 8 threads for performance and resource management
+   pscheduler->Run( uFileCount, file_size_( ptableFile ), process_, progress_, worker_count_( iThreadCount, 8 ) );
 
    MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
 
-   // ### Handle any collected errors
-   if(!vectorError.empty())
+   if( pscancache != nullptr )
    {
-      for(const auto& stringError : vectorError)
+      // ## Add counted files to scan cache, counts are read from the file-pattern table
+      std::vector<uint64_t> vectorCount_( uPatternCount );
+      for( uint64_t uRow = 0; uRow < uFileCount; uRow++ )
       {
-         ERROR_AddWarning(stringError);
+         if( vectorDone[uRow] == 3 ) { pscancache->Keep( file_path_( ptableFile, uRow ) ); continue; } // only folders for scanned files are pruned
+         if( vectorDone[uRow] != 2 ) continue;
+         for( unsigned u = 0; u < uPatternCount; u++ ) { vectorCount_[u] = ptableFilePattern->cell_get_variant_view( uRow, u + 4 ).as_uint64(); }
+         pscancache->Set( file_path_( ptableFile, uRow ), vectorStat[uRow].first, vectorStat[uRow].second, vectorCount_.data() );
       }
+
+      auto result_ = pscancache->Save();
+      if( result_.first == false ) { ERROR_AddWarning( result_.second ); }
+   }
+
+   // ### Handle any collected errors
+   for( const auto& vector_ : vectorError )
+   {
+      for(const auto& stringError : vector_) { ERROR_AddWarning(stringError); }
    }
 
    return { true, "" };
@@ -806,7 +848,7 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::arg
  * in the "file-linelist" cache table. The method uses multithreading to process files in parallel.
  *
  * @param vectorPattern A vector of strings representing the patterns to search for.
- *                      The vector must not be empty and can contain a maximum of 64 patterns.
+ *                      The vector must not be empty, large pattern sets are compiled to automaton.
  * @param argumentsList Arguments for pattern processing (e.g., segment specification, max lines)
  * @param argumentsList.icase If present, the pattern matching will ignore case.
  * @param argumentsList.word If present, the pattern matching will only match whole words.
@@ -818,14 +860,13 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternCounters(const gd::arg
  *         - `bool`: `true` if the operation was successful, `false` otherwise.
  *         - `std::string`: An empty string on success, or an error message on failure.
  *
- * @pre The `vectorPattern` must not be empty and must contain fewer than 64 patterns.
+ * @pre The `vectorPattern` must not be empty.
  * @post The "file-linelist" cache table is updated with the lines where the patterns are found.
  *
  * @note COMMAND_ListLinesWithPattern must be thread-safe.
  */
 std::pair<bool, std::string> CDocument::FILE_UpdatePatternList(const std::vector<std::string>& vectorPattern, const gd::argument::shared::arguments& argumentsList, int iThreadCount)
 {                                                                                                  assert(vectorPattern.empty() == false); // Ensure the pattern list is not empty
-                                                                                                   assert(vectorPattern.size() < 64);      // Ensure the pattern list contains fewer than 64 patterns
    using namespace gd::table;
    
    // ## Prepare pattern list for searching ...................................
@@ -850,127 +891,78 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternList(const std::vector
    uint64_t uMax = argumentsList["max"].as_uint64();                          // Get the maximum number of lines to process
    auto uFileCount = ptableFile->get_row_count();                             // Total number of files to process
 
-   // ## Thread synchronization variables
-
-   std::atomic<uint64_t> uAtomicFileIndex(0);                                 // Current file being processed
-   std::atomic<uint64_t> uAtomicProcessedCount(0);                            // Count of processed files
-   std::atomic<uint64_t> uAtomicTotalLines(0);                                // Total lines found across all threads
-   std::mutex mutexLineList;                                                  // Mutex to protect ptableLineList access
-   std::vector<std::string> vectorError;                                      // Collect errors from all threads
-   std::mutex mutexErrors;                                                    // Mutex to protect access to vectorError
+   auto* pscheduler = m_papplication->SCHEDULER_Get();
+   std::atomic<uint64_t> uAtomicTotalLines(0);                                // Total lines found across all workers
+   std::vector< std::vector<std::string> > vectorError( pscheduler->Size() ); // errors for each worker
 
-   // ## Prepare columns for line list table 
-   detail::columns* pcolumnsThread = new detail::columns{};                   // Columns for thread-local tables, columns are reference counted and deleted automatically when no longer used, ref count reach 0
+   // ## Prepare thread-local tables, results are appended to main table after all files are processed
+   detail::columns* pcolumnsThread = new detail::columns{};                   // Columns for worker tables, columns are reference counted and deleted automatically when no longer used, ref count reach 0
    ptableLineList->to_columns( *pcolumnsThread );
 
-   // ## Worker function to process files in parallel .........................
-   auto process_ = [&](int iThreadId) -> void
+   std::vector< std::unique_ptr<table> > vectorLineListLocal;
+   for( unsigned u = 0; u < pscheduler->Size(); u++ ) { vectorLineListLocal.push_back( std::make_unique<table>(pcolumnsThread, 10, ptableLineList->get_flags(), 10) ); }
+
+   // ## Worker function, called for each file ...............................
+   auto process_ = [&]( unsigned uWorker, uint64_t uRowIndex ) -> void
    {
-      // Create thread-local table for collecting results
-      std::unique_ptr<table> ptableLineListLocal = std::make_unique<table>(pcolumnsThread, 10, ptableLineList->get_flags(), 10); // Create local table with 10 rows pre-allocated
-      
-      while( true )
+      table* ptableLineListLocal = vectorLineListLocal[uWorker].get();
+      std::string stringFile;
+      try
       {
-         // Get next file index to process
-         uint64_t uRowIndex = uAtomicFileIndex.fetch_add(1);                  // get thread safe current index and increment it
-         if(uRowIndex >= uFileCount) {  break; }
-         
-         try
+         // STEP 1: Get full path to file
+         if( ptableFile->column_exists("path") == true )
          {
-            gd::file::path pathFile;
-            std::string stringFile;
-
-            // STEP 1: 
-            if( ptableFile->column_exists("path") == true )
-            {
-               stringFile = ptableFile->cell_get_variant_view(uRowIndex, "path").as_string();
-            }
-            else
-            {
-               auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
-               auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
-
-               // STEP 2: Build full file path
-               pathFile = gd::file::path(stringFolder) / stringFilename;
-               stringFile = pathFile.string();
-            }
-
-            auto uKey = ptableFile->cell_get_variant_view(uRowIndex, "key").as_uint64();
-
-            // STEP 3: Find lines with patterns 
-            gd::argument::shared::arguments arguments_({ {"source", stringFile}, {"file-key", uKey} }); assert(stringFile.empty() == false && "need to full path to file");
-            if( stringSegment.empty() == false ) arguments_.set("segment", stringSegment.data()); // Set the segment (code, comment, string) to search in
-            
-            auto result_ = COMMAND_ListLinesWithPattern(arguments_, patternsFind, ptableLineListLocal.get()); // Find lines with patterns and update the local table, ptableLineListLocal is thread-local
-
-            if(result_.first == false)
-            {
-               std::lock_guard<std::mutex> lockErrors(mutexErrors);
-               vectorError.push_back("File: " + stringFile + " - " + result_.second);
+            stringFile = ptableFile->cell_get_variant_view(uRowIndex, "path").as_string();
+         }
+         else
+         {
+            auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
+            auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
+            stringFile = ( gd::file::path(stringFolder) / stringFilename ).string();
+         }
 
-               // Update progress even on failure
-               uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-               if(uProcessed % 10 == 0)
-               {
-                  uint64_t uPercent = (uProcessed * 100) / uFileCount;
-                  MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Find in files"}, {"sticky", true}});
-               }
-               continue;                                                       // Skip to next file on error
-            }
+         auto uKey = ptableFile->cell_get_variant_view(uRowIndex, "key").as_uint64();
 
-            // STEP 4: Append results to main table (FAST operation - mutex needed for thread safety)
-            {
-               std::lock_guard<std::mutex> lockLineList(mutexLineList);
-               ptableLineList->append(ptableLineListLocal.get());              // Append the results from the local table to the main table
+         // STEP 2: Find lines with patterns, lines are added to worker table
+         gd::argument::shared::arguments arguments_({ {"source", stringFile}, {"file-key", uKey} }); assert(stringFile.empty() == false && "need to full path to file");
+         if( stringSegment.empty() == false ) arguments_.set("segment", stringSegment.data()); // Set the segment (code, comment, string) to search in
 
-               // Update total line count and check if we've exceeded the maximum
-               uint64_t uCurrentLines = uAtomicTotalLines.fetch_add(ptableLineListLocal->get_row_count()) + ptableLineListLocal->get_row_count();
-               if(uMax > 0 && uCurrentLines > uMax )                           // if max amount of hits is reached, signal other threads to stop processing
-               {
-                  uAtomicFileIndex.store(uFileCount);                          // Signal other threads to stop by setting file index to max
-               }
-            }
-            
-            ptableLineListLocal->row_clear();                                  // Clear local table rows for next iteration
+         uint64_t uRowOffset = ptableLineListLocal->get_row_count();
+         auto result_ = COMMAND_ListLinesWithPattern(arguments_, patternsFind, ptableLineListLocal);
+         if(result_.first == false) { vectorError[uWorker].push_back("File: " + stringFile + " - " + result_.second); return; }
 
-            // Update progress (thread-safe)
-            uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;
-            if(uProcessed % 10 == 0)                                           // Show progress every 10 files
-            {
-               uint64_t uPercent = (uProcessed * 100) / uFileCount;
-               MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Find in files"}, {"sticky", true}});
-            }
-         }
-         catch(const std::exception& exception_)
-         {
-            std::lock_guard<std::mutex> lockErrors(mutexErrors);
-            vectorError.push_back(std::string("Thread ") + std::to_string(iThreadId) + " error: " + exception_.what());
-         }      
+         // STEP 3: Check if max amount of hits is reached, remaining files are skipped
+         uint64_t uFound = ptableLineListLocal->get_row_count() - uRowOffset;
+         uint64_t uCurrentLines = uAtomicTotalLines.fetch_add(uFound, std::memory_order_relaxed) + uFound;
+         if( uMax > 0 && uCurrentLines > uMax ) { pscheduler->Cancel(); }
+      }
+      catch(const std::exception& exception_)
+      {
+         vectorError[uWorker].push_back(std::string("Thread ") + std::to_string(uWorker) + " error: " + exception_.what());
       }
    };
 
-   // ## Prepare and run threads ..............................................
+   auto progress_ = [this]( uint64_t uDone, uint64_t uTotal ) { MESSAGE_Progress("", {{"percent", (uDone * 100) / uTotal}, {"label", "Find in files"}, {"sticky", true}}); };
 
-   if( iThreadCount <= 0 ) { iThreadCount = std::thread::hardware_concurrency(); } // Use hardware concurrency if no thread count is specified
-   if( iThreadCount <= 0) { iThreadCount = 1; }                              // Fallback to single thread if hardware_concurrency returns 0
-   if( iThreadCount > 6 ) { iThreadCount = 6; }                              // Limit to 6 threads for performance and resource management
-   if( ptableFile->size() < iThreadCount ) { iThreadCount = (int)ptableFile->size(); } // Limit threads to number of files
+   // ## Run files in scheduler, limit to 6 threads for performance and resource management
+   pscheduler->Run( uFileCount, file_size_( ptableFile ), process_, progress_, worker_count_( iThreadCount, 6 ) );
 
-   // Create and launch worker threads
-   std::vector<std::thread> vectorPatternThread;
-   vectorPatternThread.reserve(iThreadCount);
-
-   for(int i = 0; i < iThreadCount; ++i) { vectorPatternThread.emplace_back(process_, i); }
+   MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
 
-   // Wait for all threads to complete
-   for(auto& threadWorker : vectorPatternThread) { threadWorker.join(); }
+   // ## Append worker tables to main table, key is set to row number in main table
+   uint64_t uFirstRow = ptableLineList->get_row_count();
+   for( auto& ptableLineListLocal : vectorLineListLocal ) { ptableLineList->append( ptableLineListLocal.get() ); }
 
-   MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
+   int iKeyColumn = ptableLineList->column_find_index("key");
+   if( iKeyColumn != -1 )
+   {
+      for( uint64_t uRow = uFirstRow; uRow < ptableLineList->get_row_count(); uRow++ ) { ptableLineList->cell_set( uRow, (unsigned)iKeyColumn, uRow + 1 ); }
+   }
 
    // ### Handle any collected errors
-   if(!vectorError.empty())
+   for( const auto& vector_ : vectorError )
    {
-      for(const auto& stringError : vectorError) { ERROR_AddWarning(stringError); }
+      for(const auto& stringError : vector_) { ERROR_AddWarning(stringError); }
    }
 
    return {true, ""};
@@ -1013,127 +1005,78 @@ std::pair<bool, std::string> CDocument::FILE_UpdatePatternList(const std::vector
    uint64_t uMax = argumentsList["max"].as_uint64();                          // Get the maximum number of lines to be printed
    auto uFileCount = ptableFile->get_row_count();                             // Total number of files to process
 
-   // ## Thread synchronization variables
+   auto* pscheduler = m_papplication->SCHEDULER_Get();
+   std::atomic<uint64_t> uAtomicTotalLines(0);                                // Total lines found across all workers
+   std::vector< std::vector<std::string> > vectorError( pscheduler->Size() ); // errors for each worker
 
-   std::atomic<uint64_t> uAtomicFileIndex(0);                                 // Current file being processed
-   std::atomic<uint64_t> uAtomicProcessedCount(0);                            // Count of processed files
-   std::atomic<uint64_t> uAtomicTotalLines(0);                                // Total lines found across all threads
-   //std::mutex mutexProgress;                                                  // Mutex to protect progress updates
-   std::mutex mutexLineList;                                                  // Mutex to protect ptableLineList access
-   std::vector<std::string> vectorError;                                      // Collect errors from all threads
-   std::mutex mutexErrors;                                                    // Mutex to protect access to vectorError
-
-   // ## Prepare columns for line list table 
-   detail::columns* pcolumnsThread = new detail::columns{};
+   // ## Prepare thread-local tables, results are appended to main table after all files are processed
+   detail::columns* pcolumnsThread = new detail::columns{};                   // Columns for worker tables, columns are reference counted and deleted automatically when no longer used, ref count reach 0
    ptableLineList->to_columns( *pcolumnsThread );
 
+   std::vector< std::unique_ptr<table> > vectorLineListLocal;
+   for( unsigned u = 0; u < pscheduler->Size(); u++ ) { vectorLineListLocal.push_back( std::make_unique<table>(pcolumnsThread, 10, ptableLineList->get_flags(), 10) ); }
 
-   // ## Worker function to process files in parallel .........................
-   auto process_ = [&](int iThreadId) -> void
+   // ## Worker function, called for each file ...............................
+   auto process_ = [&]( unsigned uWorker, uint64_t uRowIndex ) -> void
    {
-      // Create thread-local table for collecting results
-      std::unique_ptr<table> ptableLineListLocal = std::make_unique<table>(pcolumnsThread, 10, ptableLineList->get_flags(), 10); // Create local table with 10 rows pre-allocated
-      
-      while( true )
+      table* ptableLineListLocal = vectorLineListLocal[uWorker].get();
+      std::string stringFile;
+      try
       {
-         uint64_t uRowIndex = uAtomicFileIndex.fetch_add(1);                  // get thread safe current index and increment it
-         if(uRowIndex >= uFileCount) { break; }
-         
-         try
+         // STEP 1: Get full path to file
+         if( ptableFile->column_exists("path") == true )
          {
-            gd::file::path pathFile;
-            std::string stringFile;
-
-            // STEP 1: 
-            if(ptableFile->column_exists("path") == true)
-            {
-               stringFile = ptableFile->cell_get_variant_view(uRowIndex, "path").as_string();
-            }
-            else
-            {
-               auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
-               auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
-
-               // STEP 2: Build full file path
-               pathFile = gd::file::path(stringFolder) / stringFilename;
-               stringFile = pathFile.string();
-            }
-
-            auto uKey = ptableFile->cell_get_variant_view(uRowIndex, "key").as_uint64();
-
-            // STEP 3: Find lines with regex patterns 
-            gd::argument::shared::arguments arguments_({{"source", stringFile}, {"file-key", uKey}});
-            if( stringSegment.empty() == false ) arguments_.set("segment", stringSegment.data()); // Set the segment (code, comment, string) to search in
-            
-            auto result_ = COMMAND_ListLinesWithPattern(arguments_, vectorRegexPatterns, ptableLineListLocal.get()); // Find lines with regex patterns and update the local table
-
-            if(result_.first == false)
-            {
-               std::lock_guard<std::mutex> lockErrors(mutexErrors);
-               vectorError.push_back("File: " + stringFile + " - " + result_.second);
+            stringFile = ptableFile->cell_get_variant_view(uRowIndex, "path").as_string();
+         }
+         else
+         {
+            auto stringFolder = ptableFile->cell_get_variant_view(uRowIndex, "folder").as_string();
+            auto stringFilename = ptableFile->cell_get_variant_view(uRowIndex, "filename").as_string();
+            stringFile = ( gd::file::path(stringFolder) / stringFilename ).string();
+         }
 
-               uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;   // Update progress even on failure
-               if(uProcessed % 10 == 0)
-               {
-                  uint64_t uPercent = (uProcessed * 100) / uFileCount;
-                  MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Find in files"}, {"sticky", true}});
-               }
-               continue;                                                       // Skip to next file on error
-            }
+         auto uKey = ptableFile->cell_get_variant_view(uRowIndex, "key").as_uint64();
 
-            // STEP 4: Append results to main table (FAST operation - mutex needed for thread safety)
-            {
-               std::lock_guard<std::mutex> lockLineList(mutexLineList);
-               ptableLineList->append(ptableLineListLocal.get());              // Append the results from the local table to the main table
+         // STEP 2: Find lines with patterns, lines are added to worker table
+         gd::argument::shared::arguments arguments_({ {"source", stringFile}, {"file-key", uKey} }); assert(stringFile.empty() == false && "need to full path to file");
+         if( stringSegment.empty() == false ) arguments_.set("segment", stringSegment.data()); // Set the segment (code, comment, string) to search in
 
-               // Update total line count and check if we've exceeded the maximum
-               uint64_t uCurrentLines = uAtomicTotalLines.fetch_add(ptableLineListLocal->get_row_count()) + ptableLineListLocal->get_row_count();
-               if (uMax > 0 && uCurrentLines > uMax)                           // if max amount of hits is reached, signal other threads to stop processing
-               {
-                  uAtomicFileIndex.store(uFileCount);                          // Signal other threads to stop by setting file index to max
-               }
-            }
-            
-            ptableLineListLocal->row_clear();                                  // Clear local table rows for next iteration
+         uint64_t uRowOffset = ptableLineListLocal->get_row_count();
+         auto result_ = COMMAND_ListLinesWithPattern(arguments_, vectorRegexPatterns, ptableLineListLocal);
+         if(result_.first == false) { vectorError[uWorker].push_back("File: " + stringFile + " - " + result_.second); return; }
 
-            uint64_t uProcessed = uAtomicProcessedCount.fetch_add(1) + 1;      // Update progress (thread-safe)
-            if(uProcessed % 10 == 0)                                           // Show progress every 10 files
-            {
-               //std::lock_guard<std::mutex> lockProgress(mutexProgress);
-               uint64_t uPercent = (uProcessed * 100) / uFileCount;
-               MESSAGE_Progress("", {{"percent", uPercent}, {"label", "Find in files"}, {"sticky", true}});
-            }
-         }
-         catch(const std::exception& exception_)
-         {
-            std::lock_guard<std::mutex> lockErrors(mutexErrors);
-            vectorError.push_back(std::string("Thread ") + std::to_string(iThreadId) + " error: " + exception_.what());
-         }      
+         // STEP 3: Check if max amount of hits is reached, remaining files are skipped
+         uint64_t uFound = ptableLineListLocal->get_row_count() - uRowOffset;
+         uint64_t uCurrentLines = uAtomicTotalLines.fetch_add(uFound, std::memory_order_relaxed) + uFound;
+         if( uMax > 0 && uCurrentLines > uMax ) { pscheduler->Cancel(); }
+      }
+      catch(const std::exception& exception_)
+      {
+         vectorError[uWorker].push_back(std::string("Thread ") + std::to_string(uWorker) + " error: " + exception_.what());
       }
    };
 
-   // ## Prepare and run threads ..............................................
-
-   if( iThreadCount <= 0 ) { iThreadCount = std::thread::hardware_concurrency(); } // Use hardware concurrency if no thread count is specified
-   if(iThreadCount <= 0) { iThreadCount = 1; }                                 // Fallback to single thread if hardware_concurrency returns 0
-   if( iThreadCount > 6 ) { iThreadCount = 6; }                                // Limit to 6 threads for performance and resource management
-   if( ptableFile->size() < iThreadCount ) { iThreadCount = (int)ptableFile->size(); } // Limit threads to number of files
+   auto progress_ = [this]( uint64_t uDone, uint64_t uTotal ) { MESSAGE_Progress("", {{"percent", (uDone * 100) / uTotal}, {"label", "Find in files"}, {"sticky", true}}); };
 
-   // Create and launch worker threads
-   std::vector<std::thread> vectorPatternThread;
-   vectorPatternThread.reserve(iThreadCount);
+   // ## Run files in scheduler, limit to 6 threads for performance and resource management
+   pscheduler->Run( uFileCount, file_size_( ptableFile ), process_, progress_, worker_count_( iThreadCount, 6 ) );
 
-   for(int i = 0; i < iThreadCount; ++i) { vectorPatternThread.emplace_back(process_, i); }
+   MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
 
-   // Wait for all threads to complete
-   for(auto& threadWorker : vectorPatternThread) { threadWorker.join(); }
+   // ## Append worker tables to main table, key is set to row number in main table
+   uint64_t uFirstRow = ptableLineList->get_row_count();
+   for( auto& ptableLineListLocal : vectorLineListLocal ) { ptableLineList->append( ptableLineListLocal.get() ); }
 
-   MESSAGE_Progress("", {{"clear", true}});                                   // Clear progress message
+   int iKeyColumn = ptableLineList->column_find_index("key");
+   if( iKeyColumn != -1 )
+   {
+      for( uint64_t uRow = uFirstRow; uRow < ptableLineList->get_row_count(); uRow++ ) { ptableLineList->cell_set( uRow, (unsigned)iKeyColumn, uRow + 1 ); }
+   }
 
    // ### Handle any collected errors
-   if(!vectorError.empty())
+   for( const auto& vector_ : vectorError )
    {
-      for(const auto& stringError : vectorError) { ERROR_Add(stringError); }
+      for(const auto& stringError : vector_) { ERROR_Add(stringError); }
    }
 
    return {true, ""};
@@ -2449,8 +2392,8 @@ gd::table::arguments::table* CDocument::CACHE_GetTableArguments( const std::stri
 *   table. If the column name starts with a '-', it is treated as a descending sort.
 * - If the column is specified as an integer, the method validates the column index.
 *   A negative index indicates descending order.
-* - The method uses the `sort_null` function of the `gd::table::dto::table` class to
-*   perform the sorting.
+* - The method uses the typed `sort` function of the `gd::table::dto::table` class to
+*   perform the sorting, null values are placed as the smallest value.
 *
 * @pre The cache table identified by `stringId` must exist.
 * @post The rows in the cache table are sorted based on the specified column.
@@ -2501,7 +2444,7 @@ std::pair<bool, std::string> CDocument::CACHE_Sort(const std::string_view& strin
       if( (unsigned)iColumn >= ptable_->get_column_count() ) { return { false, "Column not found: " + std::to_string(iColumn) }; }
    }
                                                                                                    assert( iColumn >= 0 && (unsigned)iColumn < ptable_->get_column_count() );
-   ptable_->sort_null(iColumn, bAscending);
+   ptable_->sort( { gd::table::sort_key( (unsigned)iColumn, bAscending, bAscending ) } ); // null values are treated as smallest value
 
    return { true, "" };
 }
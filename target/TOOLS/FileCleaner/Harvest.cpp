@@ -0,0 +1,414 @@
+// @FILE [tag: harvest, file, thread] [summary: Parallel directory walker that collects files into table] [type: source] [name: Harvest.cpp]
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+#ifndef _WIN32
+#  include <dirent.h>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#include "gd/gd_file.h"
+#include "gd/gd_utf8.h"
+
+#include "Harvest.h"
+
+namespace {
+#ifdef _WIN32
+   constexpr char iSeparator_g = '\\';
+#else
+   constexpr char iSeparator_g = '/';
+#endif
+
+   /// Extension for file name with same rules as `std::filesystem::path::extension`, empty text points to literal (table copies terminator)
+   std::string_view extension_( std::string_view stringName )
+   {
+      if( stringName == "." || stringName == ".." ) return std::string_view( "" );
+      auto uPosition = stringName.rfind( '.' );
+      if( uPosition == std::string_view::npos || uPosition == 0 ) return std::string_view( "" );
+      return stringName.substr( uPosition );
+   }
+
+   /// Error text formatted as the one thrown by `std::filesystem::directory_iterator`
+   std::string error_( const std::string& stringPath, int iError )
+   {
+      std::filesystem::filesystem_error error_( "directory iterator cannot open directory", std::filesystem::path( stringPath ), std::error_code( iError, std::generic_category() ) );
+      return error_.what();
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Set filters used when files are collected
+ * @param stringWildcard wildcard filters for file names separated with `;` or `,` (first separator found is used)
+ * @param stringPathFilter wildcard filters for folder names separated with `;`, files are only added from folders where any part of path matches
+ * @param bSize read file size
+ */
+void CHarvest::Create( std::string_view stringWildcard, std::string_view stringPathFilter, bool bSize )
+{
+   m_vectorWildcard.clear();
+   m_vectorPathFilter.clear();
+   if( stringWildcard.empty() == false )
+   {
+      char iSplit = ';';                                                        // separator for wildcards
+      auto uPosition = stringWildcard.find_first_of( ";," );
+      if( uPosition != std::string_view::npos ) { iSplit = stringWildcard[uPosition]; } // use the first separator found
+      m_vectorWildcard = gd::utf8::split( stringWildcard, iSplit, gd::utf8::tag_string{} );
+   }
+
+   if( stringPathFilter.empty() == false ) { m_vectorPathFilter = gd::utf8::split( stringPathFilter, ';', gd::utf8::tag_string{} ); }
+   m_bSize = bSize;
+}
+
+/// True if file name matches any wildcard
+bool CHarvest::IsMatchWildcard( std::string_view stringName ) const
+{
+   if( m_vectorWildcard.empty() == true ) return true;
+   for( const auto& filter_ : m_vectorWildcard )
+   {
+      if( gd::ascii::strcmp( stringName, filter_, gd::utf8::tag_wildcard{} ) == true ) return true;
+   }
+   return false;
+}
+
+/// True if any folder name in path matches any path filter
+bool CHarvest::IsMatchPathFilter( std::string_view stringPath ) const
+{
+   if( m_vectorPathFilter.empty() == true ) return true;
+
+   std::string stringDirectory( stringPath );
+   std::replace( stringDirectory.begin(), stringDirectory.end(), '\\', '/' );  // convert to forward slashes for consistency
+   auto vectorDirectory = gd::utf8::split( stringDirectory, '/' );
+   for( const auto& filter_ : m_vectorPathFilter )
+   {
+      for( const auto& directory_ : vectorDirectory )
+      {
+         if( gd::ascii::strcmp( directory_, filter_, gd::utf8::tag_wildcard{} ) == true ) return true;
+      }
+   }
+   return false;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Read files in folder tree and add them to table
+ *
+ * Calling thread is one of the workers, if depth is 0 no threads are started.
+ * Reading stops at first error and error for that folder is returned.
+ *
+ * @param stringPath folder to read
+ * @param uDepth number of sub folder levels to read, 0 = only files in folder
+ * @param ptable_ table files are added to, rows are appended after existing rows
+ * @param uThreadCount number of workers, 0 = hardware concurrency up to `m_uThreadMax_s`
+ * @return true if ok, false and error text if not
+ */
+std::pair<bool, std::string> CHarvest::Run( const std::string& stringPath, unsigned uDepth, gd::table::dto::table* ptable_, unsigned uThreadCount )
+{                                                                                                  assert( ptable_ != nullptr ); assert( stringPath.empty() == false );
+   Prepare( ptable_ );
+
+   if( uThreadCount == 0 ) uThreadCount = std::min( std::thread::hardware_concurrency(), m_uThreadMax_s );
+   if( uThreadCount == 0 || uDepth == 0 ) uThreadCount = 1;
+
+   m_vectorFolder.clear();
+   m_vectorFolder.push_back( folder{ stringPath, uDepth } );
+   m_uActive = 0;
+   m_bCancel = false;
+   m_stringError.clear();
+
+   // ## each worker writes to its own table, shards are appended when all folders are read
+   std::vector<std::unique_ptr<gd::table::dto::table>> vectorShard;
+   for( unsigned u = 0; u < uThreadCount; u++ )
+   {
+      auto ptableShard = std::make_unique<gd::table::dto::table>( *ptable_, gd::table::tag_columns{} );
+      ptableShard->set_flags( gd::table::dto::table::eTableFlagDuplicateStrings, 0 ); // strings are checked for duplicates when shard is appended
+      ptableShard->m_uRowGrowBy = 0;                                          // grow with 50%, shards may get many rows
+      ptableShard->prepare();
+      vectorShard.push_back( std::move( ptableShard ) );
+   }
+
+   std::vector<std::thread> vectorThread;
+   for( unsigned u = 1; u < uThreadCount; u++ ) vectorThread.emplace_back( &CHarvest::Work, this, vectorShard[u].get() );
+   Work( vectorShard[0].get() );
+   for( auto& thread_ : vectorThread ) thread_.join();
+
+   if( m_bCancel == true ) { m_vectorFolder.clear(); return { false, m_stringError }; } // folders left in queue keep parent handles open
+
+   // ## merge shards and set key to row number
+   uint64_t uFirstRow = ptable_->get_row_count();
+   for( const auto& ptableShard : vectorShard )
+   {
+      if( ptableShard->get_row_count() > 0 ) ptable_->append( *ptableShard );
+   }
+
+   if( m_uColumnKey != (unsigned)-1 )
+   {
+      for( uint64_t uRow = uFirstRow, uEnd = ptable_->get_row_count(); uRow < uEnd; uRow++ ) { ptable_->cell_set( uRow, m_uColumnKey, uRow + 1 ); }
+   }
+
+   return { true, "" };
+}
+
+/// Find columns in table and check what information is needed for each file
+void CHarvest::Prepare( const gd::table::dto::table* ptable_ )
+{
+   m_uColumnKey = ptable_->column_find_index( "key" );
+   m_uColumnPath = ptable_->column_find_index( "path" );
+   m_uColumnFolder = ptable_->column_find_index( "folder" );
+   m_uColumnFilename = ptable_->column_find_index( "filename" );
+   m_uColumnExtension = ptable_->column_find_index( "extension" );
+   m_uColumnDays = ptable_->column_find_index( "days" );
+   m_uColumnYear = ptable_->column_find_index( "year" );
+   m_uColumnMonth = ptable_->column_find_index( "month" );
+   m_uColumnDay = ptable_->column_find_index( "day" );
+   m_uColumnSize = m_bSize == true ? ptable_->column_find_index( "size" ) : (unsigned)-1;
+   m_uColumnPermission = ptable_->column_find_index( "permission" );
+
+   m_bStat = m_uColumnDays != (unsigned)-1 || m_uColumnSize != (unsigned)-1;
+   m_iNow = (int64_t)std::chrono::system_clock::to_time_t( std::chrono::system_clock::now() );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Worker, reads folders from queue until all folders are read or error is found
+ *
+ * Exceptions (callbacks, memory for table) are caught and cancel the harvest, an
+ * exception that leaves a worker thread would terminate the process. Error text is
+ * returned from `Run`.
+ */
+void CHarvest::Work( gd::table::dto::table* ptable_ )
+{
+   std::vector<folder> vectorFolder;                                            // sub folders found, added to queue when folder is read
+   folder folder_;
+   while( Next( folder_ ) == true )
+   {
+      std::pair<bool, std::string> result_;
+      try { result_ = Read( folder_, ptable_, vectorFolder ); }
+      catch( const std::exception& e ) { result_ = { false, e.what() }; }
+      catch( ... ) { result_ = { false, "Unknown error reading folder: " + folder_.m_stringPath }; }
+
+      if( result_.first == false ) { vectorFolder.clear(); Cancel( result_.second ); }
+      Done( vectorFolder );
+   }
+}
+
+/// Take folder from queue, waits while queue is empty and other workers may add folders
+bool CHarvest::Next( folder& folder_ )
+{
+   std::unique_lock<std::mutex> lock_( m_mutex );
+   m_condition.wait( lock_, [this]() { return m_vectorFolder.empty() == false || m_uActive == 0 || m_bCancel == true; } );
+   if( m_vectorFolder.empty() == true || m_bCancel == true ) return false;
+
+   folder_ = std::move( m_vectorFolder.back() );                               // last added, sub folders are read close to parent
+   m_vectorFolder.pop_back();
+   m_uActive++;
+   return true;
+}
+
+/// Folder is read, add sub folders to queue
+void CHarvest::Done( std::vector<folder>& vectorFolder )
+{
+   bool bNotify = false;
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );                            assert( m_uActive > 0 );
+      m_uActive--;
+      for( auto& it : vectorFolder ) m_vectorFolder.push_back( std::move( it ) );
+      bNotify = vectorFolder.empty() == false || m_uActive == 0;
+   }
+   vectorFolder.clear();
+   if( bNotify == true ) m_condition.notify_all();
+}
+
+/// Stop all workers, first error is kept
+void CHarvest::Cancel( std::string_view stringError )
+{
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );
+      if( m_bCancel == false ) m_stringError = stringError;
+      m_bCancel = true;
+   }
+   m_condition.notify_all();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Read entries in folder, files are added to table and sub folders to list
+ * @param folder_ folder to read
+ * @param ptable_ table (shard) for worker
+ * @param vectorFolder gets sub folders to read
+ * @return true if ok, false and error text if folder could not be read
+ */
+std::pair<bool, std::string> CHarvest::Read( const folder& folder_, gd::table::dto::table* ptable_, std::vector<folder>& vectorFolder )
+{
+   bool bAddFile = IsMatchPathFilter( folder_.m_stringPath );                  // files are only added if folder matches path filter
+
+   // ## folder name used for files in table, no separator at end and native separators
+   std::string stringFile( folder_.m_stringPath );
+   std::replace( stringFile.begin(), stringFile.end(), iSeparator_g == '/' ? '\\' : '/', iSeparator_g );
+   while( stringFile.length() > 1 && stringFile.back() == iSeparator_g && !( stringFile.length() == 3 && stringFile[1] == ':' ) ) stringFile.pop_back();
+   const size_t uFolderLength = stringFile.length();
+   if( stringFile.back() != iSeparator_g ) stringFile += iSeparator_g;
+   const size_t uPrefixLength = stringFile.length();                          // names are added after this
+
+   std::string stringIgnore;                                                   // path with forward slashes for ignore callback
+   std::shared_ptr<void> pfolder;                                              // open folder handle, sub folders are opened relative to it
+   auto process_ = [&]( const entry& entry_ ) -> void {
+      stringFile.resize( uPrefixLength );
+      stringFile += entry_.m_stringName;
+      if( entry_.m_bFolder == true )
+      {
+         if( m_callbackIgnoreFolder )
+         {
+            stringIgnore = stringFile;
+            if constexpr( iSeparator_g != '/' ) std::replace( stringIgnore.begin(), stringIgnore.end(), iSeparator_g, '/' );
+            if( m_callbackIgnoreFolder( stringIgnore ) == true ) return;
+         }
+         if( folder_.m_uDepth > 0 ) vectorFolder.push_back( folder{ stringFile, folder_.m_uDepth - 1, pfolder, uPrefixLength } );
+      }
+      else if( entry_.m_bFile == true && bAddFile == true )
+      {
+         if( m_callbackIgnoreFile && m_callbackIgnoreFile( entry_.m_stringName ) == true ) return;
+         if( IsMatchWildcard( entry_.m_stringName ) == false ) return;
+         AddFile( stringFile, uFolderLength, entry_, ptable_ );
+      }
+   };
+
+#ifndef _WIN32
+   // ## read entries with folder handle, stat is relative to folder
+   //    Sub folders are opened with name relative to parent handle, kernel do not resolve the full path for each folder
+   constexpr int iOpenFlags_ = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+   int iFolder;
+   if( folder_.m_pparent != nullptr ) iFolder = ::openat( ::dirfd( static_cast<DIR*>( folder_.m_pparent.get() ) ), folder_.m_stringPath.c_str() + folder_.m_uName, iOpenFlags_ );
+   else                               iFolder = ::openat( AT_FDCWD, folder_.m_stringPath.c_str(), iOpenFlags_ );
+   if( iFolder == -1 ) return { false, error_( folder_.m_stringPath, errno ) };
+   DIR* pdir = ::fdopendir( iFolder );
+   if( pdir == nullptr ) { int iError = errno; ::close( iFolder ); return { false, error_( folder_.m_stringPath, iError ) }; }
+   pfolder = std::shared_ptr<void>( pdir, []( void* p_ ) { ::closedir( static_cast<DIR*>( p_ ) ); } ); // closed when folder and all queued sub folders are done, also if callback throws
+
+   while( m_bCancel == false )
+   {
+      errno = 0;
+      const dirent* pdirent = ::readdir( pdir );
+      if( pdirent == nullptr )
+      {
+         if( errno != 0 ) { return { false, error_( folder_.m_stringPath, errno ) }; }
+         break;
+      }
+
+      entry entry_;
+      entry_.m_stringName = pdirent->d_name;
+      if( entry_.m_stringName == "." || entry_.m_stringName == ".." ) continue;
+
+      unsigned char uType = pdirent->d_type;
+      bool bStat = uType == DT_UNKNOWN || uType == DT_LNK || ( uType == DT_REG && m_bStat == true ); // links are followed like `std::filesystem::directory_entry::is_directory`
+      if( bStat == true )
+      {
+         struct stat stat_;
+         if( ::fstatat( iFolder, pdirent->d_name, &stat_, 0 ) != 0 ) continue;  // broken link or removed file
+         entry_.m_bFolder = S_ISDIR( stat_.st_mode );
+         entry_.m_bFile = S_ISREG( stat_.st_mode );
+         entry_.m_bStat = true;
+         entry_.m_iTime = (int64_t)stat_.st_mtime;
+         entry_.m_uSize = (uint64_t)stat_.st_size;
+      }
+      else
+      {
+         entry_.m_bFolder = uType == DT_DIR;
+         entry_.m_bFile = uType == DT_REG;
+      }
+
+      process_( entry_ );
+   }
+#else
+   // ## windows reads file information with entries, no extra call is needed for time and size
+   std::error_code errorcode_;
+   std::filesystem::directory_iterator itFolder( folder_.m_stringPath, errorcode_ );
+   if( errorcode_ ) return { false, error_( folder_.m_stringPath, errorcode_.value() ) };
+   for( ; itFolder != std::filesystem::directory_iterator() && m_bCancel == false; itFolder.increment( errorcode_ ) )
+   {
+      const auto& it = *itFolder;
+      std::string stringName = it.path().filename().string();
+      entry entry_;
+      entry_.m_stringName = stringName;
+
+      // ## error for entry (broken link, removed file) skips entry, `errorcode_` is only for reading folder
+      std::error_code errorcodeEntry;
+      entry_.m_bFolder = it.is_directory( errorcodeEntry );
+      if( errorcodeEntry ) continue;
+      entry_.m_bFile = it.is_regular_file( errorcodeEntry );
+      if( errorcodeEntry ) continue;
+      if( entry_.m_bFile == true && m_bStat == true )
+      {
+         auto time_ = it.last_write_time( errorcodeEntry );
+         if( errorcodeEntry ) continue;
+         auto sctp_ = std::chrono::time_point_cast<std::chrono::system_clock::duration>( time_ - std::filesystem::file_time_type::clock::now() + std::chrono::system_clock::now() );
+         entry_.m_iTime = (int64_t)std::chrono::system_clock::to_time_t( sctp_ );
+         entry_.m_uSize = it.file_size( errorcodeEntry );
+         if( errorcodeEntry ) continue;
+         entry_.m_bStat = true;
+      }
+      process_( entry_ );
+   }
+   if( errorcode_ ) return { false, error_( folder_.m_stringPath, errorcode_.value() ) };
+#endif
+
+   return { true, "" };
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Add file to table
+ * @param stringFile full path to file
+ * @param uFolderLength length for folder part in path (without separator)
+ * @param entry_ file information
+ * @param ptable_ table (shard) for worker
+ */
+void CHarvest::AddFile( const std::string& stringFile, size_t uFolderLength, const entry& entry_, gd::table::dto::table* ptable_ ) const
+{
+   auto uRow = ptable_->row_add_one();
+
+   if( m_uColumnPath != (unsigned)-1 ) { ptable_->cell_set( uRow, m_uColumnPath, std::string_view( stringFile ) ); }
+   else
+   {
+      if( m_uColumnFolder != (unsigned)-1 ) ptable_->cell_set( uRow, m_uColumnFolder, std::string_view( stringFile.data(), uFolderLength ) );
+      if( m_uColumnFilename != (unsigned)-1 ) ptable_->cell_set( uRow, m_uColumnFilename, entry_.m_stringName );
+   }
+
+   if( m_uColumnExtension != (unsigned)-1 ) ptable_->cell_set( uRow, m_uColumnExtension, extension_( entry_.m_stringName ) );
+
+   if( entry_.m_bStat == true )
+   {
+      if( m_uColumnDays != (unsigned)-1 )
+      {
+         auto days_ = std::chrono::duration_cast<std::chrono::days>( std::chrono::seconds( m_iNow - entry_.m_iTime ) ).count();
+         ptable_->cell_set( uRow, m_uColumnDays, static_cast<double>( days_ ), gd::types::tag_convert{} );
+
+         if( m_uColumnYear != (unsigned)-1 )
+         {
+            std::time_t time_t_ = (std::time_t)entry_.m_iTime;
+            std::tm tm_;
+#ifdef _WIN32
+            localtime_s( &tm_, &time_t_ );
+#else
+            localtime_r( &time_t_, &tm_ );
+#endif
+            ptable_->cell_set( uRow, m_uColumnYear, tm_.tm_year + 1900, gd::types::tag_convert{} );
+            if( m_uColumnMonth != (unsigned)-1 ) ptable_->cell_set( uRow, m_uColumnMonth, tm_.tm_mon + 1, gd::types::tag_convert{} );
+            if( m_uColumnDay != (unsigned)-1 ) ptable_->cell_set( uRow, m_uColumnDay, tm_.tm_mday, gd::types::tag_convert{} );
+         }
+      }
+
+      if( m_uColumnSize != (unsigned)-1 ) ptable_->cell_set( uRow, m_uColumnSize, entry_.m_uSize, gd::types::tag_convert{} );
+   }
+
+   if( m_uColumnPermission != (unsigned)-1 )
+   {
+      std::pair<uint64_t, std::string> pairPermission;
+      auto result_ = gd::file::read_permission_g( stringFile, &pairPermission );
+      if( result_.first == true ) ptable_->cell_set( uRow, m_uColumnPermission, pairPermission.second, gd::types::tag_convert{} );
+   }
+}
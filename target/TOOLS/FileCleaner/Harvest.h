@@ -0,0 +1,141 @@
+/** @FILE [tag: harvest, file, thread] [summary: Parallel directory walker that collects files into table]
+ * \file Harvest.h
+ *
+ * \brief Walk folders with worker threads and add files that match filters to table
+ *
+ * Folders are placed in a queue that worker threads drain, each folder found is added to
+ * queue so that workers can take them. Each worker adds rows to its own table (shard) and
+ * shards are appended to the result table when all folders are read.
+ *
+ * On posix systems folders are read with `openat`/`readdir` (glibc reads entries in blocks
+ * with `getdents64`) and file information is read with `fstatat` relative to the folder
+ * handle. File type from directory entry is used when available so stat is only called
+ * when table has columns for date or size. On windows `std::filesystem` is used, file
+ * information is cached in directory entries.
+ *
+ \code
+ CHarvest harvest_( "*.cpp;*.h", "", true );
+ harvest_.m_callbackIgnoreFolder = []( std::string_view stringFolder ) { return stringFolder.ends_with( "/.git" ); };
+ auto result_ = harvest_.Run( "C:/source", 10, ptableFile );
+ \endcode
+ *
+ * Row order in result is not the order of folders in file system, rows from each shard
+ * are placed together.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gd/gd_table_column-buffer.h"
+
+
+/** @CLASS [tag: harvest] [summary: Collect files from folder tree into table using worker threads]
+ * \brief Collect files from folder tree into table, filters are prepared once and shared by all workers
+ *
+ * Columns are found by name, columns that do not exist in table are skipped.
+ * - `key` row number (one based), set when shards are merged
+ * - `path` full path to file, if table do not have `path` then `folder` and `filename` are used
+ * - `extension` file extension with dot
+ * - `days` days since file was modified, if `year` exists then also `year`, `month` and `day`
+ * - `size` file size, only if size is requested
+ * - `permission` file permission text
+ */
+class CHarvest
+{
+public:
+   /// folder in work queue
+   struct folder
+   {
+      std::string m_stringPath;  ///< path to folder
+      unsigned m_uDepth;         ///< number of levels below folder that are read
+      std::shared_ptr<void> m_pparent; ///< open parent folder (posix `DIR`), folder is opened relative to parent handle, kept until all sub folders are opened
+      size_t m_uName = 0;        ///< offset to folder name in path, name is opened relative to `m_pparent`
+   };
+
+   /// file information read from file system, `m_bStat` is false if only name and type is known
+   struct entry
+   {
+      std::string_view m_stringName;   ///< file name
+      bool m_bFolder = false;          ///< entry is folder (or link to folder)
+      bool m_bFile = false;            ///< entry is regular file (or link to file)
+      bool m_bStat = false;            ///< time and size are set
+      int64_t m_iTime = 0;             ///< last write time, seconds since epoch
+      uint64_t m_uSize = 0;            ///< file size
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   CHarvest() {}
+   CHarvest( std::string_view stringWildcard, std::string_view stringPathFilter, bool bSize ) { Create( stringWildcard, stringPathFilter, bSize ); }
+
+   CHarvest( const CHarvest& ) = delete;
+   CHarvest& operator=( const CHarvest& ) = delete;
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Set filters, wildcard is matched against file name and path filter against folder names
+   void Create( std::string_view stringWildcard, std::string_view stringPathFilter, bool bSize );
+
+   /// Read files in folder and sub folders down to depth and add them to table
+   std::pair<bool, std::string> Run( const std::string& stringPath, unsigned uDepth, gd::table::dto::table* ptable_, unsigned uThreadCount = 0 );
+
+   /// True if file name matches wildcard filter (or no filter is set)
+   bool IsMatchWildcard( std::string_view stringName ) const;
+   /// True if any folder name in path matches path filter (or no filter is set)
+   bool IsMatchPathFilter( std::string_view stringPath ) const;
+
+/** \name INTERNAL
+*///@{
+   void Work( gd::table::dto::table* ptable_ );
+   bool Next( folder& folder_ );
+   void Done( std::vector<folder>& vectorFolder );
+   void Cancel( std::string_view stringError );
+   std::pair<bool, std::string> Read( const folder& folder_, gd::table::dto::table* ptable_, std::vector<folder>& vectorFolder );
+   void AddFile( const std::string& stringFile, size_t uFolderLength, const entry& entry_, gd::table::dto::table* ptable_ ) const;
+   void Prepare( const gd::table::dto::table* ptable_ );
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   std::vector<std::string> m_vectorWildcard;      ///< wildcard filters
+   std::vector<std::string> m_vectorPathFilter;    ///< folder name filters
+   bool m_bSize = false;                           ///< read file size
+
+   std::function<bool( std::string_view )> m_callbackIgnoreFolder; ///< return true to skip folder, path has forward slashes
+   std::function<bool( std::string_view )> m_callbackIgnoreFile;   ///< return true to skip file, gets file name
+
+   // ## column index for values set in table, -1 if column is missing
+   unsigned m_uColumnKey = (unsigned)-1;
+   unsigned m_uColumnPath = (unsigned)-1;
+   unsigned m_uColumnFolder = (unsigned)-1;
+   unsigned m_uColumnFilename = (unsigned)-1;
+   unsigned m_uColumnExtension = (unsigned)-1;
+   unsigned m_uColumnDays = (unsigned)-1;
+   unsigned m_uColumnYear = (unsigned)-1;
+   unsigned m_uColumnMonth = (unsigned)-1;
+   unsigned m_uColumnDay = (unsigned)-1;
+   unsigned m_uColumnSize = (unsigned)-1;
+   unsigned m_uColumnPermission = (unsigned)-1;
+   bool m_bStat = false;                           ///< file information is needed for each file
+   int64_t m_iNow = 0;                             ///< time when harvest started, seconds since epoch
+
+   // ## work queue
+   std::mutex m_mutex;                             ///< guards queue and error
+   std::condition_variable m_condition;            ///< signaled when folders are added or work is done
+   std::vector<folder> m_vectorFolder;             ///< folders waiting to be read
+   unsigned m_uActive = 0;                         ///< workers reading folder
+   std::atomic<bool> m_bCancel{ false };           ///< stop reading, error found
+   std::string m_stringError;                      ///< first error
+
+   inline static unsigned m_uThreadMax_s = 8;      ///< max worker threads used when thread count is not set
+};
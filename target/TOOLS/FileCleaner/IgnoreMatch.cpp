@@ -0,0 +1,231 @@
+// @FILE [tag: ignore, match, wildcard] [summary: Compiled ignore rules, match folder and file names with hash lookups] [type: source] [name: IgnoreMatch.cpp]
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+
+#include "IgnoreMatch.h"
+
+/// Split rule at `*`, consecutive `*` gives empty segments that always match
+CIgnoreMatch::glob::glob( std::string_view stringRule )
+{
+   size_t uStart = 0;
+   for( size_t u = 0; u < stringRule.length(); u++ )
+   {
+      if( stringRule[u] != '*' ) continue;
+      m_vectorSegment.emplace_back( stringRule.substr( uStart, u - uStart ) );
+      uStart = u + 1;
+      m_bStar = true;
+   }
+   m_vectorSegment.emplace_back( stringRule.substr( uStart ) );
+}
+
+/// Compare segment with text at position, `?` matches any character. Text need to have room for segment
+bool CIgnoreMatch::glob::MatchSegment_s( const char* pbszName, std::string_view stringSegment )
+{
+   for( size_t u = 0; u < stringSegment.length(); u++ )
+   {
+      if( stringSegment[u] != '?' && stringSegment[u] != pbszName[u] ) return false;
+   }
+   return true;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Match name with wildcard rule, same result as `gd::ascii::strcmp( name, rule, tag_wildcard )`
+ *
+ * First segment need to match at start and last segment at end, segments between
+ * are found in order from left. Taking the leftmost position for each segment is
+ * always safe because segments have fixed length.
+ */
+bool CIgnoreMatch::glob::Match( std::string_view stringName ) const
+{                                                                                                  assert( m_vectorSegment.empty() == false );
+   const std::string& stringFirst = m_vectorSegment.front();
+   if( m_bStar == false ) return stringName.length() == stringFirst.length() && MatchSegment_s( stringName.data(), stringFirst );
+
+   const std::string& stringLast = m_vectorSegment.back();
+   if( stringName.length() < stringFirst.length() + stringLast.length() ) return false;
+   if( MatchSegment_s( stringName.data(), stringFirst ) == false ) return false;
+   if( MatchSegment_s( stringName.data() + stringName.length() - stringLast.length(), stringLast ) == false ) return false;
+
+   // ## middle segments, found in order between first and last segment
+   size_t uPosition = stringFirst.length();
+   const size_t uEnd = stringName.length() - stringLast.length();
+   for( size_t uSegment = 1; uSegment + 1 < m_vectorSegment.size(); uSegment++ )
+   {
+      const std::string& stringSegment = m_vectorSegment[uSegment];
+      bool bFound = false;
+      for( ; uPosition + stringSegment.length() <= uEnd; uPosition++ )
+      {
+         if( MatchSegment_s( stringName.data() + uPosition, stringSegment ) == true ) { bFound = true; break; }
+      }
+      if( bFound == false ) return false;
+      uPosition += stringSegment.length();
+   }
+
+   return true;
+}
+
+/// Add rule to group that can match it with least work
+void CIgnoreMatch::names::Add( std::string_view stringRule, std::deque<std::string>& dequeText )
+{
+   auto uStar = std::count( stringRule.begin(), stringRule.end(), '*' );
+   bool bQuestion = stringRule.find( '?' ) != std::string_view::npos;
+
+   auto store_ = [&dequeText]( std::string_view string_ ) -> std::string_view { dequeText.emplace_back( string_ ); return dequeText.back(); };
+
+   if( uStar == 0 && bQuestion == false )
+   {
+      m_setExact.insert( store_( stringRule ) );
+      m_uExactLength |= LengthBit_s( stringRule.length() );
+      if( stringRule.empty() == false ) m_bitsetExactFirst.set( static_cast<unsigned char>( stringRule[0] ) );
+   }
+   else if( uStar == 1 && bQuestion == false && stringRule.back() == '*' )
+   {
+      auto stringPrefix = store_( stringRule.substr( 0, stringRule.length() - 1 ) );
+      m_setPrefix.insert( stringPrefix );
+      AddLength_s( m_vectorPrefixLength, stringPrefix );
+   }
+   else if( uStar == 1 && bQuestion == false && stringRule.front() == '*' )
+   {
+      auto stringSuffix = store_( stringRule.substr( 1 ) );
+      m_setSuffix.insert( stringSuffix );
+      AddLength_s( m_vectorSuffixLength, stringSuffix );
+   }
+   else { m_vectorGlob.emplace_back( stringRule ); }
+}
+
+/// True if name matches any rule
+bool CIgnoreMatch::names::Match( std::string_view stringName ) const
+{
+   // ## exact name, empty name is only checked with set
+   if( ( m_uExactLength & LengthBit_s( stringName.length() ) ) != 0 )
+   {
+      if( ( stringName.empty() == true || m_bitsetExactFirst.test( static_cast<unsigned char>( stringName[0] ) ) == true ) && m_setExact.count( stringName ) != 0 ) return true;
+   }
+
+   for( const auto& length_ : m_vectorPrefixLength )
+   {
+      size_t uLength = length_.m_uLength;
+      if( uLength > stringName.length() ) continue;
+      if( uLength > 0 && length_.m_bitsetFirst.test( static_cast<unsigned char>( stringName[0] ) ) == false ) continue;
+      if( m_setPrefix.count( stringName.substr( 0, uLength ) ) != 0 ) return true;
+   }
+
+   for( const auto& length_ : m_vectorSuffixLength )
+   {
+      size_t uLength = length_.m_uLength;
+      if( uLength > stringName.length() ) continue;
+      size_t uStart = stringName.length() - uLength;
+      if( uLength > 0 && length_.m_bitsetFirst.test( static_cast<unsigned char>( stringName[uStart] ) ) == false ) continue;
+      if( m_setSuffix.count( stringName.substr( uStart ) ) != 0 ) return true;
+   }
+
+   for( const auto& glob_ : m_vectorGlob )
+   {
+      if( glob_.Match( stringName ) == true ) return true;
+   }
+
+   return false;
+}
+
+/// Add length and first character for prefix or suffix text
+void CIgnoreMatch::names::AddLength_s( std::vector<length>& vectorLength, std::string_view stringText )
+{
+   auto it = std::find_if( vectorLength.begin(), vectorLength.end(), [&stringText]( const length& l_ ) { return l_.m_uLength == stringText.length(); } );
+   if( it == vectorLength.end() ) { vectorLength.push_back( length{ stringText.length(), {} } ); it = vectorLength.end() - 1; }
+   if( stringText.empty() == false ) it->m_bitsetFirst.set( static_cast<unsigned char>( stringText[0] ) );
+}
+
+void CIgnoreMatch::names::Clear()
+{
+   m_setExact.clear();
+   m_uExactLength = 0;
+   m_bitsetExactFirst.reset();
+   m_setPrefix.clear();
+   m_setSuffix.clear();
+   m_vectorPrefixLength.clear();
+   m_vectorSuffixLength.clear();
+   m_vectorGlob.clear();
+}
+
+/// Rules are added again, sets in other object point to text owned by that object
+void CIgnoreMatch::common_construct( const CIgnoreMatch& o )
+{
+   for( const auto& it : o.m_vectorRule ) Add( it.first, it.second );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Add ignore rule
+ * @param uType rule flags, `eRuleFolder` (with `eRuleRoot` for root folder) or `eRuleFile`
+ * @param stringRule folder or file name, may have `*` and `?`
+ */
+void CIgnoreMatch::Add( unsigned uType, std::string_view stringRule )
+{
+   m_vectorRule.emplace_back( uType, std::string( stringRule ) );
+   if( ( uType & eRuleFolder ) != 0 )
+   {
+      if( ( uType & eRuleRoot ) != 0 ) m_namesRoot.Add( stringRule, m_dequeText );
+      else                               m_namesFolder.Add( stringRule, m_dequeText );
+   }
+   else if( ( uType & eRuleFile ) != 0 ) { m_namesFile.Add( stringRule, m_dequeText ); }
+}
+
+void CIgnoreMatch::Clear()
+{
+   m_namesRoot.Clear();
+   m_namesFolder.Clear();
+   m_namesFile.Clear();
+   m_vectorRule.clear();
+   m_dequeText.clear();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Check folder names in path below root against folder rules
+ *
+ * Root is removed from path if path starts with it (compared ignoring case), folder
+ * names are split at `/` and `\`. Root rules are only matched against first folder.
+ *
+ * @param stringPath folder path
+ * @param stringRoot project root, empty to use path as it is
+ * @return true if path is to be ignored
+ */
+bool CIgnoreMatch::MatchFolder( std::string_view stringPath, std::string_view stringRoot ) const
+{
+   if( m_namesRoot.Empty() == true && m_namesFolder.Empty() == true ) return false;
+
+   std::string_view stringProject = ProjectPath_s( stringPath, stringRoot );
+
+   bool bFirst = true;
+   size_t uStart = 0;
+   while( true )
+   {
+      size_t uEnd = stringProject.find_first_of( "/\\", uStart );
+      std::string_view stringFolder = stringProject.substr( uStart, uEnd == std::string_view::npos ? std::string_view::npos : uEnd - uStart );
+
+      if( bFirst == true && m_namesRoot.Match( stringFolder ) == true ) return true;
+      if( m_namesFolder.Match( stringFolder ) == true ) return true;
+
+      if( uEnd == std::string_view::npos ) break;
+      uStart = uEnd + 1;
+      bFirst = false;
+   }
+
+   return false;
+}
+
+/// Remove root from path if path starts with root (ignoring case) and has more after root
+std::string_view CIgnoreMatch::ProjectPath_s( std::string_view stringPath, std::string_view stringRoot )
+{
+   if( stringRoot.empty() == true ) return stringPath;
+
+   size_t uRootLength = stringRoot.length();
+   if( stringRoot.back() != '/' && stringRoot.back() != '\\' ) uRootLength++;  // separator after root
+   if( uRootLength >= stringPath.length() ) return stringPath;
+
+   for( size_t u = 0; u < stringRoot.length(); u++ )
+   {
+      if( std::tolower( static_cast<unsigned char>( stringPath[u] ) ) != std::tolower( static_cast<unsigned char>( stringRoot[u] ) ) ) return stringPath;
+   }
+
+   return stringPath.substr( uRootLength );
+}
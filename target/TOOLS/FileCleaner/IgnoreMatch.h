@@ -0,0 +1,132 @@
+/** @FILE [tag: ignore, match, wildcard] [summary: Compiled ignore rules, match folder and file names with hash lookups]
+ * \file IgnoreMatch.h
+ *
+ * \brief Ignore rules split by kind so that each name is matched with a few hash probes
+ *
+ * Ignore rules are checked for each folder and file found when files are harvested.
+ * Instead of comparing each name with each rule, rules are sorted into groups when added:
+ * - exact names (`node_modules`, `.git`) in hash set
+ * - prefix rules (`build*`) in hash set, one probe for each distinct prefix length
+ * - suffix rules (`*.obj`, `*~`) in hash set, one probe for each distinct suffix length
+ * - other wildcard rules are split at `*` into segments that are matched in order
+ *
+ * Before a set is probed the name length and the character at the position where the
+ * rule text starts are checked against bitmaps, most names that do not match never hash.
+ *
+ * Root and folder paths are compared without copies, folder names in path are read
+ * in place.
+ *
+ \code
+ CIgnoreMatch ignore_;
+ ignore_.Add( CIgnoreMatch::eRuleFolder, "node_modules" );
+ ignore_.Add( CIgnoreMatch::eRuleRoot|CIgnoreMatch::eRuleFolder, "build" );
+ ignore_.Add( CIgnoreMatch::eRuleFile|CIgnoreMatch::eRuleWildcard, "*.obj" );
+ bool bIgnore = ignore_.MatchFolder( "C:/project/src/node_modules", "C:/project" ); // true
+ bIgnore = ignore_.MatchFile( "main.obj" );                                        // true
+ \endcode
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+
+/** @CLASS [tag: ignore] [summary: Ignore rules compiled for fast matching]
+ * \brief Ignore rules compiled for fast matching, match methods are const and can be called from many threads
+ *
+ * Rule flags have same values as `CApplication::ignore::enumType`.
+ */
+class CIgnoreMatch
+{
+public:
+   enum enumRule
+   {
+      eRuleRoot      = 0x0001,   ///< folder rule only matches first folder in project path
+      eRuleFolder    = 0x0002,   ///< rule matches folder names
+      eRuleFile      = 0x0004,   ///< rule matches file names
+      eRuleWildcard  = 0x0008,   ///< rule has wildcard characters (`*` and `?`)
+   };
+
+   /// wildcard rule split at `*`, first segment is matched at start and last segment at end
+   struct glob
+   {
+      glob() {}
+      explicit glob( std::string_view stringRule );
+
+      bool Match( std::string_view stringName ) const;
+      static bool MatchSegment_s( const char* pbszName, std::string_view stringSegment );
+
+      std::vector<std::string> m_vectorSegment;   ///< text between `*`, may contain `?`
+      bool m_bStar = false;                       ///< rule contains `*`
+   };
+
+   /// length of prefix or suffix rules and first character in these, used to skip hash lookups
+   struct length
+   {
+      size_t m_uLength;                ///< text length for rules
+      std::bitset<256> m_bitsetFirst;  ///< first character in rule text
+   };
+
+   /// rules for one kind of name
+   struct names
+   {
+      bool Empty() const { return m_setExact.empty() && m_setPrefix.empty() && m_setSuffix.empty() && m_vectorGlob.empty(); }
+      void Add( std::string_view stringRule, std::deque<std::string>& dequeText );
+      bool Match( std::string_view stringName ) const;
+      void Clear();
+
+      static void AddLength_s( std::vector<length>& vectorLength, std::string_view stringText );
+      /// bit for length in mask, long names share last bit
+      static uint64_t LengthBit_s( size_t uLength ) { return uint64_t(1) << ( uLength < 63 ? uLength : 63 ); }
+
+      std::unordered_set<std::string_view> m_setExact;    ///< names without wildcard
+      uint64_t m_uExactLength = 0;                        ///< lengths in `m_setExact`, see `LengthBit_s`
+      std::bitset<256> m_bitsetExactFirst;                ///< first character in `m_setExact`
+      std::unordered_set<std::string_view> m_setPrefix;   ///< text before `*` for rules like `build*`
+      std::unordered_set<std::string_view> m_setSuffix;   ///< text after `*` for rules like `*.obj`
+      std::vector<length> m_vectorPrefixLength;           ///< distinct lengths in `m_setPrefix`
+      std::vector<length> m_vectorSuffixLength;           ///< distinct lengths in `m_setSuffix`
+      std::vector<glob> m_vectorGlob;                     ///< other wildcard rules
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   CIgnoreMatch() {}
+   CIgnoreMatch( const CIgnoreMatch& o ) { common_construct( o ); }
+   CIgnoreMatch& operator=( const CIgnoreMatch& o ) { if( this != &o ) { Clear(); common_construct( o ); } return *this; }
+
+   void common_construct( const CIgnoreMatch& o );
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Add rule, type is combination of `enumRule` flags
+   void Add( unsigned uType, std::string_view stringRule );
+   void Clear();
+
+   /// True if any folder in path below root matches folder rule
+   bool MatchFolder( std::string_view stringPath, std::string_view stringRoot ) const;
+   /// True if file name matches file rule
+   bool MatchFile( std::string_view stringFileName ) const { return m_namesFile.Match( stringFileName ); }
+
+   bool Empty() const { return m_namesRoot.Empty() && m_namesFolder.Empty() && m_namesFile.Empty(); }
+
+/** \name INTERNAL
+*///@{
+   /// Path below root, root is compared ignoring case and is only removed if path starts with it
+   static std::string_view ProjectPath_s( std::string_view stringPath, std::string_view stringRoot );
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   std::deque<std::string> m_dequeText;   ///< rule text, sets have views into these (deque do not move items)
+   std::vector< std::pair<unsigned, std::string> > m_vectorRule; ///< rules as added, used to copy
+   names m_namesRoot;                     ///< rules for first folder in project path
+   names m_namesFolder;                   ///< rules for any folder in project path
+   names m_namesFile;                     ///< rules for file names
+};
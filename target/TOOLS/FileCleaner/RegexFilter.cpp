@@ -0,0 +1,215 @@
+// @FILE [tag: regex, filter] [summary: Literal prefilter that skips text where regex patterns can not match] [type: source] [name: RegexFilter.cpp]
+
+#include <cassert>
+#include <cctype>
+
+#include "RegexFilter.h"
+
+namespace {
+   /// Skip character class starting at `[`, returns position after `]` or npos if class is not closed
+   size_t skip_class_( std::string_view stringRegex, size_t uPosition )
+   {                                                                                               assert( stringRegex[uPosition] == '[' );
+      size_t u = uPosition + 1;
+      if( u < stringRegex.length() && stringRegex[u] == '^' ) u++;
+      if( u < stringRegex.length() && stringRegex[u] == ']' ) u++;             // `]` first in class is literal
+      while( u < stringRegex.length() )
+      {
+         char ch_ = stringRegex[u];
+         if( ch_ == '\\' ) { u += 2; continue; }
+         if( ch_ == '[' && u + 1 < stringRegex.length() && ( stringRegex[u + 1] == ':' || stringRegex[u + 1] == '.' || stringRegex[u + 1] == '=' ) ) // [:alpha:] and similar
+         {
+            size_t uEnd = stringRegex.find( std::string{ stringRegex[u + 1], ']' }, u + 2 );
+            if( uEnd == std::string_view::npos ) return std::string_view::npos;
+            u = uEnd + 2;
+            continue;
+         }
+         if( ch_ == ']' ) return u + 1;
+         u++;
+      }
+      return std::string_view::npos;
+   }
+
+   /// Skip group starting at `(`, returns position after matching `)` or npos if group is not closed
+   size_t skip_group_( std::string_view stringRegex, size_t uPosition )
+   {                                                                                               assert( stringRegex[uPosition] == '(' );
+      unsigned uDepth = 0;
+      size_t u = uPosition;
+      while( u < stringRegex.length() )
+      {
+         char ch_ = stringRegex[u];
+         if( ch_ == '\\' ) { u += 2; continue; }
+         if( ch_ == '[' )
+         {
+            u = skip_class_( stringRegex, u );
+            if( u == std::string_view::npos ) return u;
+            continue;
+         }
+         if( ch_ == '(' ) uDepth++;
+         else if( ch_ == ')' ) { uDepth--; if( uDepth == 0 ) return u + 1; }
+         u++;
+      }
+      return std::string_view::npos;
+   }
+}
+
+/// Extract literals for each regex
+void CRegexFilter::Create( const std::vector< std::pair<boost::regex, std::string> >& vectorRegex )
+{
+   m_vectorRegex.clear();
+   m_vectorRegex.reserve( vectorRegex.size() );
+   for( const auto& it : vectorRegex )
+   {
+      literal literal_;
+      auto uFlags = it.first.flags();
+      literal_.m_bIgnoreCase = ( uFlags & boost::regex_constants::icase ) != 0;
+      std::string stringRegex = it.first.str();
+      if( ( uFlags & boost::regex_constants::literal ) != 0 ) { if( stringRegex.empty() == false ) literal_.m_vectorLiteral.push_back( stringRegex ); }
+      else if( ( uFlags & boost::regex::basic_syntax_group ) == 0 && ( uFlags & boost::regex_constants::mod_x ) == 0 ) { literal_.m_vectorLiteral = ExtractLiteral_s( stringRegex ); } // only perl syntax without free spacing is analysed
+      m_vectorRegex.push_back( std::move( literal_ ) );
+   }
+}
+
+/// True if regex at index may match text
+bool CRegexFilter::IsCandidate( size_t uRegex, std::string_view stringText ) const
+{
+   if( uRegex >= m_vectorRegex.size() ) return true;
+   const literal& literal_ = m_vectorRegex[uRegex];
+   if( literal_.m_vectorLiteral.empty() == true ) return true;
+
+   for( const auto& stringLiteral : literal_.m_vectorLiteral )
+   {
+      if( literal_.m_bIgnoreCase == false ) { if( stringText.find( stringLiteral ) != std::string_view::npos ) return true; }
+      else if( FindIgnoreCase_s( stringText, stringLiteral ) == true ) return true;
+   }
+   return false;
+}
+
+/// True if any regex may match text
+bool CRegexFilter::IsAnyCandidate( std::string_view stringText ) const
+{
+   for( size_t u = 0; u < m_vectorRegex.size(); u++ )
+   {
+      if( IsCandidate( u, stringText ) == true ) return true;
+   }
+   return m_vectorRegex.empty();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Find longest literal that is required for each top level alternative in regex
+ *
+ * Regex is read as a sequence of atoms. Literal characters that are not optional are
+ * collected in runs, any other atom (class, group, `.`, anchors, `\d`, `\<`...) ends the run.
+ * Groups are skipped, only literals outside groups are used. If regex contains syntax
+ * that is not understood (inline modifiers, `\Q`, back references...) nothing is returned
+ * and the regex is always passed to regex engine.
+ *
+ * @param stringRegex regex text, perl syntax
+ * @return literals, one for each top level alternative or empty if regex can not be filtered
+ */
+std::vector<std::string> CRegexFilter::ExtractLiteral_s( std::string_view stringRegex )
+{
+   std::vector<std::string> vectorLiteral;
+   std::string stringBest;                                                     // longest literal in active alternative
+   std::string stringRun;                                                      // literal characters read
+   auto end_run_ = [&stringBest, &stringRun]() { if( stringRun.length() > stringBest.length() ) stringBest = stringRun; stringRun.clear(); };
+
+   const size_t uLength = stringRegex.length();
+   size_t u = 0;
+   while( u < uLength )
+   {
+      // ## read atom, iLiteral is set if atom is one literal character
+      int iLiteral = -1;
+      char ch_ = stringRegex[u];
+      if( ch_ == '\\' )
+      {
+         if( u + 1 >= uLength ) return {};
+         char chEscape = stringRegex[u + 1];
+         if( std::string_view( "<>`'" ).find( chEscape ) != std::string_view::npos ) {} // zero width assertion (word start/end, buffer start/end), ends run
+         else if( std::isalnum( static_cast<unsigned char>( chEscape ) ) == 0 ) iLiteral = static_cast<unsigned char>( chEscape ); // escaped punctuation
+         else if( chEscape == 'n' ) iLiteral = '\n';
+         else if( chEscape == 't' ) iLiteral = '\t';
+         else if( chEscape == 'r' ) iLiteral = '\r';
+         else if( std::string_view( "dDwWsSbBAzZG" ).find( chEscape ) == std::string_view::npos ) return {}; // escape with arguments or unknown escape
+         u += 2;
+      }
+      else if( ch_ == '[' )
+      {
+         u = skip_class_( stringRegex, u );
+         if( u == std::string_view::npos ) return {};
+      }
+      else if( ch_ == '(' )
+      {
+         if( u + 1 < uLength && stringRegex[u + 1] == '?' )                   // only non capturing groups and lookarounds are known
+         {
+            std::string_view stringGroup = stringRegex.substr( u + 2, 3 );
+            bool bKnown = stringGroup.starts_with( ":" ) || stringGroup.starts_with( "=" ) || stringGroup.starts_with( "!" ) || stringGroup.starts_with( "<=" ) || stringGroup.starts_with( "<!" );
+            if( bKnown == false ) return {};                                   // inline modifiers like (?i) may change case
+         }
+         u = skip_group_( stringRegex, u );
+         if( u == std::string_view::npos ) return {};
+      }
+      else if( ch_ == '|' )
+      {
+         end_run_();
+         if( stringBest.empty() == true ) return {};                           // alternative without literal, any text may match
+         vectorLiteral.push_back( std::move( stringBest ) );
+         stringBest.clear();
+         u++;
+         continue;
+      }
+      else if( ch_ == '.' || ch_ == '^' || ch_ == '$' ) { u++; }
+      else if( ch_ == ')' || ch_ == '*' || ch_ == '+' || ch_ == '?' || ch_ == '{' ) { return {}; }
+      else { iLiteral = static_cast<unsigned char>( ch_ ); u++; }
+
+      // ## quantifier for atom
+      bool bOptional = false;
+      bool bRepeat = false;
+      if( u < uLength )
+      {
+         char chQuantifier = stringRegex[u];
+         if( chQuantifier == '*' || chQuantifier == '?' ) { bOptional = true; u++; }
+         else if( chQuantifier == '+' ) { bRepeat = true; u++; }
+         else if( chQuantifier == '{' )
+         {
+            size_t uEnd = stringRegex.find( '}', u );
+            if( uEnd == std::string_view::npos ) return {};
+            size_t uDigit = u + 1;
+            while( uDigit < uEnd && std::isdigit( static_cast<unsigned char>( stringRegex[uDigit] ) ) != 0 ) uDigit++;
+            if( uDigit == u + 1 ) return {};                                   // not a quantifier
+            if( std::stoul( std::string( stringRegex.substr( u + 1, uDigit - u - 1 ) ) ) == 0 ) bOptional = true;
+            else bRepeat = true;
+            u = uEnd + 1;
+         }
+
+         if( ( bOptional == true || bRepeat == true ) && u < uLength && ( stringRegex[u] == '?' || stringRegex[u] == '+' ) ) u++; // lazy or possessive
+      }
+
+      if( iLiteral == -1 || bOptional == true ) { end_run_(); continue; }
+
+      stringRun += static_cast<char>( iLiteral );
+      if( bRepeat == true ) end_run_();                                        // character may repeat, next character is not adjacent
+   }
+
+   end_run_();
+   if( stringBest.empty() == true ) return {};
+   vectorLiteral.push_back( std::move( stringBest ) );
+   return vectorLiteral;
+}
+
+/// Find text ignoring case for ascii characters
+bool CRegexFilter::FindIgnoreCase_s( std::string_view stringText, std::string_view stringFind )
+{
+   if( stringFind.empty() == true ) return true;
+   if( stringFind.length() > stringText.length() ) return false;
+
+   const size_t uLast = stringText.length() - stringFind.length();
+   const int iFirst = std::tolower( static_cast<unsigned char>( stringFind[0] ) );
+   for( size_t u = 0; u <= uLast; u++ )
+   {
+      if( std::tolower( static_cast<unsigned char>( stringText[u] ) ) != iFirst ) continue;
+      size_t uMatch = 1;
+      while( uMatch < stringFind.length() && std::tolower( static_cast<unsigned char>( stringText[u + uMatch] ) ) == std::tolower( static_cast<unsigned char>( stringFind[uMatch] ) ) ) uMatch++;
+      if( uMatch == stringFind.length() ) return true;
+   }
+   return false;
+}
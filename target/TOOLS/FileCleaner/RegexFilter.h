@@ -0,0 +1,77 @@
+/** @FILE [tag: regex, filter, pattern] [summary: Literal prefilter that skips text where regex patterns can not match]
+ * \file RegexFilter.h
+ *
+ * \brief Find literal text that each regex requires and skip text without it before running regex
+ *
+ * Most patterns used to search source code contain an identifier that is always part of a
+ * match, `m_vector\w+\.push_back` can not match text without `.push_back`. Literals are
+ * extracted from regex text once and each text window is checked with a plain string search
+ * before `boost::regex_search` is called. Patterns where no required literal is found (or
+ * that use syntax the analysis do not understand) are always passed to regex.
+ *
+ \code
+ CRegexFilter filter_( vectorRegexPatterns );
+ for( size_t u = 0; u < vectorRegexPatterns.size(); u++ )
+ {
+    if( filter_.IsCandidate( u, stringLine ) == false ) continue;         // regex can not match line
+    if( boost::regex_search( stringLine, vectorRegexPatterns[u].first ) ) { ... }
+ }
+ \endcode
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+
+/** @CLASS [tag: regex, filter] [summary: Required literals for each regex pattern]
+ * \brief Required literals for list of regex patterns, methods are const and filter can be shared between threads
+ */
+class CRegexFilter
+{
+public:
+   /// literals for one regex, text need to contain one of them (one for each top level alternative)
+   struct literal
+   {
+      std::vector<std::string> m_vectorLiteral; ///< empty = regex is not filtered
+      bool m_bIgnoreCase = false;               ///< regex is case insensitive, compare literals ignoring case
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   CRegexFilter() {}
+   explicit CRegexFilter( const std::vector< std::pair<boost::regex, std::string> >& vectorRegex ) { Create( vectorRegex ); }
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Extract literals for each regex, index is same as in vector
+   void Create( const std::vector< std::pair<boost::regex, std::string> >& vectorRegex );
+
+   /// True if regex at index may match text, false if text is missing required literal
+   bool IsCandidate( size_t uRegex, std::string_view stringText ) const;
+   /// True if any regex may match text
+   bool IsAnyCandidate( std::string_view stringText ) const;
+
+   /// True if regex at index has literals used to filter text
+   bool IsFiltered( size_t uRegex ) const { return uRegex < m_vectorRegex.size() && m_vectorRegex[uRegex].m_vectorLiteral.empty() == false; }
+
+   size_t Size() const { return m_vectorRegex.size(); }
+   const literal& Get( size_t uRegex ) const { return m_vectorRegex[uRegex]; }
+
+/** \name INTERNAL
+*///@{
+   /// Longest literal that each top level alternative in regex requires, empty if regex can not be filtered
+   static std::vector<std::string> ExtractLiteral_s( std::string_view stringRegex );
+   /// Find text ignoring case for ascii characters
+   static bool FindIgnoreCase_s( std::string_view stringText, std::string_view stringFind );
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   std::vector<literal> m_vectorRegex;   ///< literals for each regex
+};
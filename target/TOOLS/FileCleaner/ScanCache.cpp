@@ -0,0 +1,326 @@
+// @FILE [tag: cache, scan, file] [summary: Persistent cache with counters for files, reused when file is unchanged] [type: source] [name: ScanCache.cpp]
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#ifndef _WIN32
+#  include <sys/stat.h>
+#  include <unistd.h>
+#else
+#  include <process.h>
+#endif
+
+#include "gd/io/gd_io_repository_stream.h"
+
+#include "ScanCache.h"
+
+namespace {
+   constexpr uint32_t uMagic_g = 0x4e414353;                                   // "SCAN"
+
+   /// section header, followed by records: path length (uint32), path, size (uint64), time (int64), values (uint64 * value count)
+   struct header_
+   {
+      uint32_t m_uMagic;
+      uint32_t m_uVersion;
+      uint64_t m_uConfig;
+      uint32_t m_uValueCount;
+      uint32_t m_uReserved;
+      uint64_t m_uCount;
+   };
+
+   template<typename TYPE>
+   void write_( std::string& stringData, const TYPE& value_ ) { stringData.append( reinterpret_cast<const char*>( &value_ ), sizeof( TYPE ) ); }
+
+   /// read value at position and move position, false if data is too short
+   template<typename TYPE>
+   bool read_( std::string_view stringData, size_t& uPosition, TYPE& value_ )
+   {
+      if( uPosition + sizeof( TYPE ) > stringData.length() ) return false;
+      std::memcpy( &value_, stringData.data() + uPosition, sizeof( TYPE ) );
+      uPosition += sizeof( TYPE );
+      return true;
+   }
+
+   /// id for current process, used to give temporary files unique names
+   unsigned long process_id_()
+   {
+#ifndef _WIN32
+      return (unsigned long)::getpid();
+#else
+      return (unsigned long)::_getpid();
+#endif
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Load section from cache file
+ *
+ * Cache is only a shortcut, a file that can not be parsed or a section collected with
+ * other configuration gives an empty cache and is replaced when cache is saved.
+ *
+ * @param stringPath cache file, file is created when cache is saved if it do not exist
+ * @return true if cache is ready to use, false and error if file exists but could not be opened
+ */
+std::pair<bool, std::string> CScanCache::Load( const std::string& stringPath )
+{                                                                                                  assert( m_stringSection.empty() == false ); assert( m_uValueCount > 0 );
+   m_stringPath = stringPath;
+   m_mapRecord.clear();
+   m_vectorValue.clear();
+   m_bChanged = false;
+
+   std::error_code errorcode_;
+   if( std::filesystem::exists( stringPath, errorcode_ ) == false ) return { true, "" };
+
+   gd::io::stream::repository repository_;
+   auto result_ = repository_.open( stringPath, "rb" );
+   if( result_.first == false ) return result_;
+
+   for( size_t u = 0; u < repository_.size(); u++ )
+   {
+      const auto& entry_ = repository_[u];
+      if( entry_.is_valid() == false || entry_.get_name() != m_stringSection || entry_.size() == 0 ) continue;
+
+      std::string stringData;
+      result_ = repository_.read( u, stringData );
+      if( result_.first == true && Deserialize( stringData ) == false )
+      {
+         m_mapRecord.clear();
+         m_vectorValue.clear();
+      }
+      break;
+   }
+
+   repository_.close();
+   return { true, "" };
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Save section to cache file
+ *
+ * Repository is written to a temporary file that replaces the cache file, sections for
+ * other scans are copied from the old file. Temporary file is named with process id
+ * so runs that save at the same time do not write to the same file. Records for
+ * deleted files in folders scanned in this run are removed before saving.
+ */
+std::pair<bool, std::string> CScanCache::Save()
+{                                                                                                  assert( m_stringPath.empty() == false );
+   Prune();
+   if( m_bChanged == false ) return { true, "" };
+
+   // ## read other sections from current file
+   std::vector< std::pair<std::string, std::string> > vectorSection;
+   std::error_code errorcode_;
+   if( std::filesystem::exists( m_stringPath, errorcode_ ) == true )
+   {
+      gd::io::stream::repository repositoryOld;
+      if( repositoryOld.open( m_stringPath, "rb" ).first == true )
+      {
+         for( size_t u = 0; u < repositoryOld.size(); u++ )
+         {
+            const auto& entry_ = repositoryOld[u];
+            if( entry_.is_valid() == false || entry_.get_name() == m_stringSection || entry_.size() == 0 ) continue;
+            std::string stringData;
+            if( repositoryOld.read( u, stringData ).first == true ) vectorSection.emplace_back( std::string( entry_.get_name() ), std::move( stringData ) );
+         }
+         repositoryOld.close();
+      }
+   }
+
+   vectorSection.emplace_back( m_stringSection, Serialize() );
+
+   // ## write all sections to temporary file and replace cache file
+   std::string stringTemporary = m_stringPath + "." + std::to_string( process_id_() ) + ".tmp";
+   {
+      gd::io::stream::repository repository_( stringTemporary, vectorSection.size() );
+      auto result_ = repository_.create();
+      if( result_.first == false ) return result_;
+
+      for( const auto& it : vectorSection )
+      {
+         result_ = repository_.add( it.first, it.second.data(), it.second.size() );
+         if( result_.first == false ) { repository_.close(); std::filesystem::remove( stringTemporary, errorcode_ ); return result_; }
+      }
+
+      result_ = repository_.flush();
+      if( result_.first == false ) { std::filesystem::remove( stringTemporary, errorcode_ ); return result_; }
+      repository_.close();
+   }
+
+   std::filesystem::rename( stringTemporary, m_stringPath, errorcode_ );
+   if( errorcode_ ) { std::filesystem::remove( stringTemporary, errorcode_ ); return { false, "Failed to write cache file: " + m_stringPath }; }
+
+   m_bChanged = false;
+   return { true, "" };
+}
+
+/// Values for file if size and time match, safe to call from many threads as long as no records are set
+const uint64_t* CScanCache::Find( const std::string& stringFile, uint64_t uSize, int64_t iTime ) const
+{
+   auto it = m_mapRecord.find( stringFile );
+   if( it == m_mapRecord.end() ) return nullptr;
+   if( it->second.m_uSize != uSize || it->second.m_iTime != iTime ) return nullptr;
+   return m_vectorValue.data() + it->second.m_uValue;
+}
+
+/// Set values for file, values for changed file are replaced in place
+void CScanCache::Set( const std::string& stringFile, uint64_t uSize, int64_t iTime, const uint64_t* puValue )
+{                                                                                                  assert( puValue != nullptr );
+   auto [it, bInserted] = m_mapRecord.try_emplace( stringFile, record{ uSize, iTime, m_vectorValue.size(), true } );
+   if( bInserted == true ) { m_vectorValue.insert( m_vectorValue.end(), puValue, puValue + m_uValueCount ); }
+   else
+   {
+      it->second.m_uSize = uSize;
+      it->second.m_iTime = iTime;
+      it->second.m_bSet = true;
+      std::copy_n( puValue, m_uValueCount, m_vectorValue.begin() + it->second.m_uValue );
+   }
+   m_setFolder.emplace( Folder_s( stringFile ) );
+   m_bChanged = true;
+}
+
+/// Mark file as found in this run, call from one thread after workers are done
+void CScanCache::Keep( const std::string& stringFile )
+{
+   auto it = m_mapRecord.find( stringFile );
+   if( it != m_mapRecord.end() ) it->second.m_bSet = true;
+   m_setFolder.emplace( Folder_s( stringFile ) );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Remove records for files that do not exist in folders scanned in this run
+ *
+ * Only folders for files that are set or kept are checked, cache may hold records
+ * for many roots and files outside the roots scanned now are left as they are.
+ * Records set or kept in this run are known to exist, other records in scanned
+ * folders are checked with one stat call each. Values for kept records are packed
+ * so removed records do not leave holes in `m_vectorValue`.
+ *
+ * @return number of removed records
+ */
+size_t CScanCache::Prune()
+{
+   if( m_setFolder.empty() == true ) return 0;
+
+   size_t uRemoved = 0;
+   std::vector<uint64_t> vectorValue;
+   vectorValue.reserve( m_vectorValue.size() );
+
+   for( auto it = m_mapRecord.begin(); it != m_mapRecord.end(); )
+   {
+      uint64_t uSize;
+      int64_t iTime;
+      if( it->second.m_bSet == false && m_setFolder.count( std::string( Folder_s( it->first ) ) ) != 0 && Stat_s( it->first, uSize, iTime ) == false ) { it = m_mapRecord.erase( it ); uRemoved++; continue; }
+
+      auto itValue = m_vectorValue.begin() + it->second.m_uValue;
+      it->second.m_uValue = vectorValue.size();
+      vectorValue.insert( vectorValue.end(), itValue, itValue + m_uValueCount );
+      ++it;
+   }
+
+   m_vectorValue = std::move( vectorValue );
+   if( uRemoved > 0 ) m_bChanged = true;
+   return uRemoved;
+}
+
+/// Write records to binary section
+std::string CScanCache::Serialize() const
+{
+   std::string stringData;
+   stringData.reserve( sizeof( header_ ) + m_mapRecord.size() * ( 64 + m_uValueCount * sizeof( uint64_t ) ) );
+   write_( stringData, header_{ uMagic_g, m_uVersion_s, m_uConfig, m_uValueCount, 0, (uint64_t)m_mapRecord.size() } );
+
+   for( const auto& [stringFile, record_] : m_mapRecord )
+   {
+      write_( stringData, (uint32_t)stringFile.length() );
+      stringData.append( stringFile );
+      write_( stringData, record_.m_uSize );
+      write_( stringData, record_.m_iTime );
+      stringData.append( reinterpret_cast<const char*>( m_vectorValue.data() + record_.m_uValue ), m_uValueCount * sizeof( uint64_t ) );
+   }
+
+   return stringData;
+}
+
+/// Read records from binary section, false if section is damaged or collected with other configuration
+bool CScanCache::Deserialize( std::string_view stringData )
+{
+   size_t uPosition = 0;
+   header_ headerRead;
+   if( read_( stringData, uPosition, headerRead ) == false ) return false;
+   if( headerRead.m_uMagic != uMagic_g || headerRead.m_uVersion != m_uVersion_s ) return false;
+   if( headerRead.m_uConfig != m_uConfig || headerRead.m_uValueCount != m_uValueCount ) return false;
+
+   // ## count is read from file, check that data can hold that many records before memory is reserved
+   const uint64_t uRecordSize = sizeof( uint32_t ) + sizeof( uint64_t ) + sizeof( int64_t ) + m_uValueCount * sizeof( uint64_t ); // smallest record, empty path
+   if( headerRead.m_uCount > ( stringData.length() - uPosition ) / uRecordSize ) return false;
+
+   m_mapRecord.reserve( headerRead.m_uCount );
+   for( uint64_t u = 0; u < headerRead.m_uCount; u++ )
+   {
+      uint32_t uLength;
+      record record_;
+      if( read_( stringData, uPosition, uLength ) == false || uPosition + uLength > stringData.length() ) return false;
+      std::string stringFile( stringData.substr( uPosition, uLength ) );
+      uPosition += uLength;
+      if( read_( stringData, uPosition, record_.m_uSize ) == false || read_( stringData, uPosition, record_.m_iTime ) == false ) return false;
+
+      size_t uValueSize = m_uValueCount * sizeof( uint64_t );
+      if( uPosition + uValueSize > stringData.length() ) return false;
+      record_.m_uValue = m_vectorValue.size();
+      m_vectorValue.resize( m_vectorValue.size() + m_uValueCount );
+      std::memcpy( m_vectorValue.data() + record_.m_uValue, stringData.data() + uPosition, uValueSize );
+      uPosition += uValueSize;
+
+      m_mapRecord.insert_or_assign( std::move( stringFile ), record_ );
+   }
+
+   return true;
+}
+
+/// Read file size and last write time (nanoseconds on posix), one system call on posix
+bool CScanCache::Stat_s( const std::string& stringFile, uint64_t& uSize, int64_t& iTime )
+{
+#ifndef _WIN32
+   struct stat stat_;
+   if( ::stat( stringFile.c_str(), &stat_ ) != 0 || S_ISREG( stat_.st_mode ) == 0 ) return false;
+   uSize = (uint64_t)stat_.st_size;
+#  ifdef __APPLE__
+   iTime = (int64_t)stat_.st_mtimespec.tv_sec * 1'000'000'000 + stat_.st_mtimespec.tv_nsec;
+#  else
+   iTime = (int64_t)stat_.st_mtim.tv_sec * 1'000'000'000 + stat_.st_mtim.tv_nsec;
+#  endif
+   return true;
+#else
+   std::error_code errorcode_;
+   std::filesystem::directory_entry entry_( stringFile, errorcode_ );
+   if( errorcode_ || entry_.is_regular_file( errorcode_ ) == false ) return false;
+   uSize = entry_.file_size( errorcode_ );
+   if( errorcode_ ) return false;
+   auto time_ = entry_.last_write_time( errorcode_ );
+   if( errorcode_ ) return false;
+   iTime = (int64_t)time_.time_since_epoch().count();                         // file clock ticks, only compared with values from same clock
+   return true;
+#endif
+}
+
+/// Folder part of file path, both `/` and `\` are separators
+std::string_view CScanCache::Folder_s( std::string_view stringFile )
+{
+   auto uPosition = stringFile.find_last_of( "/\\" );
+   if( uPosition == std::string_view::npos ) return std::string_view();
+   return stringFile.substr( 0, uPosition );
+}
+
+uint64_t CScanCache::Hash_s( std::string_view stringText, uint64_t uHash )
+{
+   for( unsigned char uCharacter : stringText )
+   {
+      uHash ^= uCharacter;
+      uHash *= 0x100000001b3ull;
+   }
+   return uHash;
+}
@@ -0,0 +1,111 @@
+/** @FILE [tag: cache, scan, file] [summary: Persistent cache with counters for files, reused when file is unchanged]
+ * \file ScanCache.h
+ *
+ * \brief Counters collected for files are stored between runs, files are only read again if changed
+ *
+ * Each file is keyed by its path, file size and last write time. Counters for a file
+ * are reused when size and time are the same as when the counters were collected.
+ * Cache is stored in a repository file (`gd::io::stream::repository`), one entry for
+ * each kind of scan (section). A section stores a configuration hash (states, patterns,
+ * flags that change result), if hash differs from the one used to load the section
+ * all records are dropped.
+ *
+ * Lookups are const and can be done from worker threads, records are added from one
+ * thread after workers are done. When cache is saved, records for deleted files are removed
+ * from folders that were scanned in this run, records in other folders are not checked.
+ *
+ \code
+ CScanCache cache_( "count", CScanCache::Hash_s( "count" ), 6 );
+ cache_.Load( "C:/temp/cleaner.cache" );
+ uint64_t uSize; int64_t iTime;
+ if( CScanCache::Stat_s( stringFile, uSize, iTime ) == true )
+ {
+    const uint64_t* puValue = cache_.Find( stringFile, uSize, iTime );
+    if( puValue == nullptr ) { ... read file ...; cache_.Set( stringFile, uSize, iTime, arrayValue ); }
+    else                     { cache_.Keep( stringFile ); }
+ }
+ cache_.Save();
+ \endcode
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+/** @CLASS [tag: cache] [summary: Counters for files stored in file between runs]
+ * \brief Counters for files stored in file between runs, each record has same number of values
+ */
+class CScanCache
+{
+public:
+   /// file information and position for values in `m_vectorValue`
+   struct record
+   {
+      uint64_t m_uSize;    ///< file size when values were collected
+      int64_t m_iTime;     ///< last write time when values were collected
+      size_t m_uValue;     ///< index to first value
+      bool m_bSet = false; ///< set or kept in this run, file is known to exist
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   CScanCache() {}
+   CScanCache( std::string_view stringSection, uint64_t uConfig, unsigned uValueCount ): m_stringSection( stringSection ), m_uConfig( uConfig ), m_uValueCount( uValueCount ) {}
+
+   CScanCache( const CScanCache& ) = delete;
+   CScanCache& operator=( const CScanCache& ) = delete;
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Load section from cache file, missing file or section gives empty cache
+   std::pair<bool, std::string> Load( const std::string& stringPath );
+   /// Save section to file that cache was loaded from, other sections in file are kept
+   std::pair<bool, std::string> Save();
+
+   /// Values for file if size and time match, nullptr if file is not in cache or is changed
+   const uint64_t* Find( const std::string& stringFile, uint64_t uSize, int64_t iTime ) const;
+   /// Set values for file, `puValue` has `m_uValueCount` values
+   void Set( const std::string& stringFile, uint64_t uSize, int64_t iTime, const uint64_t* puValue );
+   /// Mark file as found in this run, record is kept and folder for file is checked for deleted files when pruned
+   void Keep( const std::string& stringFile );
+   /// Remove records for files that do not exist in folders scanned in this run, returns number of removed records
+   size_t Prune();
+
+   size_t Size() const { return m_mapRecord.size(); }
+   bool IsChanged() const { return m_bChanged; }
+
+/** \name INTERNAL
+*///@{
+   std::string Serialize() const;
+   bool Deserialize( std::string_view stringData );
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   std::string m_stringPath;                             ///< cache file
+   std::string m_stringSection;                          ///< entry name in repository file
+   uint64_t m_uConfig = 0;                               ///< hash for configuration used to collect values
+   unsigned m_uValueCount = 0;                           ///< values for each file
+   std::unordered_map<std::string, record> m_mapRecord;  ///< file path -> record
+   std::vector<uint64_t> m_vectorValue;                  ///< values for all records
+   std::unordered_set<std::string> m_setFolder;          ///< folders for files set or kept in this run, only records in these folders are pruned
+   bool m_bChanged = false;                              ///< records are added or updated
+
+// ## free functions ------------------------------------------------------------
+public:
+   /// Read file size and last write time, false if file is not found
+   static bool Stat_s( const std::string& stringFile, uint64_t& uSize, int64_t& iTime );
+   /// Folder part of file path, empty if path has no folder
+   static std::string_view Folder_s( std::string_view stringFile );
+   /// FNV-1a hash, stable between runs and builds. Pass previous hash to combine text
+   static uint64_t Hash_s( std::string_view stringText, uint64_t uHash = 0xcbf29ce484222325ull );
+
+   inline static uint32_t m_uVersion_s = 1;              ///< format version, increase if values collected for files change
+};
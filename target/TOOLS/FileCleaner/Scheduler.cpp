@@ -0,0 +1,213 @@
+// @FILE [tag: thread, scheduler] [summary: Work-stealing scheduler used to process files in parallel] [type: source] [name: Scheduler.cpp]
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <numeric>
+
+#include "Scheduler.h"
+
+/** ---------------------------------------------------------------------------
+ * @brief Start worker threads
+ * @param uThreadCount number of threads, 0 = hardware concurrency
+ */
+void CScheduler::Start( unsigned uThreadCount )
+{                                                                                                  assert( m_vectorThread.empty() == true );
+   if( uThreadCount == 0 ) uThreadCount = std::thread::hardware_concurrency();
+   if( uThreadCount == 0 ) uThreadCount = 1;
+
+   m_bStop = false;
+   for( unsigned u = 0; u < uThreadCount; u++ ) m_vectorQueue.push_back( std::make_unique<queue>() );
+   for( unsigned u = 0; u < uThreadCount; u++ ) m_vectorThread.emplace_back( &CScheduler::Work, this, u );
+}
+
+/// Stop worker threads, waits for active job to finish
+void CScheduler::Stop()
+{
+   std::lock_guard<std::mutex> lockRun( m_mutexRun );
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );
+      m_bStop = true;
+   }
+   m_conditionJob.notify_all();
+
+   for( auto& thread_ : m_vectorThread ) thread_.join();
+   m_vectorThread.clear();
+   m_vectorQueue.clear();
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Run job, items are processed by worker threads and call blocks until all are done
+ *
+ * Progress callback is called on the calling thread about ten times each second,
+ * `uDone` is read from atomic counter updated by workers.
+ *
+ * @param uCount number of items, item index is passed to callbacks
+ * @param size_ returns size for item (bytes for files), used to group items in tasks, may be empty
+ * @param process_ process item, called from worker threads with worker index and item index
+ * @param progress_ progress callback with processed and total count, may be empty
+ * @param uMaxWorker max number of workers used for job, 0 = all
+ */
+void CScheduler::Run( uint64_t uCount, const std::function<uint64_t( uint64_t )>& size_, const std::function<void( unsigned, uint64_t )>& process_, const std::function<void( uint64_t, uint64_t )>& progress_, unsigned uMaxWorker )
+{
+   std::lock_guard<std::mutex> lockRun( m_mutexRun );                                              assert( m_vectorThread.empty() == false );
+   if( uCount == 0 ) return;
+
+   unsigned uWorkerCount = Size();
+   if( uMaxWorker > 0 && uMaxWorker < uWorkerCount ) uWorkerCount = uMaxWorker;
+   if( uCount < uWorkerCount ) uWorkerCount = (unsigned)uCount;
+
+   Prepare( uCount, size_, uWorkerCount );
+
+   m_uDone.store( 0, std::memory_order_relaxed );
+   m_bCancel.store( false, std::memory_order_relaxed );
+   m_pexception = nullptr;
+
+   // ## start job
+   {
+      std::lock_guard<std::mutex> lock_( m_mutex );
+      m_pprocess = &process_;
+      m_uWorkerCount = uWorkerCount;
+      m_uActive = uWorkerCount;
+      m_uJob++;
+   }
+   m_conditionJob.notify_all();
+
+   // ## wait for workers, report progress while waiting
+   {
+      std::unique_lock<std::mutex> lock_( m_mutex );
+      while( m_conditionDone.wait_for( lock_, std::chrono::milliseconds( 100 ), [this] { return m_uActive == 0; } ) == false )
+      {
+         if( progress_ )
+         {
+            lock_.unlock();
+            progress_( m_uDone.load( std::memory_order_relaxed ), uCount );
+            lock_.lock();
+         }
+      }
+      m_pprocess = nullptr;
+   }
+
+   if( m_pexception != nullptr ) std::rethrow_exception( m_pexception );
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Group items in tasks and distribute tasks to worker queues
+ *
+ * Items are sorted on size with largest first. Items from `m_uBatchSize_s` get their
+ * own task, smaller items are batched until batch reach that size. Tasks are dealt
+ * round robin so each queue starts with large tasks, small tasks at the back are the
+ * ones stolen by workers that run out of work.
+ */
+void CScheduler::Prepare( uint64_t uCount, const std::function<uint64_t( uint64_t )>& size_, unsigned uWorkerCount )
+{
+   m_vectorOrder.resize( uCount );
+   std::iota( m_vectorOrder.begin(), m_vectorOrder.end(), uint64_t( 0 ) );
+
+   std::vector<uint64_t> vectorSize;
+   if( size_ )
+   {
+      vectorSize.resize( uCount );
+      for( uint64_t u = 0; u < uCount; u++ ) vectorSize[u] = size_( u );
+      std::stable_sort( m_vectorOrder.begin(), m_vectorOrder.end(), [&vectorSize]( uint64_t u1, uint64_t u2 ) { return vectorSize[u1] > vectorSize[u2]; } );
+   }
+
+   for( auto& pqueue : m_vectorQueue ) pqueue->m_dequeTask.clear();
+
+   unsigned uQueue = 0;
+   uint64_t uFirst = 0;
+   while( uFirst < uCount )
+   {
+      uint64_t uLast = uFirst + 1;
+      if( vectorSize.empty() == false )
+      {
+         uint64_t uBatch = vectorSize[m_vectorOrder[uFirst]];
+         while( uLast < uCount && uBatch < m_uBatchSize_s && ( uLast - uFirst ) < m_uBatchCount_s )
+         {
+            uBatch += vectorSize[m_vectorOrder[uLast]];
+            uLast++;
+         }
+      }
+      else
+      {
+         uLast = std::min<uint64_t>( uFirst + std::max<uint64_t>( 1, uCount / ( uint64_t( uWorkerCount ) * 16 ) ), uCount ); // no size, split in about 16 tasks for each worker
+      }
+
+      m_vectorQueue[uQueue]->m_dequeTask.push_back( task{ uFirst, uLast } );
+      uQueue = ( uQueue + 1 ) % uWorkerCount;
+      uFirst = uLast;
+   }
+}
+
+/// Get next task, first from own queue and then steal from other queues
+bool CScheduler::Next( unsigned uWorker, task& task_ )
+{
+   if( IsCancel() == true ) return false;
+
+   {
+      queue& queue_ = *m_vectorQueue[uWorker];
+      std::lock_guard<std::mutex> lock_( queue_.m_mutex );
+      if( queue_.m_dequeTask.empty() == false )
+      {
+         task_ = queue_.m_dequeTask.front();
+         queue_.m_dequeTask.pop_front();
+         return true;
+      }
+   }
+
+   for( unsigned u = 1; u < m_uWorkerCount; u++ )
+   {
+      queue& queue_ = *m_vectorQueue[( uWorker + u ) % m_uWorkerCount];
+      std::lock_guard<std::mutex> lock_( queue_.m_mutex );
+      if( queue_.m_dequeTask.empty() == false )
+      {
+         task_ = queue_.m_dequeTask.back();
+         queue_.m_dequeTask.pop_back();
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/// Worker thread, waits for job and process tasks until no task is found
+void CScheduler::Work( unsigned uWorker )
+{
+   uint64_t uJob = 0;
+   while( true )
+   {
+      const std::function<void( unsigned, uint64_t )>* pprocess = nullptr;
+      {
+         std::unique_lock<std::mutex> lock_( m_mutex );
+         m_conditionJob.wait( lock_, [&] { return m_bStop == true || ( m_uJob != uJob && uWorker < m_uWorkerCount ); } ); // wait for job that worker is part of
+         if( m_bStop == true ) return;
+         uJob = m_uJob;
+         pprocess = m_pprocess;
+      }
+
+      task task_;
+      while( Next( uWorker, task_ ) == true )
+      {
+         for( uint64_t u = task_.m_uFirst; u < task_.m_uLast && IsCancel() == false; u++ )
+         {
+            try
+            {
+               ( *pprocess )( uWorker, m_vectorOrder[u] );
+            }
+            catch( ... )
+            {
+               std::lock_guard<std::mutex> lock_( m_mutex );
+               if( m_pexception == nullptr ) m_pexception = std::current_exception();
+               Cancel();
+            }
+            m_uDone.fetch_add( 1, std::memory_order_relaxed );
+         }
+      }
+
+      {
+         std::lock_guard<std::mutex> lock_( m_mutex );
+         m_uActive--;
+      }
+      m_conditionDone.notify_all();
+   }
+}
@@ -0,0 +1,120 @@
+/** @FILE [tag: thread, scheduler, file] [summary: Work-stealing scheduler used to process files in parallel]
+ * \file Scheduler.h
+ *
+ * \brief Worker threads that are started once and reused for each parallel pass over files
+ *
+ * Each worker owns a queue with tasks. Workers take tasks from the front of their own
+ * queue and when it is empty they steal from the back of other queues. Tasks are
+ * size-aware, large files get their own task and are placed first, small files are
+ * batched so that each task has about the same amount of work.
+ *
+ * Progress is counted in an atomic counter by workers and reported on the thread that
+ * called `Run`, workers never call into the console.
+ *
+ \code
+ CScheduler scheduler_;
+ std::vector< std::vector<uint64_t> > vectorLocal( scheduler_.Size() ); // one result vector for each worker
+ scheduler_.Run( uFileCount,
+    [&]( uint64_t uIndex ) { return size_( uIndex ); },
+    [&]( unsigned uWorker, uint64_t uIndex ) { vectorLocal[uWorker].push_back( count_( uIndex ) ); },
+    [&]( uint64_t uDone, uint64_t uTotal ) { print_( uDone * 100 / uTotal ); } );
+ // merge vectorLocal
+ \endcode
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/** @CLASS [tag: scheduler] [summary: Pool with worker threads that process items in tasks]
+ * \brief Pool with worker threads, threads are started on first run and wait for next job between runs
+ *
+ * Only one job runs at the time. `Run` blocks until all items are processed or the
+ * job is canceled, do not call `Run` from within a job.
+ */
+class CScheduler
+{
+public:
+   /// task is range in item order, items in task are processed by one worker
+   struct task
+   {
+      uint64_t m_uFirst;   ///< first position in item order
+      uint64_t m_uLast;    ///< position after last item
+   };
+
+   /// queue with tasks for worker, owner takes from front and other workers steal from back
+   struct queue
+   {
+      std::mutex m_mutex;
+      std::deque<task> m_dequeTask;
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   CScheduler() {}
+   explicit CScheduler( unsigned uThreadCount ) { Start( uThreadCount ); }
+   ~CScheduler() { Stop(); }
+
+   CScheduler( const CScheduler& ) = delete;
+   CScheduler& operator=( const CScheduler& ) = delete;
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Start worker threads, 0 = hardware concurrency
+   void Start( unsigned uThreadCount );
+   /// Stop and join worker threads
+   void Stop();
+
+   /// Number of worker threads
+   unsigned Size() const { return (unsigned)m_vectorThread.size(); }
+   bool Empty() const { return m_vectorThread.empty(); }
+
+   /// Run job for `uCount` items, blocks until done
+   void Run( uint64_t uCount, const std::function<uint64_t( uint64_t )>& size_, const std::function<void( unsigned, uint64_t )>& process_, const std::function<void( uint64_t, uint64_t )>& progress_, unsigned uMaxWorker = 0 );
+
+   /// Skip items not started, items that workers are processing are completed
+   void Cancel() { m_bCancel.store( true, std::memory_order_relaxed ); }
+   bool IsCancel() const { return m_bCancel.load( std::memory_order_relaxed ); }
+
+protected:
+/** \name INTERNAL
+*///@{
+   void Work( unsigned uWorker );
+   bool Next( unsigned uWorker, task& task_ );
+   void Prepare( uint64_t uCount, const std::function<uint64_t( uint64_t )>& size_, unsigned uWorkerCount );
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   std::vector<std::thread> m_vectorThread;        ///< worker threads
+   std::vector<std::unique_ptr<queue>> m_vectorQueue; ///< task queue for each worker
+   std::vector<uint64_t> m_vectorOrder;            ///< item indexes in the order they are scheduled, tasks point into this
+
+   std::mutex m_mutexRun;                          ///< only one job at the time
+   std::mutex m_mutex;                             ///< guards job start and end
+   std::condition_variable m_conditionJob;         ///< signaled when job starts or pool stops
+   std::condition_variable m_conditionDone;        ///< signaled when worker is done with job
+
+   const std::function<void( unsigned, uint64_t )>* m_pprocess = nullptr; ///< process callback for active job
+   uint64_t m_uJob = 0;                            ///< job counter, workers wait for new value
+   unsigned m_uWorkerCount = 0;                    ///< number of workers in active job
+   unsigned m_uActive = 0;                         ///< workers still working on active job
+   bool m_bStop = false;                           ///< stop worker threads
+
+   std::atomic<uint64_t> m_uDone{ 0 };             ///< processed items in active job
+   std::atomic<bool> m_bCancel{ false };           ///< skip remaining tasks
+   std::exception_ptr m_pexception;                ///< first exception thrown from process callback
+
+   inline static uint64_t m_uBatchSize_s = 256 * 1024; ///< target size for task with small items, larger items get their own task
+   inline static unsigned m_uBatchCount_s = 64;    ///< max items in one batch
+};
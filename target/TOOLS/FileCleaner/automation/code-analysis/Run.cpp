@@ -7,12 +7,17 @@
   What they do is to iterate through table data and perform operations on each line."]
  */
 
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
 // ## convert string to tokens
 #include "gd/expression/gd_expression_value.h"
 // ## convert string to tokens
 #include "gd/expression/gd_expression_token.h"
 #include "gd/expression/gd_expression_method_01.h"
 #include "gd/expression/gd_expression_runtime.h"
+#include "gd/expression/gd_expression_operator.h"
 
 #include "gd/expression/gd_expression_glue_to_gd.h"
 
@@ -26,6 +31,332 @@
 using namespace gd::expression;
 using namespace AUTOMATION;
 
+namespace {
+
+// ## Compiled where plan ------------------------------------------------------
+//    Where expressions on dto tables mostly compare columns with constant values
+//    and combine the results with && and ||. These are compiled to a list of
+//    nodes that are evaluated for a chunk of rows at the time, each comparison
+//    node reads one column and writes a selection mask for the chunk. Postfix
+//    order is kept so child nodes are always evaluated before parent nodes.
+//    Mask values are 0 = false, 1 = true and 2 = null, the interpreter returns
+//    null when null values are compared and null is passed through && and ||.
+//    Expressions with other operators or methods are run by the interpreter.
+
+/// Node in compiled where plan
+struct where_node_
+{
+   enum enumNode { eNodeColumn, eNodeConstant, eNodeCompare, eNodeAnd, eNodeOr };
+   enum enumCompare { eCompareEqual, eCompareNotEqual, eCompareLess, eCompareLessEqual, eCompareGreater, eCompareGreaterEqual };
+   enum enumColumn { eColumnValue, eColumnInteger, eColumnDecimal, eColumnString };
+   enum enumMask { eMaskFalse = 0, eMaskTrue = 1, eMaskNull = 2 };
+
+   bool is_operand() const { return m_uNode == eNodeColumn || m_uNode == eNodeConstant; }
+
+   unsigned m_uNode = eNodeConstant;   ///< node type, value from enumNode
+   unsigned m_uCompare = eCompareEqual;///< compare operation, value from enumCompare
+   unsigned m_uColumn = 0;             ///< column index for column node and typed compare node
+   unsigned m_uColumnType = eColumnValue; ///< how column is read, eColumnValue converts each cell to expression value
+   unsigned m_uLeft = 0;               ///< index to left operand node
+   unsigned m_uRight = 0;              ///< index to right operand node
+   bool m_bConstant = true;            ///< false if constant could not be converted to column type, compare is done with expression values
+   gd::expression::value m_valueConstant; ///< constant value, for typed compare it is converted to column type
+   std::vector<uint8_t> m_vectorMask;  ///< result for rows in chunk, value from enumMask
+};
+
+/// Column type used to read cells without converting them to expression values
+unsigned where_column_type_( unsigned uType )
+{
+   if( gd::types::is_integer_g( uType ) == true ) return where_node_::eColumnInteger;
+   if( gd::types::is_decimal_g( uType ) == true ) return where_node_::eColumnDecimal;
+   unsigned uTypeNumber = uType & 0xff;
+   if( uTypeNumber == gd::types::eTypeNumberString || uTypeNumber == gd::types::eTypeNumberUtf8String ) return where_node_::eColumnString;
+   return where_node_::eColumnValue;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Compile postfix tokens to where plan
+ *
+ * Supported tokens are column values read with `source::get_cell_value`, constant
+ * values, compare operators and the logical operators `&&` and `||`.
+ *
+ * @param vectorPostfix postfix tokens for where expression
+ * @param ptable_ table expression is evaluated on
+ * @param vectorNode receives compiled nodes, last node is the root
+ * @return true if expression was compiled, false if it need to be run by interpreter
+ */
+bool where_compile_( const std::vector<gd::expression::token>& vectorPostfix, const gd::table::dto::table* ptable_, std::vector<where_node_>& vectorNode )
+{
+   using namespace gd::expression;
+   std::vector<unsigned> vectorStack;
+
+   for( size_t uIndex = 0; uIndex < vectorPostfix.size(); uIndex++ )
+   {
+      const token& token_ = vectorPostfix[uIndex];
+      uint32_t uToken = token_.get_token_type();
+
+      if( uToken == eTokenTypeVariable && token_.get_name() == "dtotable" )    // column value: `dtotable row 'name' source::get_cell_value`
+      {
+         if( uIndex + 3 >= vectorPostfix.size() ) return false;
+         const token& tokenRow = vectorPostfix[uIndex + 1];
+         const token& tokenColumn = vectorPostfix[uIndex + 2];
+         const token& tokenMethod = vectorPostfix[uIndex + 3];
+         if( tokenRow.get_token_type() != eTokenTypeVariable || tokenRow.get_name() != "row" ) return false;
+         if( tokenColumn.get_token_type() != eTokenTypeValue ) return false;
+         if( tokenMethod.get_token_type() != eTokenTypeFunction || tokenMethod.get_name() != "source::get_cell_value" ) return false;
+
+         int iColumn = -1;
+         value valueColumn = tokenColumn.as_value();
+         if( valueColumn.is_string() == true )       { iColumn = ptable_->column_find_index( valueColumn.get_string() ); }
+         else if( valueColumn.is_integer() == true ) { iColumn = (int)valueColumn.get_integer(); }
+         if( iColumn < 0 || (unsigned)iColumn >= ptable_->get_column_count() ) return false;
+
+         where_node_ node_;
+         node_.m_uNode = where_node_::eNodeColumn;
+         node_.m_uColumn = (unsigned)iColumn;
+         node_.m_uColumnType = where_column_type_( ptable_->column_get_ctype( (unsigned)iColumn ) );
+         vectorStack.push_back( (unsigned)vectorNode.size() );
+         vectorNode.push_back( std::move( node_ ) );
+         uIndex += 3;
+      }
+      else if( uToken == eTokenTypeValue )
+      {
+         where_node_ node_;
+         node_.m_uNode = where_node_::eNodeConstant;
+         node_.m_valueConstant = token_.as_value();
+         vectorStack.push_back( (unsigned)vectorNode.size() );
+         vectorNode.push_back( std::move( node_ ) );
+      }
+      else if( uToken == eTokenTypeOperator )
+      {
+         if( vectorStack.size() < 2 || token_.is_assign() == true ) return false;
+         unsigned uRight = vectorStack.back(); vectorStack.pop_back();
+         unsigned uLeft = vectorStack.back(); vectorStack.pop_back();
+
+         where_node_ node_;
+         node_.m_uLeft = uLeft;
+         node_.m_uRight = uRight;
+
+         std::string_view stringOperator = token_.get_name();
+         if( stringOperator == "&&" || stringOperator == "||" )
+         {
+            if( vectorNode[uLeft].is_operand() == true || vectorNode[uRight].is_operand() == true ) return false; // only results from compare are combined
+            node_.m_uNode = stringOperator == "&&" ? where_node_::eNodeAnd : where_node_::eNodeOr;
+         }
+         else
+         {
+            if( vectorNode[uLeft].is_operand() == false || vectorNode[uRight].is_operand() == false ) return false;
+
+            if( stringOperator == "==" )      node_.m_uCompare = where_node_::eCompareEqual;
+            else if( stringOperator == "!=" ) node_.m_uCompare = where_node_::eCompareNotEqual;
+            else if( stringOperator == "<" )  node_.m_uCompare = where_node_::eCompareLess;
+            else if( stringOperator == "<=" ) node_.m_uCompare = where_node_::eCompareLessEqual;
+            else if( stringOperator == ">" )  node_.m_uCompare = where_node_::eCompareGreater;
+            else if( stringOperator == ">=" ) node_.m_uCompare = where_node_::eCompareGreaterEqual;
+            else return false;
+
+            node_.m_uNode = where_node_::eNodeCompare;
+
+            // ## typed compare, column to the left and constant to the right
+            //    Constant is converted to column type once, same conversion as the interpreter does for each row
+            const where_node_& nodeLeft = vectorNode[uLeft];
+            const where_node_& nodeRight = vectorNode[uRight];
+            if( nodeLeft.m_uNode == where_node_::eNodeColumn && nodeLeft.m_uColumnType != where_node_::eColumnValue && nodeRight.m_uNode == where_node_::eNodeConstant )
+            {
+               value valueColumn;
+               if( nodeLeft.m_uColumnType == where_node_::eColumnInteger )      valueColumn = int64_t( 0 );
+               else if( nodeLeft.m_uColumnType == where_node_::eColumnDecimal ) valueColumn = double( 0.0 );
+               else                                                             valueColumn = std::string();
+
+               node_.m_valueConstant = nodeRight.m_valueConstant;
+               node_.m_bConstant = valueColumn.synchronize( node_.m_valueConstant, nullptr );
+               node_.m_uColumn = nodeLeft.m_uColumn;
+               node_.m_uColumnType = nodeLeft.m_uColumnType;
+            }
+         }
+
+         vectorStack.push_back( (unsigned)vectorNode.size() );
+         vectorNode.push_back( std::move( node_ ) );
+      }
+      else
+      {
+         return false;
+      }
+   }
+
+   if( vectorStack.size() != 1 || vectorNode.back().is_operand() == true ) return false;
+   return true;
+}
+
+/// Compare values in fixed size column with constant, values are read at row stride in the same way as the typed aggregate kernels
+template<typename VALUE, typename TYPE, typename COMPARE>
+void where_compare_fixed_( unsigned uColumn, const TYPE& constant_, COMPARE compare_, const gd::table::dto::table* ptable_, uint64_t uBegin, uint64_t uEnd, uint8_t uNull, uint8_t* puMask )
+{
+   const bool bHasNull = ptable_->is_null();
+   const uint64_t uStride = ptable_->size_row();
+   const uint8_t* puValue = ptable_->cell_get( uBegin, uColumn );
+   for( uint64_t uRow = uBegin; uRow < uEnd; uRow++, puValue += uStride )
+   {
+      if( bHasNull == true && ptable_->cell_is_null( uRow, uColumn ) == true ) { *puMask++ = uNull; continue; }
+      *puMask++ = compare_( static_cast<TYPE>( *(const VALUE*)puValue ), constant_ ) ? where_node_::eMaskTrue : where_node_::eMaskFalse;
+   }
+}
+
+/// Compare cells in column with constant, null cells give null result except for `==` that gives false (same as operator `equal`)
+/// Fixed size numeric columns are read directly from row buffer, variant view is only used for reference and text columns
+template<typename TYPE, typename READ>
+void where_compare_column_( const where_node_& node_, const TYPE& constant_, READ read_, const gd::table::dto::table* ptable_, uint64_t uBegin, uint64_t uEnd, uint8_t* puMask )
+{
+   unsigned uColumn = node_.m_uColumn;
+   uint8_t uNull = node_.m_uCompare == where_node_::eCompareEqual ? uint8_t(where_node_::eMaskFalse) : uint8_t(where_node_::eMaskNull);
+   auto compare_ = [&]( auto compare_ )
+   {
+      if constexpr( std::is_arithmetic_v<TYPE> == true )
+      {
+         if( ptable_->column_get( uColumn, gd::table::tag_pointer{} )->is_fixed() == true )
+         {
+            using namespace gd::types;
+            switch( ptable_->column_get_ctype( uColumn ) & 0x0000'00ff )
+            {
+            case eTypeNumberInt8:   where_compare_fixed_<int8_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberUInt8:  where_compare_fixed_<uint8_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberInt16:  where_compare_fixed_<int16_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberUInt16: where_compare_fixed_<uint16_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberInt32:  where_compare_fixed_<int32_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberUInt32: where_compare_fixed_<uint32_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberInt64:  where_compare_fixed_<int64_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberUInt64: where_compare_fixed_<uint64_t>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberFloat:  where_compare_fixed_<float>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            case eTypeNumberDouble: where_compare_fixed_<double>( uColumn, constant_, compare_, ptable_, uBegin, uEnd, uNull, puMask ); return;
+            default: break;
+            }
+         }
+      }
+
+      for( uint64_t uRow = uBegin; uRow < uEnd; uRow++ )
+      {
+         auto variantview_ = ptable_->cell_get_variant_view( uRow, uColumn );
+         if( variantview_.is_null() == true ) { *puMask++ = uNull; continue; }
+         *puMask++ = compare_( read_( variantview_ ), constant_ ) ? where_node_::eMaskTrue : where_node_::eMaskFalse;
+      }
+   };
+
+   switch( node_.m_uCompare )
+   {
+   case where_node_::eCompareEqual:        compare_( std::equal_to<>{} ); break;
+   case where_node_::eCompareNotEqual:     compare_( std::not_equal_to<>{} ); break;
+   case where_node_::eCompareLess:         compare_( std::less<>{} ); break;
+   case where_node_::eCompareLessEqual:    compare_( std::less_equal<>{} ); break;
+   case where_node_::eCompareGreater:      compare_( std::greater<>{} ); break;
+   case where_node_::eCompareGreaterEqual: compare_( std::greater_equal<>{} ); break;
+   default: assert( false );
+   }
+}
+
+/// Read value for operand node, column values are converted the same way as `source::get_cell_value` does
+gd::expression::value where_operand_( const where_node_& node_, const gd::table::dto::table* ptable_, uint64_t uRow )
+{
+   if( node_.m_uNode == where_node_::eNodeColumn ) { return gd::expression::value( gd::expression::to_value_g( ptable_->cell_get_variant_view( uRow, node_.m_uColumn ) ) ); }
+   return node_.m_valueConstant;
+}
+
+/// Compare node where values are converted to expression values for each row and compared with operator methods used by interpreter
+void where_compare_value_( const where_node_& node_, const where_node_& nodeLeft, const where_node_& nodeRight, const gd::table::dto::table* ptable_, uint64_t uBegin, uint64_t uEnd, uint8_t* puMask )
+{
+   using namespace gd::expression;
+   runtime* pruntime = nullptr;
+   for( uint64_t uRow = uBegin; uRow < uEnd; uRow++ )
+   {
+      value valueLeft = where_operand_( nodeLeft, ptable_, uRow );
+      value valueRight = where_operand_( nodeRight, ptable_, uRow );
+      value valueResult;
+      switch( node_.m_uCompare )
+      {
+      case where_node_::eCompareEqual:        valueResult = equal( valueLeft, valueRight, pruntime ); break;
+      case where_node_::eCompareNotEqual:     valueResult = not_equal( valueLeft, valueRight, pruntime ); break;
+      case where_node_::eCompareLess:         valueResult = less( valueLeft, valueRight, pruntime ); break;
+      case where_node_::eCompareLessEqual:    valueResult = less_equal( valueLeft, valueRight, pruntime ); break;
+      case where_node_::eCompareGreater:      valueResult = greater( valueLeft, valueRight, pruntime ); break;
+      case where_node_::eCompareGreaterEqual: valueResult = greater_equal( valueLeft, valueRight, pruntime ); break;
+      default: assert( false );
+      }
+
+      if( valueResult.is_bool() == false ) { *puMask++ = where_node_::eMaskNull; continue; }
+      *puMask++ = valueResult.get_bool() == true ? where_node_::eMaskTrue : where_node_::eMaskFalse;
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Evaluate compiled where plan for all rows in table
+ * @param vectorNode compiled nodes from `where_compile_`
+ * @param ptable_ table to evaluate
+ * @param vectorDeleteRow receives rows that do not match
+ */
+void where_select_( std::vector<where_node_>& vectorNode, const gd::table::dto::table* ptable_, std::vector<uint64_t>& vectorDeleteRow )
+{                                                                                                  assert( vectorNode.empty() == false );
+   constexpr uint64_t uChunk_ = 4096;                                          // rows evaluated in each pass, masks for chunk are kept in cache
+
+   for( auto& it : vectorNode ) { if( it.is_operand() == false ) it.m_vectorMask.resize( uChunk_ ); }
+
+   const uint64_t uRowCount = ptable_->size();
+   for( uint64_t uBegin = 0; uBegin < uRowCount; uBegin += uChunk_ )
+   {
+      uint64_t uEnd = std::min( uBegin + uChunk_, uRowCount );
+      uint64_t uCount = uEnd - uBegin;
+
+      for( auto& node_ : vectorNode )
+      {
+         uint8_t* puMask = node_.m_vectorMask.data();
+         if( node_.m_uNode == where_node_::eNodeCompare )
+         {
+            unsigned uColumnType = node_.m_bConstant == true ? node_.m_uColumnType : (unsigned)where_node_::eColumnValue;
+            switch( uColumnType )
+            {
+            case where_node_::eColumnInteger:
+               where_compare_column_( node_, node_.m_valueConstant.get_integer(), []( const gd::variant_view& v_ ) { return v_.as_int64(); }, ptable_, uBegin, uEnd, puMask );
+               break;
+            case where_node_::eColumnDecimal:
+               where_compare_column_( node_, node_.m_valueConstant.get_double(), []( const gd::variant_view& v_ ) { return v_.as_double(); }, ptable_, uBegin, uEnd, puMask );
+               break;
+            case where_node_::eColumnString:
+               where_compare_column_( node_, std::string_view( node_.m_valueConstant.get_string() ), []( const gd::variant_view& v_ ) { return v_.as_string_view(); }, ptable_, uBegin, uEnd, puMask );
+               break;
+            default:
+               where_compare_value_( node_, vectorNode[node_.m_uLeft], vectorNode[node_.m_uRight], ptable_, uBegin, uEnd, puMask );
+            }
+         }
+         else if( node_.m_uNode == where_node_::eNodeAnd || node_.m_uNode == where_node_::eNodeOr )
+         {
+            const uint8_t* puLeft = vectorNode[node_.m_uLeft].m_vectorMask.data();
+            const uint8_t* puRight = vectorNode[node_.m_uRight].m_vectorMask.data();
+            // ## null on any side gives null
+            if( node_.m_uNode == where_node_::eNodeAnd ) { for( uint64_t u = 0; u < uCount; u++ ) { puMask[u] = ((puLeft[u] | puRight[u]) & where_node_::eMaskNull) ? uint8_t(where_node_::eMaskNull) : uint8_t(puLeft[u] & puRight[u]); } }
+            else                                         { for( uint64_t u = 0; u < uCount; u++ ) { puMask[u] = ((puLeft[u] | puRight[u]) & where_node_::eMaskNull) ? uint8_t(where_node_::eMaskNull) : uint8_t(puLeft[u] | puRight[u]); } }
+         }
+      }
+
+      const uint8_t* puSelect = vectorNode.back().m_vectorMask.data();
+      for( uint64_t u = 0; u < uCount; u++ )
+      {
+         if( puSelect[u] != where_node_::eMaskTrue ) { vectorDeleteRow.push_back( uBegin + u ); }
+      }
+   }
+}
+
+/// Evaluate compiled where plan and erase rows that do not match
+std::pair<bool, std::string> where_erase_( std::vector<where_node_>& vectorNode, gd::table::dto::table* ptable_ )
+{
+   std::vector<uint64_t> vectorDeleteRow; // rows to delete
+   where_select_( vectorNode, ptable_, vectorDeleteRow );
+                                                                                                   LOG_VERBOSE_RAW("== Keep Rows: " & (ptable_->size() - vectorDeleteRow.size()));
+   if( vectorDeleteRow.empty() == false ) { ptable_->erase(vectorDeleteRow); }  // erase rows that did not match the where condition
+
+   return { true, "" };
+}
+
+} // namespace
+
+
 
 /** 
  * @brief Executes an expression given as a string, using the provided arguments and table data.
@@ -233,6 +564,10 @@ std::pair<bool, std::string> RunExpression_Where_g(const std::string_view& strin
    std::pair<bool, std::string> result_ = gd::expression::token::parse_s(stringExpression, vectorPostfix, gd::expression::tag_postfix{});
    if( result_.first == false ) { return result_; }
 
+   // ## try compiled plan, evaluates column chunks instead of running interpreter for each row
+   std::vector<where_node_> vectorNode;
+   if( where_compile_( vectorPostfix, ptable_, vectorNode ) == true ) { return where_erase_( vectorNode, ptable_ ); }
+
    // ## create runtime and add methods for operations .......................
 
    gd::expression::runtime runtime_;
@@ -286,6 +621,9 @@ std::pair<bool, std::string> RunExpression_WhereExpression_g(const std::string_v
    result_ = gd::expression::token::compile_s(vectorToken, vectorPostfix, tag_postfix{});
    if( result_.first == false ) { throw std::invalid_argument(result_.second); }
 
+   // ## try compiled plan, evaluates column chunks instead of running interpreter for each row
+   std::vector<where_node_> vectorNode;
+   if( where_compile_( vectorPostfix, ptable_, vectorNode ) == true ) { return where_erase_( vectorNode, ptable_ ); }
 
    // ## create runtime and add methods for operations .......................
 
@@ -42,6 +42,7 @@ NAMESPACE_CLI_BEGIN
  * - `print` (flag, optional): Indicates whether to print the results to the console.
  * - `output` (string, optional): Specifies the file to save the output. Defaults to stdout if not set.
  * - `table` (string, optional): Specifies the table name for generating SQL insert queries.
+ * - `cache` (string, optional): Cache file with counters from earlier runs, only changed files are read.
  *
  * @param poptionsActive The active command-line options that should be on 'count'.
  * @return std::pair<bool, std::string> A pair indicating success or failure and an error message if applicable.
@@ -90,6 +91,7 @@ std::pair<bool, std::string> Count_g( const gd::cli::options* poptionsCount, CDo
  * - `print` (flag, optional): Indicates whether to print the results to the console.
  * - `output` (string, optional): Specifies the file to save the output. Defaults to stdout if not set.
  * - `table` (string, optional): Specifies the table name for generating SQL insert queries.
+ * - `cache` (string, optional): Cache file with counters from earlier runs, only changed files are read.
  *
  * @param poptionsActive The active command-line options that should be on 'count'.
  * @return std::pair<bool, std::string> A pair indicating success or failure and an error message if applicable.
@@ -134,6 +136,9 @@ std::pair<bool, std::string> CountLine_g(const gd::cli::options* poptionsCount,
    auto result_ = pdocument->FILE_Harvest(argumentsPath, stringFilter);                            if( !result_.first ) { return result_; }
 
 
+   std::string stringCache = options_["cache"].as_string();
+   if( stringCache.empty() == false ) pdocument->PROPERTY_Set("scan-cache", std::filesystem::absolute(stringCache).string()); // counters for unchanged files are read from cache
+
    // ## Prepare arguments for pattern counting ...............................
 
    gd::argument::shared::arguments argumentsPattern;
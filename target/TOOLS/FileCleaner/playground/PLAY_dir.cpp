@@ -1,6 +1,8 @@
 // @FILE [tag: git, ignore, directory, playground] [description: Playground for testing directory functionality and logic around git and git ignore]
 
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 
 #include "gd/gd_file.h"
 #include "gd/gd_utf8.h"
@@ -21,6 +23,10 @@
 #include "main.h"
 
 #include "../Command.h"
+#include "../Document.h"
+#include "../Harvest.h"
+#include "../Scheduler.h"
+#include "../ScanCache.h"
 
 #include "catch2/catch_amalgamated.hpp"
 
@@ -75,4 +81,218 @@ TEST_CASE("[file] read .gitignore", "[file]")
       uReadSize = file_.gcount();                                             // get number of valid bytes read
       lineBuffer.update(uReadSize);
    }
-}
\ No newline at end of file
+}
+
+TEST_CASE("[file] scan cache", "[file]")
+{
+   std::string stringFolder = ( std::filesystem::temp_directory_path() / "cleaner-scan-cache" ).string();
+   std::filesystem::create_directories( stringFolder );
+   std::string stringFile = stringFolder + "/file.txt";
+   std::string stringCache = stringFolder + "/scan.cache";
+   std::filesystem::remove( stringCache );
+   { std::ofstream ofstream_( stringFile, std::ios::binary ); ofstream_ << "1\n2\n3\n"; }
+
+   uint64_t uSize = 0;
+   int64_t iTime = 0;
+   REQUIRE( CScanCache::Stat_s( stringFile, uSize, iTime ) == true );
+   REQUIRE( uSize == 6 );
+
+   const uint64_t puValue[] = { 3, 2, 1 };
+   {
+      CScanCache cache_( "count", CScanCache::Hash_s( "count" ), 3 );
+      REQUIRE( cache_.Load( stringCache ).first == true );
+      REQUIRE( cache_.Find( stringFile, uSize, iTime ) == nullptr );
+      cache_.Set( stringFile, uSize, iTime, puValue );
+      REQUIRE( cache_.Save().first == true );
+
+      CScanCache cachePattern( "pattern", CScanCache::Hash_s( "pattern" ), 1 );           // second section is added to same file
+      REQUIRE( cachePattern.Load( stringCache ).first == true );
+      cachePattern.Set( stringFile, uSize, iTime, puValue );
+      REQUIRE( cachePattern.Save().first == true );
+   }
+
+   {
+      CScanCache cache_( "count", CScanCache::Hash_s( "count" ), 3 );
+      REQUIRE( cache_.Load( stringCache ).first == true );
+      const uint64_t* puCache = cache_.Find( stringFile, uSize, iTime );
+      REQUIRE( puCache != nullptr );
+      REQUIRE( std::equal( puValue, puValue + 3, puCache ) );
+      REQUIRE( cache_.Find( stringFile, uSize + 1, iTime ) == nullptr );      // changed file is read again
+
+      CScanCache cacheOther( "count", CScanCache::Hash_s( "other" ), 3 );     // other configuration, records are dropped
+      REQUIRE( cacheOther.Load( stringCache ).first == true );
+      REQUIRE( cacheOther.Size() == 0 );
+
+      CScanCache cachePattern( "pattern", CScanCache::Hash_s( "pattern" ), 1 );
+      REQUIRE( cachePattern.Load( stringCache ).first == true );
+      REQUIRE( cachePattern.Find( stringFile, uSize, iTime ) != nullptr );
+   }
+
+   // ## damaged section with a record count larger than data is rejected, not reserved
+   {
+      CScanCache cache_( "count", CScanCache::Hash_s( "count" ), 3 );
+      cache_.Set( stringFile, uSize, iTime, puValue );
+      std::string stringData = cache_.Serialize();
+      const uint64_t uCount = 0xffff'ffff'ffffull;
+      std::memcpy( stringData.data() + 24, &uCount, sizeof( uCount ) );        // record count in header
+
+      CScanCache cacheRead( "count", CScanCache::Hash_s( "count" ), 3 );
+      REQUIRE( cacheRead.Deserialize( stringData ) == false );
+   }
+
+   // ## records for deleted files are removed when cache is saved, only in folders scanned in this run
+   {
+      std::string stringSub = stringFolder + "/sub";
+      std::filesystem::create_directories( stringSub );
+      std::string stringDeleted = stringFolder + "/deleted.txt";
+      std::string stringDeletedSub = stringSub + "/deleted.txt";
+      for( const auto& it : { stringDeleted, stringDeletedSub } ) { std::ofstream ofstream_( it, std::ios::binary ); ofstream_ << "1\n"; }
+      uint64_t uSizeDeleted = 0;
+      int64_t iTimeDeleted = 0;
+      REQUIRE( CScanCache::Stat_s( stringDeleted, uSizeDeleted, iTimeDeleted ) == true );
+
+      CScanCache cache_( "count", CScanCache::Hash_s( "count" ), 3 );
+      REQUIRE( cache_.Load( stringCache ).first == true );
+      cache_.Set( stringDeleted, uSizeDeleted, iTimeDeleted, puValue );
+      cache_.Set( stringDeletedSub, uSizeDeleted, iTimeDeleted, puValue );
+      REQUIRE( cache_.Save().first == true );
+      std::filesystem::remove( stringDeleted );
+      std::filesystem::remove( stringDeletedSub );
+
+      CScanCache cacheLoad( "count", CScanCache::Hash_s( "count" ), 3 );
+      REQUIRE( cacheLoad.Load( stringCache ).first == true );
+      REQUIRE( cacheLoad.Size() == 3 );
+      REQUIRE( cacheLoad.Prune() == 0 );                                       // no folder is scanned, nothing is checked
+      cacheLoad.Keep( stringFile );                                            // file found in scan, folder for file is checked
+      REQUIRE( cacheLoad.Prune() == 1 );
+      REQUIRE( cacheLoad.Size() == 2 );
+      REQUIRE( cacheLoad.Find( stringDeletedSub, uSizeDeleted, iTimeDeleted ) != nullptr ); // folder not scanned, record is kept
+      const uint64_t* puCache = cacheLoad.Find( stringFile, uSize, iTime );  // values for kept record are moved
+      REQUIRE( puCache != nullptr );
+      REQUIRE( std::equal( puValue, puValue + 3, puCache ) );
+      REQUIRE( cacheLoad.Save().first == true );
+
+      for( const auto& it : std::filesystem::directory_iterator( stringFolder ) ) { REQUIRE( it.path().extension() != ".tmp" ); }
+   }
+
+   std::filesystem::remove_all( stringFolder );
+}
+
+TEST_CASE("[file] harvest with worker threads", "[file]")
+{
+   std::string stringFolder = ( std::filesystem::temp_directory_path() / "cleaner-harvest" ).string();
+   std::filesystem::remove_all( stringFolder );
+
+   // ## folder tree, 4 folders with 3 sub folders each and 5 files in each folder
+   unsigned uFileCount = 0;
+   for( unsigned uFolder = 0; uFolder < 4; uFolder++ )
+   {
+      for( unsigned uSub = 0; uSub < 4; uSub++ )
+      {
+         std::filesystem::path pathFolder = std::filesystem::path( stringFolder ) / ( "f" + std::to_string( uFolder ) );
+         if( uSub > 0 ) pathFolder /= "s" + std::to_string( uSub );
+         std::filesystem::create_directories( pathFolder );
+         for( unsigned uFile = 0; uFile < 5; uFile++ )
+         {
+            std::ofstream ofstream_( pathFolder / ( "file" + std::to_string( uFile ) + ( uFile % 2 == 0 ? ".cpp" : ".h" ) ), std::ios::binary );
+            ofstream_ << "12345";
+            uFileCount++;
+         }
+      }
+   }
+
+   // ## deeper folders are opened relative to parent folder handle
+   std::filesystem::create_directories( std::filesystem::path( stringFolder ) / "f1" / "s2" / "d1" / "d2" );
+   std::ofstream( std::filesystem::path( stringFolder ) / "f1" / "s2" / "d1" / "d2" / "deep.cpp", std::ios::binary ) << "12345";
+   uFileCount++;
+
+   auto create_table_ = []() {
+      return std::make_unique<gd::table::dto::table>( gd::table::dto::table::eTableFlagNull32, std::vector<std::tuple<std::string_view, unsigned, std::string_view>>{ { "uint64", 0, "key" }, { "rstring", 0, "path" }, { "string", 20, "extension" }, { "uint64", 0, "size" } }, gd::table::tag_prepare{} );
+   };
+
+   // ## number of open file handles, folder handles are closed when harvest is done
+   auto count_handle_ = []() -> size_t {
+#ifdef __linux__
+      return (size_t)std::distance( std::filesystem::directory_iterator( "/proc/self/fd" ), std::filesystem::directory_iterator() );
+#else
+      return 0;
+#endif
+   };
+   const size_t uHandleCount = count_handle_();
+
+   // ## all files are found with 4 workers, same as with one worker
+   {
+      auto ptable_ = create_table_();
+      CHarvest harvest_( "", "", true );
+      auto result_ = harvest_.Run( stringFolder, 10, ptable_.get(), 4 );                          REQUIRE( result_.first == true );
+      REQUIRE( ptable_->get_row_count() == uFileCount );
+      REQUIRE( ptable_->cell_get_variant_view( ptable_->get_row_count() - 1, "key" ).as_uint64() == uFileCount );
+      for( uint64_t uRow = 0; uRow < ptable_->get_row_count(); uRow++ ) 
+      { 
+         REQUIRE( ptable_->cell_get_variant_view( uRow, "size" ).as_uint64() == 5 ); 
+         REQUIRE( std::filesystem::is_regular_file( ptable_->cell_get_variant_view( uRow, "path" ).as_string() ) == true ); // full path is kept for files in sub folders
+      }
+      REQUIRE( count_handle_() == uHandleCount );
+
+      auto ptableOne = create_table_();
+      CHarvest harvestOne( "*.cpp", "", true );
+      result_ = harvestOne.Run( stringFolder, 10, ptableOne.get(), 1 );                           REQUIRE( result_.first == true );
+      REQUIRE( ptableOne->get_row_count() == 16 * 3 + 1 );
+   }
+
+   // ## exception in callback for worker thread is returned as error
+   {
+      auto ptable_ = create_table_();
+      CHarvest harvest_( "", "", false );
+      harvest_.m_callbackIgnoreFile = []( std::string_view stringName ) -> bool {
+         if( stringName == "file3.h" ) throw std::runtime_error( "ignore callback failed" );
+         return false;
+      };
+      auto result_ = harvest_.Run( stringFolder, 10, ptable_.get(), 4 );
+      REQUIRE( result_.first == false );
+      REQUIRE( result_.second == "ignore callback failed" );
+      REQUIRE( count_handle_() == uHandleCount );                              // folders left in queue when harvest is cancelled release parent handles
+   }
+
+   std::filesystem::remove_all( stringFolder );
+}
+
+TEST_CASE("[file] pattern counters with worker threads", "[file]")
+{
+   std::string stringFolder = ( std::filesystem::temp_directory_path() / "cleaner-pattern" ).string();
+   std::filesystem::remove_all( stringFolder );
+   std::filesystem::create_directories( stringFolder );
+
+   // ## file n has "alpha" n % 5 times and "beta" n % 3 times
+   constexpr unsigned uFileCount = 60;
+   for( unsigned u = 0; u < uFileCount; u++ )
+   {
+      std::ofstream ofstream_( std::filesystem::path( stringFolder ) / ( std::to_string( u ) + ".txt" ), std::ios::binary );
+      for( unsigned uAlpha = 0; uAlpha < u % 5; uAlpha++ ) { ofstream_ << "line with alpha\n"; }
+      for( unsigned uBeta = 0; uBeta < u % 3; uBeta++ ) { ofstream_ << "beta is here\n"; }
+      ofstream_ << "end\n";
+   }
+
+   CApplication application_;
+   papplication_g = &application_;                                             // harvest reads application state, pointer is reset when application is destroyed
+   application_.m_pscheduler = std::make_unique<CScheduler>( 4 );            // more than one worker even on single core machines
+   CDocument* pdocument = application_.DOCUMENT_Add( "pattern" );
+
+   auto result_ = pdocument->FILE_Harvest( gd::argument::shared::arguments( { {"source", stringFolder}, {"recursive", 1u} } ) ); REQUIRE( result_.first == true );
+   auto* ptableFile = pdocument->CACHE_Get( "file", false );                                      REQUIRE( ptableFile != nullptr );
+   REQUIRE( ptableFile->get_row_count() == uFileCount );
+
+   result_ = pdocument->FILE_UpdatePatternCounters( gd::argument::shared::arguments(), std::vector<std::string>{ "alpha", "beta" }, 4 ); REQUIRE( result_.first == true );
+   auto* ptablePattern = pdocument->CACHE_Get( "file-pattern", false );                           REQUIRE( ptablePattern != nullptr );
+   REQUIRE( ptablePattern->get_row_count() == uFileCount );
+
+   for( uint64_t uRow = 0; uRow < uFileCount; uRow++ )
+   {
+      std::string stringFilename = ptablePattern->cell_get_variant_view( uRow, "filename" ).as_string();
+      unsigned uFile = (unsigned)std::stoul( stringFilename );
+      REQUIRE( ptablePattern->cell_get_variant_view( uRow, 4u ).as_uint64() == uFile % 5 );
+      REQUIRE( ptablePattern->cell_get_variant_view( uRow, 5u ).as_uint64() == uFile % 3 );
+   }
+
+   std::filesystem::remove_all( stringFolder );
+}
@@ -15,6 +15,7 @@
 #include "main.h"
 
 #include "../Command.h"
+#include "../IgnoreMatch.h"
 
 #include "catch2/catch_amalgamated.hpp"
 
@@ -136,4 +137,38 @@ TEST_CASE("[file] test", "[file]")
    }
 
    PrintFiles(stringDirectory, vectorList);
-}
\ No newline at end of file
+}
+
+TEST_CASE("[file] ignore match", "[file]")
+{
+   CIgnoreMatch ignore_;
+   ignore_.Add( CIgnoreMatch::eRuleFolder, "node_modules" );
+   ignore_.Add( CIgnoreMatch::eRuleRoot|CIgnoreMatch::eRuleFolder, "build" );
+   ignore_.Add( CIgnoreMatch::eRuleFolder|CIgnoreMatch::eRuleWildcard, "cmake-*" );
+   ignore_.Add( CIgnoreMatch::eRuleFile|CIgnoreMatch::eRuleWildcard, "*.obj" );
+   ignore_.Add( CIgnoreMatch::eRuleFile|CIgnoreMatch::eRuleWildcard, "~$*" );
+   ignore_.Add( CIgnoreMatch::eRuleFile|CIgnoreMatch::eRuleWildcard, "test_*.?pp" );
+
+   // ## folders, root is removed from path ignoring case and root rules only match first folder
+   REQUIRE( ignore_.MatchFolder( "C:/Project/src/node_modules", "c:/project" ) == true );
+   REQUIRE( ignore_.MatchFolder( "C:\\Project\\node_modules\\lib", "C:\\Project" ) == true );
+   REQUIRE( ignore_.MatchFolder( "C:/project/build", "C:/project/" ) == true );
+   REQUIRE( ignore_.MatchFolder( "C:/project/src/build", "C:/project" ) == false );
+   REQUIRE( ignore_.MatchFolder( "C:/project/cmake-debug/x", "C:/project" ) == true );
+   REQUIRE( ignore_.MatchFolder( "C:/project/src", "C:/project" ) == false );
+
+   // ## files, same result as gd::ascii::strcmp with wildcard
+   std::vector<std::string> vectorRule = { "*.obj", "~$*", "test_*.?pp" };
+   for( std::string_view stringName : { "main.obj", "main.cpp", "~$doc.docx", "test_a.cpp", "test_.hpp", "test.cpp", "test_a.c", "obj" } )
+   {
+      bool bExpected = false;
+      for( const auto& stringRule : vectorRule ) { if( gd::ascii::strcmp( stringName, stringRule, gd::utf8::tag_wildcard{} ) == true ) bExpected = true; }
+      REQUIRE( ignore_.MatchFile( stringName ) == bExpected );
+   }
+
+   // ## copy get own rule text
+   CIgnoreMatch ignoreCopy( ignore_ );
+   ignore_.Clear();
+   REQUIRE( ignore_.MatchFile( "main.obj" ) == false );
+   REQUIRE( ignoreCopy.MatchFile( "main.obj" ) == true );
+}
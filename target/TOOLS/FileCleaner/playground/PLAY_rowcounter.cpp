@@ -95,6 +95,33 @@ TEST_CASE("[rowcouner] match", "[rowcouner]") {
    std::cout << "Pattern found: " << iFind << "\n";
 }
 
+TEST_CASE("[rowcouner] match automaton", "[rowcouner]") {
+   std::vector<std::string> vectorPattern = { "int", "Int32", "integer", "in", "nt", "print", "_value", "value" };
+   for( int i = 0; i < 40; i++ ) { vectorPattern.push_back( "name" + std::to_string( i ) ); }
+
+   gd::parse::patterns patternsScan( vectorPattern );
+   patternsScan.set_ignore_case( true );
+   patternsScan.sort();
+   gd::parse::patterns patternsAutomaton = patternsScan;
+   patternsScan.prepare( gd::parse::patterns::eEngineScan );
+   patternsAutomaton.prepare();                                                REQUIRE( patternsAutomaton.is_automaton() == true );
+
+   std::string stringText = "int32 INTEGER print(_value); name17 = NAME3 + xname39 * interval;";
+   for( bool bWord : { false, true } )
+   {
+      patternsScan.set_word( bWord );
+      patternsAutomaton.set_word( bWord );
+      for( uint64_t uOffset = 0; uOffset <= stringText.length(); uOffset++ )
+      {
+         uint64_t uFindScan = 0, uFindAutomaton = 0;
+         int iScan = patternsScan.find_pattern( stringText, uOffset, &uFindScan );
+         int iAutomaton = patternsAutomaton.find_pattern( stringText, uOffset, &uFindAutomaton );
+         REQUIRE( iScan == iAutomaton );
+         if( iScan != -1 ) { REQUIRE( uFindScan == uFindAutomaton ); }
+      }
+   }
+}
+
 TEST_CASE("[rowcouner] count characters", "[rowcouner]") {
    std::string stringFile = FOLDER_GetRoot_g("temp__/sqlite3.c");                                  REQUIRE(std::filesystem::exists(stringFile) == true);
 
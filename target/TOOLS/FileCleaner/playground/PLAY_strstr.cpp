@@ -12,6 +12,8 @@
 #include "gd/gd_parse.h"
 #include "gd/parse/gd_parse_formats.h"
 
+#include "../RegexFilter.h"
+
 #include "main.h"
 
 #include "catch2/catch_amalgamated.hpp"
@@ -71,4 +73,39 @@ TEST_CASE("[table] custom columns", "[strstr]")
       std::string_view stringValue4(result4_.first, result4_.second);
       std::cout << "Found value for key4: " << stringValue4 << std::endl;
    }
-}
\ No newline at end of file
+}
+
+TEST_CASE("[strstr] regex literal filter", "[strstr]")
+{
+   REQUIRE( CRegexFilter::ExtractLiteral_s( R"(m_vector\w+\.push_back)" ) == std::vector<std::string>{ ".push_back" } );
+   REQUIRE( CRegexFilter::ExtractLiteral_s( "foo|bar" ) == std::vector<std::string>{ "foo", "bar" } );
+   REQUIRE( CRegexFilter::ExtractLiteral_s( "colou?r" ) == std::vector<std::string>{ "colo" } );
+   REQUIRE( CRegexFilter::ExtractLiteral_s( R"(abc|\d)" ).empty() == true );     // second alternative has no literal
+   REQUIRE( CRegexFilter::ExtractLiteral_s( "(?i)hello" ).empty() == true );      // inline modifier is not analysed
+
+   std::vector< std::pair<boost::regex, std::string> > vectorRegex = { { boost::regex( R"(\bclass\s+(\w+))" ), "" }, { boost::regex( "TODO", boost::regex::icase ), "" }, { boost::regex( R"(\d+)" ), "" } };
+   CRegexFilter filter_( vectorRegex );
+   REQUIRE( filter_.IsCandidate( 0, "class CFilter" ) == true );
+   REQUIRE( filter_.IsCandidate( 0, "int iValue = 0;" ) == false );
+   REQUIRE( filter_.IsCandidate( 1, "// todo: fix" ) == true );
+   REQUIRE( filter_.IsCandidate( 2, "no digits" ) == true );                      // not filtered, regex decides
+
+   // ## zero width escapes are not literal characters, filter must agree with regex engine
+   REQUIRE( CRegexFilter::ExtractLiteral_s( R"(\<push_back\>)" ) == std::vector<std::string>{ "push_back" } );
+   REQUIRE( CRegexFilter::ExtractLiteral_s( R"(\`foo)" ) == std::vector<std::string>{ "foo" } );
+   REQUIRE( CRegexFilter::ExtractLiteral_s( R"(a\')" ) == std::vector<std::string>{ "a" } );
+   std::vector< std::tuple<std::string, std::string, bool> > vectorTest = {
+      { R"(\<push_back\>)", "v.push_back(1);", true }, { R"(\<push_back\>)", "v.push_backs(1);", false },
+      { R"(\`foo)", "foo bar", true }, { R"(\`foo)", "bar foo", false },
+      { R"(a\')", "cba", true }, { R"(a\')", "abc", false },
+      { R"(x\>|\<y)", "x y", true }, { R"(\.\<at\>\()", "v.at(0)", true } };
+   for( const auto& [stringRegex, stringText, bExpect] : vectorTest )
+   {
+      std::vector< std::pair<boost::regex, std::string> > vectorOne = { { boost::regex( stringRegex ), "" } };
+      CRegexFilter filterOne( vectorOne );
+      INFO( stringRegex << " in " << stringText );
+      bool bMatch = boost::regex_search( stringText, vectorOne[0].first );
+      REQUIRE( bMatch == bExpect );
+      if( bMatch == true ) { REQUIRE( filterOne.IsCandidate( 0, stringText ) == true ); } // filter may never reject text regex matches
+   }
+}
@@ -1,6 +1,7 @@
 // @FILE [tag: table, playground] [description: Playground for testing table functionality]
 
 #include <iostream>
+#include <numeric>
 #include <fstream>
 #include <filesystem>
 #include <cstdio>
@@ -636,6 +637,162 @@ TEST_CASE("[table] custom columns 1", "[table]")
    }
 }
 
+TEST_CASE("[table] reference values", "[table]")
+{
+   gd::table::dto::table table_( 0u, { { "rstring", 0, "name" }, { "int64", 0, "id" } }, gd::table::tag_prepare{} );
+
+   for( uint64_t u = 0; u < 1000; u++ )
+   {
+      table_.row_add();
+      table_.cell_set( u, 0u, gd::variant_view( "value-" + std::to_string( u % 100 ) ) );
+      table_.cell_set( u, 1u, gd::variant_view( (int64_t)u ) );
+   }
+   REQUIRE( table_.m_references.size() == 100 );                              // equal values are stored once
+   REQUIRE( table_.cell_get_variant_view( 150u, 0u ).as_string() == "value-50" );
+
+   gd::table::dto::table tableCopy( table_ );
+   REQUIRE( tableCopy.m_references.size() == 100 );
+   REQUIRE( tableCopy.cell_get_variant_view( 999u, 0u ).as_string() == "value-99" );
+
+   table_.erase( uint64_t(0), uint64_t(950) );                                // rows left use value-50 .. value-99
+   REQUIRE( table_.reference_compact() == 50 );
+   REQUIRE( table_.m_references.size() == 50 );
+   REQUIRE( table_.cell_get_variant_view( 0u, 0u ).as_string() == "value-50" );
+   REQUIRE( table_.cell_get_variant_view( 49u, 0u ).as_string() == "value-99" );
+
+   table_.row_add();
+   table_.cell_set( 50u, 0u, gd::variant_view( "value-75" ) );                // found in index after compact
+   REQUIRE( table_.m_references.size() == 50 );
+   table_.cell_set( 50u, 0u, gd::variant_view( "value-1" ) );
+   REQUIRE( table_.m_references.size() == 51 );
+}
+
+TEST_CASE("[table] erase scattered rows", "[table]")
+{
+   using namespace gd::table::dto;
+   table table_( table::eTableFlagNull32 | table::eTableFlagRowStatus, { { "int64", 0, "id" }, { "rstring", 0, "name" }, { "double", 0, "value" } }, gd::table::tag_prepare{} );
+   std::vector<int64_t> vectorExpected;
+   for( int64_t i = 0; i < 1000; i++ )
+   {
+      uint64_t uRow = table_.row_add_one();
+      table_.cell_set( uRow, 0u, gd::variant_view( i ) );
+      table_.cell_set( uRow, 1u, gd::variant_view( "name-" + std::to_string( i ) ) );
+      if( i % 3 == 0 ) table_.cell_set_null( uRow, 2u ); else table_.cell_set( uRow, 2u, gd::variant_view( double( i ) ) );
+      vectorExpected.push_back( i );
+   }
+
+   // ## first and last row, adjacent rows, duplicates, unsorted and out of range indexes
+   std::vector<uint64_t> vectorErase = { 999, 0, 1, 2, 500, 17, 17, 998, 250, 251, 252, 5000, 3, 640, 999 };
+   for( uint64_t u = 100; u < 200; u += 7 ) vectorErase.push_back( u );
+
+   std::vector<uint64_t> vectorSorted( vectorErase );
+   std::sort( vectorSorted.begin(), vectorSorted.end(), std::greater<>{} );
+   vectorSorted.erase( std::unique( vectorSorted.begin(), vectorSorted.end() ), vectorSorted.end() );
+   for( uint64_t u : vectorSorted ) { if( u < vectorExpected.size() ) vectorExpected.erase( vectorExpected.begin() + u ); }
+
+   table_.erase( vectorErase );
+   REQUIRE( table_.get_row_count() == vectorExpected.size() );
+   for( uint64_t uRow = 0; uRow < table_.get_row_count(); uRow++ )
+   {
+      int64_t iId = vectorExpected[uRow];
+      REQUIRE( table_.cell_get_variant_view( uRow, 0u ).as_int64() == iId );
+      REQUIRE( table_.cell_get_variant_view( uRow, 1u ).as_string() == "name-" + std::to_string( iId ) );
+      if( iId % 3 == 0 ) { REQUIRE( table_.cell_is_null( uRow, 2u ) == true ); }               // null flags are moved with row
+      else               { REQUIRE( table_.cell_get_variant_view( uRow, 2u ).as_double() == double( iId ) ); }
+   }
+
+   // ## erase every second row and then all rows
+   std::vector<uint64_t> vectorEven;
+   for( uint64_t u = 0; u < table_.get_row_count(); u += 2 ) vectorEven.push_back( u );
+   int64_t iLast = table_.cell_get_variant_view( table_.get_row_count() - 1, 0u ).as_int64();
+   uint64_t uRowCount = table_.get_row_count() - vectorEven.size();
+   table_.erase( vectorEven );
+   REQUIRE( table_.get_row_count() == uRowCount );
+   REQUIRE( table_.cell_get_variant_view( 0u, 0u ).as_int64() == vectorExpected[1] );
+   if( vectorExpected.size() % 2 == 0 ) { REQUIRE( table_.cell_get_variant_view( uRowCount - 1, 0u ).as_int64() == iLast ); }
+
+   std::vector<uint64_t> vectorAll( table_.get_row_count() );
+   std::iota( vectorAll.begin(), vectorAll.end(), uint64_t( 0 ) );
+   table_.erase( vectorAll );
+   REQUIRE( table_.get_row_count() == 0 );
+}
+
+TEST_CASE("[table] read csv in parallel", "[table]")
+{
+   std::string stringCsv;
+   for( uint64_t u = 0; u < 100000; u++ )
+   {
+      stringCsv += std::to_string( u ) + ",";
+      if( u % 7 == 0 ) stringCsv += "\"name, \"\"quoted\"\"\n" + std::to_string( u % 50 ) + "\"";  // separator, quote and new line in value
+      else             stringCsv += "name" + std::to_string( u % 50 );
+      stringCsv += "," + std::to_string( u ) + ".5\r\n";
+   }
+
+   gd::table::dto::table table_( 0u, { { "int64", 0, "id" }, { "rstring", 0, "name" }, { "double", 0, "value" } }, gd::table::tag_prepare{} );
+   auto result_ = gd::table::read_g( table_, stringCsv, ',', '\n', gd::table::tag_io_csv{}, gd::table::tag_parallel{}, 4 );
+   REQUIRE( result_.first == true );
+   REQUIRE( table_.get_row_count() == 100000 );
+   REQUIRE( table_.m_references.size() == 100 );                              // values from all threads are added once
+   for( uint64_t u = 0; u < 100000; u += 997 )
+   {
+      REQUIRE( table_.cell_get_variant_view( u, 0u ).as_int64() == (int64_t)u );
+      REQUIRE( table_.cell_get_variant_view( u, 2u ).as_double() == (double)u + 0.5 );
+      std::string stringName = u % 7 == 0 ? "name, \"quoted\"\n" + std::to_string( u % 50 ) : "name" + std::to_string( u % 50 );
+      REQUIRE( table_.cell_get_variant_view( u, 1u ).as_string() == stringName );
+   }
+
+   gd::table::dto::table tableError( 0u, { { "int64", 0, "id" }, { "rstring", 0, "name" } }, gd::table::tag_prepare{} );
+   result_ = gd::table::read_g( tableError, std::string_view( "1,a\n2,\"b\n" ), ',', '\n', gd::table::tag_io_csv{}, gd::table::tag_parallel{} );
+   REQUIRE( result_.first == false );                                         // missing end quote
+}
+
+TEST_CASE("[table] write json and csv", "[table]")
+{
+   gd::table::dto::table table_( 1u, { { "int32", 0, "id" }, { "double", 0, "value" }, { "rstring", 0, "name" }, { "bool", 0, "flag" } }, gd::table::tag_prepare{} );
+   table_.row_add( { gd::variant_view( (int32_t)-1 ), gd::variant_view( 2.5 ), gd::variant_view( "say \"hi\"\n" ), gd::variant_view( true ) } );
+   table_.row_add( gd::table::tag_null{} );
+   table_.cell_set( 1u, 0u, gd::variant_view( (int32_t)42 ) );
+   table_.cell_set( 1u, 1u, gd::variant_view( 100.0 ) );
+
+   std::string stringJson;
+   gd::table::to_string( table_, 0, 2, gd::argument::arguments( { { "format", "escape" } } ), nullptr, stringJson, gd::table::tag_io_json{} );
+   REQUIRE( stringJson == "[-1,2.5,\"say \\\"hi\\\"\\n\",1],\n[42,100,null,null]\n" );
+
+   // ## selected rows do not read "format" option, text is copied as is
+   std::string stringSelected;
+   gd::table::to_string( table_, std::vector<uint64_t>{ 1, 0 }, gd::argument::arguments( { { "format", "escape" } } ), nullptr, stringSelected, gd::table::tag_io_json{} );
+   REQUIRE( stringSelected == "[42,100,null,null],\n[-1,2.5,\"say \"hi\"\n\",1]\n" );
+
+   std::string stringCsv;
+   gd::table::to_string( table_, 0, 2, gd::argument::arguments(), std::function<bool( const std::string_view&, std::string& )>(), stringCsv, gd::table::tag_io_csv{} );
+   REQUIRE( stringCsv == "-1,2.5,\"say \"\"hi\"\"\\\n\",1,\n42,100,,\n" );
+
+   // ## fixed size numbers and text with length are read from row buffer, each native size and null
+   {
+      gd::table::dto::table tableFixed( 1u, { { "int8", 0, "i8" }, { "uint16", 0, "u16" }, { "int64", 0, "i64" }, { "uint64", 0, "u64" }, { "float", 0, "f" }, { "string", 10, "text" } }, gd::table::tag_prepare{} );
+      tableFixed.row_add( { gd::variant_view( (int8_t)-7 ), gd::variant_view( (uint16_t)65535 ), gd::variant_view( (int64_t)-9000000000 ), gd::variant_view( (uint64_t)18446744073709551615ull ), gd::variant_view( 1.5f ), gd::variant_view( "a\"b" ) } );
+      tableFixed.row_add( gd::table::tag_null{} );
+      tableFixed.cell_set( 1u, 1u, gd::variant_view( (uint16_t)3 ) );
+      tableFixed.cell_set( 1u, 5u, gd::variant_view( "" ) );
+      std::string stringFixed;
+      gd::table::to_string( tableFixed, 0, 2, gd::argument::arguments( { { "format", "escape" } } ), nullptr, stringFixed, gd::table::tag_io_json{} );
+      REQUIRE( stringFixed == "[-7,65535,-9000000000,18446744073709551615,1.500000,\"a\\\"b\"],\n[null,3,null,null,null,\"\"]\n" );
+      stringFixed.clear();
+      gd::table::to_string( tableFixed, 0, 2, gd::argument::arguments(), std::function<bool( const std::string_view&, std::string& )>(), stringFixed, gd::table::tag_io_csv{} );
+      REQUIRE( stringFixed == "-7,65535,-9000000000,18446744073709551615,1.500000,\"a\"\"b\",\n,3,,,,\"\"\n" );
+   }
+
+   // ## stream rows in chunks, all chunks together are the same as json written to string
+   for( uint64_t u = 0; u < 20000; u++ ) table_.row_add( { gd::variant_view( (int32_t)u ), gd::variant_view( u * 0.25 ), gd::variant_view( "name" ), gd::variant_view( false ) } );
+   std::string stringAll, stringBuffer, stringStream;
+   unsigned uChunkCount = 0;
+   gd::table::to_string( table_, 0, table_.get_row_count(), gd::argument::arguments(), nullptr, stringAll, gd::table::tag_io_json{} );
+   gd::table::write_g( table_, 0, table_.get_row_count(), gd::argument::arguments(), stringBuffer, [&]( std::string_view stringChunk ) { stringStream += stringChunk; uChunkCount++; }, gd::table::tag_io_json{} );
+   REQUIRE( stringStream == stringAll );
+   REQUIRE( uChunkCount > 1 );
+   REQUIRE( stringBuffer.empty() == true );
+}
+
 
 
 
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <filesystem>
 
 #include "gd/gd_file.h"
@@ -7,6 +8,9 @@
 #include "gd/gd_table_column-buffer.h"
 #include "gd/gd_table_io.h"
 #include "gd/gd_sql_value.h"
+#include "gd/expression/gd_expression_token.h"
+#include "gd/expression/gd_expression_method_01.h"
+#include "gd/expression/gd_expression_runtime.h"
 
 
 //#include "tool/Tool_SSHClient.h"
@@ -16,6 +20,9 @@
 
 #include "../Command.h"
 
+#include "../automation/code-analysis/Expression.h"
+#include "../automation/code-analysis/Run.h"
+
 #include "catch2/catch_amalgamated.hpp"
 
 // - take directories
@@ -157,4 +164,97 @@ TEST_CASE("[file] test", "[file]")
 
    std::cout << iCount << " " << "Rows" << "\n";
 
-}
\ No newline at end of file
+}
+
+
+namespace {
+   /// Run where expression with interpreter for each row and return value in column "id" for rows that match
+   std::vector<int64_t> where_interpret_( const std::string& stringExpression, gd::table::dto::table* ptable_ )
+   {
+      using namespace gd::expression;
+      std::vector<token> vectorToken, vectorPostfix;
+      auto result_ = token::parse_s( stringExpression, vectorToken, tag_formula{} );                REQUIRE( result_.first == true );
+      result_ = token::compile_s( vectorToken, vectorPostfix, tag_postfix{} );                      REQUIRE( result_.first == true );
+
+      runtime runtime_;
+      runtime_.add( { (unsigned)uMethodDefaultSize_g, pmethodDefault_g, "" } );
+      runtime_.add( { (unsigned)uMethodStringSize_g, pmethodString_g, std::string( "str" ) } );
+      runtime_.add( { (unsigned)AUTOMATION::uMethodSelectSize_g, AUTOMATION::pmethodSelect_g, std::string( "source" ) } );
+      runtime_.set_variable( "dtotable", std::pair<const char*, void*>( "dtotable", ptable_ ) );
+
+      std::vector<int64_t> vectorId;
+      for( uint64_t uRow = 0; uRow < ptable_->size(); uRow++ )
+      {
+         runtime_.set_variable( "row", (int64_t)uRow );
+         std::vector<value> vectorReturn;
+         result_ = token::calculate_s( vectorPostfix, &vectorReturn, runtime_ );                    REQUIRE( result_.first == true );
+         bool bWhere = std::any_of( vectorReturn.begin(), vectorReturn.end(), []( const value& v_ ) { return v_.is_bool() == true && v_.get_bool() == true; } );
+         if( bWhere == true ) vectorId.push_back( ptable_->cell_get_variant_view( uRow, "id" ).as_int64() );
+      }
+      return vectorId;
+   }
+}
+
+TEST_CASE("[where] compiled plan selects same rows as interpreter", "[where]")
+{
+   using namespace gd::table::dto;
+   // ## more rows than one chunk in compiled plan, columns with different types and null values
+   table table_( table::eTableFlagNull32, { { "int64", 0, "id" }, { "int32", 0, "count" }, { "double", 0, "value" }, { "rstring", 0, "name" }, { "string", 20, "text" }, { "int16", 0, "small" }, { "float", 0, "ratio" } }, gd::table::tag_prepare{} );
+   const char* ppbszName[] = { "a", "b", "c", "bb", "" };
+   for( int64_t i = 0; i < 10000; i++ )
+   {
+      uint64_t uRow = table_.row_add_one();
+      table_.cell_set( uRow, 0u, gd::variant_view( i ) );
+      if( i % 7 == 0 ) table_.cell_set_null( uRow, 1u ); else table_.cell_set( uRow, 1u, gd::variant_view( int32_t( i % 11 ) - 3 ) );
+      if( i % 5 == 0 ) table_.cell_set_null( uRow, 2u ); else table_.cell_set( uRow, 2u, gd::variant_view( double( i % 13 ) * 0.5 ) );
+      if( i % 3 == 0 ) table_.cell_set_null( uRow, 3u ); else table_.cell_set( uRow, 3u, gd::variant_view( ppbszName[i % 5] ) );
+      table_.cell_set( uRow, 4u, gd::variant_view( ppbszName[(i / 2) % 5] ) );
+      if( i % 9 == 0 ) table_.cell_set_null( uRow, 5u ); else table_.cell_set( uRow, 5u, gd::variant_view( int16_t( i % 300 - 150 ) ) );
+      if( i % 4 == 0 ) table_.cell_set_null( uRow, 6u ); else table_.cell_set( uRow, 6u, gd::variant_view( float( i % 17 ) * 0.25f ) );
+   }
+
+   auto column_ = []( const char* pbszName ) { return "source::get_cell_value( dtotable, row, '" + std::string( pbszName ) + "' )"; };
+   std::string stringCount = column_( "count" ), stringValue = column_( "value" ), stringName = column_( "name" ), stringText = column_( "text" ), stringId = column_( "id" );
+   std::string stringSmall = column_( "small" ), stringRatio = column_( "ratio" );
+
+   std::vector<std::string> vectorExpression = {
+      stringCount + " > 5",
+      stringCount + " == 3",
+      stringCount + " != 3",
+      stringCount + " <= -1",
+      stringCount + " >= '4'",                                                 // constant converted to column type
+      stringCount + " == 2.0",
+      stringValue + " < 2.5",
+      stringValue + " == 3",
+      stringValue + " >= 1",
+      stringSmall + " < -100",                                                 // fixed size columns read at row stride
+      stringSmall + " == 0",
+      stringRatio + " >= 2.5",
+      stringRatio + " != 1",
+      stringId + " <= 17",
+      stringName + " == 'b'",
+      stringName + " != 'a'",
+      stringName + " < 'bb'",
+      stringText + " == ''",
+      stringText + " > 'a'",
+      stringName + " == " + stringText,                                        // column compared with column
+      stringValue + " > " + stringCount,
+      "5 < " + stringCount,                                                    // constant to the left
+      stringName + " != 'a' && " + stringCount + " >= 2",
+      stringValue + " > 1 || " + stringName + " < 'c'",
+      stringId + " > 100 && (" + stringValue + " < 3 || " + stringName + " == 'c')",
+      "(" + stringCount + " == 1 || " + stringCount + " != 1) && " + stringText + " != 'c'",
+   };
+
+   for( const auto& stringExpression : vectorExpression )
+   {
+      INFO( stringExpression );
+      table tableWhere( table_ );
+      std::vector<int64_t> vectorExpected = where_interpret_( stringExpression, &tableWhere );
+
+      auto result_ = RunExpression_WhereExpression_g( stringExpression, &tableWhere );             REQUIRE( result_.first == true );
+      std::vector<int64_t> vectorId;
+      for( uint64_t uRow = 0; uRow < tableWhere.size(); uRow++ ) vectorId.push_back( tableWhere.cell_get_variant_view( uRow, "id" ).as_int64() );
+      REQUIRE( vectorId == vectorExpected );
+   }
+}
@@ -0,0 +1,80 @@
+// @FILE [tag: log, binary, tool] [summary: Decode binary log files written by printer_binary to text] [type: source] [name: main.cpp]
+
+/**
+ * \file main.cpp
+ *
+ * \brief Print binary log file as text, one line for each message
+ *
+ * Usage: `logdecode <file> [--source] [--severity <name>]`
+ * - `--source` add source file and line for deferred messages
+ * - `--severity` skip messages with lower severity, name is FATAL, ERROR, WARNING, INFORMATION, DEBUG or VERBOSE
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gd/gd_log_logger.h"
+#include "gd/gd_log_logger_binary.h"
+
+/// Format time as local date and time with milliseconds
+static std::string time_to_string_s( uint64_t uTime )
+{
+   std::time_t time_ = std::time_t( uTime / 1'000'000'000 );
+   std::tm tm_{};
+#ifdef _WIN32
+   localtime_s( &tm_, &time_ );
+#else
+   localtime_r( &time_, &tm_ );
+#endif
+   char pbszBuffer[64];
+   size_t uLength = std::strftime( pbszBuffer, sizeof( pbszBuffer ), "%Y-%m-%d %H:%M:%S", &tm_ );
+   std::snprintf( pbszBuffer + uLength, sizeof( pbszBuffer ) - uLength, ".%03u", unsigned( ( uTime / 1'000'000 ) % 1000 ) );
+   return pbszBuffer;
+}
+
+int main( int iArgumentCount, char** ppbszArgument )
+{
+   if( iArgumentCount < 2 ) { std::fprintf( stderr, "usage: logdecode <file> [--source] [--severity <name>]\n" ); return 1; }
+
+   bool bSource = false;
+   unsigned uSeverity = 0;
+   for( int i = 2; i < iArgumentCount; i++ )
+   {
+      std::string_view stringArgument( ppbszArgument[i] );
+      if( stringArgument == "--source" ) bSource = true;
+      else if( stringArgument == "--severity" && i + 1 < iArgumentCount ) uSeverity = gd::log::severity_get_type_number_g( ppbszArgument[++i] );
+      else { std::fprintf( stderr, "unknown argument: %s\n", ppbszArgument[i] ); return 1; }
+   }
+
+   std::ifstream ifstreamLog( ppbszArgument[1], std::ios::binary );
+   if( ifstreamLog.is_open() == false ) { std::fprintf( stderr, "unable to open %s\n", ppbszArgument[1] ); return 1; }
+   std::stringstream stringstreamLog;
+   stringstreamLog << ifstreamLog.rdbuf();
+   std::string stringData = stringstreamLog.str();
+
+   auto result_ = gd::log::binary_decode_g( stringData, [&]( const gd::log::binary_record& record_ ) {
+      unsigned uNumber = record_.m_uSeverity & static_cast<unsigned>( gd::log::enumSeverityMask::eSeverityMaskNumber );
+      if( uSeverity != 0 && uNumber > uSeverity ) return true;
+
+      std::string stringLine = time_to_string_s( record_.m_uTime );
+      stringLine += "  [";
+      stringLine += gd::log::severity_get_name_g( record_.m_uSeverity );
+      stringLine += "]  ";
+      if( bSource == true && record_.m_stringFile.empty() == false )
+      {
+         stringLine += record_.m_stringFile;
+         stringLine += "(" + std::to_string( record_.m_uLine ) + ")  ";
+      }
+      stringLine += record_.m_stringText;
+      stringLine += '\n';
+      std::fwrite( stringLine.data(), 1, stringLine.size(), stdout );
+      return true;
+   });
+
+   if( result_.first == false ) { std::fprintf( stderr, "%s\n", result_.second.c_str() ); return 2; }
+   return 0;
+}
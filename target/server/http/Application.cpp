@@ -301,6 +301,16 @@ std::pair<bool, std::string> CApplication::Initialize()
          unsigned uSeverityLevel = PROPERTY_Get( "log-level" ).as_uint();
          plogger->set_severity_Level( uSeverityLevel );                        // set severity filter level
       }
+
+      // ## async logging, request threads only copy message to queue and printers run on log thread
+      if( PROPERTY_Get( "log-async" ).is_null() == false )
+      {
+         std::string stringOverflow = PROPERTY_Get( "log-async" ).as_string();
+         unsigned uOverflow = gd::log::eOverflowBlock;
+         if( stringOverflow == "drop" ) uOverflow = gd::log::eOverflowDrop;
+         else if( stringOverflow == "sample" ) uOverflow = gd::log::eOverflowSample;
+         plogger->async_start( uOverflow );
+      }
    }
 
    // ## create main document .................................................
@@ -397,6 +407,8 @@ std::pair<bool, std::string> CApplication::Configure(const gd::cli::options& opt
       if( result_.first == false ) return result_;
       m_pdocumentActive->SetDatabase(pdatabaseOpen);
       if( pdatabaseOpen != nullptr ) pdatabaseOpen->release();
+      result_ = m_pdocumentActive->DATABASE_OpenPool( argumentsOpen );       // connections used by server requests
+      if( result_.first == false ) return result_;
                                                                                                    LOG_INFORMATION_RAW( "Open database: " & stringOpen & "\n");
       auto database_meta_tables_ = PROPERTY_Get( arguments_, "database-meta-tables" );
       auto database_meta_columns_ = PROPERTY_Get( arguments_, "database-meta-columns" );
@@ -774,6 +786,7 @@ std::pair<bool, std::string> CApplication::DATABASE_Connect( const gd::argument:
       m_pdocumentActive->SetDatabase(pdatabaseOpen);
 
       result_ = m_pdocumentActive->DATABASE_PrepareConnection( argumentsConnect );  // prepare database connection, this is needed to be able to set connection specific settings like dialect and metadata
+      if( result_.first == true ) { result_ = m_pdocumentActive->DATABASE_OpenPool( argumentsOpen ); } // connections used by server requests
 
       if( pdatabaseOpen != nullptr ) pdatabaseOpen->release();
 
@@ -32,6 +32,7 @@ namespace gd { namespace cli { class options; } }
 * - file-log : log file name
 * - log-console : log console severity
 * - log-level : log severity level
+* - log-async : log from background thread, value is overflow policy "block", "drop" or "sample"
 * - folder-root : root folder for site
 * - system-treadcount : number of threads to use
 * - ip : ip address to bind to
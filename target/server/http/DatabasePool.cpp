@@ -0,0 +1,269 @@
+// @FILE [tag: database, pool] [summary: Pool of database connections for document] [type: source] [name: DatabasePool.cpp]
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "gd/gd_database_sqlite.h"
+
+#include "DatabasePool.h"
+
+// ----------------------------------------------------------------------------
+// ----------------------------------------------------------------- connection
+// ----------------------------------------------------------------------------
+
+CDatabasePool::connection::~connection()
+{
+   clear_statement();                                                          // statements need to be released before connection is closed
+   m_pdatabase->release();
+   m_pdatabase = nullptr;
+}
+
+/**  -------------------------------------------------------------------------- prepare
+ * @brief Get prepared statement for sql from connection cache
+ *
+ * If sql is found in cache the statement is reset (bindings cleared) and returned,
+ * if not found a new statement is prepared and added to cache. When cache is full
+ * the least recently used statement is released.
+ *
+ * Statements from cache can only be used by one caller at the time, release
+ * returned cursor before connection is returned to pool.
+ *
+ * @param stringSql sql text for statement
+ * @param ppcursor receives cursor with prepared statement, caller need to release it
+ * @return true if ok, false and error information if prepare failed
+ */
+std::pair<bool, std::string> CDatabasePool::connection::prepare( std::string_view stringSql, gd::database::cursor_i** ppcursor )
+{                                                                                                  assert( ppcursor != nullptr );
+   uint64_t uHash = std::hash<std::string_view>{}( stringSql );
+
+   // ## check cache for statement
+   for( auto it = m_vectorStatement.begin(); it != m_vectorStatement.end(); it++ )
+   {
+      if( it->m_uHash != uHash || it->m_stringSql != stringSql ) continue;
+
+      auto* pcursor = static_cast<gd::database::sqlite::cursor_i*>( it->m_pcursor );              assert( pcursor->m_iReference == 1 && "cached statement is still in use" );
+      auto result_ = pcursor->m_pcursor->reset();                              // clear bindings and move statement to start
+      if( result_.first == false )                                             // last step failed, prepare new statement
+      {
+         pcursor->release();
+         m_vectorStatement.erase( it );
+         break;
+      }
+
+      it->m_uUse = ++m_uUseCounter;
+      pcursor->add_reference();
+      *ppcursor = pcursor;
+      return { true, "" };
+   }
+
+   // ## prepare new statement
+   gd::database::cursor_i* pcursor = nullptr;
+   auto result_ = m_pdatabase->get_cursor( &pcursor );
+   if( result_.first == false ) { return result_; }
+
+   result_ = pcursor->prepare( stringSql );
+   if( result_.first == false ) { pcursor->release(); return result_; }
+
+   // ## cache is full, release least recently used statement
+   if( m_vectorStatement.size() >= CDatabasePool::m_uStatementMax_s )
+   {
+      auto itOldest = std::min_element( m_vectorStatement.begin(), m_vectorStatement.end(), []( const statement& s1, const statement& s2 ) { return s1.m_uUse < s2.m_uUse; } );
+      itOldest->m_pcursor->release();
+      *itOldest = std::move( m_vectorStatement.back() );
+      m_vectorStatement.pop_back();
+   }
+
+   m_vectorStatement.push_back( statement{ uHash, std::string( stringSql ), pcursor, ++m_uUseCounter } );
+
+   pcursor->add_reference();
+   *ppcursor = pcursor;
+   return { true, "" };
+}
+
+/// Reset statements, a statement that is not read to end keeps read transaction open and connection would read old data
+void CDatabasePool::connection::reset_statement()
+{
+   for( auto& it : m_vectorStatement ) { static_cast<gd::database::sqlite::cursor_i*>( it.m_pcursor )->m_pcursor->reset(); }
+}
+
+/// Release all cached statements for connection
+void CDatabasePool::connection::clear_statement()
+{
+   for( auto& it : m_vectorStatement ) { it.m_pcursor->release(); }
+   m_vectorStatement.clear();
+}
+
+// ----------------------------------------------------------------------------
+// --------------------------------------------------------------------- borrow
+// ----------------------------------------------------------------------------
+
+void CDatabasePool::borrow::release()
+{
+   if( m_pconnection != nullptr )
+   {                                                                                               assert( m_pdatabasepool != nullptr );
+      m_pconnection->reset_statement();
+      m_pdatabasepool->Release( m_pconnection );
+      m_pconnection = nullptr;
+   }
+}
+
+// ----------------------------------------------------------------------------
+// -------------------------------------------------------------- CDatabasePool
+// ----------------------------------------------------------------------------
+
+/**  -------------------------------------------------------------------------- Open
+ * @brief Open connections to sqlite database file
+ *
+ * Opens one write connection and `read-count` read-only connections. Write
+ * connection sets database in WAL mode, in WAL mode readers and the writer
+ * work at the same time.
+ *
+ * @param argumentsOpen open arguments
+ * @param argumentsOpen.file database file
+ * @param argumentsOpen.read-count number of read connections, 0 = `hardware_concurrency`
+ * @return true if ok, false and error information if connection failed to open
+ */
+std::pair<bool, std::string> CDatabasePool::Open( const gd::argument::arguments& argumentsOpen )
+{
+   std::string stringFile = argumentsOpen["file"].as_string();
+   if( stringFile.empty() == true || stringFile == ":memory:" ) { return { false, "database pool needs database file" }; }
+   if( Empty() == false ) { return { false, "database pool is already open" }; }
+
+   unsigned uReadCount = argumentsOpen["read-count"].as_uint();
+   if( uReadCount == 0 ) { uReadCount = std::max( 1u, std::thread::hardware_concurrency() ); }
+
+   auto result_ = Add( stringFile, eConnectionWrite );                         // write connection first, it sets journal mode
+   if( result_.first == false ) { return result_; }
+
+   for( unsigned u = 0; u < uReadCount; u++ )
+   {
+      result_ = Add( stringFile, eConnectionRead );
+      if( result_.first == false ) { Close(); return result_; }
+   }
+
+   return { true, "" };
+}
+
+/**  -------------------------------------------------------------------------- Close
+ * @brief Close all connections, waits until all borrowed connections are returned.
+ */
+void CDatabasePool::Close()
+{
+   std::unique_lock<std::mutex> lock_{ m_mutexPool };
+   m_conditionConnectionAvailable.wait( lock_, [this]
+   {
+      for( const auto& pconnection_ : m_vectorConnection ) { if( pconnection_->m_bInUse.load( std::memory_order_acquire ) == true ) return false; }
+      return true;
+   });
+
+   m_vectorConnection.clear();
+}
+
+/**  -------------------------------------------------------------------------- Acquire
+ * @brief Borrow an idle connection of type.
+ *
+ * Read requests get a read connection, if pool do not have any read connections
+ * the write connection is used. If all matching connections are busy the call
+ * waits until one is returned or the timeout expires. Connections may be held
+ * by streamed responses for as long as the client reads, so the wait is bounded
+ * and server threads are never parked indefinitely.
+ *
+ * @param uConnection connection type, `eConnectionRead` or `eConnectionWrite`
+ * @param millisecondsTimeout max time to wait for a busy connection
+ * @return `borrow` RAII token wrapping the connection, empty if pool is empty or timeout expired
+ */
+CDatabasePool::borrow CDatabasePool::Acquire( unsigned uConnection, std::chrono::milliseconds millisecondsTimeout )
+{
+   std::unique_lock<std::mutex> lock_{ m_mutexPool };
+   if( m_vectorConnection.empty() == true ) { return borrow{}; }
+
+   if( uConnection == eConnectionRead )
+   {
+      bool bRead = std::any_of( m_vectorConnection.begin(), m_vectorConnection.end(), []( const auto& p_ ) { return p_->is_read(); } );
+      if( bRead == false ) { uConnection = eConnectionWrite; }
+   }
+
+   const auto timeDeadline = std::chrono::steady_clock::now() + millisecondsTimeout;
+   while( true )
+   {
+      for( auto& pconnection_ : m_vectorConnection )
+      {
+         if( pconnection_->m_uType != uConnection ) { continue; }
+
+         bool bExpectedIdle = false;
+         if( pconnection_->m_bInUse.compare_exchange_strong( bExpectedIdle, true, std::memory_order_acquire, std::memory_order_relaxed ) )
+         {
+            return borrow{ *pconnection_, this };
+         }
+      }
+
+      if( std::chrono::steady_clock::now() >= timeDeadline ) { return borrow{}; } // timeout, caller decides how to report busy pool
+      m_conditionConnectionAvailable.wait_until( lock_, timeDeadline );       // all matching connections busy, wait for one to be returned
+   }
+}
+
+size_t CDatabasePool::Size() const
+{
+   std::lock_guard<std::mutex> lockguardPool{ m_mutexPool };
+   return m_vectorConnection.size();
+}
+
+bool CDatabasePool::Empty() const
+{
+   std::lock_guard<std::mutex> lockguardPool{ m_mutexPool };
+   return m_vectorConnection.empty();
+}
+
+
+// ## internal helpers ---------------------------------------------------------
+
+/**  -------------------------------------------------------------------------- Add
+ * @brief Open sqlite connection and add it to pool
+ *
+ * Connections are opened in serialized mode (`SQLITE_OPEN_FULLMUTEX`). A cursor
+ * streamed to client after request is done keeps the connection borrowed, the
+ * stream owns the borrow and returns it when all rows are read.
+ *
+ * @param stringFile database file
+ * @param uConnection connection type, read connections are opened read-only
+ * @return true if ok, false and error information if open failed
+ */
+std::pair<bool, std::string> CDatabasePool::Add( const std::string& stringFile, unsigned uConnection )
+{
+   unsigned uFlags = SQLITE_OPEN_FULLMUTEX;
+   if( uConnection == eConnectionRead ) { uFlags |= SQLITE_OPEN_READONLY; }
+   else                                 { uFlags |= SQLITE_OPEN_READWRITE; }
+
+   auto* pdatabase = new gd::database::sqlite::database_i( "sqlite" );
+   auto result_ = pdatabase->m_pdatabase->open( stringFile, uFlags );
+   if( result_.first == false ) { pdatabase->release(); return result_; }
+   pdatabase->set( "dialect", "sqlite" );
+
+   // ## connection settings
+   std::string stringBusyTimeout = "PRAGMA busy_timeout = " + std::to_string( m_uBusyTimeout_s ) + ";";
+   result_ = pdatabase->execute( stringBusyTimeout );
+   if( result_.first == true && uConnection == eConnectionWrite )
+   {
+      result_ = pdatabase->execute( "PRAGMA journal_mode = WAL;" );           // readers and writer work at the same time
+      if( result_.first == true ) result_ = pdatabase->execute( "PRAGMA synchronous = NORMAL;" ); // safe in WAL mode, sync at checkpoint
+      if( result_.first == true ) result_ = pdatabase->execute( "PRAGMA foreign_keys = ON;" );
+   }
+
+   if( result_.first == false ) { pdatabase->release(); return result_; }
+
+   std::lock_guard<std::mutex> lockguardPool{ m_mutexPool };
+   m_vectorConnection.emplace_back( std::make_unique<connection>( next_id(), uConnection, pdatabase ) );
+
+   return { true, "" };
+}
+
+/// Clear in-use flag, the lock makes sure waiting callers do not miss the notification
+void CDatabasePool::Release( connection* pconnection )
+{
+   {
+      std::lock_guard<std::mutex> lockguardPool{ m_mutexPool };
+      pconnection->m_bInUse.store( false, std::memory_order_release );
+   }
+   m_conditionConnectionAvailable.notify_all();
+}
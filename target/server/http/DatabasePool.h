@@ -0,0 +1,253 @@
+/**
+ * @FILE [tag: database, pool, web_server] [summary: Pool of database connections for document, one writer and many readers]
+ *
+ * @brief Manages connections to the document database so requests running on
+ *        different server threads do not share one connection. Each connection
+ *        has a numeric id, a type (write or read) and an in-use flag that is set
+ *        atomically when a caller acquires the connection.
+ *
+ * ## Usage
+ *
+ * Acquire a connection with `Acquire( eConnectionRead )` or `Acquire( eConnectionWrite )`.
+ * The pool marks one idle connection as in-use and wraps it in an RAII `borrow`
+ * token. The flag is cleared automatically when the `borrow` goes out of scope.
+ *
+~~~{.cpp}
+auto borrow_ = pdocument->DATABASE_GetPool()->Acquire( CDatabasePool::eConnectionRead );
+gd::com::pointer<gd::database::cursor_i> pcursor;
+borrow_.prepare( "SELECT * FROM TUser", &pcursor );                            // prepared statement is cached in connection
+pcursor->open();
+// release cursor before borrow, in-use flag cleared when borrow is destroyed
+~~~
+ *
+ * - `class CDatabasePool` - Owns all `connection` objects
+ * - `struct connection`   - One database connection with id, type, in-use flag and statement cache
+ * - `struct borrow`       - RAII guard; clears in-use flag on destruction
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gd/gd_arguments.h"
+#include "gd/gd_com.h"
+#include "gd/gd_database.h"
+
+/**
+ * @CLASS [tag: database, pool, concurrency] [summary: Thread-safe pool of database connections]
+ *
+ * @brief The pool owns **all** connections for their entire lifetime. Callers
+ *        never take ownership; they receive a `borrow` token that holds a
+ *        non-owning pointer and clears the in-use flag on destruction.
+ *
+ *        SQLite only allows one writer so there is one write connection, read
+ *        connections are opened read-only and the database is set to WAL mode
+ *        so readers do not block the writer or each other.
+ *
+ * **Thread safety**: All public methods are thread-safe.
+ * **Blocking behaviour**: `Acquire()` waits at most `m_uAcquireTimeout_s` milliseconds
+ *   when every matching connection is in use, then returns an empty borrow.
+ * **Read fallback**: if pool do not have read connections, read requests get the write connection.
+ */
+class CDatabasePool
+{
+// ## types --------------------------------------------------------------------
+public:
+   enum enumConnection
+   {
+      eConnectionWrite = 0x01,   ///< read and write connection, only one in pool
+      eConnectionRead  = 0x02,   ///< read only connection
+   };
+
+   // --------------------------------------------------------------------------
+   /**
+    * @CLASS [tag: database, pool] [summary: Owned connection record — database connection with identity, status and statement cache]
+    *
+    * @brief The `m_bInUse` flag is the only field written concurrently, the
+    *        statement cache is only touched by the caller that has the
+    *        connection borrowed.
+    *
+    *        Non-copyable, non-movable (borrow tokens point to this object).
+    */
+   struct connection
+   {
+      /// cached prepared statement, key is the sql text
+      struct statement
+      {
+         uint64_t m_uHash;                         ///< hash for sql text, compared before text
+         std::string m_stringSql;                  ///< sql text statement is prepared from
+         gd::database::cursor_i* m_pcursor;        ///< cursor holding prepared statement, owned by cache
+         uint64_t m_uUse;                          ///< last use, used to find least recently used statement
+      };
+
+   // ## construction ----------------------------------------------------------
+      connection() = delete;
+      connection( uint64_t uId, unsigned uType, gd::database::database_i* pdatabase ): m_uId{ uId }, m_uType{ uType }, m_bInUse{ false }, m_pdatabase{ pdatabase } { assert( pdatabase != nullptr ); }
+      ~connection();
+
+      connection( const connection& ) = delete;
+      connection& operator=( const connection& ) = delete;
+      connection( connection&& ) = delete;
+      connection& operator=( connection&& ) = delete;
+
+   // ## methods ---------------------------------------------------------------
+      bool is_read() const { return m_uType == eConnectionRead; }
+
+      /// Get prepared statement for sql from cache or prepare new and add it to cache
+      std::pair<bool, std::string> prepare( std::string_view stringSql, gd::database::cursor_i** ppcursor );
+      /// Reset cached statements, ends read transactions for statements not read to end
+      void reset_statement();
+      /// Release all cached statements
+      void clear_statement();
+
+   // ## attributes ------------------------------------------------------------
+      const uint64_t       m_uId;         ///< unique id assigned at construction, never changes
+      const unsigned       m_uType;       ///< connection type, value from enumConnection
+      std::atomic<bool>    m_bInUse;      ///< true while borrowed by a caller
+      gd::database::database_i* m_pdatabase; ///< owning reference to database connection
+      std::vector<statement> m_vectorStatement; ///< prepared statements for connection
+      uint64_t             m_uUseCounter = 0; ///< incremented each time a statement is used
+   };
+
+
+   // --------------------------------------------------------------------------
+   /**
+    * @CLASS [tag: database, RAII] [summary: Borrow token — clears in-use flag on destruction]
+    *
+    * @brief Non-owning handle to a `connection` inside the pool. Grants
+    *        exclusive access to the connection for the lifetime of the
+    *        `borrow` object. Cursors from `prepare` need to be released
+    *        before the borrow is released.
+    *
+    *        Non-copyable, movable. Default constructed borrow is empty.
+    */
+   struct borrow
+   {
+   // ## construction ----------------------------------------------------------
+      borrow() = default;
+      borrow( connection& connectionTarget, CDatabasePool* pdatabasepool ): m_pconnection{ &connectionTarget }, m_pdatabasepool{ pdatabasepool } {}
+
+      borrow( borrow&& o ) noexcept : m_pconnection{ o.m_pconnection }, m_pdatabasepool{ o.m_pdatabasepool } { o.m_pconnection = nullptr; }
+
+      borrow& operator=( borrow&& o ) noexcept
+      {
+         if( this != &o )
+         {
+            release();
+            m_pconnection   = o.m_pconnection;
+            m_pdatabasepool = o.m_pdatabasepool;
+            o.m_pconnection = nullptr;
+         }
+         return *this;
+      }
+
+      borrow( const borrow& ) = delete;
+      borrow& operator=( const borrow& ) = delete;
+
+      ~borrow() { release(); }
+
+   // ## operators -------------------------------------------------------------
+      gd::database::database_i* operator->() const { assert( m_pconnection != nullptr ); return m_pconnection->m_pdatabase; }
+      explicit operator bool() const { return m_pconnection != nullptr; }
+
+   // ## interface -------------------------------------------------------------
+      gd::database::database_i* get() const { return m_pconnection != nullptr ? m_pconnection->m_pdatabase : nullptr; }
+      bool empty() const { return m_pconnection == nullptr; }
+      bool is_read() const { return m_pconnection != nullptr && m_pconnection->is_read(); }
+
+      /**  -------------------------------------------------------------------------- id
+       * @brief Id of the borrowed connection.
+       * @return Unique numeric id.
+       */
+      uint64_t id() const { assert( m_pconnection != nullptr ); return m_pconnection->m_uId; }
+
+      /// Get prepared statement from connection cache, cursor is reset and ready to bind values and open
+      std::pair<bool, std::string> prepare( std::string_view stringSql, gd::database::cursor_i** ppcursor ) { assert( m_pconnection != nullptr ); return m_pconnection->prepare( stringSql, ppcursor ); }
+
+      /// Return connection to pool
+      void release();
+
+   // ## attributes ------------------------------------------------------------
+   private:
+      connection* m_pconnection = nullptr;      ///< non-owning; pool is the sole owner
+      CDatabasePool* m_pdatabasepool = nullptr; ///< pool to notify when connection is returned
+   };
+
+
+// ## construction -------------------------------------------------------------
+public:
+   CDatabasePool() {}
+   ~CDatabasePool() { Close(); }
+
+   CDatabasePool( const CDatabasePool& ) = delete;
+   CDatabasePool& operator=( const CDatabasePool& ) = delete;
+   CDatabasePool( CDatabasePool&& ) = delete;
+   CDatabasePool& operator=( CDatabasePool&& ) = delete;
+
+
+// ## public interface ---------------------------------------------------------
+public:
+
+   /// Open connections to database, "file" is database file and "read-count" number of read connections
+   std::pair<bool, std::string> Open( const gd::argument::arguments& argumentsOpen );
+
+   /// Close all connections, waits until borrowed connections are returned
+   void Close();
+
+   /// Borrow an idle connection of type. Waits `m_uAcquireTimeout_s` if all matching connections are busy.
+   [[nodiscard]] borrow Acquire( unsigned uConnection ) { return Acquire( uConnection, std::chrono::milliseconds( m_uAcquireTimeout_s ) ); }
+   /// Borrow an idle connection of type, empty borrow if none is returned within timeout
+   [[nodiscard]] borrow Acquire( unsigned uConnection, std::chrono::milliseconds millisecondsTimeout );
+
+   /**  -------------------------------------------------------------------------- Size
+    * @brief Total number of connections owned by the pool (idle + in use).
+    * @return Snapshot count.
+    */
+   size_t Size() const;
+
+   /**  -------------------------------------------------------------------------- Empty
+    * @brief True when the pool owns no connections.
+    * @return `true` if the pool is empty.
+    */
+   bool Empty() const;
+
+
+// ## internal helpers ---------------------------------------------------------
+private:
+
+   /// Open one sqlite connection and add it to pool
+   std::pair<bool, std::string> Add( const std::string& stringFile, unsigned uConnection );
+
+   /// Clear in-use flag for connection and wake waiting callers
+   void Release( connection* pconnection );
+
+   /**  -------------------------------------------------------------------------- next_id
+    * @brief Atomically generate the next unique connection id.
+    * @return Monotonically increasing id value.
+    */
+   uint64_t next_id() { return m_uNextConnectionId.fetch_add( 1, std::memory_order_relaxed ); }
+
+
+// ## attributes ---------------------------------------------------------------
+private:
+   std::vector<std::unique_ptr<connection>> m_vectorConnection; ///< sole owner of all connections
+
+   mutable std::mutex      m_mutexPool;                    ///< guards `m_vectorConnection` and waiting for connections
+   std::condition_variable m_conditionConnectionAvailable; ///< signalled when a borrow is released
+
+   std::atomic<uint64_t>   m_uNextConnectionId{ 1 };       ///< monotonic id counter; 0 is reserved as "invalid"
+
+public:
+   inline static unsigned m_uStatementMax_s = 64;          ///< max number of cached statements for each connection
+   inline static unsigned m_uBusyTimeout_s = 5000;         ///< milliseconds connection waits for locked database
+   inline static unsigned m_uAcquireTimeout_s = 2000;      ///< milliseconds `Acquire` waits for a busy connection to be returned
+};
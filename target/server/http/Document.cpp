@@ -30,6 +30,8 @@ CDocument::~CDocument()
       m_vectorTableCache.clear();
    }
 
+   m_pdatabasepool.reset();                                                   // waits for borrowed connections
+
    if( m_pdatabase != nullptr )
    {
       m_pdatabase->release();
@@ -324,8 +326,8 @@ gd::table::arguments::table* CDocument::CACHE_GetTableArguments( const std::stri
 *   table. If the column name starts with a '-', it is treated as a descending sort.
 * - If the column is specified as an integer, the method validates the column index.
 *   A negative index indicates descending order.
-* - The method uses the `sort_null` function of the `gd::table::dto::table` class to
-*   perform the sorting.
+* - The method uses the typed `sort` function of the `gd::table::dto::table` class to
+*   perform the sorting, null values are placed as the smallest value.
 *
 * @pre The cache table identified by `stringId` must exist.
 * @post The rows in the cache table are sorted based on the specified column.
@@ -376,7 +378,7 @@ std::pair<bool, std::string> CDocument::CACHE_Sort(const std::string_view& strin
       if( (unsigned)iColumn >= ptable_->get_column_count() ) { return { false, "Column not found: " + std::to_string(iColumn) }; }
    }
                                                                                                    assert( iColumn >= 0 && (unsigned)iColumn < ptable_->get_column_count() );
-   ptable_->sort_null(iColumn, bAscending);
+   ptable_->sort( { gd::table::sort_key( (unsigned)iColumn, bAscending, bAscending ) } ); // null values are treated as smallest value
 
    return { true, "" };
 }
@@ -527,6 +529,38 @@ std::pair<bool, std::string> CDocument::DATABASE_PrepareConnection( const gd::ar
    return { true, "" };
 }
 
+/** ------------------------------------------------------------------------- DATABASE_OpenPool
+ * @brief Open connection pool to document database
+ *
+ * Requests running in server threads borrow connections from pool instead of
+ * sharing the document connection. Only sqlite files are pooled, for other
+ * databases the pool is not created and the document connection is used.
+ *
+ * @param arguments_ open arguments
+ * @param arguments_.type database type, pool is only opened for "sqlite"
+ * @param arguments_.name database file
+ * @param arguments_.read-count number of read connections, if not set `system-threadcount` property is used
+ * @return true if ok (or database is not pooled), false and error information on error
+ */
+std::pair<bool, std::string> CDocument::DATABASE_OpenPool( const gd::argument::arguments& arguments_ )
+{
+   if( arguments_["type"].as_string_view() != "sqlite" ) { return { true, "" }; }
+
+   std::string stringFile = arguments_["name"].as_string();
+   if( stringFile.empty() == true || stringFile == ":memory:" ) { return { true, "" }; } // memory database can not be shared between connections
+
+   unsigned uReadCount = arguments_["read-count"].as_uint();
+   if( uReadCount == 0 && m_papplication != nullptr ) { uReadCount = m_papplication->PROPERTY_Get( "system-threadcount" ).as_uint(); }
+
+   auto ppool_ = std::make_unique<CDatabasePool>();
+   gd::argument::arguments argumentsPool( { { "file", stringFile }, { "read-count", uReadCount } } );
+   auto result_ = ppool_->Open( argumentsPool );
+   if( result_.first == false ) { return result_; }
+
+   m_pdatabasepool = std::move( ppool_ );
+   return { true, "" };
+}
+
 std::pair<bool, std::string> CDocument::DATABASE_Initialize( const gd::argument::arguments& arguments_ )
 {
    if( m_pMDatabase == nullptr )
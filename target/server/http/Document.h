@@ -30,6 +30,7 @@
 #include "meta/METADatabase.h"
 #include "meta/METAQueries.h"
 
+#include "DatabasePool.h"
 #include "Session.h"
 
 class CApplication;
@@ -244,6 +245,9 @@ public:
    std::pair<bool, std::string> DATABASE_Prepare( const gd::argument::arguments& arguments_ );
    std::pair<bool, std::string> DATABASE_LoadStatements( const gd::argument::arguments& arguments_ );
    std::pair<bool, std::string> DATABASE_LoadExpressions( const gd::argument::arguments& arguments_ );
+   /// Open connection pool for document database, only sqlite databases are pooled
+   std::pair<bool, std::string> DATABASE_OpenPool( const gd::argument::arguments& arguments_ );
+   CDatabasePool* DATABASE_GetPool() { return m_pdatabasepool.get(); }
 
 // ## @API [tag: load] [description: metadata about database]
 
@@ -277,6 +281,7 @@ public:
    gd::argument::shared::arguments m_arguments; ///< document information (members)
 
 	gd::database::database_i* m_pdatabase{};     ///< document database connection if any
+   std::unique_ptr<CDatabasePool> m_pdatabasepool; ///< pool with connections to document database, requests borrow connections from pool
 
    std::unique_ptr<CSessions> m_psessions;      ///< session manager for document if any
 
@@ -309,6 +314,7 @@ public:
 inline void CDocument::SetDatabase(gd::database::database_i* pdatabase_)
 {
    if(m_pdatabase != nullptr) { m_pdatabase->release(); m_pdatabase = nullptr; }
+   m_pdatabasepool.reset();                                                   // pool is connected to previous database
 
 	if(pdatabase_ != nullptr) pdatabase_->add_reference();
    m_pdatabase = pdatabase_;
@@ -168,7 +168,9 @@ std::pair<bool, std::string> CRouter::Run( std::string_view stringQueryString, b
    if(IsCommand() == true)
    {
       // ## parse command path and query arguments and prepare important variables
-      auto [vectorPath, arguments_] = gd::parse::uri::parse_path_and_query(stringQueryString);
+      std::vector<std::string_view> vectorPath;
+      gd::argument::arguments arguments_( m_context.CreateArguments( m_uArgumentsSize_s ) ); // arguments in request arena if router has arena
+      gd::parse::uri::parse_path_and_query(stringQueryString, vectorPath, arguments_);
       if(vectorPath.empty() == true) { return { false, std::string("No command found in query string: " + std::string(stringQueryString)) }; }
 
       // ## If nog arguments, then check if member query string differ and parse that for arguments.
@@ -301,7 +303,9 @@ std::pair<bool, std::string> CRouter::RunXml(pugi::xml_document* pxmldocument_)
 
       std::string_view stringQueryString = xmlattributeQs.value();
       
-      auto [vectorPath, arguments_] = gd::parse::uri::parse_path_and_query(stringQueryString);
+      std::vector<std::string_view> vectorPath;
+      gd::argument::arguments arguments_( m_context.CreateArguments( m_uArgumentsSize_s ) );
+      gd::parse::uri::parse_path_and_query(stringQueryString, vectorPath, arguments_);
       if(vectorPath.empty() == true) { return { false, std::string("No command found in query string: " + std::string(stringQueryString)) }; }
 
       // check if command node has child nodes
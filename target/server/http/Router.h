@@ -111,6 +111,8 @@ public:
 
    bool IsCommand() const { return (m_uFlags & eFlagCommand) != 0; }
    bool IsPrepared() const { return ( m_uFlags & eFlagPrepared ) != 0; }
+   /// True if request failed because all pooled database connections were busy
+   bool IsDatabaseBusy() const { return m_context.IsDatabaseBusy(); }
 
    bool IsBody() const { return m_stringBody.empty() == false; }
    bool IsPage() const { return m_stringPage.empty() == false; }
@@ -126,6 +128,8 @@ public:
 
    void SetResponseData( unsigned uType, void* pData ) { m_pairRequestData = { uType, pData }; }
    void SetSession( const session* psession ) { m_context.SetSession( psession ); }
+   /// Set arena for request, arguments and api objects for request allocate from arena
+   void SetArena( gd::memory::arena<>* parena ) { m_context.SetArena( parena ); }
    // Convenience accessors that forward to m_context so existing call-sites
    // in Run() / Prepare() / PrintResponseXml() do not need to change.
    CApplication* GetApplication()             { return m_context.GetApplication(); }
@@ -149,6 +153,11 @@ public:
    std::pair<bool, std::string> Prepare();
 
    std::pair<bool, std::string> PrintResponseXml( std::string& stringXml, const gd::argument::arguments* parguments_ );
+   /// Offset for stream marker in xml printed by `PrintResponseXml`, npos if no marker
+   uint64_t GetStreamOffset() const { return m_pdtoresponse != nullptr ? m_pdtoresponse->GetStreamOffset() : std::string::npos; }
+
+   /// Detach stream object from response, used to send rows while response is written to client. Stream takes the borrowed database connection.
+   std::unique_ptr<CDTOStream> ReleaseStream();
 
    template<typename APIObject, typename Customize = std::monostate>
    std::pair<bool, std::string> ExecuteCommand_( const std::vector<std::string_view>& vectorPath, const gd::argument::arguments& arguments_, unsigned& uCommandIndex, Customize&& customize = {} );
@@ -171,6 +180,7 @@ public:
 
 // ## free functions ------------------------------------------------------------
 public:
+   inline static unsigned m_uArgumentsSize_s = 512;   ///< buffer size for arguments parsed from query string, grows on heap if query string has more
 
    /// Encode values in arguments for specified names in vectorName
    static std::pair<bool, std::string> Encode_s( gd::argument::arguments& arguments_, const std::vector<std::string>& vectorName );
@@ -195,3 +205,12 @@ inline std::pair<bool, std::string> CRouter::PrintResponseXml( std::string& stri
    }
    return m_pdtoresponse->PrintXml( stringXml, parguments_ );
 }
+
+/// @brief Detach stream from response, stream gets the borrowed connection because cursor is read after router is done
+inline std::unique_ptr<CDTOStream> CRouter::ReleaseStream()
+{
+   if( m_pdtoresponse == nullptr ) { return nullptr; }
+   auto pstream = m_pdtoresponse->ReleaseStream();
+   if( pstream != nullptr ) { pstream->SetBorrow( m_context.ReleaseBorrow() ); }
+   return pstream;
+}
@@ -42,6 +42,30 @@ CServer::~CServer()
 void CServer::common_construct(const CServer& o) {}
 void CServer::common_construct(CServer&& o) noexcept {}
 
+namespace
+{
+   thread_local unsigned uArenaDepth_g = 0;                                    // active arena scopes in thread
+}
+
+/// Arena for thread, created first time thread handles a request
+gd::memory::arena<>& CServer::RequestArena_s()
+{
+   thread_local gd::memory::arena<> arena_( m_uArenaBlockSize_s );
+   return arena_;
+}
+
+CServer::arena_scope::arena_scope(): m_parena( &RequestArena_s() ) { uArenaDepth_g++; }
+
+/// Release memory used by request, blocks are kept for next request unless request needed lots of memory
+CServer::arena_scope::~arena_scope()
+{                                                                                                  assert( uArenaDepth_g > 0 );
+   uArenaDepth_g--;
+   if( uArenaDepth_g > 0 ) return;
+
+   if( m_parena->block_count() > m_uArenaKeepBlocks_s ) m_parena->reset();
+   else                                                 m_parena->clear();
+}
+
 /// @brief Get the listener for the server ----------------------------------
 std::shared_ptr<listener> CServer::GetListener() const { return m_plistener; }
 
@@ -105,6 +129,16 @@ std::pair<bool, std::string> CServer::Initialize( const gd::argument::arguments&
    m_puIndexSettings[ValueIndex_s("ssr-comment")] = m_argumentIndexSettings.get_index("ssr-comment"); // set index for ssr-comment setting
    m_puIndexSettings[ValueIndex_s("ssr-extension")] = m_argumentIndexSettings.get_index("ssr-extension"); // set index for ssr-extension setting   
 
+   // ## split lists in settings once, they are checked for each request ....
+   auto split_ = [](std::string_view stringList, std::vector<std::string>& vectorValue) {
+      std::array<std::string_view, 32> arrayString;
+      auto uCount = gd::utf8::split(stringList, ',', arrayString, gd::utf8::tag_stack{});
+      vectorValue.assign(arrayString.begin(), arrayString.begin() + uCount);
+   };
+   split_(m_argumentSettings["ignore-extension"].as_string_view(), m_vectorIgnoreExtension);
+   split_(m_argumentSettings["ssr-extension"].as_string_view(), m_vectorSSRExtension);
+   split_(m_argumentSettings["ssr-comment"].as_string_view(), m_vectorSSRComment);
+
    return { true, "" };
 }
 
@@ -121,6 +155,108 @@ namespace
       response.prepare_payload();
       return response;
    }
+
+   /** ========================================================================
+    * @brief Beast body used to stream rows from cursor as chunked response
+    *
+    * Body holds response text before and after streamed rows. Writer returns
+    * prefix, then one buffer for each batch read from stream and last the suffix.
+    * Only one batch is in memory while response is written to client.
+    */
+   struct stream_body
+   {
+      struct value_type
+      {
+         std::string m_stringPrefix;            ///< response text before rows
+         std::string m_stringSuffix;            ///< response text after rows
+         std::unique_ptr<CDTOStream> m_pstream; ///< stream with open cursor
+      };
+
+      class writer
+      {
+      public:
+         using const_buffers_type = boost::asio::const_buffer;
+
+         template<bool bRequest, class FIELDS>
+         writer( boost::beast::http::header<bRequest, FIELDS>&, value_type& body_ ): m_body( body_ ) {}
+
+         void init( boost::beast::error_code& errorcode ) { errorcode = {}; }
+
+         boost::optional<std::pair<const_buffers_type, bool>> get( boost::beast::error_code& errorcode )
+         {
+            errorcode = {};
+            if( m_uState == 0 )                                                // prefix
+            {
+               m_uState = 1;
+               return { { boost::asio::buffer( m_body.m_stringPrefix ), true } };
+            }
+
+            while( m_uState == 1 )                                             // rows, skip empty batches
+            {
+               if( m_body.m_pstream == nullptr || m_body.m_pstream->IsEnd() == true ) { m_uState = 2; break; }
+
+               m_stringChunk.clear();
+               auto result_ = m_body.m_pstream->Read( m_stringChunk );
+               if( result_.first == false ) { errorcode = boost::beast::errc::make_error_code( boost::beast::errc::io_error ); return boost::none; }
+               if( m_stringChunk.empty() == false ) { return { { boost::asio::buffer( m_stringChunk ), true } }; }
+            }
+
+            if( m_uState == 2 )                                                // suffix
+            {
+               m_uState = 3;
+               m_body.m_pstream.reset();                                      // all rows read, close cursor
+               return { { boost::asio::buffer( m_body.m_stringSuffix ), false } };
+            }
+
+            return boost::none;
+         }
+
+      private:
+         value_type& m_body;
+         unsigned m_uState = 0;        ///< 0 = prefix, 1 = rows, 2 = suffix, 3 = done
+         std::string m_stringChunk;    ///< buffer for batch that is sent
+      };
+   };
+
+   /** ========================================================================
+    * @brief Beast body for file in static cache, content is sent from memory
+    *
+    * Body holds cached entry so content is valid while response is written even
+    * if file is changed and entry is replaced in cache.
+    */
+   struct cache_body
+   {
+      struct value_type
+      {
+         std::shared_ptr<const CStaticCache::entry> m_pentry; ///< cached file
+         std::string_view m_stringData;                       ///< content in entry for selected encoding
+      };
+
+      static std::uint64_t size( const value_type& body_ ) { return body_.m_stringData.size(); }
+
+      class writer
+      {
+      public:
+         using const_buffers_type = boost::asio::const_buffer;
+
+         template<bool bRequest, class FIELDS>
+         writer( boost::beast::http::header<bRequest, FIELDS>&, const value_type& body_ ): m_body( body_ ) {}
+
+         void init( boost::beast::error_code& errorcode ) { errorcode = {}; }
+
+         boost::optional<std::pair<const_buffers_type, bool>> get( boost::beast::error_code& errorcode )
+         {
+            errorcode = {};
+            if( m_bDone == true || m_body.m_stringData.empty() == true ) return boost::none;
+            m_bDone = true;
+            return { { boost::asio::buffer( m_body.m_stringData.data(), m_body.m_stringData.size() ), false } };
+         }
+
+      private:
+         const value_type& m_body;
+         bool m_bDone = false;         ///< true when content is returned
+      };
+   };
 } // namespace
 
 /** @CRITICAL [tag: server, http, request] [summary: Handle incoming HTTP requests and generate responses]
@@ -229,11 +365,6 @@ boost::beast::http::message_generator                                          /
       }
    }
 
-   // ## Attempt to open the file
-   boost::beast::error_code errorcode_;
-   boost::beast::http::file_body::value_type body_;
-   body_.open(stringPath.c_str(), boost::beast::file_mode::scan, errorcode_);
-
    // ------------------------------------------------------------------------
    // ## Check if server is in SSR mode, if it is, check if file is SSR extension and render it
    if(pserver != nullptr && pserver->IsSSR() == true && pserver->IsSSRExtension(stringPath) )
@@ -250,7 +381,56 @@ boost::beast::http::message_generator                                          /
       }
    }
 
+   // ## Small files are served from memory ..................................
+   std::shared_ptr<const CStaticCache::entry> pentry;
+   if( pserver != nullptr && pserver->GetStaticCache().Find( stringPath, pentry ) == true )
+   {
+      // ### Client has current version, send headers only
+      std::string_view stringIfNoneMatch = request_[boost::beast::http::field::if_none_match];
+      std::string_view stringIfModifiedSince = request_[boost::beast::http::field::if_modified_since];
+      if( CStaticCache::IsNotModified_s( stringIfNoneMatch, stringIfModifiedSince, *pentry ) == true )
+      {
+         boost::beast::http::response<boost::beast::http::empty_body> response_{boost::beast::http::status::not_modified, request_.version()};
+         response_.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
+         response_.set(boost::beast::http::field::etag, pentry->m_stringETag);
+         response_.set(boost::beast::http::field::last_modified, pentry->m_stringLastModified);
+         response_.keep_alive(request_.keep_alive());
+         return response_;
+      }
+
+      auto eEncoding = CStaticCache::SelectEncoding_s( request_[boost::beast::http::field::accept_encoding], *pentry );
+      std::string_view stringData = pentry->get( eEncoding );
+
+      auto set_header_ = [&]( auto& response_ ) {
+         response_.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
+         response_.set(boost::beast::http::field::content_type, mime_type_g(stringPath));
+         response_.set(boost::beast::http::field::etag, pentry->m_stringETag);
+         response_.set(boost::beast::http::field::last_modified, pentry->m_stringLastModified);
+         if( eEncoding == CStaticCache::eEncodingBrotli ) { response_.set(boost::beast::http::field::content_encoding, "br"); }
+         else if( eEncoding == CStaticCache::eEncodingGzip ) { response_.set(boost::beast::http::field::content_encoding, "gzip"); }
+         if( pentry->m_stringGzip.empty() == false || pentry->m_stringBrotli.empty() == false ) { response_.set(boost::beast::http::field::vary, "Accept-Encoding"); }
+         response_.content_length(stringData.size());
+         response_.keep_alive(request_.keep_alive());
+      };
+
+      if(request_.method() == boost::beast::http::verb::head)
+      {
+         boost::beast::http::response<boost::beast::http::empty_body> response_{boost::beast::http::status::ok, request_.version()};
+         set_header_( response_ );
+         return response_;
+      }
 
+      boost::beast::http::response<cache_body> response_{boost::beast::http::status::ok, request_.version()};
+      response_.body().m_pentry = pentry;
+      response_.body().m_stringData = stringData;
+      set_header_( response_ );
+      return response_;
+   }
+
+   // ## Attempt to open the file, larger files are streamed from disk .......
+   boost::beast::error_code errorcode_;
+   boost::beast::http::file_body::value_type body_;
+   body_.open(stringPath.c_str(), boost::beast::file_mode::scan, errorcode_);
 
    if(errorcode_ == boost::beast::errc::no_such_file_or_directory) 
    {                                                                                               LOG_DEBUG_RAW( std::format( "File not found: '{}'", stringPath ) );
@@ -304,8 +484,10 @@ boost::beast::http::message_generator                                          /
  */
 boost::beast::http::message_generator CServer::RouteCommand( std::string_view stringTarget, std::string_view stringBody, boost::beast::http::request<boost::beast::http::string_body>&& request_, const session* psession_ )
 {
+   arena_scope arenascope_;                                                   // memory for request, released after router is destroyed
 	CRouter router_(papplication_g, stringTarget, stringBody);                 // create router for the target, router is a simple command router to handle commands
    router_.SetSession( psession_ );
+   router_.SetArena( arenascope_.get() );
 
    if( stringBody.empty() == false )
    {
@@ -324,16 +506,25 @@ boost::beast::http::message_generator CServer::RouteCommand( std::string_view st
    if( result_.first == false ) 
    { 
       std::string& stringError = result_.second;
+      if( router_.IsDatabaseBusy() == true )                                  // no pooled connection returned in time, client may retry
+      {
+         auto response_ = PrepareResponse_s( request_, int(boost::beast::http::status::service_unavailable), "text/plain", stringError );
+         response_.set( boost::beast::http::field::retry_after, "1" );
+         return response_;
+      }
       auto response_ = PrepareResponse_s( request_, int(boost::beast::http::status::bad_request), "text/plain", stringError );
       return response_;
    }
 
    std::string stringResponse;
+   std::unique_ptr<CDTOStream> pstream;                                       // set if rows from cursor are streamed to client
 
    // ## print response as XML or JSON, this will be used as response body
    if( router_.HasResult() == true )
    {
-      router_.PrintResponseXml( stringResponse, nullptr );                    // print response as XML, this will be used as response body
+      gd::argument::arguments argumentsPrint( { "stream", true } );          // place marker in xml where streamed rows are inserted
+      router_.PrintResponseXml( stringResponse, &argumentsPrint );            // print response as XML, this will be used as response body
+      pstream = router_.ReleaseStream();
    }
 
    if( stringResponse.empty() == true ) { stringResponse = "<response status=\"ok\" />"; } // if response is empty, set it to a default response
@@ -344,6 +535,26 @@ boost::beast::http::message_generator CServer::RouteCommand( std::string_view st
    if( router_.IsJson() == true ){ argumentHeader["format"] = "json"; }
    else { argumentHeader["format"] = "xml; charset=utf-8"; }                  // set format of response, this will be added to response header
 
+   // ## stream rows, response is sent as chunks and rows are read from cursor when chunks are written
+   if( pstream != nullptr )
+   {
+      auto uMarker = router_.GetStreamOffset();                                 assert( uMarker != std::string::npos );
+      if( uMarker != std::string::npos )
+      {
+         boost::beast::http::response<stream_body> responseStream{ boost::beast::http::status::ok, request_.version() };
+         auto& body_ = responseStream.body();
+         body_.m_stringPrefix = stringResponse.substr( 0, uMarker );
+         body_.m_stringSuffix = stringResponse.substr( uMarker + CDTOResponse::m_stringStreamMarker_s.length() );
+         pstream->SetCData( true );                                           // rows are placed in CDATA section
+         body_.m_pstream = std::move( pstream );
+
+         PrepareResponseHeader_s( argumentHeader, responseStream );
+         responseStream.keep_alive( request_.keep_alive() );
+         responseStream.chunked( true );
+         return responseStream;
+      }
+   }
+
    boost::beast::http::file_body::value_type body_;
 
    // 1. Create a response object using string_body
@@ -382,8 +593,10 @@ boost::beast::http::message_generator CServer::RenderPage(
    boost::beast::http::request<boost::beast::http::string_body>&& request_,
    const session* psession_)
 {
+   arena_scope arenascope_;                                                   // memory for request, released after router is destroyed
    CRouter router_(papplication_g, stringTarget, stringBody);                 // create router for the target, router is a simple command router to handle commands
    router_.SetSession(psession_);
+   router_.SetArena(arenascope_.get());
 
    std::string stringSSRPage;
    CRouter::Configure_call configure_ = [&]( CAPI_Base* papiObject, std::string_view stringObjectType, std::string_view stringEventStage  ) {
@@ -411,7 +624,16 @@ boost::beast::http::message_generator CServer::RenderPage(
 
    router_.SetFlag(CRouter::eFlagCommand | CRouter::eFlagNoResponse);
    result_ = router_.Run( "view/ssr" );
-   if(result_.first == false) { return server_error_s(request_, result_.second); }
+   if(result_.first == false) 
+   { 
+      if( router_.IsDatabaseBusy() == true )
+      {
+         auto response_ = PrepareResponse_s( request_, int(boost::beast::http::status::service_unavailable), "text/plain", result_.second );
+         response_.set( boost::beast::http::field::retry_after, "1" );
+         return response_;
+      }
+      return server_error_s(request_, result_.second); 
+   }
 
    std::size_t uSize = stringSSRPage.size();
 
@@ -443,22 +665,17 @@ boost::beast::http::message_generator CServer::RenderPage(
  * @return true if the file is blocked (i.e., its extension is in the ignore list)
  */
 bool CServer::IsIgnored(std::string_view stringPath) const
-{
-   std::string_view stringIgnoreExtension = GetPropertyValue(eIndexSettingsIgnoreExtension);       assert(stringIgnoreExtension.empty() == false);
-
+{                                                                                                  assert(m_vectorIgnoreExtension.empty() == false);
    // ## extract file extension from path
    auto uPosition = stringPath.rfind('.');
    if(uPosition == std::string_view::npos) { return false; }
 
    std::string_view stringExtension = stringPath.substr(uPosition + 1);
 
-   std::array<std::string_view, 32> arrayString;   // adjust 32 as needed
-   auto uCount = gd::utf8::split(stringIgnoreExtension, ',', arrayString, gd::utf8::tag_stack{});
-
    // ## check if file extension is in ignore list
-   for(std::size_t u = 0; u < uCount; ++u)
+   for(const auto& it : m_vectorIgnoreExtension)
    {
-      if(stringExtension == arrayString[u]) { return true; }
+      if(stringExtension == it) { return true; }
    }
    
    return false;
@@ -483,19 +700,15 @@ bool CServer::IsSSRExtension(std::string_view stringPath) const                /
       return stringExtension == "html";
    }
 
-   std::string_view stringSSRExtension = GetPropertyValue(eIndexSettingsSSRExtension);             assert(stringSSRExtension.empty() == false);
-
    // ## extract file extension from path ...................................
    auto uPosition = stringPath.rfind('.');
    if(uPosition == std::string_view::npos) { return false; }
    std::string_view stringExtension = stringPath.substr(uPosition + 1);
 
-   std::array<std::string_view, 32> arrayString;   // adjust 32 as needed
-   auto uCount = gd::utf8::split(stringSSRExtension, ',', arrayString, gd::utf8::tag_stack{});
    // ## check if file extension is in SSR list
-   for(std::size_t u = 0; u < uCount; ++u)
+   for(const auto& it : m_vectorSSRExtension)
    {
-      if(stringExtension == arrayString[u]) { return true; }
+      if(stringExtension == it) { return true; }
    }
 
    return false;
@@ -516,29 +729,21 @@ bool CServer::PeekSSRComment(std::string_view stringPath, std::string& stringCom
    constexpr std::size_t uMaxCommentLength = 16;
    stringComment.clear();
 
-   std::string_view stringSSRComment = GetPropertyValue(eIndexSettingsSSRComment);                 assert( stringSSRComment.empty() == false );
-   if(stringSSRComment.empty() == true) { return false; }
+   if(m_vectorSSRComment.empty() == true) { return false; }
 
-   // ## split ssr comment setting into array of comments ....................
-   std::array<std::string_view, 16> arrayIdentifier;
-   std::size_t uCommentCount = gd::utf8::split(stringSSRComment, ',', arrayIdentifier, gd::utf8::tag_stack{});
-   if(uCommentCount == 0) { return false; }
-
-   // ## Read the first 16 characters in file and check for ssr comment ......
-   std::string stringHead;
-   stringHead.resize(uMaxCommentLength);
+   // ## Read the first 16 characters in file and check for ssr comment, page is compiled when it is rendered
+   std::array<char, uMaxCommentLength> arrayHead;
    std::ifstream ifstreamFile(std::string(stringPath), std::ios::binary);
    if(ifstreamFile.is_open() == false) { return false; }
-   ifstreamFile.read(stringHead.data(), static_cast<std::streamsize>(stringHead.size()));
+   ifstreamFile.read(arrayHead.data(), static_cast<std::streamsize>(arrayHead.size()));
 
    std::size_t uReadCount = static_cast<std::size_t>(ifstreamFile.gcount());
    if(uReadCount == 0) { return false; }
 
-   std::string_view stringHeadView(stringHead.data(), uReadCount);
+   std::string_view stringHeadView(arrayHead.data(), uReadCount);
 
-   for(std::size_t u = 0; u < uCommentCount; ++u)
+   for(const auto& stringIdentifier : m_vectorSSRComment)
    {
-      const std::string_view stringIdentifier = arrayIdentifier[u];
       if(stringIdentifier.empty() == true) { continue; }
       if(stringHeadView.find(stringIdentifier) != std::string_view::npos)
       {
@@ -546,7 +751,6 @@ bool CServer::PeekSSRComment(std::string_view stringPath, std::string& stringCom
          return true;
       }
    }
-
    return false;
 }
 
@@ -569,6 +773,13 @@ bool CServer::PeekSSRComment(std::string_view stringPath, std::string& stringCom
  * @endcode
  */
 void CServer::PrepareResponseHeader_s( gd::argument::arguments& argumentHeader, boost::beast::http::response<boost::beast::http::string_body>& response )
+{
+   PrepareResponseHeader_s( argumentHeader, static_cast<boost::beast::http::response_header<>&>( response ) );
+   response.prepare_payload();
+}
+
+/// Set common header fields, payload is not prepared so this works for any response body
+void CServer::PrepareResponseHeader_s( gd::argument::arguments& argumentHeader, boost::beast::http::response_header<>& response )
 {
    using namespace boost::beast::http;
    response.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
@@ -590,8 +801,6 @@ void CServer::PrepareResponseHeader_s( gd::argument::arguments& argumentHeader,
    {
       response.set( field::content_type, "text/plain" );
    }
-
-   response.prepare_payload();
 }
 
 boost::beast::http::response<boost::beast::http::string_body> CServer::PrepareResponse_s( const boost::beast::http::request<boost::beast::http::string_body>& request_, int iType, std::string_view stringContentType, std::string& stringBody )
@@ -30,6 +30,7 @@
 #include "gd/gd_com.h"
 #include "gd/com/gd_com_server.h"
 
+#include "gd/gd_arena.h"
 #include "gd/gd_arguments.h"
 #include "gd/gd_arguments_shared.h"
 #include "gd/gd_arguments_index.h"
@@ -37,6 +38,7 @@
 #include "gd/gd_log_logger_define.h"
 
 #include "Application.h"
+#include "StaticCache.h"
 
 // Return a reasonable mime type based on the extension of a file.
 boost::beast::string_view mime_type_g(boost::beast::string_view path);
@@ -78,6 +80,24 @@ public:
       eIndexSettingsMAX,                 ///< index for maximum number of settings
    };
 
+   /** 
+    * @brief Scope for one request, memory allocated from request arena is released when outermost scope ends
+    *
+    * Each thread running io_context has its own arena so requests never share allocator state.
+    * Scopes may nest (a request that runs other requests), arena is only cleared by the first one.
+    */
+   struct arena_scope
+   {
+      arena_scope();
+      ~arena_scope();
+      arena_scope( const arena_scope& ) = delete;
+      arena_scope& operator=( const arena_scope& ) = delete;
+
+      gd::memory::arena<>* get() const { return m_parena; }
+
+      gd::memory::arena<>* m_parena;  ///< arena for thread
+   };
+
 // ## construction -------------------------------------------------------------
 public:
    CServer();
@@ -147,6 +167,9 @@ public:
    /// Peek for server ssr comment to check if ssr replacement is needed
    bool PeekSSRComment(std::string_view stringPath, std::string& stringComment) const;
 
+   /// Cache for small static files
+   CStaticCache& GetStaticCache() { return m_staticcache; }
+
 
 /** \name ROUTER
 *///@{
@@ -175,11 +198,22 @@ public:
    gd::argument::arguments m_argumentSettings; ///< settings from application and other server related information.
    gd::argument::arguments_index_t m_argumentIndexSettings; ///< index for settings arguments, this is used to quickly access settings arguments without searching by name, need to be fast
    std::array<std::size_t, eIndexSettingsMAX> m_puIndexSettings{ InitializeBuffer_s() }; ///< index for settings arguments, this is used to quickly access settings arguments without searching by name
+   std::vector<std::string> m_vectorIgnoreExtension;  ///< extensions from ignore-extension setting, split when server is initialized
+   std::vector<std::string> m_vectorSSRExtension;     ///< extensions from ssr-extension setting
+   std::vector<std::string> m_vectorSSRComment;       ///< identifiers from ssr-comment setting
+   CStaticCache m_staticcache;                        ///< small static files kept in memory
 
 // ## free functions ------------------------------------------------------------
 public:
+   /// Arena for requests handled by current thread
+   static gd::memory::arena<>& RequestArena_s();
+
+   inline static std::size_t m_uArenaBlockSize_s = 32 * 1024;   ///< block size for request arena
+   inline static std::size_t m_uArenaKeepBlocks_s = 4;          ///< blocks kept between requests, arena with more blocks is shrunk to one block
+
    /// Prepares response header for request
    void PrepareResponseHeader_s( gd::argument::arguments& argumentHeader, boost::beast::http::response<boost::beast::http::string_body>& response );
+   void PrepareResponseHeader_s( gd::argument::arguments& argumentHeader, boost::beast::http::response_header<>& response );
    boost::beast::http::response<boost::beast::http::string_body> PrepareResponse_s( const boost::beast::http::request<boost::beast::http::string_body>& request_, int iType, std::string_view stringContentType, std::string& stringBody );
 
    static constexpr std::size_t ValueIndex_s(std::string_view stringName)
@@ -0,0 +1,296 @@
+// @FILE [tag: cache, file, web_server] [summary: Cache for small static files served by web server] [type: source] [name: StaticCache.cpp]
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#include <sys/stat.h>
+
+#include "StaticCache.h"
+
+namespace {
+   /// Read complete file into string, false if file could not be read
+   bool read_file_( const std::string& stringPath, uint64_t uSize, std::string& stringData )
+   {
+      std::ifstream file_( stringPath, std::ios::binary );
+      if( file_.is_open() == false ) return false;
+      stringData.resize( uSize );
+      file_.read( stringData.data(), static_cast<std::streamsize>( uSize ) );
+      stringData.resize( static_cast<std::size_t>( file_.gcount() ) );
+      return true;
+   }
+
+   /// Stat compressed sibling, stamp time is -1 if sibling is not found
+   void stat_sibling_( const std::string& stringPath, CStaticCache::stamp& stamp_ )
+   {
+      if( CStaticCache::Stat_s( stringPath, stamp_.m_uSize, stamp_.m_iTime ) == false ) stamp_ = CStaticCache::stamp();
+   }
+
+   /// Read compressed sibling if it is found, not larger than file and not older than file
+   void read_sibling_( const std::string& stringPath, const CStaticCache::stamp& stampSibling, const CStaticCache::stamp& stampFile, std::string& stringData )
+   {
+      if( stampSibling.m_iTime < 0 || stampSibling.m_uSize > stampFile.m_uSize || stampSibling.m_iTime < stampFile.m_iTime ) return;
+      if( read_file_( stringPath, stampSibling.m_uSize, stringData ) == false ) stringData.clear();
+   }
+
+   /// Check if etag is in If-None-Match list, `*` matches all. Weak comparison, `W/` prefix is ignored
+   bool is_etag_match_( std::string_view stringIfNoneMatch, std::string_view stringETag )
+   {
+      if( stringETag.starts_with( "W/" ) == true ) stringETag.remove_prefix( 2 );
+      std::size_t uPosition = 0;
+      while( uPosition < stringIfNoneMatch.length() )
+      {
+         std::size_t uEnd = stringIfNoneMatch.find( ',', uPosition );
+         if( uEnd == std::string_view::npos ) uEnd = stringIfNoneMatch.length();
+         std::string_view stringPart = stringIfNoneMatch.substr( uPosition, uEnd - uPosition );
+         uPosition = uEnd + 1;
+
+         while( stringPart.empty() == false && stringPart.front() == ' ' ) stringPart.remove_prefix( 1 );
+         while( stringPart.empty() == false && stringPart.back() == ' ' ) stringPart.remove_suffix( 1 );
+         if( stringPart == "*" ) return true;
+         if( stringPart.starts_with( "W/" ) == true ) stringPart.remove_prefix( 2 );
+         if( stringPart == stringETag ) return true;
+      }
+      return false;
+   }
+
+   /// Check if encoding is accepted, encoding with `q=0` is not accepted
+   bool is_accepted_( std::string_view stringAcceptEncoding, std::string_view stringEncoding )
+   {
+      std::size_t uPosition = 0;
+      while( uPosition < stringAcceptEncoding.length() )
+      {
+         std::size_t uEnd = stringAcceptEncoding.find( ',', uPosition );
+         if( uEnd == std::string_view::npos ) uEnd = stringAcceptEncoding.length();
+         std::string_view stringPart = stringAcceptEncoding.substr( uPosition, uEnd - uPosition );
+         uPosition = uEnd + 1;
+
+         while( stringPart.empty() == false && stringPart.front() == ' ' ) stringPart.remove_prefix( 1 );
+         std::size_t uParameter = stringPart.find( ';' );
+         std::string_view stringName = stringPart.substr( 0, uParameter );
+         while( stringName.empty() == false && stringName.back() == ' ' ) stringName.remove_suffix( 1 );
+         if( stringName != stringEncoding ) continue;
+
+         if( uParameter == std::string_view::npos ) return true;
+         std::string_view stringQuality = stringPart.substr( uParameter + 1 );
+         while( stringQuality.empty() == false && stringQuality.front() == ' ' ) stringQuality.remove_prefix( 1 );
+         return stringQuality.starts_with( "q=0" ) == false || stringQuality.find_first_of( "123456789", 3 ) != std::string_view::npos;
+      }
+      return false;
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Find cached file
+ *
+ * Size and last write time for file and `.gz` and `.br` siblings are checked on each
+ * call, if file or sibling is changed the file is read again. File is read without
+ * holding the lock. When cache is full least recently used files are removed, files
+ * larger than max cache size are returned without being cached.
+ *
+ * @param stringPath path to file
+ * @param pentry receives cached file
+ * @return true if file is found, false if file is not found or too large
+ */
+bool CStaticCache::Find( std::string_view stringPath, std::shared_ptr<const entry>& pentry )
+{
+   std::string stringFile( stringPath );
+   stamp stampFile, stampGzip, stampBrotli;
+   if( Stat_s( stringFile, stampFile.m_uSize, stampFile.m_iTime ) == false || stampFile.m_uSize > m_uMaxFileSize ) return false;
+   stat_sibling_( stringFile + ".gz", stampGzip );
+   stat_sibling_( stringFile + ".br", stampBrotli );
+
+   {
+      std::shared_lock lock_( m_sharedmutex );
+      auto it = m_mapEntry.find( stringFile );
+      if( it != m_mapEntry.end() )
+      {
+         const entry& entry_ = *it->second.m_pentry;
+         if( entry_.m_stampFile == stampFile && entry_.m_stampGzip == stampGzip && entry_.m_stampBrotli == stampBrotli )
+         {
+            it->second.m_uUse.store( ++m_uUseCounter, std::memory_order_relaxed );
+            pentry = it->second.m_pentry;
+            return true;
+         }
+      }
+   }
+
+   // ## read file and siblings ..............................................
+   auto pentryNew = std::make_shared<entry>();
+   if( Read_s( stringFile, stampFile, stampGzip, stampBrotli, *pentryNew ) == false ) return false;
+   uint64_t uEntrySize = pentryNew->m_stringBody.size() + pentryNew->m_stringGzip.size() + pentryNew->m_stringBrotli.size();
+
+   {
+      std::unique_lock lock_( m_sharedmutex );
+      auto it = m_mapEntry.find( stringFile );
+      if( it != m_mapEntry.end() )
+      {
+         const entry& entryOld = *it->second.m_pentry;
+         m_uSize -= entryOld.m_stringBody.size() + entryOld.m_stringGzip.size() + entryOld.m_stringBrotli.size();
+         if( uEntrySize > m_uMaxSize ) m_mapEntry.erase( it );
+      }
+
+      if( uEntrySize <= m_uMaxSize )
+      {
+         cached& cached_ = m_mapEntry[stringFile];
+         cached_.m_pentry = pentryNew;
+         cached_.m_uUse.store( ++m_uUseCounter, std::memory_order_relaxed );
+         m_uSize += uEntrySize;
+         Evict();
+      }
+   }
+
+   pentry = std::move( pentryNew );
+   return true;
+}
+
+void CStaticCache::Clear()
+{
+   std::unique_lock lock_( m_sharedmutex );
+   m_mapEntry.clear();
+   m_uSize = 0;
+}
+
+/// Read file, `.gz` and `.br` siblings and prepare header values
+bool CStaticCache::Read_s( const std::string& stringPath, const stamp& stampFile, const stamp& stampGzip, const stamp& stampBrotli, entry& entry_ )
+{
+   if( read_file_( stringPath, stampFile.m_uSize, entry_.m_stringBody ) == false ) return false;
+   read_sibling_( stringPath + ".gz", stampGzip, stampFile, entry_.m_stringGzip );
+   read_sibling_( stringPath + ".br", stampBrotli, stampFile, entry_.m_stringBrotli );
+
+   entry_.m_stampFile = stampFile;
+   entry_.m_stampGzip = stampGzip;
+   entry_.m_stampBrotli = stampBrotli;
+
+   // ## etag changes when file or a sibling that is sent is changed
+   char pbszETag[96];
+   int iLength = std::snprintf( pbszETag, sizeof( pbszETag ), "W/\"%llx-%llx", (unsigned long long)stampFile.m_uSize, (unsigned long long)stampFile.m_iTime );
+   if( entry_.m_stringGzip.empty() == false ) iLength += std::snprintf( pbszETag + iLength, sizeof( pbszETag ) - iLength, "-g%llx", (unsigned long long)stampGzip.m_iTime );
+   if( entry_.m_stringBrotli.empty() == false ) iLength += std::snprintf( pbszETag + iLength, sizeof( pbszETag ) - iLength, "-b%llx", (unsigned long long)stampBrotli.m_iTime );
+   entry_.m_stringETag.assign( pbszETag, iLength );
+   entry_.m_stringETag += '"';
+
+   entry_.m_iLastModified = stampFile.m_iTime / 1'000'000'000;
+   entry_.m_stringLastModified = HttpDate_s( entry_.m_iLastModified );
+   return true;
+}
+
+/// Remove least recently used entries until size is below max, entry just added is the most recently used and is kept
+void CStaticCache::Evict()
+{
+   while( m_uSize > m_uMaxSize && m_mapEntry.size() > 1 )
+   {
+      auto itOldest = m_mapEntry.begin();
+      for( auto it = m_mapEntry.begin(); it != m_mapEntry.end(); it++ )
+      {
+         if( it->second.m_uUse.load( std::memory_order_relaxed ) < itOldest->second.m_uUse.load( std::memory_order_relaxed ) ) itOldest = it;
+      }
+      const entry& entry_ = *itOldest->second.m_pentry;
+      m_uSize -= entry_.m_stringBody.size() + entry_.m_stringGzip.size() + entry_.m_stringBrotli.size();
+      m_mapEntry.erase( itOldest );
+   }
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief Check conditional request headers against entry
+ *
+ * If-None-Match has precedence and If-Modified-Since is ignored when it is present.
+ * If-Modified-Since is compared as date, file is not modified if its last write time
+ * (seconds) is not later than date in header. Invalid dates are ignored.
+ *
+ * @param stringIfNoneMatch value for If-None-Match header, empty if not sent
+ * @param stringIfModifiedSince value for If-Modified-Since header, empty if not sent
+ * @param entry_ cached file
+ * @return true if client has current version and 304 can be sent
+ */
+bool CStaticCache::IsNotModified_s( std::string_view stringIfNoneMatch, std::string_view stringIfModifiedSince, const entry& entry_ )
+{
+   if( stringIfNoneMatch.empty() == false ) return is_etag_match_( stringIfNoneMatch, entry_.m_stringETag );
+   if( stringIfModifiedSince.empty() == false )
+   {
+      int64_t iTime;
+      if( ParseHttpDate_s( stringIfModifiedSince, iTime ) == true ) return entry_.m_iLastModified <= iTime;
+   }
+   return false;
+}
+
+bool CStaticCache::Stat_s( const std::string& stringPath, uint64_t& uSize, int64_t& iTime )
+{
+#ifndef _WIN32
+   struct stat stat_;
+   if( ::stat( stringPath.c_str(), &stat_ ) != 0 || S_ISREG( stat_.st_mode ) == 0 ) return false;
+#else
+   struct _stat64 stat_;
+   if( ::_stat64( stringPath.c_str(), &stat_ ) != 0 || ( stat_.st_mode & _S_IFREG ) == 0 ) return false;
+#endif
+   uSize = (uint64_t)stat_.st_size;
+#if defined( __APPLE__ )
+   iTime = (int64_t)stat_.st_mtimespec.tv_sec * 1'000'000'000 + (int64_t)stat_.st_mtimespec.tv_nsec;
+#elif !defined( _WIN32 )
+   iTime = (int64_t)stat_.st_mtim.tv_sec * 1'000'000'000 + (int64_t)stat_.st_mtim.tv_nsec;
+#else
+   std::error_code errorcode;
+   auto time_ = std::filesystem::last_write_time( stringPath, errorcode );
+   if( errorcode ) return false;
+   iTime = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::clock_cast<std::chrono::system_clock>( time_ ).time_since_epoch() ).count();
+#endif
+   return true;
+}
+
+std::string CStaticCache::HttpDate_s( int64_t iTime )
+{
+   std::time_t time_ = (std::time_t)iTime;
+   std::tm tm_{};
+#ifndef _WIN32
+   ::gmtime_r( &time_, &tm_ );
+#else
+   ::gmtime_s( &tm_, &time_ );
+#endif
+   char pbszDate[64];
+   std::size_t uLength = std::strftime( pbszDate, sizeof( pbszDate ), "%a, %d %b %Y %H:%M:%S GMT", &tm_ );
+   return std::string( pbszDate, uLength );
+}
+
+bool CStaticCache::ParseHttpDate_s( std::string_view stringDate, int64_t& iTime )
+{
+   // ## "Sun, 06 Nov 1994 08:49:37 GMT", day name is skipped ...............
+   std::size_t uComma = stringDate.find( ',' );
+   if( uComma == std::string_view::npos ) return false;
+   std::string stringValue( stringDate.substr( uComma + 1 ) );
+
+   int iDay, iYear, iHour, iMinute, iSecond;
+   char pbszMonth[4] = {};
+   if( std::sscanf( stringValue.c_str(), " %2d %3s %4d %2d:%2d:%2d", &iDay, pbszMonth, &iYear, &iHour, &iMinute, &iSecond ) != 6 ) return false;
+   constexpr std::string_view stringMonth_s = "JanFebMarAprMayJunJulAugSepOctNovDec";
+   std::size_t uMonth = stringMonth_s.find( pbszMonth );
+   if( std::strlen( pbszMonth ) != 3 || uMonth == std::string_view::npos || uMonth % 3 != 0 ) return false;
+   if( iDay < 1 || iDay > 31 || iHour > 23 || iMinute > 59 || iSecond > 60 ) return false;
+
+   std::tm tm_{};
+   tm_.tm_mday = iDay;
+   tm_.tm_mon = (int)( uMonth / 3 );
+   tm_.tm_year = iYear - 1900;
+   tm_.tm_hour = iHour;
+   tm_.tm_min = iMinute;
+   tm_.tm_sec = iSecond;
+#ifndef _WIN32
+   std::time_t time_ = ::timegm( &tm_ );
+#else
+   std::time_t time_ = ::_mkgmtime( &tm_ );
+#endif
+   if( time_ == (std::time_t)-1 ) return false;
+   iTime = (int64_t)time_;
+   return true;
+}
+
+CStaticCache::enumEncoding CStaticCache::SelectEncoding_s( std::string_view stringAcceptEncoding, const entry& entry_ )
+{
+   if( stringAcceptEncoding.empty() == true ) return eEncodingIdentity;
+   if( entry_.m_stringBrotli.empty() == false && is_accepted_( stringAcceptEncoding, "br" ) == true ) return eEncodingBrotli;
+   if( entry_.m_stringGzip.empty() == false && is_accepted_( stringAcceptEncoding, "gzip" ) == true ) return eEncodingGzip;
+   return eEncodingIdentity;
+}
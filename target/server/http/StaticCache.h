@@ -0,0 +1,137 @@
+/**
+ * @FILE [tag: cache, file, web_server] [summary: Cache for small static files served by web server]
+ *
+ * @brief Small files are read once and kept in memory together with ETag and
+ *        Last-Modified values. Precompressed siblings (`file.js.gz`, `file.js.br`)
+ *        are read with the file and sent when client accepts that encoding.
+ *
+ * Each lookup checks file size and last write time (nanoseconds) for the file and
+ * its siblings, a changed file or sibling is read again. Files larger than
+ * `m_uMaxFileSize` are not cached and are streamed from disk. When cache is full
+ * the least recently used files are removed.
+ *
+~~~{.cpp}
+std::shared_ptr<const CStaticCache::entry> pentry;
+if( staticcache_.Find( stringPath, pentry ) == true )
+{
+   std::string_view stringBody = pentry->get( CStaticCache::eEncodingGzip );
+}
+~~~
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @CLASS [tag: cache, file] [summary: Thread-safe cache for small static files]
+ *
+ * @brief Entries are immutable and shared with responses, a response keeps its
+ *        entry alive while it is written even if file is changed and entry replaced.
+ *
+ * **Thread safety**: All public methods are thread-safe.
+ */
+class CStaticCache
+{
+// ## types --------------------------------------------------------------------
+public:
+   enum enumEncoding
+   {
+      eEncodingIdentity = 0,  ///< file as it is
+      eEncodingGzip     = 1,  ///< precompressed `.gz` file
+      eEncodingBrotli   = 2,  ///< precompressed `.br` file
+   };
+
+   /// file size and last write time, used to detect changed files
+   struct stamp
+   {
+      bool operator==( const stamp& o ) const { return m_uSize == o.m_uSize && m_iTime == o.m_iTime; }
+
+      uint64_t m_uSize = 0;               ///< file size
+      int64_t m_iTime = -1;               ///< last write time in nanoseconds since epoch, -1 if file is not found
+   };
+
+   /// cached file with values used in response header
+   struct entry
+   {
+      /// content for encoding, empty if file do not have that encoding
+      std::string_view get( enumEncoding eEncoding ) const
+      {
+         if( eEncoding == eEncodingBrotli ) return m_stringBrotli;
+         if( eEncoding == eEncodingGzip )   return m_stringGzip;
+         return m_stringBody;
+      }
+
+      std::string m_stringBody;           ///< file content
+      std::string m_stringGzip;           ///< content from `.gz` file, empty if not found
+      std::string m_stringBrotli;         ///< content from `.br` file, empty if not found
+      std::string m_stringETag;           ///< weak etag from size and time for file and siblings
+      std::string m_stringLastModified;   ///< last write time formated as http date
+      int64_t m_iLastModified = 0;        ///< last write time in seconds, used to compare with If-Modified-Since
+      stamp m_stampFile;                  ///< file when file was read
+      stamp m_stampGzip;                  ///< `.gz` sibling when file was read
+      stamp m_stampBrotli;                ///< `.br` sibling when file was read
+   };
+
+   /// cached entry and when it was used
+   struct cached
+   {
+      std::shared_ptr<const entry> m_pentry;
+      std::atomic<uint64_t> m_uUse{ 0 };  ///< last use, set with shared lock
+   };
+
+// ## construction -------------------------------------------------------------
+public:
+   CStaticCache() {}
+   CStaticCache( uint64_t uMaxFileSize, uint64_t uMaxSize ): m_uMaxFileSize( uMaxFileSize ), m_uMaxSize( uMaxSize ) {}
+
+   CStaticCache( const CStaticCache& ) = delete;
+   CStaticCache& operator=( const CStaticCache& ) = delete;
+
+// ## methods ------------------------------------------------------------------
+public:
+   /// Find cached file, file is read if not in cache or changed. false if file is not found or too large for cache
+   bool Find( std::string_view stringPath, std::shared_ptr<const entry>& pentry );
+   /// Check conditional request headers against entry, true if client has current version
+   static bool IsNotModified_s( std::string_view stringIfNoneMatch, std::string_view stringIfModifiedSince, const entry& entry_ );
+   /// Remove all files from cache
+   void Clear();
+
+   uint64_t Size() const { std::shared_lock lock_( m_sharedmutex ); return m_uSize; }
+
+/** \name INTERNAL
+*///@{
+   /// Read file and compressed siblings into entry
+   static bool Read_s( const std::string& stringPath, const stamp& stampFile, const stamp& stampGzip, const stamp& stampBrotli, entry& entry_ );
+   /// Remove least recently used entries until size is below max, caller holds unique lock
+   void Evict();
+//@}
+
+// ## attributes ----------------------------------------------------------------
+public:
+   uint64_t m_uMaxFileSize = 256 * 1024;       ///< larger files are not cached
+   uint64_t m_uMaxSize = 64 * 1024 * 1024;     ///< max bytes for all cached files, least recently used files are removed when cache is full
+   uint64_t m_uSize = 0;                       ///< bytes for cached files
+   std::atomic<uint64_t> m_uUseCounter{ 0 };   ///< incremented each time a file is used
+   std::unordered_map<std::string, cached> m_mapEntry; ///< file path -> cached file
+   mutable std::shared_mutex m_sharedmutex;    ///< lock for map and size
+
+// ## free functions ------------------------------------------------------------
+public:
+   /// Read file size and last write time in nanoseconds, false if not a regular file
+   static bool Stat_s( const std::string& stringPath, uint64_t& uSize, int64_t& iTime );
+   /// Format time (seconds) as http date, like "Sun, 06 Nov 1994 08:49:37 GMT"
+   static std::string HttpDate_s( int64_t iTime );
+   /// Parse http date to time in seconds, false if date is not in http date format
+   static bool ParseHttpDate_s( std::string_view stringDate, int64_t& iTime );
+   /// Select encoding from Accept-Encoding header that is available for entry, brotli is preferred
+   static enumEncoding SelectEncoding_s( std::string_view stringAcceptEncoding, const entry& entry_ );
+};
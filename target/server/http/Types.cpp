@@ -2,6 +2,8 @@
 #include "gd/gd_arguments.h"
 #include "gd/gd_table_column-buffer.h"
 
+#include "dto/DTOStream.h"
+
 #include "Types.h"
 
 namespace Types {
@@ -47,6 +49,12 @@ void Clear_g( unsigned uType, void* pobject_ )
          delete parguments;
       }
       break;
+   case eTypeCursorStream:
+      {
+         auto pstream = static_cast<CDTOStream*>( pobject_ );
+         delete pstream;
+      }
+      break;
    default:                                                                                        assert( false && "Unknown type in Clear_g, cannot clear object" );
       // unknown type, do nothing
       break;
@@ -9,6 +9,8 @@
 #include "gd/gd_arguments.h"
 #include "gd/gd_table_column-buffer.h"
 
+class CDTOStream;
+
 #if defined( __clang__ )
    #pragma clang diagnostic push
    #pragma clang diagnostic ignored "-Wdeprecated-enum-enum-conversion"
@@ -38,6 +40,7 @@ enum enumTypeNumber
    eTypeTextCsv         = 4,
    eTypeTableDto        = 5,  // dto::table object 
    eTypeArgumentsDto    = 6,  // gd::table::arguments object
+   eTypeCursorStream    = 7,  // CDTOStream object, rows read from cursor when response is sent
 };
 
 enum enumGroupNumber
@@ -59,6 +62,7 @@ enum enumType
    eTypeCsv             = eTypeTextCsv       | eGroupText,
    eTypeDtoTable        = eTypeTableDto      | eGroupTable,
    eTypeArguments       = eTypeArgumentsDto  | eGroupArguments,
+   eTypeStream          = eTypeCursorStream  | eGroupTable,
 };
 
 /// clear object based on type, in http there are some common objects used to hold data and these are moved around as void pointers, this method will clear the object based on type
@@ -75,6 +79,7 @@ constexpr Types::enumTypeNumber TypeNumber_g( std::string_view stringTypeName )
    else if( stringTypeName == "text/csv" )         return Types::eTypeTextCsv;
    else if( stringTypeName == "table" )            return Types::eTypeTableDto;
    else if( stringTypeName == "arguments" )        return Types::eTypeArgumentsDto;
+   else if( stringTypeName == "stream" )           return Types::eTypeCursorStream;
    else return Types::eTypeUnknown;
 }
 
@@ -167,6 +172,7 @@ struct Objects
 
    void Add( std::string_view stringText ) { m_vectorObjects.emplace_back( Object{ eTypePlain, new std::string(stringText) } ); }
    void Add( gd::table::dto::table* p_ ) { m_vectorObjects.emplace_back( Object{ eTypeDtoTable, p_ } ); }
+   void Add( CDTOStream* p_ ) { m_vectorObjects.emplace_back( Object{ eTypeStream, p_ } ); }
    void Add( gd::argument::arguments* p_ ) { m_vectorObjects.emplace_back( Object{ eTypeArguments, p_ } ); }
    void Add( const gd::argument::arguments& arguments_ ) { m_vectorObjects.emplace_back( Object{ eTypeArguments, new gd::argument::arguments(arguments_) } ); }
 
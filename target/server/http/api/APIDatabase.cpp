@@ -1,7 +1,10 @@
 // @FILE [tag: database, api] [description: API class for database operations] [type: source] [name: APIDatabase.cpp]
 
+#include <charconv>
 #include <memory>
 #include <filesystem>
+#include <unordered_map>
+#include <vector>
 
 #include "gd/gd_binary.h"
 #include "gd/parse/gd_parse_json.h"
@@ -11,16 +14,20 @@
 
 #include "gd/gd_sql_query.h"
 #include "gd/gd_sql_query_builder.h"
+#include "gd/gd_sql_value.h"
 
 #include "pugixml/pugixml.hpp"
 #include "jsoncons/json.hpp"
 #include "jsoncons_ext/jsonpath/jsonpath.hpp"
 
 #include "../service/SERVICE_SqlBuilder.h"
+#include "../service/SERVICE_BulkInsert.h"
 #include "../render/RENDERSql.h"
 
 #include "../lua/LUAObjects.h"
 
+#include "../dto/DTOStream.h"
+
 #include "../Router.h"
 #include "../Document.h"
 #include "../Application.h"
@@ -75,8 +82,17 @@ std::pair<bool, std::string> CAPIDatabase::Execute()
 
    // ## Check for database connection and if not connected, try to connect to database
    CDocument* pdocument = GetDocument();                                                           if(pdocument == nullptr) { return { false, GetLastError() }; }
-   auto* pdatabase = pdocument->GetDatabase();                                                     if(pdatabase == nullptr) return { false, "no database" };
-   if(GetContext()->GetDatabase() == nullptr) { GetContext()->SetDatabase(pdatabase); }
+   if(pdocument->GetDatabase() == nullptr) return { false, "no database" };
+
+   // ## borrow read connection if all commands only read from database
+   unsigned uConnection = CDatabasePool::eConnectionRead;
+   for( std::size_t u = m_uCommandIndex; u < m_vectorCommand.size(); ++u )
+   {
+      std::string_view stringCommand_ = m_vectorCommand[u];
+      if( stringCommand_ != "db" && stringCommand_ != "select" && stringCommand_ != "ask" ) { uConnection = CDatabasePool::eConnectionWrite; break; }
+   }
+   auto* pdatabase = GetContext()->AcquireDatabase( uConnection );
+   if( pdatabase == nullptr ) return { false, GetContext()->IsDatabaseBusy() == true ? "database busy" : "no database" };
 
    std::pair<bool, std::string> result_(true,"");
 
@@ -152,6 +168,7 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Execute()
    {
       std::string stringTable = QS_GetArguments()["table"].as_string();
       if( stringTable.empty() == false ) { argumentsOptions["table"] = stringTable; }
+      if( QS_Exists( "commit" ) == true ) { argumentsOptions["commit"] = QS_GetArguments()["commit"].as_uint64(); }
 
       argumentsOptions["form"] = "attribute";
       gd::argument::arguments argumentsReturn;
@@ -193,8 +210,8 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Execute()
  */
 std::pair<bool, std::string> CAPIDatabase::Execute_Create()
 {
-   std::string stringType = m_argumentsQS["type"].as_string();
-   std::string stringName = m_argumentsQS["name"].as_string();
+   std::string stringType = QS_Get("type").as_string();
+   std::string stringName = QS_Get("name").as_string();
 
    if( stringType.empty() == true || stringType == "sqlite" )
    {
@@ -236,10 +253,11 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Create()
 std::pair<bool, std::string> CAPIDatabase::Execute_Open()
 {
    gd::database::database_i* pdatabaseOpen = nullptr;
-   std::string stringType = m_argumentsQS["type"].as_string();
-   std::string stringName = m_argumentsQS["name"].as_string();
+   std::string stringType = QS_Get("type").as_string();
+   std::string stringName = QS_Get("name").as_string();
 
-   std::string stringDocument = m_argumentsQS[{ {"document"}, {"doc"} }].as_string();
+   gd::argument::arguments argumentsOpen;
+   std::string stringDocument = QS_Get( { "document", "doc" } ).as_string();
 
 	if( stringDocument.empty() == true ) stringDocument = "default";
 
@@ -255,7 +273,6 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Open()
       auto result_ = gd::file::file_absolute_g(pathFile.string(), stringName);
       if(result_.first == false) { return { false, "failed to get absolute path for database file: " + result_.second }; }
 
-		gd::argument::arguments argumentsOpen;
 		argumentsOpen.push_back({ "name", stringName });
       argumentsOpen.push_back({ "type", std::string_view("sqlite") });
 
@@ -269,6 +286,9 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Open()
 
    pdatabaseOpen->release();
 
+   auto result_ = pdocument->DATABASE_OpenPool( argumentsOpen );              // pooled connections for requests
+   if( result_.first == false ) { return result_; }
+
    return { true, "" };
 }
 
@@ -295,10 +315,10 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Query()
    CDocument* pdocument = GetDocument();
    if( pdocument == nullptr ) { return { false, GetLastError() }; }
 
-   auto* pdatabase = pdocument->GetDatabase();                                // get database from document, this connection has to be opened before
+   auto* pdatabase = GetContext()->GetDatabase();                             // connection for request, this connection has to be opened before
    if( pdatabase == nullptr ) return { false, "no database connection in document: " + std::string( pdocument->GetName() ) };
 
-   std::string stringQuery = m_argumentsQS["query"].as_string();       // get query to execute
+   std::string stringQuery = QS_Get("query").as_string();              // get query to execute
    if( stringQuery.empty() == true ) { return { false, "no query specified to execute" }; }
 
    auto result_ = pdatabase->execute( stringQuery );                          // execute query on database
@@ -314,6 +334,10 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Query()
  * and executes the SELECT SQL query provided in the "query" parameter of m_argumentsParameter.
  * The results of the query are converted into a table format.
  *
+ * If `stream` is set the cursor is kept open and rows are read in batches when
+ * response is sent to client (chunked response), for large results memory is only
+ * needed for one batch. `stream` may be a number and then it is the batch size.
+ *
  * @return std::pair<bool, std::string> A pair where the bool indicates success/failure
  *
  * Example usage:
@@ -333,10 +357,13 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Select()
    CDocument* pdocument = GetDocument();                                                           assert(pdocument != nullptr && "no document");
    auto* pdatabase = GetContext()->GetDatabase();                                                  assert(pdatabase != nullptr && "no database connection");
 
+   auto stream_ = QS_GetArgument("stream");
+   std::vector<gd::variant> vectorBind;                                       // values bound to prepared statement
    std::string stringQuery = GetNextArgument( "query" ).as_string();          // get query name to find query to execute
+   bool bBind = stringQuery.empty() == false && stream_.is_true() == false;  // named queries are prepared with parameters, streamed cursor outlive bound values
    if( stringQuery.empty() == false )                                           // if query statement is to be used
    {
-      auto result_ = PrepareStatement( stringQuery, stringSelect );
+      auto result_ = PrepareStatement( stringQuery, stringSelect, bBind == true ? &vectorBind : nullptr );
       if( result_.first == false ) { return result_; }
    }
    else
@@ -347,7 +374,7 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Select()
    }
 
    gd::com::pointer<gd::database::cursor_i> pcursor;
-   pdatabase->get_cursor( &pcursor );
+   if( bBind == false ) { pdatabase->get_cursor( &pcursor ); }
 #if(TARGET_COMPILE_MODE_ & 1)                                                 // @DEBUG [tag: debug] [summary: if compiled as debug it is possible to return select statement as argument for debugging purposes]
    auto debug_ = QS_GetArgument("debug");
    if(debug_.is_true() == true)
@@ -360,14 +387,34 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Select()
 #endif // (TARGET_COMPILE_MODE_ & FLAG_MODE_DEVELOPER_)
 
    std::pair< bool, std::string > pairReturn;   
-   pairReturn = pcursor->open( stringSelect );
+   if( bBind == true )                                                        // statement is reused from connection cache, only values are bound
+   {
+      pairReturn = GetContext()->PrepareCursor( stringSelect, &pcursor );
+      if( pairReturn.first == true && vectorBind.empty() == false )
+      {
+         std::vector<gd::variant_view> vectorValue;
+         vectorValue.reserve( vectorBind.size() );
+         for( const auto& it : vectorBind ) { vectorValue.emplace_back( it ); }
+         pairReturn = pcursor->bind( vectorValue );
+      }
+      if( pairReturn.first == true ) { pairReturn = pcursor->open(); }
+   }
+   else { pairReturn = pcursor->open( stringSelect ); }
 #ifndef NDEBUG
                                                                                                    LOG_ERROR_IF( pairReturn.first == false, "query=" & stringQuery & ": " & pairReturn.second & " - " & stringSelect);
 #endif // NDEBUG
 
    // ## create table to hold select result
 
-   if( pairReturn.first == true )
+   if( pairReturn.first == true && stream_.is_true() == true )                // stream rows, cursor is read when response is sent
+   {
+      std::string stringBatch = stream_.as_string();
+      uint64_t uBatchSize = 0;
+      std::from_chars( stringBatch.data(), stringBatch.data() + stringBatch.length(), uBatchSize ); // `stream=500` sets batch size, value is unchanged if not a number
+      auto pstream_ = uBatchSize > 0 ? new CDTOStream( pcursor.get(), uBatchSize ) : new CDTOStream( pcursor.get() );
+      Objects().Add( pstream_ );
+   }
+   else if( pairReturn.first == true )
    {
       auto ptable_ = new gd::table::dto::table( gd::table::tag_full_meta{} );
       gd::database::to_table( pcursor.get(), ptable_ );
@@ -378,7 +425,10 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Select()
       if( uRowCount_d > 0 ) { stringRow0_d = gd::table::debug::print_row( *ptable_, 0 ); }
 #endif // NDEBUG
       Objects().Add( ptable_ );
+   }
 
+   if( pairReturn.first == true )
+   {
       if( argumentsOptional["name"].is_true() == true )  
       {                                                                                            assert( argumentsOptional["name"].is_string() == true && "name argument must be a string" );
          auto stringName = argumentsOptional["name"].as_string();
@@ -408,7 +458,7 @@ std::pair<bool, std::string> CAPIDatabase::Execute_Ask()
 {
    CDocument* pdocument = GetDocument();                                                           if( pdocument == nullptr ) { return { false, GetLastError() }; }
 
-   auto* pdatabase = pdocument->GetDatabase();
+   auto* pdatabase = GetContext()->GetDatabase();
    if( pdatabase == nullptr ) return { false, "no database connection in document: " + std::string( pdocument->GetName() ) };
 
    // ## Prepare SQL statement ................................................
@@ -802,22 +852,52 @@ std::pair<bool, std::string> CAPIDatabase::Database_Execute( gd::database::datab
 }
 
 namespace {
+/// Column types read from database metadata, each column is only searched once in bulk operations
+struct column_type_
+{
+   explicit column_type_( META::CDatabase* pdatabase ): m_pdatabase( pdatabase ) {}
+
+   /// Find type for column in table, false if column is not found
+   bool find( std::string_view stringTable, std::string_view stringColumn, uint32_t& uType )
+   {
+      m_stringKey.assign( stringTable );
+      m_stringKey += '.';
+      m_stringKey += stringColumn;
+      auto it = m_mapType.find( m_stringKey );
+      if( it == m_mapType.end() )
+      {
+         std::array<std::byte, 128> buffer_;
+         gd::argument::arguments argumentsFind( buffer_ );
+         argumentsFind.append( { {std::string_view("table"), stringTable}, {std::string_view("column"), stringColumn} }, gd::types::tag_view{});
+         int64_t iRow = m_pdatabase->Column_FindRow( argumentsFind );
+         it = m_mapType.emplace( m_stringKey, iRow == -1 ? int64_t(-1) : int64_t( m_pdatabase->Column_GetType( iRow ) ) ).first;
+      }
+
+      if( it->second == -1 ) return false;
+      uType = (uint32_t)it->second;
+      return true;
+   }
+
+   META::CDatabase* m_pdatabase;
+   std::unordered_map<std::string, int64_t> m_mapType;   ///< "table.column" -> type, -1 if column is not found
+   std::string m_stringKey;                              ///< buffer for key
+};
+
 /** -------------------------------------------------------------------------
  * @brief Appends named arguments as fields to a SQL insert query, validating columns against database metadata.
  * 
  * @NOTE [tag: gcc] [description: There were problems adding this method as a lambda using GCC compiler]
  * 
  * @param stringTable The default table name to use when column names don't specify a table.
- * @param pdatabase_ Pointer to the database metadata object used to validate columns and retrieve types.
+ * @param columntype_ Column types from database metadata used to validate columns and retrieve types.
  * @param pargumentsGlobal Pointer to the arguments container with named key-value pairs to append.
  * @param queryInsert Reference to the SQL insert query object that will receive the fields.
  * @return A pair containing: success flag (true if all columns found), and error message (empty on success, or description of missing column on failure).
  */
-std::pair<bool, std::string> append_arguments_( const std::string& stringTable, META::CDatabase* pdatabase_, const auto* pargumentsGlobal, auto& queryInsert )
+std::pair<bool, std::string> append_arguments_( const std::string& stringTable, column_type_& columntype_, const auto* pargumentsGlobal, auto& queryInsert )
 {
    using namespace gd::sql;
    std::array<std::byte, 128> buffer_; // buffer to avoid allocate memory
-   gd::argument::arguments argumentsFind( buffer_ );
 
    std::string_view name_;
    for( auto [key_, value_] : pargumentsGlobal->named() )
@@ -827,12 +907,9 @@ std::pair<bool, std::string> append_arguments_( const std::string& stringTable,
       if( index_ != std::string::npos ) { table_ = key_.substr( 0, index_ ); name_ = key_.substr( index_ + 1 ); }
       else { name_ = key_; }
 
-      argumentsFind.clear();
-      argumentsFind.append( { {std::string_view("table"), table_}, {std::string_view("column"), name_} }, gd::types::tag_view{});
-      int64_t iRow = pdatabase_->Column_FindRow( argumentsFind ); 
-      if( iRow != -1 ) 
+      uint32_t uType;
+      if( columntype_.find( table_, name_, uType ) == true ) 
       { 
-         auto uType = pdatabase_->Column_GetType( iRow );
          queryInsert << field_g( table_, name_, buffer_ ).value( value_ ).type( uType );
       }
       else { return { false, "column not found in database: " + std::string( name_ ) };  }
@@ -843,12 +920,32 @@ std::pair<bool, std::string> append_arguments_( const std::string& stringTable,
 
 }
 
+/** --------------------------------------------------------------------------
+ * @brief Insert rows from xml into table using prepared statements in batched transactions
+ *
+ * Each row in xml is one insert. Rows with the same columns are inserted with the same
+ * prepared statement where values are bound as parameters, column types are only read
+ * from database metadata once for each column. If insert template (`query`) is set the
+ * template is formatted for each row with `?` placeholders and statements are reused
+ * for rows that generate the same sql. Generated sql without placeholders is executed
+ * directly. Rows are inserted with the write connection borrowed by the request context,
+ * the same connection is used for all rows.
+ *
+ * @param argumentsOptions options for insert
+ * @param argumentsOptions.table table to insert into (required)
+ * @param argumentsOptions.form `attribute` for `<values column1="value1" />` else `<values><value element="name" value="value" /></values>`
+ * @param argumentsOptions.container xpath to rows, default is `//values`
+ * @param argumentsOptions.query name for insert template
+ * @param argumentsOptions.commit number of rows in each transaction, default is `m_uBulkCommit_s`, 0 inserts all rows in one transaction
+ * @param pxmldocument xml document with rows
+ * @param pdocument document with database
+ * @param pargumentsReturn if set, `count` with number of inserted rows is added
+ * @return true if all rows are inserted, false and error if not (rows not committed are rolled back)
+ */
 std::pair<bool, std::string> CAPIDatabase::XML_BulkExecute( const gd::argument::arguments& argumentsOptions, pugi::xml_document* pxmldocument, CDocument* pdocument, gd::argument::arguments* pargumentsReturn )
 {
    using namespace gd::sql;
    std::array<std::byte, 256> buffer_; // buffer to avoid allocate memory
-   gd::argument::arguments argumentsFind( buffer_ );
-   uint64_t uInsertCount = 0;
 
    std::string stringInsertTemplate; // If insert template is set for query
    std::string_view stringQuery = argumentsOptions["query"].as_string_view();
@@ -865,7 +962,9 @@ std::pair<bool, std::string> CAPIDatabase::XML_BulkExecute( const gd::argument::
    std::string stringForm = argumentsOptions["form"].as_string(); // layout is required and should be string
    std::string stringContainer = argumentsOptions["container"].as_string(); // container is required and should be string
 
-   auto* pdatabase = pdocument->GetDatabase();
+   if( pdocument->GetDatabase() == nullptr ) return { false, "no database connection in document: " + std::string( pdocument->GetName() ) };
+   auto* pdatabase = GetContext()->AcquireDatabase( CDatabasePool::eConnectionWrite ); // write connection is kept by context for all rows
+   if( pdatabase == nullptr && GetContext()->IsDatabaseBusy() == true ) return { false, "database busy" };
    if( pdatabase == nullptr ) return { false, "no database connection in document: " + std::string( pdocument->GetName() ) };
 
    if( stringContainer.empty() == true ) { stringContainer = "//values"; }
@@ -873,6 +972,57 @@ std::pair<bool, std::string> CAPIDatabase::XML_BulkExecute( const gd::argument::
    std::string stringTable = argumentsOptions["table"].as_string(); // table is required and should be string  
    if( stringTable.empty() == true ) { return { false, "table name is required for attribute form" }; }
 
+   uint64_t uCommit = argumentsOptions.exists("commit") == true ? argumentsOptions["commit"].as_uint64() : m_uBulkCommit_s;
+
+   column_type_ columntype_( pdatabase_ );
+   CBulkInsert bulkinsert_( pdatabase, uCommit );
+   uint64_t uInsertCount = 0;
+
+   // ## Global arguments are added to each row after values from xml
+   const gd::argument::arguments* pargumentsGlobal = GetContext()->GetGlobalArguments();
+   if( pargumentsGlobal != nullptr && pargumentsGlobal->empty() == true ) { pargumentsGlobal = nullptr; }
+   std::vector<gd::variant_view> vectorGlobal;
+   if( pargumentsGlobal != nullptr ) { for( auto [key_, value_] : pargumentsGlobal->named() ) { vectorGlobal.push_back( value_.as_variant_view() ); } }
+
+   std::string stringKey;                                                     // columns in row, rows with same key use same statement
+   std::vector<gd::variant_view> vectorValue;                                 // values in row, same order as fields in query
+
+   // ## Insert row, `build_` adds fields to query and is only called if statement for row is not prepared
+   auto insert_ = [&]( auto&& build_ ) -> std::pair<bool, std::string>
+   {
+      vectorValue.insert( vectorValue.end(), vectorGlobal.begin(), vectorGlobal.end() );
+
+      CBulkInsert::statement* pstatement = stringInsertTemplate.empty() == true ? bulkinsert_.Find( stringKey ) : nullptr;
+      if( pstatement != nullptr ) { return bulkinsert_.Execute( pstatement, vectorValue ); }
+
+      query queryInsert{ enumSqlDialect( uDialect ) };
+      queryInsert << table_g( stringTable );                                  // set table for insert query
+      auto result_ = build_( queryInsert );
+      if( result_.first == false ) { return result_; }
+
+      if( pargumentsGlobal != nullptr )
+      {
+         result_ = append_arguments_( stringTable, columntype_, pargumentsGlobal, queryInsert );
+         if( result_.first == false ) { return result_; }
+      }
+
+      if( stringInsertTemplate.empty() == false )                             // template, statement is found from generated sql
+      {
+         std::string stringInsertSql;
+         std::vector<gd::variant> vectorBind;
+         result_ = queryInsert.sql_format( stringInsertTemplate, stringInsertSql, nullptr, &vectorBind );
+         if( result_.first == false ) { return result_; }
+
+         return bulkinsert_.Execute( stringInsertSql, vectorBind );           // sql without bound values is executed directly, not cached
+      }
+
+      if( queryInsert.field_size() != vectorValue.size() ) { return bulkinsert_.Execute( std::string_view( queryInsert.sql_get( eSqlInsert ) ) ); } // row do not map to fields, insert as text
+
+      result_ = bulkinsert_.Add( stringKey, queryInsert, &pstatement );
+      if( result_.first == false ) { return result_; }
+      return bulkinsert_.Execute( pstatement, vectorValue );
+   };
+
    if( stringForm == "attribute" )
    {
       // ## xml form is like <values column1="value1" column2="value2" />
@@ -881,67 +1031,51 @@ std::pair<bool, std::string> CAPIDatabase::XML_BulkExecute( const gd::argument::
       pugi::xpath_node_set xpathnodesetValues = pxmldocument->select_nodes(stringContainer.c_str());
       for( auto& xpathnode_ : xpathnodesetValues )
       {
-         query queryInsert{ enumSqlDialect( uDialect ) };
-
-         queryInsert << table_g( stringTable );                     // set table for insert query
-
          pugi::xml_node xmlnodeValue = xpathnode_.node();
-         for( auto& xmlattribute_ : xmlnodeValue.attributes() )              // loop attributes in element and add attribute name and values to query
+
+         stringKey.clear();
+         vectorValue.clear();
+         for( auto& xmlattribute_ : xmlnodeValue.attributes() )
          {
             std::string_view stringName = xmlattribute_.name();
-            std::string_view stringValue = xmlattribute_.value();
-
             if( stringName.empty() == true ) { continue; }
+            stringKey += stringName;
+            stringKey += '\n';
+            vectorValue.push_back( gd::variant_view( std::string_view( xmlattribute_.value() ) ) );
+         }
 
-            if( stringName[0] == '_' )
+         auto build_ = [&]( query& queryInsert ) -> std::pair<bool, std::string>
+         {
+            for( auto& xmlattribute_ : xmlnodeValue.attributes() )           // loop attributes in element and add attribute name and values to query
             {
-               argumentsFind.clear();
-               stringName.remove_prefix( 1 );                                 // remove _ prefix to prepare for extended syntax
-               queryInsert.add( stringName, stringValue, gd::sql::tag_parse{} );
-
-               auto* pfield = queryInsert.field_get_last();
-               auto table_ = pfield->table_name();
-               auto name_ = pfield->name();
+               std::string_view stringName = xmlattribute_.name();
+               std::string_view stringValue = xmlattribute_.value();
 
-               argumentsFind.append( { {std::string_view( "table" ), table_}, {std::string_view( "column" ), name_} }, gd::types::tag_view{} );
-               int64_t iRow = pdatabase_->Column_FindRow( argumentsFind ); 
-               if( iRow == -1 ) { return { false, "column not found in database: " + std::string(table_) }; }
-               auto uType = pdatabase_->Column_GetType( iRow );
-               pfield->set_type( uType );
+               if( stringName.empty() == true ) { continue; }
 
-               continue;
-            }
+               uint32_t uType;
+               if( stringName[0] == '_' )
+               {
+                  stringName.remove_prefix( 1 );                              // remove _ prefix to prepare for extended syntax
+                  queryInsert.add( stringName, stringValue, gd::sql::tag_parse{} );
 
-            argumentsFind.clear();
-            argumentsFind.append( { {std::string_view("table"), stringTable}, {std::string_view("column"), stringName} }, gd::types::tag_view{});
-            int64_t iRow = pdatabase_->Column_FindRow( argumentsFind ); 
-            if( iRow == -1 ) { return { false, "column not found in database: Table " + std::string(stringTable) + ", Column " + std::string(stringName) }; }
-
-            auto uType = pdatabase_->Column_GetType( iRow );
-            queryInsert << field_g( stringTable, stringName, buffer_ ).value( stringValue ).type( uType );
-         }
+                  auto* pfield = queryInsert.field_get_last();
+                  auto table_ = pfield->table_name();
+                  auto name_ = pfield->name();
 
-         const gd::argument::arguments* pargumentsGlobal = GetContext()->GetGlobalArguments();
-         if( pargumentsGlobal != nullptr && pargumentsGlobal->empty() == false )
-         {
-            auto result_ = append_arguments_( stringTable, pdatabase_, pargumentsGlobal, queryInsert );
-            if( result_.first == false ) { return result_; }
-         }
+                  if( columntype_.find( table_, name_, uType ) == false ) { return { false, "column not found in database: " + std::string(table_) }; }
+                  pfield->set_type( uType );
 
-         std::string stringInsertSql;
+                  continue;
+               }
 
-         if( stringInsertTemplate.empty() == false )
-         {
-            auto result_ = queryInsert.sql_format( stringInsertTemplate, stringInsertSql );
-            if( result_.first == false ) { return result_; }
-         }
-         else 
-         {
-            stringInsertSql = queryInsert.sql_get( eSqlInsert );
-         }
+               if( columntype_.find( stringTable, stringName, uType ) == false ) { return { false, "column not found in database: Table " + std::string(stringTable) + ", Column " + std::string(stringName) }; }
+               queryInsert << field_g( stringTable, stringName, buffer_ ).value( stringValue ).type( uType );
+            }
+            return { true, "" };
+         };
 
-         //auto result_ = pdatabase->execute( stringInsertSql );
-         auto result_ = Database_Execute( pdatabase, stringInsertSql );
+         auto result_ = insert_( build_ );
          if( result_.first == false ) { return result_; }
          uInsertCount++;
       }
@@ -960,42 +1094,47 @@ std::pair<bool, std::string> CAPIDatabase::XML_BulkExecute( const gd::argument::
       pugi::xpath_node_set xpathnodesetValues = pxmldocument->select_nodes(stringContainer.c_str());
       for( auto& xpathnode_ : xpathnodesetValues )
       {
-         query queryInsert{ enumSqlDialect( uDialect ) };
-         queryInsert << table_g( stringTable );                     // set table for insert query
-
          pugi::xml_node xmlnodeValues = xpathnode_.node();
-         for( auto& xmlnodeValue_ : xmlnodeValues.children() )               // loop child elements (each is a column)
+
+         // ### collect columns, child elements (each is a column) with element name
+         stringKey.clear();
+         vectorValue.clear();
+         for( auto& xmlnodeValue_ : xmlnodeValues.children() )
          {
             if( xmlnodeValue_.name() == nullptr || stringElement != xmlnodeValue_.name() ) continue; // skip if no element name
-
             std::string_view stringName = xmlnodeValue_.attribute(stringElement.c_str()).value();
-            std::string_view stringFieldValue = xmlnodeValue_.attribute(stringValue.c_str()).value();
-
             if( stringName.empty() == true ) continue;                       // skip if no element name
-
-            argumentsFind.clear();
-            argumentsFind.append( { {std::string_view("table"), gd::variant_view(stringTable)}, {std::string_view("column"), gd::variant_view(stringName)} }, gd::types::tag_view{});
-            int64_t iRow = pdatabase_->Column_FindRow( argumentsFind );
-            if( iRow == -1 ) { return { false, "column not found in database: " + std::string(stringName) }; }
-
-            auto uType = pdatabase_->Column_GetType( iRow );
-            queryInsert << field_g( stringName, buffer_ ).value( stringFieldValue ).type( uType );
+            stringKey += stringName;
+            stringKey += '\n';
+            vectorValue.push_back( gd::variant_view( std::string_view( xmlnodeValue_.attribute(stringValue.c_str()).value() ) ) );
          }
 
-         const gd::argument::arguments* pargumentsGlobal = GetContext()->GetGlobalArguments();
-         if( pargumentsGlobal != nullptr && pargumentsGlobal->empty() == false )
+         auto build_ = [&]( query& queryInsert ) -> std::pair<bool, std::string>
          {
-            auto result_ = append_arguments_( stringTable, pdatabase_, pargumentsGlobal, queryInsert );
-            if( result_.first == false ) { return result_; }
-         }
+            for( auto& xmlnodeValue_ : xmlnodeValues.children() )
+            {
+               if( xmlnodeValue_.name() == nullptr || stringElement != xmlnodeValue_.name() ) continue;
 
-         std::string stringInsertSql = queryInsert.sql_get( eSqlInsert );
-         auto result_ = Database_Execute( pdatabase, stringInsertSql );
+               std::string_view stringName = xmlnodeValue_.attribute(stringElement.c_str()).value();
+               std::string_view stringFieldValue = xmlnodeValue_.attribute(stringValue.c_str()).value();
+               if( stringName.empty() == true ) continue;
+
+               uint32_t uType;
+               if( columntype_.find( stringTable, stringName, uType ) == false ) { return { false, "column not found in database: " + std::string(stringName) }; }
+               queryInsert << field_g( stringName, buffer_ ).value( stringFieldValue ).type( uType );
+            }
+            return { true, "" };
+         };
+
+         auto result_ = insert_( build_ );
          if( result_.first == false ) { return result_; }
          uInsertCount++;
       }
    }
 
+   auto result_ = bulkinsert_.Commit();
+   if( result_.first == false ) { return result_; }
+
    if( pargumentsReturn != nullptr ) { pargumentsReturn->push_back_view( std::string_view("count"), gd::variant_view(uInsertCount) ); }
 
    return { true, "" };
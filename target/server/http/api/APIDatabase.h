@@ -88,10 +88,12 @@ public:
 
 // ## attributes ----------------------------------------------------------------
 public:
+   inline static uint64_t m_uBulkCommit_s = 1000;      ///< default number of rows in each transaction for bulk insert
 
 
 // ## free functions ------------------------------------------------------------
 public:
+   /// Insert rows from xml, rows are inserted with prepared statements in transactions with `commit` rows
    std::pair<bool, std::string> XML_BulkExecute( const gd::argument::arguments& argumentsOptions, pugi::xml_document* pxmldocument, CDocument* pdocument, gd::argument::arguments* pargumentsReturn = nullptr );
 
 
@@ -80,7 +80,7 @@ std::pair<bool, std::string> CAPISql::Execute_Add()
    // TODO: Implement SQL query execution logic
    
    // Get query from parameters
-   std::string stringQuery = m_argumentsQS["query"].as_string();
+   std::string stringQuery = QS_Get("query").as_string();
 
    CDocument* pdocument = GetDocument();
 
@@ -48,6 +48,7 @@ std::pair<bool, std::string> CAPISystem::Execute()
    std::pair<bool, std::string> result_(true,"");
 
    CRouter::Encode_s( m_argumentsQS, { "query" } );
+   QS_ResetIndex();                                                           // query is changed in buffer
 
    for( std::size_t uIndex = m_uCommandIndex; uIndex < m_vectorCommand.size(); ++uIndex )
    {
@@ -182,7 +183,7 @@ std::pair<bool, std::string> CAPISystem::Execute()
 std::pair<bool, std::string> CAPISystem::Execute_FileDelete()
 {
    std::string stringPathFound;
-   std::string stringPath = m_argumentsQS["path"].as_string();
+   std::string stringPath = QS_Get("path").as_string();
    if(stringPath.empty() == false)
    {
       if( std::filesystem::exists(stringPath) && std::filesystem::is_regular_file(stringPath) )
@@ -213,11 +214,11 @@ std::pair<bool, std::string> CAPISystem::Execute_FileDirectory()
 {
    std::string stringAction;
 
-   if( m_argumentsQS.exists( "action" ) == true ) { stringAction = m_argumentsQS["action"].as_string(); }
+   if( QS_Exists( "action" ) == true ) { stringAction = QS_Get("action").as_string(); }
 
    if( stringAction == "get" )
    {
-      std::string stringType = m_argumentsQS["type"].as_string();      // type of folder, "root", "application" etc
+      std::string stringType = QS_Get("type").as_string();             // type of folder, "root", "application" etc
       std::string stringFolderType("folder-");
       stringFolderType += stringType;
 
@@ -228,11 +229,11 @@ std::pair<bool, std::string> CAPISystem::Execute_FileDirectory()
    }
    else if( stringAction == "set" )
    {
-      std::string stringType = m_argumentsQS["type"].as_string();
+      std::string stringType = QS_Get("type").as_string();
       std::string stringFolderType("folder-");
       stringFolderType += stringType;
       
-      std::string stringValue = m_argumentsQS.get_argument({"name", "value"}).as_string();
+      std::string stringValue = QS_Get({"name", "value"}).as_string();
       papplication_g->PROPERTY_Set( stringFolderType, stringValue );          // Note that setting folder is not thread safe and should only be done in development mode or local on prem solutions
    }
    else
@@ -249,7 +250,7 @@ std::pair<bool, std::string> CAPISystem::Execute_FileDirectory()
 std::pair<bool, std::string> CAPISystem::Execute_FileExists()
 {
    std::string stringPathFound;
-   std::string stringPath = m_argumentsQS["path"].as_string();
+   std::string stringPath = QS_Get("path").as_string();
    if(stringPath.empty() == false)
    {
       if( std::filesystem::exists(stringPath) )
@@ -468,9 +469,9 @@ std::pair<bool, std::string> CAPISystem::Execute_SessionAdd()
    gd::types::uuid uuid; // uuid for session
    std::string stringSession; // session string read from request
 
-   if(m_argumentsQS.exists("new") == false)                                  // No "new" parameter, so we are adding a session by value
+   if(QS_Exists("new") == false)                                             // No "new" parameter, so we are adding a session by value
    {
-      stringSession = m_argumentsQS["session"].as_string();    // get session to add
+      stringSession = QS_Get("session").as_string();           // get session to add
 
       if( stringSession.size() < 32 ) { stringSession.append( 32 - stringSession.size(), '0' ); } // Pad session if less than 32 bytes
    
@@ -494,7 +495,7 @@ std::pair<bool, std::string> CAPISystem::Execute_SessionAdd()
 
    gd::argument::arguments* parguments_ = new gd::argument::arguments( "index", uIndex, gd::argument::arguments::tag_view{}, gd::argument::arguments::tag_no_initializer_list{});
    //gd::argument::arguments* parguments_ = new gd::argument::arguments( { { "index", uIndex } } );
-   if( m_argumentsQS.exists("new") == true ) { parguments_->append("session", stringSession); }
+   if( QS_Exists("new") == true ) { parguments_->append("session", stringSession); }
    Objects().Add( parguments_ );
    
    return { true, "" };
@@ -505,7 +506,7 @@ std::pair<bool, std::string> CAPISystem::Execute_SessionDelete()
 {
    if( QS_Exists("session") == true )
    {
-      std::string stringSession = m_argumentsQS["session"].as_string(); // get session to delete
+      std::string stringSession = QS_Get("session").as_string();        // get session to delete
       
       // ## Pad session if less than 32 bytes and validate ...................
       if( stringSession.size() < 32 ) { stringSession.append(32 - stringSession.size(), '0'); }
@@ -554,7 +555,7 @@ std::pair<bool, std::string> CAPISystem::Execute_SessionExists()
    CDocument* pdocument = GetDocument();
    auto* psessions = pdocument->SESSION_Get();
 
-   std::string stringSession = m_argumentsQS["session"].as_string();   // session to check for
+   std::string stringSession = QS_Get("session").as_string();          // session to check for
 
    // ## Pad session if less than 32 bytes
    if( stringSession.size() < 32 ) { stringSession.append(32 - stringSession.size(), '0'); }
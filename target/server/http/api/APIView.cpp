@@ -1,5 +1,6 @@
 // @FILE [tag: api, view] [summary: API View renders pages, like server side rendering] [type: source] [name: APIView.cpp]
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <fstream>
@@ -7,14 +8,13 @@
 
 #include "gd/gd_arguments.h"
 #include "gd/gd_binary.h"
-#include "gd/parse/gd_parse_window_line.h"
-#include "gd/expression/gd_expression_parse_state.h"
 
 
 #include "../Router.h"
 #include "../Document.h"
 #include "../Application.h"
 
+#include "../render/RENDERHtml.h"
 #include "../render/RENDERSql.h"
 #include "API_Scripting.h"
 #include "APIView.h"
@@ -49,15 +49,8 @@ std::pair<bool, std::string> CAPIView::Execute()
 
 std::pair<bool, std::string> CAPIView::Execute_RenderPage( std::string& stringRendered )
 {                                                                                                  assert(m_stringPath.empty() == false );
-   enum enumLanguage { eLanguageNone = 0, eLanguageLua, eLanguageGD, eLanguageExpression };
-   gd::parse::window::line lineBuffer(48 * 64, 64 * 64, gd::types::tag_create{});  // create line buffer 64 * 64 = 4096 bytes = 64 cache lines
-   gd::expression::parse::state state_; // state is used to check what type of code part we are in
-   const gd::expression::parse::state::rule* pruleActive = nullptr; // pointer to active rule, this is used to check what type of code part we are in and to get end marker for code part
-
    auto pdocument = GetContext()->GetDocument();                                                   assert(pdocument != nullptr);
-   auto* pdatabase = pdocument->GetDatabase();                                                     if(pdatabase == nullptr) return { false, "no database" };
-   if(GetContext()->GetDatabase() == nullptr) { GetContext()->SetDatabase(pdatabase); }
-
+   if(pdocument->GetDatabase() == nullptr) return { false, "no database" };
 
    // ## CRENDERSql as container that handle query sting values, this because it has more logic compared to just a key value container.
    gd::sql::enumSqlDialect eDialect = static_cast<gd::sql::enumSqlDialect>(pdocument->DATABASE_Get()->GetDialect());
@@ -65,84 +58,28 @@ std::pair<bool, std::string> CAPIView::Execute_RenderPage( std::string& stringRe
    sql_.Initialize();
    sql_.AddValues(m_argumentsQS);
 
+   // ## page is parsed once into static text and code blocks, parsed again if file is changed
+   std::shared_ptr<const CRENDERHtml::page> ppage;
+   auto result_ = CRENDERHtml::GetPage_s( m_stringPath, ppage );
+   if( result_.first == false ) return result_;
 
-   std::string stringPage;
-   std::string stringCode; // string to hold code found in page, this will be used to render page
-
-   stringPage.reserve(1024 * 8);                                              // reserve space for page
-   stringCode.reserve(1024);                                                  // reserve space for code
-
-   std::ifstream file_(m_stringPath.data(), std::ios::binary);
-   if(file_.is_open() == false) return { false, "Failed to open file: " + std::string(m_stringPath) };
-
-   auto uAvailable = lineBuffer.available();
-   file_.read((char*)lineBuffer.buffer(), uAvailable);
-   auto uReadSize = file_.gcount();                                           // get number of valid bytes read
-   lineBuffer.update(uReadSize);                                              // Update valid size in line buffer
-
-   state_.add(std::string_view("SCRIPTCODE"), "[[lua", "]]");
-   state_.add(std::string_view("SCRIPTCODE"), "[[gd", "]]");
-   state_.add(std::string_view("EXPRESSION"), "[[=", "]]");
-
-   uint8_t uCharacter = 0;                                                    // character to hold current character
-
-
-   // ## Scan file and read lines found in table
-   while(lineBuffer.eof() == false)
+   // ## Lua code gets database from context, borrow connection only for pages with lua code and writer only if code writes
+   if( ppage->m_bLua == true )
    {
-      auto [first_, last_] = lineBuffer.range(gd::types::tag_pair{});         // get range of valid data in buffer
-      for(auto it = first_; it < last_; it++)
-      {
-         uCharacter = *it;                                                    // get current character
-
-         if(state_.in_state() == false)                                       // not in a state? that means we are reading page code
-         {
-            // ## check if we have found state ...............................
-            if(state_[uCharacter] != 0 && state_.exists(it) == true)
-            {
-               stringCode.clear();                                            // clear code string to start reading new code
-               auto uLength = state_.activate(it);                            // activate state
-               if(uLength > 1) it += (uLength - 1);                           // skip to end of state marker and if it is more than 1 character, skip to end of state
-               pruleActive = state_.get_active_rule_pointer();                // get pointer to active rule, this will be used to check for end of state
-               continue;                                                      // continue to next character, we will start reading code in next iteration
-            }
-
-            stringPage += uCharacter;                                         // add character to page string
-         }
-         else
-         {
-            // ## check if we have found end of state
-            unsigned uLength;
-            if(state_.deactivate(it, &uLength) == true)
-            {
-               if(uLength > 1) it += (uLength - 1);                           // skip to end of state marker and if it is more than 1 character, skip to end of state
-
-               if(stringCode.empty() == false)
-               {
-                  assert(pruleActive != nullptr);
-                  auto stringType = std::string_view(pruleActive->get_start()).substr(2);// get code type from start marker, this will be used to determine how to render code
-                  if(stringType == "lua" )
-                  {
-                     auto result_ = SCRIPT::LuaSSRExecute(std::string_view(stringCode), GetContext(), &sql_, &stringPage); // run Lua code and insert text to page
-                     if(result_.first == false) { return result_; }
-                  }
-               }
-               pruleActive = nullptr;
-               continue;
-            }
-
-            stringCode += uCharacter;                                         // add character to code string
-         }
-      }
+      unsigned uConnection = ppage->m_bWrite == true ? CDatabasePool::eConnectionWrite : CDatabasePool::eConnectionRead;
+      if( GetContext()->AcquireDatabase( uConnection ) == nullptr ) return { false, GetContext()->IsDatabaseBusy() == true ? "database busy" : "no database" };
+   }
 
-      lineBuffer.rotate();                                                    // rotate buffer
+   std::string stringPage;
+   stringPage.reserve( ppage->m_uTextSize + 1024 );                           // static text and some space for generated text
 
-      if(uReadSize > 0)                                                       // was it possible to read data last read, then more data is available
+   for( const auto& segment_ : ppage->m_vectorSegment )
+   {
+      if( segment_.m_eType == CRENDERHtml::eSegmentText ) { stringPage += ppage->text( segment_ ); }
+      else if( segment_.m_eType == CRENDERHtml::eSegmentLua )
       {
-         auto uAvailable = lineBuffer.available();                            // get available space in buffer to be filled
-         file_.read((char*)lineBuffer.buffer(), lineBuffer.available());      // read more data into available space in buffer
-         uReadSize = file_.gcount();
-         lineBuffer.update(uReadSize);                                        // update valid size in line buffer
+         result_ = SCRIPT::LuaSSRExecute( ppage->text( segment_ ), GetContext(), &sql_, &stringPage ); // run Lua code and insert text to page
+         if( result_.first == false ) { return result_; }
       }
    }
 
@@ -58,9 +58,74 @@ void CAPIContext::ResetDatabase()
    }
 
    m_pdatabase = nullptr; 
+   m_borrowDatabase.release();
    ClearFlag( eFlagDatabaseOwner ); 
 }
 
+/** -------------------------------------------------------------------------- AcquireDatabase
+ * @brief Get database connection for request
+ *
+ * If document has a connection pool a connection is borrowed and kept until the
+ * context is destroyed or database is reset, chained API sections use the same
+ * connection. A borrowed read connection is switched to the write connection
+ * when write is requested. Without pool the document connection is used.
+ * If all pooled connections stay busy until the pool timeout `eFlagDatabaseBusy`
+ * is set and nullptr is returned, the shared document connection is not used
+ * as fallback because it is not safe to share between threads.
+ *
+ * @param uConnection connection type, `CDatabasePool::eConnectionRead` or `CDatabasePool::eConnectionWrite`
+ * @return database connection or nullptr if document do not have a database or pool is busy
+ */
+gd::database::database_i* CAPIContext::AcquireDatabase( unsigned uConnection )
+{
+   if( m_borrowDatabase.empty() == false )
+   {
+      if( uConnection == CDatabasePool::eConnectionRead || m_borrowDatabase.is_read() == false ) { return m_pdatabase; }
+      ResetDatabase();                                                         // return read connection before write connection is borrowed
+   }
+   else if( m_pdatabase != nullptr ) { return m_pdatabase; }                  // database set by caller
+
+   if( m_pdocument == nullptr ) { return nullptr; }
+
+   CDatabasePool* ppool = m_pdocument->DATABASE_GetPool();
+   if( ppool != nullptr )
+   {
+      m_borrowDatabase = ppool->Acquire( uConnection );
+      if( m_borrowDatabase.empty() == false ) { m_pdatabase = m_borrowDatabase.get(); return m_pdatabase; }
+      if( ppool->Empty() == false ) { SetFlag( eFlagDatabaseBusy ); return nullptr; } // timeout waiting for connection
+   }
+
+   m_pdatabase = m_pdocument->GetDatabase();
+   return m_pdatabase;
+}
+
+/** -------------------------------------------------------------------------- PrepareCursor
+ * @brief Get cursor with prepared statement for sql
+ *
+ * With borrowed pool connection the statement is taken from connection cache,
+ * sql is only parsed first time. Without pool a new cursor is prepared.
+ * Release cursor before context is destroyed.
+ *
+ * @param stringSql sql statement, use `?` for values that are bound
+ * @param ppcursor receives cursor with prepared statement
+ * @return true if ok, false and error information if prepare failed
+ */
+std::pair<bool, std::string> CAPIContext::PrepareCursor( std::string_view stringSql, gd::database::cursor_i** ppcursor )
+{                                                                                                  assert( ppcursor != nullptr );
+   if( m_borrowDatabase.empty() == false ) { return m_borrowDatabase.prepare( stringSql, ppcursor ); }
+   if( m_pdatabase == nullptr ) { return { false, "no database connection" }; }
+
+   gd::database::cursor_i* pcursor = nullptr;
+   auto result_ = m_pdatabase->get_cursor( &pcursor );
+   if( result_.first == false ) { return result_; }
+
+   result_ = pcursor->prepare( stringSql );
+   if( result_.first == false ) { pcursor->release(); return result_; }
+
+   *ppcursor = pcursor;
+   return { true, "" };
+}
+
 
 void CAPIContext::Reset()
 {
@@ -91,6 +156,7 @@ void CAPI_Base::common_construct( CAPI_Base&& o ) noexcept
    m_vectorCommand          = std::move( o.m_vectorCommand );
    m_uCommandIndex          = std::exchange( o.m_uCommandIndex, 0 );
    m_argumentsQS            = std::move( o.m_argumentsQS );
+   m_indexQS.clear();                                                         // index points into source buffer, built again on first lookup
    m_stringBody             = o.m_stringBody;
    m_arrayBufferCounter     = std::move( o.m_arrayBufferCounter );    // NOTE: was self-moving in original — fixed
    m_argumentsArgumentCount = std::move( o.m_argumentsArgumentCount );
@@ -227,7 +293,7 @@ size_t CAPI_Base::GetArgumentIndex( const std::string_view& stringFirst,
  */
 bool CAPI_Base::QS_Exists(const std::string_view& stringName) const
 {
-   return m_argumentsQS.exists(stringName);
+   return QS_GetIndex().exists(stringName);
 }
 
 /** -------------------------------------------------------------------------- CAPI_Base::IncrementArgumentCounter
@@ -272,11 +338,16 @@ void CAPI_Base::IncrementArgumentCounter( std::string_view stringName )
  * - finalize render state (`Prepare`) and build SQL (`ToSqlFromTemplate`)
  * - write SQL into `stringSqlExecute` (assign if empty, otherwise append)
  *
+ * If `pvectorBind` is set, values are collected in vector and `?` is placed in
+ * SQL (see `gd::sql::query::sql_format`). Same statement with same values generates
+ * the same SQL and the prepared statement can be reused from connection cache.
+ *
  * @param statement_id_ Statement selector: row index or named query identifier.
  * @param stringSqlExecute Output SQL buffer; receives generated SQL by assign/append.
+ * @param pvectorBind Optional vector that receives values to bind as parameters.
  * @return std::pair<bool, std::string> `first` is success; `second` is error text on failure.
  */
-std::pair<bool, std::string> CAPI_Base::PrepareStatement( std::variant<size_t, std::string_view> statement_id_, std::string& stringSqlExecute )
+std::pair<bool, std::string> CAPI_Base::PrepareStatement( std::variant<size_t, std::string_view> statement_id_, std::string& stringSqlExecute, std::vector<gd::variant>* pvectorBind )
 {
    std::string stringQuery;
    uint64_t uStatementRow; // resolved statement row index, this to speed up access to statement
@@ -349,7 +420,7 @@ std::pair<bool, std::string> CAPI_Base::PrepareStatement( std::variant<size_t, s
    if( stringSelectTemplate.empty() == true ) { return { false, "query statement is empty for: " + std::string( stringQuery ) }; }
 
    stringQuery.clear();
-   result_ = FromTemplate_s(sql_, stringSelectTemplate, stringQuery);                             if(result_.first == false) { return result_; }
+   result_ = FromTemplate_s(sql_, stringSelectTemplate, stringQuery, pvectorBind);                if(result_.first == false) { return result_; }
 
    if( stringSqlExecute.empty() == true ) { stringSqlExecute = std::move(stringQuery); }
    else { stringSqlExecute += stringQuery; }
@@ -564,7 +635,7 @@ std::pair<bool, std::string> CAPI_Base::Lua_Execute( uint64_t uStatementRow, CDo
    return { true, "" };
 }
 
-std::pair<bool, std::string> CAPI_Base::FromTemplate_s(CRENDERSql& sql_, std::string_view stringTemplate, std::string& stringSql)
+std::pair<bool, std::string> CAPI_Base::FromTemplate_s(CRENDERSql& sql_, std::string_view stringTemplate, std::string& stringSql, std::vector<gd::variant>* pvectorBind)
 {
    std::string stringTemporary; // If preprocessing and it have modified query then we need to store it.
 
@@ -579,7 +650,7 @@ std::pair<bool, std::string> CAPI_Base::FromTemplate_s(CRENDERSql& sql_, std::st
    result_ = sql_.ValidateColumnValues();                                                         if(result_.first == false) { return result_; }
 
    // @NOTE [tag: sql, statement] [summary: render SQL statement from template]
-   result_ = sql_.ToSqlFromTemplate(stringTemplate, stringSql);                                   if(result_.first == false) { return result_; }
+   result_ = sql_.ToSqlFromTemplate(stringTemplate, stringSql, pvectorBind);                      if(result_.first == false) { return result_; }
 
    return { true, "" };
 }
@@ -8,11 +8,14 @@
 #include <utility>
 #include <vector>
 
+#include "gd/gd_arena.h"
 #include "gd/gd_arguments.h"
+#include "gd/gd_arguments_index.h"
 #include "gd/gd_variant_view.h"
 #include "gd/gd_database.h"
 
 #include "../Types.h"
+#include "../DatabasePool.h"
 
 #include "../Server.h"
 
@@ -93,9 +96,11 @@ private:
       m_pdocument       = std::exchange( o.m_pdocument,    nullptr );
       m_psession        = std::exchange( o.m_psession,     nullptr );
       m_pdatabase       = std::exchange( o.m_pdatabase,    nullptr);
+      m_borrowDatabase  = std::move( o.m_borrowDatabase );
       m_objects         = std::move( o.m_objects );
       m_argumentsGlobal = std::move( o.m_argumentsGlobal );
       m_stringLastError = std::move( o.m_stringLastError );
+      m_parena          = std::exchange( o.m_parena, nullptr );
       m_uFlags          = std::exchange( o.m_uFlags, 0u );
    }
 
@@ -109,6 +114,7 @@ public:
       eFlagHasResult       = 0x00000004,  ///< at least one object was added to m_objects
       eFlagDatabaseOwner   = 0x00000008,  ///< Ownss the database, releases it on destruction (not yet implemented)
       eFlagSession         = 0x00000010,  ///< Linked to a session (m_psession is valid); set by constructor that takes session pointer
+      eFlagDatabaseBusy    = 0x00000020,  ///< all pooled connections were busy when AcquireDatabase() timed out
 
       eFlagStatusAbort     = 0x00010000,  ///< API execution should be aborted
       eFlagStatusContinue  = 0x00020000,  ///< API execution should continue to the next section
@@ -128,10 +134,25 @@ public:
    gd::database::database_i* GetDatabase() { return m_pdatabase; }
    const gd::database::database_i* GetDatabase() const { return m_pdatabase; }
    void SetDatabase( gd::database::database_i* pdatabase ) { m_pdatabase = pdatabase; }
+   /// Get database for request, connection is borrowed from document pool if document has pool
+   gd::database::database_i* AcquireDatabase( unsigned uConnection );
+   /// Move borrowed connection out of context, used when cursor is read after context is done (streamed rows)
+   CDatabasePool::borrow ReleaseBorrow() { if( m_borrowDatabase.empty() == false ) { m_pdatabase = nullptr; } return std::move( m_borrowDatabase ); }
+   /// Get cursor with prepared statement, statement is reused from connection cache if connection is borrowed from pool
+   std::pair<bool, std::string> PrepareCursor( std::string_view stringSql, gd::database::cursor_i** ppcursor );
 
    const session*      GetSession() const { return m_psession; }
    void SetSession( const session* psession );
 
+   /// Arena for memory used by request, all memory is released when request is done
+   gd::memory::arena<>* GetArena() const { return m_parena; }
+   void SetArena( gd::memory::arena<>* parena ) { m_parena = parena; }
+
+   /// Arguments with buffer in request arena, buffer moves to heap if it is too small. Heap arguments if no arena
+   gd::argument::arguments CreateArguments( unsigned uSize ) const;
+   /// Copy arguments to buffer in request arena
+   gd::argument::arguments CreateArguments( const gd::argument::arguments& arguments_ ) const;
+
    /// Bind a document pointer; also sets eFlagLinked when application is already set
    void SetDocument( CDocument* pdocument )
    {
@@ -154,6 +175,7 @@ public:
    bool HasError()   const { return ( m_uFlags & eFlagHasError )  != 0; }
    bool HasResult()  const { return ( m_uFlags & eFlagHasResult ) != 0; }
    bool IsDatabaseOwner() const { return ( m_uFlags & eFlagDatabaseOwner ) != 0; }
+   bool IsDatabaseBusy() const { return ( m_uFlags & eFlagDatabaseBusy ) != 0; }
 
    // ## Status flags that can be set by API sections to control execution flow across chained sections
 
@@ -233,12 +255,29 @@ public:
    CDocument*              m_pdocument{};          ///< non-owning; resolves to the calling user's document
    const session*          m_psession{};           ///< non-owning; resolves to the calling user's session (optional, can be used for session-specific data or operations)
    gd::database::database_i* m_pdatabase{};        ///< database used for this request
+   CDatabasePool::borrow   m_borrowDatabase;       ///< connection borrowed from document pool, returned when context is destroyed or database is reset
    Types::Objects          m_objects;              ///< accumulates result objects across chained API sections
    gd::argument::arguments m_argumentsGlobal;      ///< global values shared across sections (e.g. insert key passed to next section)
    std::string             m_stringLastError;      ///< last error message recorded in this context
+   gd::memory::arena<>*    m_parena{};             ///< non-owning; arena for request, reset by server when request is done
    unsigned                m_uFlags{ eFlagNone };  ///< state flags (bound, has-error, has-result)
 };
 
+inline gd::argument::arguments CAPIContext::CreateArguments( unsigned uSize ) const
+{                                                                                                  assert( uSize > 0 );
+   if( m_parena == nullptr ) return gd::argument::arguments();
+   auto span_ = m_parena->allocate_span<std::byte>( uSize );
+   return gd::argument::arguments( reinterpret_cast<gd::argument::arguments::pointer>( span_.data() ), uSize );
+}
+
+inline gd::argument::arguments CAPIContext::CreateArguments( const gd::argument::arguments& arguments_ ) const
+{
+   if( m_parena == nullptr || arguments_.empty() == true ) return arguments_;
+   gd::argument::arguments argumentsCopy( CreateArguments( arguments_.buffer_size() ) );
+   argumentsCopy = arguments_;                                                // copied into arena buffer, it is large enough
+   return argumentsCopy;
+}
+
 /// Set or clear eFlagSession based on whether the session pointer is valid
 inline void CAPIContext::SetSession( const session* psession ) {
    m_psession = psession;
@@ -292,10 +331,10 @@ public:
    // -- shared-context constructors (preferred for chained endpoints) -------
 
    CAPI_Base( CAPIContext& context, const std::vector<std::string_view>& vectorCommand, const gd::argument::arguments& argumentsParameter )
-      : m_vectorCommand( vectorCommand ), m_argumentsQS( argumentsParameter ), m_pcontext( &context ) {}
+      : m_vectorCommand( vectorCommand ), m_argumentsQS( context.CreateArguments( argumentsParameter ) ), m_pcontext( &context ) {}
 
    CAPI_Base( CAPIContext& context, const std::vector<std::string_view>& vectorCommand, const gd::argument::arguments& argumentsParameter, unsigned uCommandIndex )
-      : m_vectorCommand( vectorCommand ), m_uCommandIndex( uCommandIndex ), m_argumentsQS( argumentsParameter ), m_pcontext( &context ) { assert( uCommandIndex < vectorCommand.size() ); }
+      : m_vectorCommand( vectorCommand ), m_uCommandIndex( uCommandIndex ), m_argumentsQS( context.CreateArguments( argumentsParameter ) ), m_pcontext( &context ) { assert( uCommandIndex < vectorCommand.size() ); }
 
    CAPI_Base( CAPIContext& context, std::vector<std::string_view>&& vectorCommand,gd::argument::arguments&& argumentsParameter )
       : m_vectorCommand( std::move( vectorCommand ) ) , m_argumentsQS( std::move( argumentsParameter ) ), m_pcontext( &context ) {}
@@ -332,7 +371,7 @@ private:
 public:
    /// Get argument by name (first value for that name from URI parameters)
    gd::variant_view operator[]( const char* piName ) { 
-      return m_argumentsQS.get_argument( std::string_view( piName ) ).as_variant_view(); }
+      return m_argumentsQS[ QS_GetIndex()[ std::string_view( piName ) ] ].as_variant_view(); }
 
    gd::variant_view operator[]( std::tuple<std::string_view, size_t> index_ ) { 
       return m_argumentsQS.find_argument( std::get<0>( index_ ), (unsigned)std::get<1>( index_ ) ).as_variant_view(); }
@@ -384,12 +423,22 @@ public:
    // @API [tag: parameter] [description: Accessors for per-request parameters parsed from the URL query string]
 
    /// Get the first value for parameter name from the URL query string; returns empty variant if not found
-   gd::variant_view QS_Get( std::string_view stringName ) const { return m_argumentsQS.get_argument( stringName ); }
-   gd::variant_view QS_GetArgument( std::string_view stringName ) const { return m_argumentsQS.get_argument( stringName ); }
+   gd::variant_view QS_Get( std::string_view stringName ) const { return m_argumentsQS[ QS_GetIndex()[stringName] ].as_variant_view(); }
+   gd::variant_view QS_GetArgument( std::string_view stringName ) const { return m_argumentsQS[ QS_GetIndex()[stringName] ].as_variant_view(); }
+   /// Get value for first name found, like `QS_Get( { "document", "doc" } )`, null if no name is found
+   gd::variant_view QS_Get( std::initializer_list<std::string_view> listName ) const {
+      for( auto stringName : listName ) { gd::variant_view v_ = QS_Get( stringName ); if( v_.is_null() == false ) return v_; }
+      return gd::variant_view(); }
    /// True if the named argument exists in m_argumentsQS
    bool QS_Exists(const std::string_view& stringName) const;
    /// Get all arguments parsed from the URL query string
    const gd::argument::arguments& QS_GetArguments() const { return m_argumentsQS; }
+   /// Name index for m_argumentsQS, built on first lookup so each request scans the query string once
+   const gd::argument::arguments_index<gd::argument::arguments>& QS_GetIndex() const {
+      if( m_indexQS.empty() == true && m_argumentsQS.empty() == false ) { m_indexQS.build( m_argumentsQS ); }
+      return m_indexQS; }
+   /// Drop name index, call this after m_argumentsQS is changed
+   void QS_ResetIndex() { m_indexQS.clear(); }
 
    gd::variant_view GetNextArgument( std::string_view stringName );
 
@@ -416,7 +465,7 @@ public:
 
    // @API [tag: format, template, statement] [description: Format logic to prepare information mixing values from endpoint to make it work in server]
 
-   std::pair<bool, std::string> PrepareStatement( std::variant<size_t,std::string_view> statement_id_, std::string& stringSelectAddTo );
+   std::pair<bool, std::string> PrepareStatement( std::variant<size_t,std::string_view> statement_id_, std::string& stringSelectAddTo, std::vector<gd::variant>* pvectorBind = nullptr );
    std::pair<bool, std::string> PrepareStatement(std::variant<size_t, std::string_view> statement_id_, std::function< std::pair<bool, std::string>( std::string_view stringSql )> callback_ );
 
    // @API [tag: query] [description: Query helpers]
@@ -442,6 +491,7 @@ public:
    std::vector<std::string_view>  m_vectorCommand;        ///< full command path segments parsed from URL
    unsigned                       m_uCommandIndex{};      ///< index into m_vectorCommand currently being dispatched
    gd::argument::arguments        m_argumentsQS;          ///< per-request URL parameters @NOTE [tag: url] [description: QS = query string; these are not shared across chained sections, but each section can read them as needed]
+   mutable gd::argument::arguments_index<gd::argument::arguments> m_indexQS; ///< name index for m_argumentsQS, see QS_GetIndex()
    std::string_view               m_stringBody;           ///< raw request body (XML/JSON forwarded from router)
 
    // Argument counter – small stack buffer avoids heap for typical use
@@ -457,7 +507,7 @@ private:
 
 // ## free functions ---------------------------------------------------------
 public:
-   static std::pair<bool, std::string> FromTemplate_s(CRENDERSql& sql_, std::string_view stringTemplate, std::string& stringSql );
+   static std::pair<bool, std::string> FromTemplate_s(CRENDERSql& sql_, std::string_view stringTemplate, std::string& stringSql, std::vector<gd::variant>* pvectorBind = nullptr );
 
 };
 
@@ -94,7 +94,7 @@ std::pair<bool, std::string> CDTOResponse::AddTransfer( Types::Objects* pobjects
 /** --------------------------------------------------------------------------
  * @brief Serializes the contents of the table to XML format, storing the result in a string and returning a status indicator and message.
  * @param stringXml A reference to a string where the resulting XML will be appended.
- * @param parguments_ A pointer to a gd::argument::arguments object, used for additional serialization context (may be unused in this function).
+ * @param parguments_ A pointer to a gd::argument::arguments object, used for additional serialization context, if "stream" is true then the first stream object is written as a placeholder (`m_stringStreamMarker_s`) and rows are read when response is sent. Offset for placeholder in `stringXml` is set in `m_uStreamOffset`.
  * @return A std::pair where the first element is a boolean indicating success (true) or failure (false), and the second element is a string containing an error message if serialization failed, or an empty string on success.
  */
 std::pair<bool, std::string> CDTOResponse::PrintXml( std::string& stringXml, const gd::argument::arguments* parguments_ )
@@ -108,6 +108,9 @@ std::pair<bool, std::string> CDTOResponse::PrintXml( std::string& stringXml, con
    xmlnodeDeclaration.append_attribute("encoding") = "UTF-8";
 
    pugi::xml_node xmlnodeResults = xmldocument.append_child( m_stringResults_s );
+   bool bStreamMarker = parguments_ != nullptr && (*parguments_)["stream"].is_true(); // stream rows later, only for first stream object
+   pugi::xml_node xmlnodeStream;                                              // result node with stream marker
+   m_uStreamOffset = std::string::npos;
 
    // ## iterate all objects in table and serialize them to xml
 
@@ -162,6 +165,22 @@ std::pair<bool, std::string> CDTOResponse::PrintXml( std::string& stringXml, con
             // #### add json as xml node as cdata
             xmlnodeResult.append_child(node_cdata).set_value(stringJson);
          }
+         else if( Types::TypeNumber_g("stream") == uType )
+         {
+            if( bStreamMarker == true )
+            {
+               xmlnodeResult.append_child(node_cdata).set_value(m_stringStreamMarker_s);
+               xmlnodeStream = xmlnodeResult;
+               bStreamMarker = false;
+            }
+            else
+            {
+               CDTOStream* pstream = (CDTOStream*)pobject;                   // read all rows, result can't be streamed
+               auto result_ = pstream->ReadAll( stringJson );
+               if( result_.first == false ) { return result_; }
+               xmlnodeResult.append_child(node_cdata).set_value(stringJson);
+            }
+         }
          else if( Types::TypeNumber_g("arguments") == uType )
          {
             gd::argument::arguments* parguments = (gd::argument::arguments*)pobject;  //  cast to arguments object
@@ -183,7 +202,28 @@ std::pair<bool, std::string> CDTOResponse::PrintXml( std::string& stringXml, con
    
    // ## serialize xml document to `stringXml`
    std::stringstream stringstream_;
-   xmldocument.save( stringstream_, "", pugi::format_raw, pugi::encoding_utf8);
+   if( xmlnodeStream.empty() == true ) { xmldocument.save( stringstream_, "", pugi::format_raw, pugi::encoding_utf8); }
+   else
+   {
+      // ## print result nodes one by one to get offset for stream marker, marker text may be found in results printed before it
+      xmlnodeDeclaration.print( stringstream_, "", pugi::format_raw, pugi::encoding_utf8 );
+      stringstream_ << '<' << m_stringResults_s << '>';
+      for( auto xmlnode : xmlnodeResults.children() )
+      {
+         if( xmlnode == xmlnodeStream )
+         {
+            std::stringstream stringstreamNode;
+            xmlnode.print( stringstreamNode, "", pugi::format_raw, pugi::encoding_utf8 );
+            std::string stringNode = stringstreamNode.str();
+            auto uMarker = stringNode.rfind( m_stringStreamMarker_s );            // marker is the only text in node, attributes are printed before it
+                                                                                                   assert( uMarker != std::string::npos );
+            m_uStreamOffset = stringXml.length() + (uint64_t)stringstream_.tellp() + uMarker;
+            stringstream_ << stringNode;
+         }
+         else { xmlnode.print( stringstream_, "", pugi::format_raw, pugi::encoding_utf8 ); }
+      }
+      stringstream_ << "</" << m_stringResults_s << '>';
+   }
    stringXml.append( std::istreambuf_iterator<char>( stringstream_.rdbuf() ), std::istreambuf_iterator<char>() ); // @OPTIMIZED [tag: string] [description: avoid unnecessary copy by appending directly to stringXml]
 
    return { true, "" };
@@ -191,6 +231,31 @@ std::pair<bool, std::string> CDTOResponse::PrintXml( std::string& stringXml, con
 
 
 
+/** -------------------------------------------------------------------------- ReleaseStream
+ * @brief Detach first stream object from response body
+ *
+ * Object is removed from response so it is not deleted when response is cleared,
+ * this is used to keep cursor open while response is sent to client.
+ *
+ * @return std::unique_ptr<CDTOStream> stream object or null if no stream in response
+ */
+std::unique_ptr<CDTOStream> CDTOResponse::ReleaseStream()
+{
+   for( uint64_t uRow = 0; uRow < m_tableBody.get_row_count(); uRow++ )
+   {
+      uint32_t uType = m_tableBody.cell_get_variant_view( uRow, "type" );
+      if( Types::TypeNumber_g("stream") != uType ) continue;
+
+      auto* pobject = ( void* )m_tableBody.cell_get_variant_view( uRow, "object" );
+      if( pobject == nullptr ) continue;
+
+      m_tableBody.cell_set( uRow, "object", (void*)nullptr );
+      return std::unique_ptr<CDTOStream>( (CDTOStream*)pobject );
+   }
+
+   return nullptr;
+}
+
 /// Clear response body (table with objects)
 void CDTOResponse::Clear()
 {
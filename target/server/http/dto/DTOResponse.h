@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <string_view>
@@ -13,6 +14,7 @@
 #include "gd/gd_table_arguments.h"
 
 #include "../Types.h"
+#include "DTOStream.h"
 
 /**
  * \file CDTOResponse.h
@@ -62,6 +64,8 @@ public:
 // ## methods ------------------------------------------------------------------
 public:
 // @API [tag: get, set]
+/// Offset in xml printed by `PrintXml` where stream marker is placed, npos if no stream marker was printed
+uint64_t GetStreamOffset() const noexcept { return m_uStreamOffset; }
 
 // @API [tag: operation]
 
@@ -73,6 +77,9 @@ std::pair<bool, std::string> AddTransfer( Types::Objects* pobjects_ );
 
 std::pair<bool, std::string> PrintXml(std::string& stringXml, const gd::argument::arguments* parguments_); // @CRITICAL [tag: response] [description: Print response as XML, this will be used as response body]
 
+/// Detach first stream object in response, caller takes ownership
+std::unique_ptr<CDTOStream> ReleaseStream();
+
 /// Check if response body is empty
 bool Empty() const noexcept { return m_tableBody.size() == 0; }
 
@@ -90,10 +97,12 @@ public:
    gd::argument::arguments m_argumentsContext;  ///< response arguments that holds context information for response
    gd::table::arguments::table m_tableBody;     ///< response headers
    std::mutex m_mutexDto;                       ///< mutex for dto object that need to be thread safe
+   uint64_t m_uStreamOffset = std::string::npos; ///< offset for stream marker in printed xml, marker text may also be found in other results so search is not safe
 
    inline static gd::table::detail::columns* m_pcolumnsBody_s = nullptr; ///< static columns for body
    inline static std::string m_stringResults_s = "results";  ///< default container name for results
    inline static std::string m_stringResult_s = "result";   ///< default item name for each result
+   inline static std::string m_stringStreamMarker_s = "@@stream@@"; ///< placeholder in CDATA where streamed rows are inserted when response is sent
 
 
 // @API [tag: free-functions]
@@ -0,0 +1,100 @@
+// @FILE [tag: dto, http, stream] [description: Data transfer object that streams cursor result in batches] [type: source] [name: CDTOStream.cpp]
+
+#include <cassert>
+
+#include "gd/gd_arguments.h"
+#include "gd/gd_table_io.h"
+#include "gd/database/gd_database_io.h"
+
+#include "DTOStream.h"
+
+/** ------------------------------------------------------------------------- Read
+ * @brief Read next batch of rows from cursor and append them as json to `stringChunk`
+ *
+ * First read generates the header and first batch, following reads only rows.
+ * When cursor is at end the json array is closed and stream state is set to end.
+ *
+ * Generated parts put together: `[["name1","name2"],\n[1,"a"],\n[2,"b"]\n]`
+ *
+ * @param stringChunk string that next part is appended to
+ * @return true if ok, false and error information on error
+ */
+std::pair<bool, std::string> CDTOStream::Read( std::string& stringChunk )
+{
+   using namespace gd::table;
+   if( m_uState == eStateEnd ) return { true, "" };
+                                                                                                   assert( m_pcursor != nullptr );
+
+   size_t uOffset = stringChunk.length();
+   gd::argument::arguments argumentsJson( { "format", "escape" } );           // same format as table results in response
+
+   m_tableBatch.row_clear( tag_reference{} );                                 // reuse table buffer, clear rows and text from last batch
+   auto result_ = gd::database::to_table( m_pcursor.get(), &m_tableBatch, m_uBatchSize );
+   if( result_.first == false ) { return result_; }
+
+   uint64_t uCount = m_tableBatch.get_row_count();
+   m_uRowCount += uCount;
+
+   if( m_uState == eStateHeader )
+   {
+      stringChunk += '[';
+      to_string( m_tableBatch, 0, uCount, argumentsJson, nullptr, stringChunk, tag_io_header{}, tag_io_json{} );
+      m_uState = eStateBody;
+   }
+   else if( uCount > 0 )
+   {
+      stringChunk += ",\n";
+      to_string( m_tableBatch, 0, uCount, argumentsJson, nullptr, stringChunk, tag_io_json{} );
+   }
+
+   if( m_pcursor->is_valid_row() == false )                                   // no more rows, close json array
+   {
+      stringChunk += ']';
+      m_uState = eStateEnd;
+      Close();                                                                // return connection as soon as all rows are read
+   }
+
+   if( m_bCData == true ) { EscapeCData( stringChunk, uOffset ); }
+
+   return { true, "" };
+}
+
+/** ------------------------------------------------------------------------- ReadAll
+ * @brief Read all remaining rows from cursor and append them to `stringResult`
+ * @param stringResult string that result is appended to
+ * @return true if ok, false and error information on error
+ */
+std::pair<bool, std::string> CDTOStream::ReadAll( std::string& stringResult )
+{
+   while( IsEnd() == false )
+   {
+      auto result_ = Read( stringResult );
+      if( result_.first == false ) { return result_; }
+   }
+
+   return { true, "" };
+}
+
+/** ------------------------------------------------------------------------- Close
+ * @brief Release cursor and return borrowed connection to pool
+ *
+ * Cursor is released before the borrow because the pool resets cached
+ * statements for the connection when it is returned.
+ */
+void CDTOStream::Close()
+{
+   m_pcursor.reset();
+   m_borrowDatabase.release();
+}
+
+/// Split `]]>` in text to be able to place it in xml CDATA section, only text after `uOffset` is checked
+void CDTOStream::EscapeCData( std::string& stringText, size_t uOffset )
+{
+   constexpr std::string_view stringEnd_ = "]]>";
+   constexpr std::string_view stringSplit_ = "]]]]><![CDATA[>";
+
+   for( size_t uPosition = stringText.find( stringEnd_, uOffset ); uPosition != std::string::npos; uPosition = stringText.find( stringEnd_, uPosition + stringSplit_.length() ) )
+   {
+      stringText.replace( uPosition, stringEnd_.length(), stringSplit_ );
+   }
+}
@@ -0,0 +1,108 @@
+// @FILE [tag: dto, http, stream] [description: Data transfer object that streams cursor result in batches] [type: header] [name: CDTOStream.h]
+
+#pragma once
+
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "gd/gd_com.h"
+#include "gd/gd_database.h"
+#include "gd/gd_table_column-buffer.h"
+
+#include "../DatabasePool.h"
+
+/**
+ * \file CDTOStream.h
+ *
+ * \brief Data transfer object for result that is sent to client in parts
+ *
+ *
+ */
+
+ /** @CLASS [name: CDTOStream] [description: Read rows from open cursor in batches and format them as json ]
+  *
+  * \brief Stream result from database cursor
+  *
+  * Holds an open cursor and a table used as buffer for one batch of rows. Each
+  * call to `Read` appends next part of json result, format is the same as table
+  * results (header array followed by row arrays) so client do not need to know
+  * if result was streamed or not.
+  *
+  * Only one batch is in memory, table buffer is reused for all batches.
+ *
+ * Cursor is read after the request context is done, so the stream owns the
+ * connection borrowed from the pool (`SetBorrow`). Connection is returned when
+ * last row is read or when stream is destroyed.
+  *
+  \code
+  CDTOStream stream_( pcursor );
+  std::string stringChunk;
+  while( stream_.IsEnd() == false )
+  {
+     stringChunk.clear();
+     auto result_ = stream_.Read( stringChunk );
+     if( result_.first == false ) { ... }
+     // send stringChunk
+  }
+  \endcode
+  */
+class CDTOStream
+{
+public:
+   enum enumState
+   {
+      eStateHeader   = 0,  ///< nothing is read, next read generates header and first batch
+      eStateBody     = 1,  ///< header is read, next read generates rows
+      eStateEnd      = 2,  ///< all rows read and array is closed
+   };
+
+   // @API [tag: construction]
+public:
+   CDTOStream( gd::database::cursor_i* pcursor ): m_pcursor( pcursor ), m_tableBatch( gd::table::tag_full_meta{} ) { assert( pcursor != nullptr ); }
+   CDTOStream( gd::database::cursor_i* pcursor, uint64_t uBatchSize ): m_pcursor( pcursor ), m_tableBatch( gd::table::tag_full_meta{} ), m_uBatchSize( uBatchSize ) { assert( pcursor != nullptr ); assert( uBatchSize > 0 ); }
+   // copy
+   CDTOStream( const CDTOStream& ) = delete;
+   CDTOStream& operator=( const CDTOStream& ) = delete;
+
+   ~CDTOStream() { Close(); }
+
+// ## methods ------------------------------------------------------------------
+public:
+// @API [tag: get, set]
+   bool IsEnd() const noexcept { return m_uState == eStateEnd; }
+   uint64_t GetRowCount() const noexcept { return m_uRowCount; }
+
+   /// Set if text should be prepared to be placed in xml CDATA section
+   void SetCData( bool bCData ) { m_bCData = bCData; }
+   /// Set connection cursor reads from, connection is kept until stream is closed
+   void SetBorrow( CDatabasePool::borrow&& borrowDatabase ) { m_borrowDatabase = std::move( borrowDatabase ); }
+
+// @API [tag: operation]
+
+   /// Read next batch from cursor and append it as json to `stringChunk`
+   std::pair<bool, std::string> Read( std::string& stringChunk );
+
+   /// Read all remaining rows, used when result can not be streamed
+   std::pair<bool, std::string> ReadAll( std::string& stringResult );
+
+   /// Release cursor and return borrowed connection to pool
+   void Close();
+
+protected:
+// @API [tag: internal]
+   void EscapeCData( std::string& stringText, size_t uOffset );
+
+// ## attributes ----------------------------------------------------------------
+public:
+   CDatabasePool::borrow m_borrowDatabase;               ///< connection cursor belongs to, declared before cursor so cursor is released first
+   gd::com::pointer<gd::database::cursor_i> m_pcursor;   ///< open cursor rows are read from
+   gd::table::dto::table m_tableBatch;                   ///< table used as buffer for each batch
+   uint64_t m_uBatchSize = m_uBatchSize_s;               ///< max number of rows in each batch
+   uint64_t m_uRowCount = 0;                             ///< total number of rows read
+   unsigned m_uState = eStateHeader;                     ///< stream state, value from enumState
+   bool m_bCData = false;                                ///< if text is placed in xml CDATA section, `]]>` need to be split
+
+   inline static uint64_t m_uBatchSize_s = 1000;         ///< default number of rows in each batch
+};
@@ -15,6 +15,7 @@
 #include "gd/gd_arguments.h"
 #include "gd/gd_vector.h"
 
+#include "../api/API_Base.h"
 #include "../Session.h"
 #include "../Document.h"
 #include "../Application.h"
@@ -778,6 +779,32 @@ TEST_CASE( "[arena::borrow] adapter 04 - STL allocator fallback logic", "[arena]
     }
 }
 
+TEST_CASE( "[arena] request arguments", "[arena]" )
+{
+   CServer::arena_scope arenascope_;
+   CAPIContext context_;
+   context_.SetArena( arenascope_.get() );
+
+   gd::argument::arguments arguments_( context_.CreateArguments( 128 ) );
+   arguments_.append( "table", "TUser" );
+   arguments_.append( "limit", 10 );
+   REQUIRE( arguments_.is_owner() == false );                                 // buffer is in arena
+
+   gd::argument::arguments argumentsCopy( context_.CreateArguments( arguments_ ) );
+   REQUIRE( argumentsCopy.is_owner() == false );
+   REQUIRE( argumentsCopy["table"].as_string() == "TUser" );
+   REQUIRE( argumentsCopy["limit"].as_int() == 10 );
+
+   for( int i = 0; i < 100; i++ ) { argumentsCopy.append( "value", i ); }   // grows out of arena buffer
+   REQUIRE( argumentsCopy.is_owner() == true );
+   REQUIRE( argumentsCopy["table"].as_string() == "TUser" );
+
+   {
+      CServer::arena_scope arenascopeInner_;                                  // nested scope do not clear arena
+   }
+   REQUIRE( arguments_["table"].as_string() == "TUser" );
+}
+
 #ifdef _WIN32
 
 #define _CRTDBG_MAP_ALLOC
@@ -884,4 +911,4 @@ TEST_CASE( "[arena::borrow] stress 08 - heavy allocations with leak check", "[ar
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,18 +1,23 @@
 // @FILE [tag: strstr, playground] [description: Key value and finding things in string] [type: playground]
 
+#include <chrono>
 #include <filesystem>
+#include <thread>
 #include "catch2/catch_amalgamated.hpp"
 
 #include "gd/gd_arguments.h"
 #include "gd/gd_arguments_shared.h"
 #include "gd/gd_table_io.h"
+#include "gd/gd_database_sqlite.h"
 
 #include "../render/RENDERSql.h"
 
 #include "../Session.h"
 #include "../Router.h"
+#include "../DatabasePool.h"
 #include "../Document.h"
 #include "../Application.h"
+#include "../dto/DTOResponse.h"
 
 #ifdef _WIN32
 #define _CRTDBG_MAP_ALLOC
@@ -154,4 +159,138 @@ TEST_CASE("[session] test uri logic", "[session]")
        _CrtMemDumpAllObjectsSince(&memStateStart);
    }
    #endif
-}
\ No newline at end of file
+}
+
+TEST_CASE( "[response] stream marker offset and batch size", "[response]" )
+{
+   std::string stringDatabaseFile = ( std::filesystem::temp_directory_path() / "play-stream-marker.sqlite" ).string();
+   std::filesystem::remove( stringDatabaseFile );
+
+   auto* pdatabase = new gd::database::sqlite::database_i( "sqlite" );
+   auto result_ = pdatabase->m_pdatabase->open( stringDatabaseFile, {"create", "write"} );       REQUIRE( result_.first == true );
+   result_ = pdatabase->execute( "CREATE TABLE TRow (RowK INTEGER PRIMARY KEY, FName TEXT);" );    REQUIRE( result_.first == true );
+   result_ = pdatabase->execute( "INSERT INTO TRow (FName) VALUES ('one'),('two'),('three'),('four'),('five');" ); REQUIRE( result_.first == true );
+
+   {
+      gd::com::pointer<gd::database::cursor_i> pcursor;
+      pdatabase->get_cursor( &pcursor );
+      result_ = pcursor->open( "SELECT RowK, FName FROM TRow ORDER BY RowK" );                    REQUIRE( result_.first == true );
+
+      // ## marker text in results before and after stream
+      CDTOResponse response_;
+      response_.Initialize();
+      Types::Objects objects_;
+      objects_.Add( std::string_view( "before " + CDTOResponse::m_stringStreamMarker_s ) );
+      objects_.Add( new CDTOStream( pcursor.get(), 1 ) );                                        // `stream=1`, one row in each batch
+      objects_["echo"] = CDTOResponse::m_stringStreamMarker_s;
+      objects_.Add( std::string_view( CDTOResponse::m_stringStreamMarker_s + " after" ) );
+      result_ = response_.AddTransfer( &objects_ );                                               REQUIRE( result_.first == true );
+
+      std::string stringXml = "<!-- -->";                                                         // xml is appended, offset is from start of string
+      gd::argument::arguments argumentsPrint( { "stream", true } );
+      result_ = response_.PrintXml( stringXml, &argumentsPrint );                                 REQUIRE( result_.first == true );
+      const std::string& stringMarker = CDTOResponse::m_stringStreamMarker_s;
+      auto uOffset = response_.GetStreamOffset();                                                 REQUIRE( uOffset != std::string::npos );
+      REQUIRE( stringXml.find( stringMarker ) < uOffset );
+      REQUIRE( stringXml.compare( uOffset, stringMarker.length(), stringMarker ) == 0 );
+      REQUIRE( stringXml.substr( 0, uOffset ).ends_with( "<![CDATA[" ) == true );
+      REQUIRE( stringXml.substr( uOffset + stringMarker.length() ).starts_with( "]]></result>" ) == true );
+
+      pugi::xml_document xmldocument;
+      REQUIRE( xmldocument.load_string( stringXml.c_str() + 8 ) );
+      REQUIRE( std::distance( xmldocument.child( "results" ).begin(), xmldocument.child( "results" ).end() ) == 3 );
+
+      // ## batch size 1 reads one row for each chunk
+      auto pstream = response_.ReleaseStream();                                                   REQUIRE( pstream != nullptr );
+      std::string stringChunk;
+      unsigned uReadCount = 0;
+      while( pstream->IsEnd() == false )
+      {
+         result_ = pstream->Read( stringChunk );                                                  REQUIRE( result_.first == true );
+         uReadCount++;
+      }
+      REQUIRE( pstream->GetRowCount() == 5 );
+      REQUIRE( uReadCount == 5 );
+
+      // ## without stream argument rows are printed and there is no marker
+      CDTOResponse responseText;
+      responseText.Initialize();
+      objects_.Clear();
+      objects_.Add( std::string_view( stringMarker ) );
+      responseText.AddTransfer( &objects_ );
+      stringXml.clear();
+      result_ = responseText.PrintXml( stringXml, &argumentsPrint );                              REQUIRE( result_.first == true );
+      REQUIRE( responseText.GetStreamOffset() == std::string::npos );
+   }
+
+   pdatabase->release();
+   std::filesystem::remove( stringDatabaseFile );
+}
+
+TEST_CASE( "[pool] acquire waits with timeout and stream returns connection", "[pool]" )
+{
+   using namespace std::chrono_literals;
+   std::string stringDatabaseFile = ( std::filesystem::temp_directory_path() / "play-pool-acquire.sqlite" ).string();
+   for( auto stringEnd : { "", "-wal", "-shm" } ) { std::filesystem::remove( stringDatabaseFile + stringEnd ); }
+
+   {
+      auto* pdatabase = new gd::database::sqlite::database_i( "sqlite" );
+      auto result_ = pdatabase->m_pdatabase->open( stringDatabaseFile, {"create", "write"} );    REQUIRE( result_.first == true );
+      result_ = pdatabase->execute( "CREATE TABLE TRow (RowK INTEGER PRIMARY KEY, FName TEXT);" ); REQUIRE( result_.first == true );
+      result_ = pdatabase->execute( "INSERT INTO TRow (FName) VALUES ('one'),('two'),('three');" ); REQUIRE( result_.first == true );
+      pdatabase->release();
+   }
+
+   {
+      CDatabasePool pool_;
+      auto result_ = pool_.Open( { { "file", stringDatabaseFile }, { "read-count", 1u } } );     REQUIRE( result_.first == true );
+      REQUIRE( pool_.Size() == 2 );
+
+      // ## exhausted pool returns empty borrow when timeout expires
+      auto borrowRead = pool_.Acquire( CDatabasePool::eConnectionRead );                         REQUIRE( borrowRead.empty() == false );
+      auto timeStart = std::chrono::steady_clock::now();
+      auto borrowBusy = pool_.Acquire( CDatabasePool::eConnectionRead, 50ms );
+      REQUIRE( borrowBusy.empty() == true );
+      REQUIRE( std::chrono::steady_clock::now() - timeStart >= 50ms );
+
+      auto uAcquireTimeout = CDatabasePool::m_uAcquireTimeout_s;
+      CDatabasePool::m_uAcquireTimeout_s = 10;                                   // default timeout is used without timeout argument
+      REQUIRE( pool_.Acquire( CDatabasePool::eConnectionRead ).empty() == true );
+      CDatabasePool::m_uAcquireTimeout_s = uAcquireTimeout;
+
+      {
+         auto borrowWrite = pool_.Acquire( CDatabasePool::eConnectionWrite, 0ms );             // writer is not used by readers
+         REQUIRE( borrowWrite.empty() == false );
+         REQUIRE( borrowWrite.is_read() == false );
+      }
+
+      // ## waiting caller gets connection when it is returned
+      std::thread threadRelease( [&borrowRead]() { std::this_thread::sleep_for( 50ms ); borrowRead.release(); } );
+      auto borrowWait = pool_.Acquire( CDatabasePool::eConnectionRead, 5000ms );
+      threadRelease.join();
+      REQUIRE( borrowWait.empty() == false );
+      REQUIRE( borrowWait.is_read() == true );
+      borrowWait.release();
+
+      // ## stream owns connection until it is destroyed
+      {
+         auto borrowStream = pool_.Acquire( CDatabasePool::eConnectionRead, 0ms );             REQUIRE( borrowStream.empty() == false );
+         gd::com::pointer<gd::database::cursor_i> pcursor;
+         result_ = borrowStream.prepare( "SELECT RowK, FName FROM TRow ORDER BY RowK", &pcursor ); REQUIRE( result_.first == true );
+         result_ = pcursor->open();                                                             REQUIRE( result_.first == true );
+
+         auto pstream = std::make_unique<CDTOStream>( pcursor.get(), 1 );
+         pcursor.reset();
+         pstream->SetBorrow( std::move( borrowStream ) );
+         REQUIRE( pool_.Acquire( CDatabasePool::eConnectionRead, 10ms ).empty() == true );
+
+         std::string stringChunk;
+         result_ = pstream->Read( stringChunk );                                                 REQUIRE( result_.first == true );
+         REQUIRE( pstream->IsEnd() == false );
+         pstream.reset();                                                                        // client closed before all rows were read
+         REQUIRE( pool_.Acquire( CDatabasePool::eConnectionRead, 0ms ).empty() == false );
+      }
+   }
+
+   for( auto stringEnd : { "", "-wal", "-shm" } ) { std::filesystem::remove( stringDatabaseFile + stringEnd ); }
+}
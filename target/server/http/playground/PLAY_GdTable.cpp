@@ -9,6 +9,7 @@
 #include "gd/gd_table_simd.h"
 #include "gd/gd_table_arguments.h"
 #include "gd/gd_table_io.h"
+#include "gd/gd_table_aggregate.h"
 #include "gd/gd_sql_value.h"
 #include "gd/gd_parse.h"
 #include "gd/gd_uuid.h"
@@ -64,6 +65,80 @@ TEST_CASE("[gd-table] test to check gd::table::simd::table", "[gd-table]")
    }
 }
 
+TEST_CASE("[gd-table] sort on multiple keys", "[gd-table]")
+{
+   using namespace gd::table;
+   dto::table tableSort( dto::table::eTableFlagNull32, { { "int32", 0, "group"}, { "string", 20, "name"}, { "double", 0, "value"} }, tag_prepare{} );
+   for( int i = 0; i < 1000; i++ )
+   {
+      tableSort.row_add( { i % 7, std::to_string( (i * 31) % 100 ), double( (i * 13) % 17 ) }, tag_convert{} );
+      if( i % 50 == 0 ) tableSort.cell_set_null( (uint64_t)i, 0u );
+   }
+
+   SECTION("index, rows are not moved")
+   {
+      auto vectorIndex = tableSort.sort( { sort_key( 2u ) }, tag_sort_index{} );
+      REQUIRE( vectorIndex.size() == tableSort.get_row_count() );
+      for( size_t u = 1; u < vectorIndex.size(); u++ )
+      {
+         REQUIRE( tableSort.cell_get_variant_view( vectorIndex[u - 1], 2u ).as_double() <= tableSort.cell_get_variant_view( vectorIndex[u], 2u ).as_double() );
+      }
+      REQUIRE( tableSort.cell_get_variant_view( 1u, 0u ).as_int() == 1 );
+   }
+
+   SECTION("group descending, nulls last, then name ascending")
+   {
+      tableSort.sort( { sort_key( 0u, false, false ), sort_key( 1u ) } );
+      for( uint64_t uRow = 1; uRow < tableSort.get_row_count(); uRow++ )
+      {
+         bool bNullPrevious = tableSort.cell_is_null( uRow - 1, 0u );
+         bool bNull = tableSort.cell_is_null( uRow, 0u );
+         REQUIRE( (bNullPrevious == false || bNull == true) );
+         if( bNullPrevious == true || bNull == true ) continue;
+
+         int iPrevious = tableSort.cell_get_variant_view( uRow - 1, 0u ).as_int();
+         int iGroup = tableSort.cell_get_variant_view( uRow, 0u ).as_int();
+         REQUIRE( iPrevious >= iGroup );
+         if( iPrevious == iGroup ) { REQUIRE( tableSort.cell_get_variant_view( uRow - 1, 1u ).as_string() <= tableSort.cell_get_variant_view( uRow, 1u ).as_string() ); }
+      }
+   }
+}
+
+TEST_CASE("[gd-table] aggregate fixed columns", "[gd-table]")
+{
+   using namespace gd::table;
+   dto::table tableValue( dto::table::eTableFlagNull32, { { "int32", 0, "signed"}, { "double", 0, "decimal"} }, tag_prepare{} );
+   int64_t iSum = 0;
+   double dSum = 0.0;
+   for( int i = 0; i < 1000; i++ )
+   {
+      tableValue.row_add( { i - 500, i * 0.25 }, tag_convert{} );
+      if( i % 3 == 0 ) { tableValue.cell_set_null( (uint64_t)i, 0u ); continue; }
+      iSum += i - 500;
+      dSum += i * 0.25;
+   }
+
+   aggregate<dto::table> aggregate_( &tableValue );
+   REQUIRE( aggregate_.sum<int64_t>( 0u ) == iSum );
+   REQUIRE( aggregate_.min<int32_t>( 0u ) == -499 );
+   REQUIRE( aggregate_.max<int32_t>( 0u ) == 498 );
+   REQUIRE( std::abs( aggregate_.sum<double>( 1u ) - 999 * 1000 / 2 * 0.25 ) < 1e-9 );
+   REQUIRE( std::abs( aggregate_.average<double>( 1u ) - ( 999 * 1000 / 2 * 0.25 ) / 1000.0 ) < 1e-9 );
+   REQUIRE( aggregate_.variance<double>( 1u ) > 0.0 );
+
+   // ## parallel and summary results match serial results
+   REQUIRE( aggregate_.sum<int64_t>( 0u, 0, 1000, tag_parallel{}, 4 ) == iSum );
+   REQUIRE( std::abs( aggregate_.variance<double>( 1u, 0, 1000, tag_parallel{}, 4 ) - aggregate_.variance<double>( 1u ) ) < 1e-9 );
+   REQUIRE( aggregate_.median<int32_t>( 0u, 0, 1000, tag_parallel{}, 4 ) == aggregate_.median<int32_t>( 0u ) );
+
+   std::vector<aggregate_summary> vectorSummary;
+   aggregate_.summary( { 0u, 1u }, vectorSummary, tag_parallel{} );
+   REQUIRE( vectorSummary[0].sum<int64_t>() == iSum );
+   REQUIRE( vectorSummary[0].min() == -499.0 );
+   REQUIRE( std::abs( vectorSummary[1].sum<double>() - aggregate_.sum<double>( 1u ) ) < 1e-9 );
+   REQUIRE( vectorSummary[1].count() == 1000 );
+}
+
 /*
 
 TEST_CASE("[gd-table] create", "[gd-table]")
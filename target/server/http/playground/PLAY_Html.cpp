@@ -2,12 +2,15 @@
 
 #include <array>
 #include <filesystem>
+#include <fstream>
 
 #include "gd/gd_variant.h"
 #include "gd/gd_arguments_shared.h"
 #include "gd/gd_file.h"
 #include "gd_tools/html/gd_tools_html_document.h"
 
+#include "../render/RENDERHtml.h"
+
 #include "main.h"
 
 #include "catch2/catch_amalgamated.hpp"
@@ -193,3 +196,145 @@ TEST_CASE( "[html] load", "[html]" ) {
    }
 
 }
+
+TEST_CASE( "[html] compile ssr page", "[html]" ) {
+   auto compile_ = []( std::string_view stringText ) {
+      CRENDERHtml::page page_;
+      page_.m_stringText = stringText;
+      CRENDERHtml::Compile_s( page_ );
+      return page_;
+   };
+
+   // ## text only
+   {
+      auto page_ = compile_( "<html><body>text</body></html>" );
+      REQUIRE( page_.m_vectorSegment.size() == 1 );
+      REQUIRE( page_.m_vectorSegment[0].m_eType == CRENDERHtml::eSegmentText );
+      REQUIRE( page_.text( page_.m_vectorSegment[0] ) == "<html><body>text</body></html>" );
+      REQUIRE( page_.m_uTextSize == page_.m_stringText.length() );
+      REQUIRE( compile_( "" ).m_vectorSegment.empty() == true );
+   }
+
+   // ## each type of code block
+   {
+      auto page_ = compile_( "a[[lua print(1) ]]b[[gd value]]c[[= 1 + 2]]d" );
+      REQUIRE( page_.m_vectorSegment.size() == 7 );
+      REQUIRE( page_.m_vectorSegment[1].m_eType == CRENDERHtml::eSegmentLua );
+      REQUIRE( page_.text( page_.m_vectorSegment[1] ) == " print(1) " );
+      REQUIRE( page_.m_vectorSegment[3].m_eType == CRENDERHtml::eSegmentGD );
+      REQUIRE( page_.text( page_.m_vectorSegment[3] ) == " value" );
+      REQUIRE( page_.m_vectorSegment[5].m_eType == CRENDERHtml::eSegmentExpression );
+      REQUIRE( page_.text( page_.m_vectorSegment[5] ) == " 1 + 2" );
+      for( unsigned u = 0; u < 7; u += 2 ) { REQUIRE( page_.m_vectorSegment[u].m_eType == CRENDERHtml::eSegmentText ); }
+      REQUIRE( page_.text( page_.m_vectorSegment[6] ) == "d" );
+      REQUIRE( page_.m_uTextSize == 4 );
+      REQUIRE( page_.m_bLua == true );
+      REQUIRE( page_.m_bWrite == false );
+   }
+
+   // ## database connection is only needed for lua code, writer only when lua code calls Execute
+   {
+      auto page_ = compile_( "a[[gd db:Execute()]]b[[= 1 + 2]]c" );
+      REQUIRE( page_.m_bLua == false );
+      REQUIRE( page_.m_bWrite == false );
+      page_ = compile_( "a[[lua local t = db:Ask(\"SELECT 1\") ]]b" );
+      REQUIRE( page_.m_bLua == true );
+      REQUIRE( page_.m_bWrite == false );
+      page_ = compile_( "a[[lua db:Ask(\"SELECT 1\") ]]b[[lua db:Execute(\"DELETE FROM TLog\") ]]c" );
+      REQUIRE( page_.m_bLua == true );
+      REQUIRE( page_.m_bWrite == true );
+      page_ = compile_( "[[lua db:Execute(\"DELETE FROM TLog\") ]]" );
+      page_.m_stringText = "text";
+      CRENDERHtml::Compile_s( page_ );                                         // flags are reset when page is compiled again
+      REQUIRE( page_.m_bLua == false );
+      REQUIRE( page_.m_bWrite == false );
+   }
+
+   // ## code at start and end of page
+   {
+      auto page_ = compile_( "[[= 1]]" );
+      REQUIRE( page_.m_vectorSegment.size() == 1 );
+      REQUIRE( page_.m_vectorSegment[0].m_eType == CRENDERHtml::eSegmentExpression );
+      REQUIRE( page_.m_uTextSize == 0 );
+   }
+
+   // ## empty blocks are removed
+   {
+      auto page_ = compile_( "a[[lua]]b[[gd]]c[[=]]" );
+      REQUIRE( page_.m_vectorSegment.size() == 3 );
+      for( const auto& segment_ : page_.m_vectorSegment ) { REQUIRE( segment_.m_eType == CRENDERHtml::eSegmentText ); }
+      REQUIRE( page_.m_uTextSize == 3 );
+   }
+
+   // ## block without end marker removes rest of page
+   {
+      auto page_ = compile_( "a[[lua print(1)" );
+      REQUIRE( page_.m_vectorSegment.size() == 1 );
+      REQUIRE( page_.text( page_.m_vectorSegment[0] ) == "a" );
+      REQUIRE( compile_( "[[gd" ).m_vectorSegment.empty() == true );
+   }
+
+   // ## `[[` without marker is text
+   {
+      auto page_ = compile_( "array[[0]] and [[x]] [[" );
+      REQUIRE( page_.m_vectorSegment.size() == 1 );
+      REQUIRE( page_.text( page_.m_vectorSegment[0] ) == "array[[0]] and [[x]] [[" );
+
+      page_ = compile_( "[[[[= 1]]" );
+      REQUIRE( page_.m_vectorSegment.size() == 2 );
+      REQUIRE( page_.text( page_.m_vectorSegment[0] ) == "[[" );
+      REQUIRE( page_.m_vectorSegment[1].m_eType == CRENDERHtml::eSegmentExpression );
+   }
+}
+
+TEST_CASE( "[html] ssr page cache", "[html]" ) {
+   std::filesystem::path pathFolder = std::filesystem::temp_directory_path() / "play-ssr-page";
+   std::filesystem::remove_all( pathFolder );
+   std::filesystem::create_directories( pathFolder );
+   auto write_ = [&pathFolder]( const std::string& stringName, const std::string& stringText ) {
+      std::ofstream ofstream_( pathFolder / stringName, std::ios::binary );
+      ofstream_ << stringText;
+      return ( pathFolder / stringName ).string();
+   };
+
+   CRENDERHtml::ClearCache_s();
+   auto uCacheMaxSize = CRENDERHtml::m_uCacheMaxSize_s;
+   auto uPageMaxSize = CRENDERHtml::m_uPageMaxSize_s;
+   CRENDERHtml::m_uCacheMaxSize_s = 250;
+   CRENDERHtml::m_uPageMaxSize_s = 200;
+
+   std::shared_ptr<const CRENDERHtml::page> ppage;
+   auto stringFile1 = write_( "1.html", std::string( 100, 'a' ) );
+   auto stringFile2 = write_( "2.html", std::string( 100, 'b' ) );
+   auto stringFile3 = write_( "3.html", std::string( 100, 'c' ) );
+   auto stringLarge = write_( "large.html", std::string( 300, 'd' ) );
+
+   auto result_ = CRENDERHtml::GetPage_s( stringFile1, ppage );                                    REQUIRE( result_.first == true );
+   auto ppage1 = ppage;
+   result_ = CRENDERHtml::GetPage_s( stringFile2, ppage );                                         REQUIRE( result_.first == true );
+   REQUIRE( CRENDERHtml::GetCacheSize_s() == 200 );
+   result_ = CRENDERHtml::GetPage_s( stringFile1, ppage );                                         REQUIRE( ppage == ppage1 ); // page 1 is used, page 2 is oldest
+   result_ = CRENDERHtml::GetPage_s( stringFile3, ppage );                                         REQUIRE( result_.first == true );
+   REQUIRE( CRENDERHtml::GetCacheSize_s() == 200 );                                                // one page is removed
+   result_ = CRENDERHtml::GetPage_s( stringFile1, ppage );                                         REQUIRE( ppage == ppage1 );
+
+   // ## large page is compiled but not kept
+   result_ = CRENDERHtml::GetPage_s( stringLarge, ppage );                                         REQUIRE( result_.first == true );
+   REQUIRE( ppage->m_stringText.size() == 300 );
+   REQUIRE( CRENDERHtml::GetCacheSize_s() == 200 );
+
+   // ## changed file is compiled again
+   write_( "1.html", std::string( 50, 'e' ) + "[[= 1]]" );
+   result_ = CRENDERHtml::GetPage_s( stringFile1, ppage );                                         REQUIRE( result_.first == true );
+   REQUIRE( ppage != ppage1 );
+   REQUIRE( ppage->m_vectorSegment.size() == 2 );
+   REQUIRE( CRENDERHtml::GetCacheSize_s() == 157 );
+
+   result_ = CRENDERHtml::GetPage_s( ( pathFolder / "missing.html" ).string(), ppage );            REQUIRE( result_.first == false );
+
+   CRENDERHtml::ClearCache_s();
+   REQUIRE( CRENDERHtml::GetCacheSize_s() == 0 );
+   CRENDERHtml::m_uCacheMaxSize_s = uCacheMaxSize;
+   CRENDERHtml::m_uPageMaxSize_s = uPageMaxSize;
+   std::filesystem::remove_all( pathFolder );
+}
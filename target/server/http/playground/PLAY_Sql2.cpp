@@ -59,4 +59,22 @@ TEST_CASE( "[sql] select", "[sql]" )
 
    stringSQL2 = query02.sql_get( eSqlInsert );
    std::cout << stringSQL2 << "\n";
-}
\ No newline at end of file
+}
+TEST_CASE( "[sql] format with bind values", "[sql]" )
+{
+   using namespace gd::sql;
+   query query_( eSqlDialectSqlite );
+   gd::argument::arguments argumentsValue( { {"id", int64_t(2)}, {"name", std::string("O'Reilly")}, {"key", std::string("AB")}, {"count", int64_t(10)} } );
+
+   std::string stringSql;
+   std::vector<gd::variant> vectorBind;
+   auto result_ = query_.sql_format( "SELECT * FROM T WHERE a >= {id} AND b = {name} AND k = X{key} LIMIT {count}", stringSql, &argumentsValue, &vectorBind );
+   REQUIRE( result_.first == true );
+   REQUIRE( stringSql == "SELECT * FROM T WHERE a >= ? AND b = ? AND k = X'AB' LIMIT ?" ); // `X{key}` is part of token and placed in text
+   REQUIRE( vectorBind.size() == 3 );
+   REQUIRE( vectorBind[1].as_string() == "O'Reilly" );
+
+   std::string stringText;
+   query_.sql_format( "SELECT * FROM T WHERE a >= {id} AND b = {name}", stringText, &argumentsValue );
+   REQUIRE( stringText == "SELECT * FROM T WHERE a >= 2 AND b = 'O''Reilly'" );
+}
@@ -0,0 +1,158 @@
+// @FILE [tag: cache, file, playground] [description: Cache for small static files, encoding and conditional requests] [type: playground]
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "../StaticCache.h"
+
+#include "main.h"
+
+#include "catch2/catch_amalgamated.hpp"
+
+namespace {
+   /// Write text to file in folder and return path to file
+   std::string write_( const std::filesystem::path& pathFolder, const std::string& stringName, const std::string& stringText )
+   {
+      std::ofstream ofstream_( pathFolder / stringName, std::ios::binary );
+      ofstream_ << stringText;
+      return ( pathFolder / stringName ).string();
+   }
+}
+
+TEST_CASE( "[static] find and read again when changed", "[static]" ) {
+   std::filesystem::path pathFolder = std::filesystem::temp_directory_path() / "play-static-cache";
+   std::filesystem::remove_all( pathFolder );
+   std::filesystem::create_directories( pathFolder );
+
+   CStaticCache staticcache_( 200, 250 );
+   std::shared_ptr<const CStaticCache::entry> pentry, pentry1;
+   auto stringFile = write_( pathFolder, "1.js", std::string( 100, 'a' ) );
+
+   REQUIRE( staticcache_.Find( stringFile, pentry1 ) == true );
+   REQUIRE( pentry1->m_stringBody.size() == 100 );
+   REQUIRE( pentry1->m_stringGzip.empty() == true );
+   REQUIRE( staticcache_.Size() == 100 );
+   REQUIRE( staticcache_.Find( stringFile, pentry ) == true );                                     REQUIRE( pentry == pentry1 );
+
+   // ## same size and same second, nanoseconds in last write time is enough to find change
+   auto time_ = std::filesystem::last_write_time( stringFile );
+   std::filesystem::last_write_time( stringFile, time_ + std::chrono::milliseconds( 1 ) );
+   REQUIRE( staticcache_.Find( stringFile, pentry ) == true );                                     REQUIRE( pentry != pentry1 );
+   REQUIRE( pentry->m_stringETag != pentry1->m_stringETag );
+   REQUIRE( staticcache_.Size() == 100 );
+
+   // ## siblings added or changed after file is cached
+   pentry1 = pentry;
+   write_( pathFolder, "1.js.gz", std::string( 10, 'g' ) );
+   REQUIRE( staticcache_.Find( stringFile, pentry ) == true );                                     REQUIRE( pentry != pentry1 );
+   REQUIRE( pentry->m_stringGzip.size() == 10 );
+   REQUIRE( pentry->m_stringETag != pentry1->m_stringETag );
+   REQUIRE( staticcache_.Size() == 110 );
+
+   pentry1 = pentry;
+   write_( pathFolder, "1.js.gz", std::string( 20, 'g' ) );
+   write_( pathFolder, "1.js.br", std::string( 5, 'b' ) );
+   REQUIRE( staticcache_.Find( stringFile, pentry ) == true );                                     REQUIRE( pentry != pentry1 );
+   REQUIRE( pentry->m_stringGzip.size() == 20 );
+   REQUIRE( pentry->m_stringBrotli.size() == 5 );
+   REQUIRE( staticcache_.Size() == 125 );
+
+   pentry1 = pentry;
+   std::filesystem::remove( pathFolder / "1.js.br" );
+   REQUIRE( staticcache_.Find( stringFile, pentry ) == true );                                     REQUIRE( pentry != pentry1 );
+   REQUIRE( pentry->m_stringBrotli.empty() == true );
+   REQUIRE( pentry1->m_stringBrotli.size() == 5 );                                                 // old entry is kept alive while it is used
+
+   // ## missing and too large files are not cached
+   REQUIRE( staticcache_.Find( ( pathFolder / "missing.js" ).string(), pentry ) == false );
+   auto stringLarge = write_( pathFolder, "large.js", std::string( 201, 'l' ) );
+   REQUIRE( staticcache_.Find( stringLarge, pentry ) == false );
+
+   std::filesystem::remove_all( pathFolder );
+}
+
+TEST_CASE( "[static] least recently used files are removed when cache is full", "[static]" ) {
+   std::filesystem::path pathFolder = std::filesystem::temp_directory_path() / "play-static-cache-full";
+   std::filesystem::remove_all( pathFolder );
+   std::filesystem::create_directories( pathFolder );
+
+   CStaticCache staticcache_( 200, 250 );
+   std::shared_ptr<const CStaticCache::entry> pentry, pentry1;
+   auto stringFile1 = write_( pathFolder, "1.css", std::string( 100, 'a' ) );
+   auto stringFile2 = write_( pathFolder, "2.css", std::string( 100, 'b' ) );
+   auto stringFile3 = write_( pathFolder, "3.css", std::string( 100, 'c' ) );
+
+   REQUIRE( staticcache_.Find( stringFile1, pentry1 ) == true );
+   REQUIRE( staticcache_.Find( stringFile2, pentry ) == true );
+   REQUIRE( staticcache_.Size() == 200 );
+   REQUIRE( staticcache_.Find( stringFile1, pentry ) == true );                                    REQUIRE( pentry == pentry1 ); // 2.css is oldest
+   REQUIRE( staticcache_.Find( stringFile3, pentry ) == true );
+   REQUIRE( staticcache_.Size() == 200 );
+   REQUIRE( staticcache_.m_mapEntry.contains( stringFile2 ) == false );
+   REQUIRE( staticcache_.Find( stringFile1, pentry ) == true );                                    REQUIRE( pentry == pentry1 );
+
+   // ## file larger than cache is served without being cached
+   CStaticCache staticcacheSmall( 200, 50 );
+   REQUIRE( staticcacheSmall.Find( stringFile1, pentry ) == true );
+   REQUIRE( pentry->m_stringBody.size() == 100 );
+   REQUIRE( staticcacheSmall.Size() == 0 );
+   REQUIRE( staticcacheSmall.m_mapEntry.empty() == true );
+
+   staticcache_.Clear();
+   REQUIRE( staticcache_.Size() == 0 );
+   std::filesystem::remove_all( pathFolder );
+}
+
+TEST_CASE( "[static] select encoding", "[static]" ) {
+   CStaticCache::entry entry_;
+   entry_.m_stringBody = "body";
+   entry_.m_stringGzip = "gzip";
+   entry_.m_stringBrotli = "br";
+
+   REQUIRE( CStaticCache::SelectEncoding_s( "", entry_ ) == CStaticCache::eEncodingIdentity );
+   REQUIRE( CStaticCache::SelectEncoding_s( "gzip, deflate, br", entry_ ) == CStaticCache::eEncodingBrotli );
+   REQUIRE( CStaticCache::SelectEncoding_s( "gzip", entry_ ) == CStaticCache::eEncodingGzip );
+   REQUIRE( CStaticCache::SelectEncoding_s( "deflate", entry_ ) == CStaticCache::eEncodingIdentity );
+   REQUIRE( CStaticCache::SelectEncoding_s( "br;q=0, gzip", entry_ ) == CStaticCache::eEncodingGzip );
+   REQUIRE( CStaticCache::SelectEncoding_s( "br;q=0.000, gzip;q=0.5", entry_ ) == CStaticCache::eEncodingGzip );
+   REQUIRE( CStaticCache::SelectEncoding_s( "br;q=0.1", entry_ ) == CStaticCache::eEncodingBrotli );
+   REQUIRE( CStaticCache::SelectEncoding_s( "br ; q=1, gzip", entry_ ) == CStaticCache::eEncodingBrotli );
+   REQUIRE( CStaticCache::SelectEncoding_s( "gzip;q=0", entry_ ) == CStaticCache::eEncodingIdentity );
+   REQUIRE( CStaticCache::SelectEncoding_s( "brotli, xgzip", entry_ ) == CStaticCache::eEncodingIdentity );
+
+   entry_.m_stringBrotli.clear();                                                                  // not available for file
+   REQUIRE( CStaticCache::SelectEncoding_s( "br, gzip", entry_ ) == CStaticCache::eEncodingGzip );
+}
+
+TEST_CASE( "[static] conditional request", "[static]" ) {
+   int64_t iTime = 0;
+   REQUIRE( CStaticCache::ParseHttpDate_s( "Sun, 06 Nov 1994 08:49:37 GMT", iTime ) == true );
+   REQUIRE( iTime == 784111777 );
+   REQUIRE( CStaticCache::HttpDate_s( iTime ) == "Sun, 06 Nov 1994 08:49:37 GMT" );
+   REQUIRE( CStaticCache::ParseHttpDate_s( "Sunday, 06-Nov-94 08:49:37 GMT", iTime ) == false );
+   REQUIRE( CStaticCache::ParseHttpDate_s( "Sun, 06 Nox 1994 08:49:37 GMT", iTime ) == false );
+   REQUIRE( CStaticCache::ParseHttpDate_s( "yesterday", iTime ) == false );
+
+   CStaticCache::entry entry_;
+   entry_.m_stringETag = "W/\"64-1a2b\"";
+   entry_.m_iLastModified = 784111777;
+   entry_.m_stringLastModified = CStaticCache::HttpDate_s( entry_.m_iLastModified );
+
+   // ## If-None-Match
+   REQUIRE( CStaticCache::IsNotModified_s( "W/\"64-1a2b\"", "", entry_ ) == true );
+   REQUIRE( CStaticCache::IsNotModified_s( "\"64-1a2b\"", "", entry_ ) == true );                  // weak comparison
+   REQUIRE( CStaticCache::IsNotModified_s( "\"x\", W/\"64-1a2b\"", "", entry_ ) == true );
+   REQUIRE( CStaticCache::IsNotModified_s( "*", "", entry_ ) == true );
+   REQUIRE( CStaticCache::IsNotModified_s( "W/\"64-1a2\"", "", entry_ ) == false );
+   REQUIRE( CStaticCache::IsNotModified_s( "W/\"64-1a2b-g1\"", "", entry_ ) == false );
+   REQUIRE( CStaticCache::IsNotModified_s( "W/\"0-0\"", "Sun, 06 Nov 1994 08:49:37 GMT", entry_ ) == false ); // If-Modified-Since is ignored
+
+   // ## If-Modified-Since is compared as date
+   REQUIRE( CStaticCache::IsNotModified_s( "", "Sun, 06 Nov 1994 08:49:37 GMT", entry_ ) == true );
+   REQUIRE( CStaticCache::IsNotModified_s( "", "Mon, 07 Nov 1994 00:00:00 GMT", entry_ ) == true );
+   REQUIRE( CStaticCache::IsNotModified_s( "", "Sun, 06 Nov 1994 08:49:36 GMT", entry_ ) == false );
+   REQUIRE( CStaticCache::IsNotModified_s( "", "Sun, 6 Nov 1994 08:49:37 GMT", entry_ ) == true );
+   REQUIRE( CStaticCache::IsNotModified_s( "", "not a date", entry_ ) == false );
+   REQUIRE( CStaticCache::IsNotModified_s( "", "", entry_ ) == false );
+}
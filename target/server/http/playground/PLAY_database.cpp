@@ -21,6 +21,8 @@
 
 #include "gd/parse/gd_parse_uri.h"
 
+#include "../service/SERVICE_BulkInsert.h"
+
 #include "main.h"
 
 #include "catch2/catch_amalgamated.hpp"
@@ -99,6 +101,154 @@ TEST_CASE( "[database] sqlite select to table", "[database]" )
 #endif
 }
 
+/**
+ * @brief Rows from cursor are copied into table with a column plan
+ *
+ * Numbers with same type are copied as bytes, other columns are converted. Table
+ * columns not in result are null. Row count pass reserve blocks (64, 128 ...).
+ */
+TEST_CASE( "[database] sqlite cursor to table with copy plan", "[database]" )
+{
+   gd::database::sqlite::database databaseSqlite;
+   auto result_ = databaseSqlite.open( ":memory:", {"create", "write"});                        REQUIRE(result_.first == true);
+   result_ = databaseSqlite.execute( "CREATE TABLE TValue (ValueK INTEGER PRIMARY KEY, FName TEXT, FCount INTEGER, FPrice REAL);" ); REQUIRE( result_.first == true );
+   result_ = databaseSqlite.execute( "WITH RECURSIVE n(x) AS (SELECT 0 UNION ALL SELECT x + 1 FROM n WHERE x < 299) "
+                                     "INSERT INTO TValue (ValueK, FName, FCount, FPrice) SELECT x, 'n' || x, CASE WHEN x % 10 = 0 THEN NULL ELSE x * 2 END, x * 0.5 FROM n;" ); REQUIRE( result_.first == true );
+
+   // ## empty table, columns are generated from result and all values are copied
+   {
+      gd::database::sqlite::cursor cursor_( &databaseSqlite );
+      result_ = cursor_.open( "SELECT ValueK, FName, FCount, FPrice FROM TValue ORDER BY ValueK;" ); REQUIRE( result_.first == true );
+      gd::database::sqlite::cursor_i pcursor_i;
+      pcursor_i.attach( &cursor_ );
+
+      gd::table::dto::table tableResult;
+      gd::database::to_table( &pcursor_i, &tableResult );
+      REQUIRE( tableResult.get_row_count() == 300 );
+      for( uint64_t uRow = 0; uRow < 300; uRow++ )
+      {
+         REQUIRE( tableResult.cell_get_variant_view( uRow, 0u ).as_int64() == (int64_t)uRow );
+         REQUIRE( tableResult.cell_get_variant_view( uRow, 1u ).as_string() == "n" + std::to_string( uRow ) );
+         if( uRow % 10 == 0 ) { REQUIRE( tableResult.cell_get_variant_view( uRow, 2u ).is_null() == true ); }
+         else                 { REQUIRE( tableResult.cell_get_variant_view( uRow, 2u ).as_int64() == (int64_t)uRow * 2 ); }
+         REQUIRE( tableResult.cell_get_variant_view( uRow, 3u ).as_double() == uRow * 0.5 );
+      }
+      pcursor_i.detach();
+   }
+
+   // ## table with own columns, matched by name, int32 is converted and column not in result is null
+   {
+      gd::database::sqlite::cursor cursor_( &databaseSqlite );
+      result_ = cursor_.open( "SELECT ValueK, FCount, FName FROM TValue ORDER BY ValueK;" );     REQUIRE( result_.first == true );
+      gd::database::sqlite::cursor_i pcursor_i;
+      pcursor_i.attach( &cursor_ );
+
+      gd::table::dto::table tableResult( gd::table::dto::table::eTableFlagNull32, { {"int32", 0, "FCount"}, {"string", 20, "FName"}, {"double", 0, "FMissing"} }, gd::table::tag_prepare{} );
+      gd::database::to_table( &pcursor_i, &tableResult );
+      REQUIRE( tableResult.get_row_count() == 300 );
+      REQUIRE( tableResult.cell_get_variant_view( 7u, 0u ).as_int64() == 14 );
+      REQUIRE( tableResult.cell_get_variant_view( 7u, 1u ).as_string() == "n7" );
+      REQUIRE( tableResult.cell_get_variant_view( 7u, 2u ).is_null() == true );
+      REQUIRE( tableResult.cell_get_variant_view( 10u, 0u ).is_null() == true );
+      REQUIRE( tableResult.cell_get_variant_view( 299u, 1u ).as_string() == "n299" );
+      pcursor_i.detach();
+   }
+
+   databaseSqlite.close();
+}
+
+TEST_CASE( "[database] bulk insert with batched commits", "[database]" )
+{
+   using namespace gd::sql;
+   std::string stringDatabaseFile = ( std::filesystem::temp_directory_path() / "play-bulk-insert.sqlite" ).string();
+   for( auto stringEnd : { "", "-wal", "-shm" } ) { std::filesystem::remove( stringDatabaseFile + stringEnd ); }
+
+   auto* pdatabase = new gd::database::sqlite::database_i( "sqlite" );
+   auto result_ = pdatabase->m_pdatabase->open( stringDatabaseFile, {"create", "write"} );       REQUIRE( result_.first == true );
+   result_ = pdatabase->execute( "PRAGMA journal_mode = WAL;" );                                REQUIRE( result_.first == true );
+   result_ = pdatabase->execute( "CREATE TABLE TValue (ValueK INTEGER PRIMARY KEY, FName TEXT, FCount INTEGER);" ); REQUIRE( result_.first == true );
+
+   // ## second connection only sees committed rows
+   gd::database::sqlite::database databaseRead;
+   result_ = databaseRead.open( stringDatabaseFile, {"write"} );                                REQUIRE( result_.first == true );
+   auto count_ = [&databaseRead]() -> int64_t {
+      gd::variant variantCount;
+      auto result_ = databaseRead.ask( "SELECT COUNT(*) FROM TValue;", &variantCount );        REQUIRE( result_.first == true );
+      return variantCount.as_int64();
+   };
+
+   // ## rows with same columns use one statement, transaction is committed each 4 rows
+   {
+      SERVICE::CBulkInsert bulkinsert_( pdatabase, 4 );
+      std::array<std::byte, 128> buffer_;
+      std::string stringKey = "FName\nFCount\n";
+      for( int iRow = 0; iRow < 10; iRow++ )
+      {
+         std::string stringName = "name" + std::to_string( iRow );
+         std::string stringCount = std::to_string( iRow * 10 );
+         std::vector<gd::variant_view> vectorValue = { gd::variant_view( std::string_view( stringName ) ), gd::variant_view( std::string_view( stringCount ) ) };
+
+         auto* pstatement = bulkinsert_.Find( stringKey );
+         if( pstatement == nullptr )
+         {
+            query queryInsert{ eSqlDialectSqlite };
+            queryInsert << table_g( "TValue" );
+            queryInsert << field_g( "TValue", "FName", buffer_ ).value( stringName ).type( gd::types::type_g( "string" ) );
+            queryInsert << field_g( "TValue", "FCount", buffer_ ).value( stringCount ).type( gd::types::type_g( "int64" ) );
+            result_ = bulkinsert_.Add( stringKey, queryInsert, &pstatement );                  REQUIRE( result_.first == true );
+         }
+         result_ = bulkinsert_.Execute( pstatement, vectorValue );                               REQUIRE( result_.first == true );
+      }
+      REQUIRE( bulkinsert_.GetStatementCount() == 1 );
+      REQUIRE( bulkinsert_.GetRowCount() == 10 );
+      REQUIRE( count_() == 8 );                                                                 // two batches committed
+      result_ = bulkinsert_.Commit();                                                           REQUIRE( result_.first == true );
+      REQUIRE( count_() == 10 );
+   }
+
+   gd::variant variantSum;
+   result_ = databaseRead.ask( "SELECT SUM(FCount) FROM TValue WHERE typeof(FCount) = 'integer';", &variantSum ); REQUIRE( result_.first == true );
+   REQUIRE( variantSum.as_int64() == 450 );                                                     // values are bound with column type
+
+   // ## template sql, sql without values is not cached and cache is limited
+   {
+      SERVICE::CBulkInsert bulkinsert_( pdatabase, 0 );
+      bulkinsert_.m_uStatementMax = 4;
+      for( int iRow = 0; iRow < 20; iRow++ )
+      {
+         std::string stringSql = "INSERT INTO TValue (FName, FCount) VALUES( 'text" + std::to_string( iRow ) + "', " + std::to_string( iRow ) + " )";
+         result_ = bulkinsert_.Execute( stringSql, {} );                                         REQUIRE( result_.first == true );
+      }
+      REQUIRE( bulkinsert_.GetStatementCount() == 0 );
+
+      for( int iRow = 0; iRow < 20; iRow++ )
+      {
+         std::string stringSql = "INSERT INTO TValue (FName, FCount) VALUES( 'bound" + std::to_string( iRow % 6 ) + "', ? )";
+         result_ = bulkinsert_.Execute( stringSql, { gd::variant( int64_t( iRow ) ) } );         REQUIRE( result_.first == true );
+         REQUIRE( bulkinsert_.GetStatementCount() <= 4 );
+      }
+      REQUIRE( bulkinsert_.GetRowCount() == 40 );
+      REQUIRE( count_() == 10 );                                                                // commit = 0, all rows in one transaction
+      result_ = bulkinsert_.Commit();                                                           REQUIRE( result_.first == true );
+      REQUIRE( count_() == 50 );
+   }
+
+   // ## rows not committed are rolled back
+   {
+      SERVICE::CBulkInsert bulkinsert_( pdatabase, 3 );
+      for( int iRow = 0; iRow < 5; iRow++ )
+      {
+         result_ = bulkinsert_.Execute( std::string( "INSERT INTO TValue (FName) VALUES( ? )" ), { gd::variant( "rollback" ) } ); REQUIRE( result_.first == true );
+      }
+      REQUIRE( bulkinsert_.IsTransaction() == true );
+   }
+   REQUIRE( count_() == 53 );
+
+   databaseRead.close();
+   pdatabase->release();
+   for( auto stringEnd : { "", "-wal", "-shm" } ) { std::filesystem::remove( stringDatabaseFile + stringEnd ); }
+}
+
 TEST_CASE( "[database] sqlite select to table with callback", "[database]" )
 {
    std::string stringDatabaseFile = "test01.sqlite";
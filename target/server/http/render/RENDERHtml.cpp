@@ -1,98 +1,67 @@
 // @PAGE [tag: html, render] [summary: Render HTML pages with embedded code] [description: Implement a renderer for HTML pages that can execute embedded Lua, GD, and expression code] [type: source] [name: RENDERHtml.cpp]
 
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <fstream>
 #include <filesystem>
-
-#include "gd/parse/gd_parse_window_line.h"
-#include "gd/expression/gd_expression_parse_state.h"
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+#include <unordered_map>
 
 #include "../api/API_Base.h"
 #include "../Document.h"
 
 #include "RENDERHtml.h"
 
-std::pair<bool, std::string> CRENDERHtml::Render( std::string& stringRendered )
-{
-   enum enumLanguage { eLanguageNone = 0, eLanguageLua, eLanguageGD, eLanguageExpression };
-   gd::parse::window::line lineBuffer(48 * 64, 64 * 64, gd::types::tag_create{});  // create line buffer 64 * 64 = 4096 bytes = 64 cache lines
-   gd::expression::parse::state state_; // state is used to check what type of code part we are in
-   const gd::expression::parse::state::rule* pruleActive = nullptr; // pointer to active rule, this is used to check what type of code part we are in and to get end marker for code part
-
-   std::string stringPage;
-   std::string stringCode; // string to hold code found in page, this will be used to render page
-
-   stringPage.reserve(1024 * 8);                                              // reserve space for page
-   stringCode.reserve(1024);                                                  // reserve space for code
-
-   std::ifstream file_(m_stringPath.data(), std::ios::binary);
-   if(file_.is_open() == false) return { false, "Failed to open file: " + std::string(m_stringPath) };
+namespace {
+   /// compiled page in cache and when it was used
+   struct cached_page_
+   {
+      std::shared_ptr<const CRENDERHtml::page> m_ppage;
+      std::atomic<uint64_t> m_uUse{ 0 };                                       ///< last use, set with shared lock
+   };
 
-   auto uAvailable = lineBuffer.available();
-   file_.read((char*)lineBuffer.buffer(), uAvailable);
-   auto uReadSize = file_.gcount();                                           // get number of valid bytes read
-   lineBuffer.update(uReadSize);                                              // Update valid size in line buffer
+   std::shared_mutex sharedmutexPage_g;                                        ///< lock for compiled pages
+   std::unordered_map<std::string, cached_page_> mapPage_g;                    ///< file path -> compiled page
+   uint64_t uCacheSize_g = 0;                                                  ///< size of page text in cache
+   std::atomic<uint64_t> uUseCounter_g{ 0 };                                   ///< incremented each time a page is used
 
-   state_.add(std::string_view("SCRIPTCODE"), "[[lua", "]]");
-   state_.add(std::string_view("SCRIPTCODE"), "[[gd", "]]");
-   state_.add(std::string_view("EXPRESSION"), "[[=", "]]");
+   /// Read file size and last write time, false if file is not found
+   bool stat_( const std::string& stringFile, uint64_t& uSize, int64_t& iTime )
+   {
+      std::error_code errorcode_;
+      std::filesystem::directory_entry entry_( stringFile, errorcode_ );
+      if( errorcode_ || entry_.is_regular_file( errorcode_ ) == false ) return false;
+      uSize = entry_.file_size( errorcode_ );
+      if( errorcode_ ) return false;
+      auto time_ = entry_.last_write_time( errorcode_ );
+      if( errorcode_ ) return false;
+      iTime = (int64_t)time_.time_since_epoch().count();
+      return true;
+   }
+}
 
-   uint8_t uCharacter = 0;                                                    // character to hold current character
+/** --------------------------------------------------------------------------- Render
+ * @brief Render page, static text is copied from compiled page and code blocks are run
+ * @param stringRendered receives rendered page
+ */
+std::pair<bool, std::string> CRENDERHtml::Render( std::string& stringRendered )
+{
+   std::shared_ptr<const page> ppage;
+   auto result_ = GetPage_s( m_stringPath, ppage );
+   if( result_.first == false ) return result_;
 
+   std::string stringPage;
+   stringPage.reserve( ppage->m_uTextSize + 1024 );                           // static text and some space for generated text
 
-   // ## Scan file and read lines found in table
-   while(lineBuffer.eof() == false)
+   for( const auto& segment_ : ppage->m_vectorSegment )
    {
-      auto [first_, last_] = lineBuffer.range(gd::types::tag_pair{});         // get range of valid data in buffer
-      for(auto it = first_; it < last_; it++)
-      {
-         uCharacter = *it;                                                    // get current character
-
-         if(state_.in_state() == false)                                       // not in a state? that means we are reading page code
-         {
-            // ## check if we have found state ...............................
-            if(state_[uCharacter] != 0 && state_.exists(it) == true)
-            {
-               stringCode.clear();                                            // clear code string to start reading new code
-               auto uLength = state_.activate(it);                            // activate state
-               if(uLength > 1) it += (uLength - 1);                           // skip to end of state marker and if it is more than 1 character, skip to end of state
-               pruleActive = state_.get_active_rule_pointer();                // get pointer to active rule, this will be used to check for end of state
-               continue;                                                      // continue to next character, we will start reading code in next iteration
-            }
-
-            stringPage += uCharacter;                                         // add character to page string
-         }
-         else
-         {
-            // ## check if we have found end of state
-            unsigned uLength;
-            if(state_.deactivate(it, &uLength) == true)
-            {
-               if(uLength > 1) it += (uLength - 1);                           // skip to end of state marker and if it is more than 1 character, skip to end of state
-
-               if(stringCode.empty() == false)
-               {                                                              assert( pruleActive != nullptr);
-                  auto stringType = std::string_view(pruleActive->get_start()).substr(2);// get code type from start marker, this will be used to determine how to render code
-                  auto reult_ = Run(stringType, stringCode, &stringPage);      // run code and get result, this will be used to render page
-               }
-               pruleActive = nullptr;
-               continue;
-            }
-
-            stringCode += uCharacter;                                         // add character to code string
-         }
-      }
-
-      lineBuffer.rotate();                                                    // rotate buffer
+      if( segment_.m_eType == eSegmentText ) { stringPage += ppage->text( segment_ ); continue; }
 
-      if(uReadSize > 0)                                                       // was it possible to read data last read, then more data is available
-      {
-         auto uAvailable = lineBuffer.available();                            // get available space in buffer to be filled
-         file_.read((char*)lineBuffer.buffer(), lineBuffer.available());      // read more data into available space in buffer
-         uReadSize = file_.gcount();
-         lineBuffer.update(uReadSize);                                        // update valid size in line buffer
-      }
+      std::string_view stringType = segment_.m_eType == eSegmentLua ? "lua" : ( segment_.m_eType == eSegmentGD ? "gd" : "=" );
+      auto reult_ = Run( stringType, ppage->text( segment_ ), &stringPage );  // run code and get result, this will be used to render page
    }
 
    stringRendered = std::move(stringPage);                                    // for now we just return the page
@@ -114,3 +83,145 @@ std::pair<bool, std::string> CRENDERHtml::Run(std::string_view stringType, std::
    
    return { true, "" };
 }
+
+/** --------------------------------------------------------------------------- GetPage_s
+ * @brief Get compiled page for file
+ *
+ * Pages are compiled once and kept in cache keyed by path. File size and last write
+ * time are checked for each call, a changed file is read and compiled again. File is
+ * read without holding the lock so other pages can be served meanwhile.
+ *
+ * Cache size is limited to `m_uCacheMaxSize_s` bytes of page text, least recently
+ * used pages are removed when cache is full. Pages larger than `m_uPageMaxSize_s`
+ * are compiled for each call and not kept in cache.
+ *
+ * @param stringPath path to page file
+ * @param ppage receives compiled page
+ * @return true if page is found, false and error if file could not be read
+ */
+std::pair<bool, std::string> CRENDERHtml::GetPage_s( std::string_view stringPath, std::shared_ptr<const page>& ppage )
+{
+   std::string stringFile( stringPath );
+   uint64_t uSize = 0;
+   int64_t iTime = 0;
+   if( stat_( stringFile, uSize, iTime ) == false ) return { false, "Failed to open file: " + stringFile };
+
+   {
+      std::shared_lock lock_( sharedmutexPage_g );
+      auto it = mapPage_g.find( stringFile );
+      if( it != mapPage_g.end() && it->second.m_ppage->m_uFileSize == uSize && it->second.m_ppage->m_iFileTime == iTime )
+      {
+         it->second.m_uUse.store( ++uUseCounter_g, std::memory_order_relaxed );
+         ppage = it->second.m_ppage;
+         return { true, "" };
+      }
+   }
+
+   // ## read and compile page ...............................................
+   auto ppageNew = std::make_shared<page>();
+   std::ifstream file_( stringFile, std::ios::binary );
+   if( file_.is_open() == false ) return { false, "Failed to open file: " + stringFile };
+
+   ppageNew->m_stringText.resize( uSize );
+   file_.read( ppageNew->m_stringText.data(), static_cast<std::streamsize>( uSize ) );
+   ppageNew->m_stringText.resize( static_cast<std::size_t>( file_.gcount() ) );
+   ppageNew->m_uFileSize = uSize;
+   ppageNew->m_iFileTime = iTime;
+   Compile_s( *ppageNew );
+
+   uint64_t uPageSize = ppageNew->m_stringText.size();
+   if( uPageSize <= m_uPageMaxSize_s )
+   {
+      std::unique_lock lock_( sharedmutexPage_g );
+      auto [it, bInsert] = mapPage_g.try_emplace( std::move( stringFile ) );
+      if( bInsert == false ) { uCacheSize_g -= it->second.m_ppage->m_stringText.size(); }
+      it->second.m_ppage = ppageNew;
+      it->second.m_uUse.store( ++uUseCounter_g, std::memory_order_relaxed );
+      uCacheSize_g += uPageSize;
+
+      // ## remove least recently used pages until cache is below max size, page just added is the most recently used
+      while( uCacheSize_g > m_uCacheMaxSize_s && mapPage_g.size() > 1 )
+      {
+         auto itOldest = mapPage_g.begin();
+         for( auto itPage = mapPage_g.begin(); itPage != mapPage_g.end(); itPage++ )
+         {
+            if( itPage->second.m_uUse.load( std::memory_order_relaxed ) < itOldest->second.m_uUse.load( std::memory_order_relaxed ) ) itOldest = itPage;
+         }
+         uCacheSize_g -= itOldest->second.m_ppage->m_stringText.size();
+         mapPage_g.erase( itOldest );
+      }
+   }
+
+   ppage = std::move( ppageNew );
+   return { true, "" };
+}
+
+/** --------------------------------------------------------------------------- Compile_s
+ * @brief Split page text into static text and code blocks
+ *
+ * Code blocks are `[[lua ... ]]`, `[[gd ... ]]` and `[[= ... ]]`. Empty blocks are
+ * removed and a block without end marker removes the rest of the page. Lua
+ * blocks are checked for `Execute` calls to know if page needs the write
+ * connection, read connections are read-only so a missed write fails.
+ *
+ * @param page_ page with text to compile, segments are replaced
+ */
+void CRENDERHtml::Compile_s( page& page_ )
+{
+   std::string_view stringText( page_.m_stringText );
+   page_.m_vectorSegment.clear();
+   page_.m_uTextSize = 0;
+   page_.m_bLua = false;
+   page_.m_bWrite = false;
+
+   auto add_ = [&page_, &stringText]( enumSegment eType, std::size_t uOffset, std::size_t uLength ) {
+      if( uLength == 0 ) return;
+      page_.m_vectorSegment.push_back( { eType, uOffset, uLength } );
+      if( eType == eSegmentText ) page_.m_uTextSize += uLength;
+      else if( eType == eSegmentLua )
+      {
+         page_.m_bLua = true;
+         if( stringText.substr( uOffset, uLength ).find( "Execute" ) != std::string_view::npos ) page_.m_bWrite = true;
+      }
+   };
+
+   std::size_t uText = 0;                                                      // start of static text not added to segments
+   std::size_t uPosition = 0;
+   while( ( uPosition = stringText.find( "[[", uPosition ) ) != std::string_view::npos )
+   {
+      // ## check type of code block .........................................
+      std::string_view stringMarker = stringText.substr( uPosition + 2 );
+      enumSegment eType;
+      std::size_t uMarkerLength;
+      if( stringMarker.starts_with( "lua" ) == true )    { eType = eSegmentLua; uMarkerLength = 5; }
+      else if( stringMarker.starts_with( "gd" ) == true ) { eType = eSegmentGD; uMarkerLength = 4; }
+      else if( stringMarker.starts_with( "=" ) == true )  { eType = eSegmentExpression; uMarkerLength = 3; }
+      else { uPosition++; continue; }
+
+      add_( eSegmentText, uText, uPosition - uText );
+
+      std::size_t uCode = uPosition + uMarkerLength;
+      std::size_t uEnd = stringText.find( "]]", uCode );
+      if( uEnd == std::string_view::npos ) { uText = stringText.length(); break; }
+
+      add_( eType, uCode, uEnd - uCode );
+      uText = uPosition = uEnd + 2;
+   }
+
+   add_( eSegmentText, uText, stringText.length() - uText );
+}
+
+/// Remove all compiled pages, pages in use are released when last request is done
+void CRENDERHtml::ClearCache_s()
+{
+   std::unique_lock lock_( sharedmutexPage_g );
+   mapPage_g.clear();
+   uCacheSize_g = 0;
+}
+
+/// Size of page text in cache
+uint64_t CRENDERHtml::GetCacheSize_s()
+{
+   std::shared_lock lock_( sharedmutexPage_g );
+   return uCacheSize_g;
+}
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -22,6 +24,36 @@ class CAPIContext;
  */
 class CRENDERHtml
 {
+public:
+   /// type of segment in compiled page
+   enum enumSegment { eSegmentText = 0, eSegmentLua, eSegmentGD, eSegmentExpression };
+
+   /** 
+    * @brief Page parsed once into static text and code blocks
+    *
+    * Page is not changed after it is compiled and is shared between requests,
+    * segments hold offset and length into `m_stringText`.
+    */
+   struct page
+   {
+      struct segment
+      {
+         enumSegment m_eType;       ///< static text or type of code
+         std::size_t m_uOffset;     ///< offset in page text
+         std::size_t m_uLength;     ///< length for text or code
+      };
+
+      std::string_view text( const segment& segment_ ) const { return std::string_view( m_stringText ).substr( segment_.m_uOffset, segment_.m_uLength ); }
+
+      std::string m_stringText;                 ///< file content
+      std::vector<segment> m_vectorSegment;     ///< static text and code blocks in page order
+      std::size_t m_uTextSize = 0;              ///< size of all static text, used to reserve rendered page
+      bool m_bLua = false;                      ///< page has lua code, lua code needs database connection
+      bool m_bWrite = false;                    ///< lua code calls `Execute`, needs write connection
+      uint64_t m_uFileSize = 0;                 ///< file size when page was compiled
+      int64_t m_iFileTime = 0;                  ///< last write time when page was compiled
+   };
+
    // @API [tag: construction]
 public:
    CRENDERHtml() {}
@@ -73,7 +105,17 @@ public:
 
 // @API [tag: free-functions]
 public:
-
+   /// Get compiled page for file, page is compiled on first use and again if file is changed
+   static std::pair<bool, std::string> GetPage_s( std::string_view stringPath, std::shared_ptr<const page>& ppage );
+   /// Parse page text into static text and code blocks
+   static void Compile_s( page& page_ );
+   /// Remove all compiled pages
+   static void ClearCache_s();
+   /// Size of page text in cache
+   static uint64_t GetCacheSize_s();
+
+   inline static uint64_t m_uCacheMaxSize_s = 16 * 1024 * 1024;               ///< max size of page text in cache, least recently used pages are removed
+   inline static uint64_t m_uPageMaxSize_s = 1024 * 1024;                     ///< pages larger than this are not kept in cache
 
 
 };
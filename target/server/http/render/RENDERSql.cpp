@@ -1716,12 +1716,12 @@ std::pair<bool, std::string> CRENDERSql::ToSql( std::string_view stringType, std
    return { false, "" };
 }
 
-std::pair<bool, std::string> CRENDERSql::ToSqlFromTemplate( std::string_view stringTemplate, std::string& stringQuery )
+std::pair<bool, std::string> CRENDERSql::ToSqlFromTemplate( std::string_view stringTemplate, std::string& stringQuery, std::vector<gd::variant>* pvectorBind )
 {
    gd::sql::query query_(m_eSqlDialect);
    Query_AddFields(&query_);
 
-   auto [bSuccess, stringError] = query_.sql_format( stringTemplate, stringQuery );
+   auto [bSuccess, stringError] = query_.sql_format( stringTemplate, stringQuery, nullptr, pvectorBind );
    if( bSuccess == false ) { return { false, "Failed to generate SQL from template: " + stringError }; }
 
    return { true, "" };
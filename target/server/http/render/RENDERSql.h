@@ -271,7 +271,9 @@ public:
    std::pair<bool, std::string> ToSqlUpdate( std::string& stringQuery );
    std::pair<bool, std::string> ToSqlDelete( std::string& stringQuery );
    std::pair<bool, std::string> ToSql( std::string_view stringType, std::string& stringQuery );
-   std::pair<bool, std::string> ToSqlFromTemplate( std::string_view stringTemplate, std::string& stringQuery );
+   std::pair<bool, std::string> ToSqlFromTemplate( std::string_view stringTemplate, std::string& stringQuery ) { return ToSqlFromTemplate( stringTemplate, stringQuery, nullptr ); }
+   /// Generate sql from template, values are added to `pvectorBind` and `?` is placed in sql if vector is set
+   std::pair<bool, std::string> ToSqlFromTemplate( std::string_view stringTemplate, std::string& stringQuery, std::vector<gd::variant>* pvectorBind );
 
    std::pair<bool, std::string> ToBulkInsert( const gd::argument::arguments& argumentsOptions, pugi::xml_document* pxmldocument, std::function<bool(std::string_view)> execute_ );
 
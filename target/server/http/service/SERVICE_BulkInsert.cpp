@@ -0,0 +1,174 @@
+// @FILE [tag: sql, insert, bulk] [description: Insert many rows with prepared statements in batched transactions] [name: SERVICE_BulkInsert.cpp] [type: source]
+
+#include <cassert>
+
+#include "gd/gd_sql_value.h"
+
+#include "SERVICE_BulkInsert.h"
+
+NAMESPACE_SERVICE_BEGIN
+
+CBulkInsert::~CBulkInsert()
+{
+   if( m_bTransaction == true ) m_pdatabase->transaction( "rollback" );       // not committed, error in insert
+   for( auto& it : m_mapStatement ) { it.second.m_pcursor->release(); }
+}
+
+/// Statement for key, key is columns in row or sql text
+CBulkInsert::statement* CBulkInsert::Find( const std::string& stringKey )
+{
+   auto it = m_mapStatement.find( stringKey );
+   if( it == m_mapStatement.end() ) return nullptr;
+   it->second.m_uUse = ++m_uUseCounter;
+   return &it->second;
+}
+
+/** ------------------------------------------------------------------------- Add
+ * @brief Prepare sql and add statement for key, least recently used statement is released if cache is full
+ * @param stringKey key to find statement with
+ * @param stringSql sql statement prepared
+ * @param ppstatement receives pointer to added statement
+ * @return true if ok, false and error information if prepare failed
+ */
+std::pair<bool, std::string> CBulkInsert::Add( const std::string& stringKey, std::string_view stringSql, statement** ppstatement )
+{                                                                                                  assert( ppstatement != nullptr );
+   statement statement_;
+   auto result_ = m_pdatabase->get_cursor( &statement_.m_pcursor );
+   if( result_.first == false ) return result_;
+   result_ = statement_.m_pcursor->prepare( stringSql );
+   if( result_.first == false ) { statement_.m_pcursor->release(); return result_; }
+
+   Evict();
+   statement_.m_uUse = ++m_uUseCounter;
+   *ppstatement = &m_mapStatement.emplace( stringKey, std::move( statement_ ) ).first->second;
+   return { true, "" };
+}
+
+/** ------------------------------------------------------------------------- Add
+ * @brief Add statement inserting fields in query, one `?` placeholder for each field
+ * @param stringKey key to find statement with, columns in row
+ * @param queryInsert query with fields, values in row have same order as fields in query
+ * @param ppstatement receives pointer to added statement
+ * @return true if ok, false and error information if prepare failed
+ */
+std::pair<bool, std::string> CBulkInsert::Add( const std::string& stringKey, const gd::sql::query& queryInsert, statement** ppstatement )
+{
+   std::string stringSql = "INSERT INTO " + queryInsert.sql_get_insert() + "\nVALUES( ";
+   std::vector< std::pair<unsigned, uint32_t> > vectorBind;
+   auto uTableKey = queryInsert.table_get_key();
+   unsigned uIndex = 0;
+   for( auto it = queryInsert.field_begin(); it != queryInsert.field_end(); it++, uIndex++ )
+   {
+      if( it->get_table_key() != uTableKey || it->is_insert() == false ) continue; // same fields as in `sql_get_insert`
+      if( vectorBind.empty() == false ) stringSql += ", ";
+      stringSql += '?';
+      vectorBind.emplace_back( uIndex, it->type() );
+   }
+   stringSql += ")";
+
+   auto result_ = Add( stringKey, stringSql, ppstatement );
+   if( result_.first == true ) { (*ppstatement)->m_vectorBind = std::move( vectorBind ); }
+   return result_;
+}
+
+/// Bind values in row to statement and execute, values are converted to column type
+std::pair<bool, std::string> CBulkInsert::Execute( statement* pstatement, const std::vector<gd::variant_view>& vectorValue )
+{                                                                                                  assert( pstatement != nullptr );
+   m_vectorBind.clear();
+   for( const auto& [uIndex, uType] : pstatement->m_vectorBind )
+   {                                                                                               assert( uIndex < vectorValue.size() );
+      const gd::variant_view& value_ = vectorValue[uIndex];
+      if( value_.is_string() == true ) m_vectorBind.push_back( gd::sql::to_bind_value_g( value_.as_string_view(), uType ) );
+      else                             m_vectorBind.push_back( value_.as_variant() );
+   }
+   return Execute( pstatement, m_vectorBind );
+}
+
+/// Bind values to statement and execute, commit each `m_uCommit` rows
+std::pair<bool, std::string> CBulkInsert::Execute( statement* pstatement, const std::vector<gd::variant>& vectorBind )
+{                                                                                                  assert( pstatement != nullptr );
+   Begin();
+
+   m_vectorView.clear();
+   for( const auto& it : vectorBind ) { m_vectorView.push_back( gd::variant_view( it ) ); }
+   auto result_ = pstatement->m_pcursor->bind( m_vectorView );
+   if( result_.first == true ) result_ = pstatement->m_pcursor->execute();
+   if( result_.first == false ) return result_;
+
+   return Next();
+}
+
+/** ------------------------------------------------------------------------- Execute
+ * @brief Execute sql with values to bind, statement is found or prepared with sql as key
+ *
+ * Sql without values is unique for each row (values are placed in sql text), it is
+ * executed directly and not added to cache.
+ *
+ * @param stringSql sql statement with `?` for each value
+ * @param vectorBind values bound to statement
+ * @return true if ok, false and error information on error
+ */
+std::pair<bool, std::string> CBulkInsert::Execute( const std::string& stringSql, const std::vector<gd::variant>& vectorBind )
+{
+   if( vectorBind.empty() == true ) return Execute( std::string_view( stringSql ) );
+
+   statement* pstatement = Find( stringSql );
+   if( pstatement == nullptr )
+   {
+      auto result_ = Add( stringSql, stringSql, &pstatement );
+      if( result_.first == false ) return result_;
+   }
+   return Execute( pstatement, vectorBind );
+}
+
+/// Execute sql without values to bind, statement is not cached
+std::pair<bool, std::string> CBulkInsert::Execute( std::string_view stringSql )
+{
+   Begin();
+   auto result_ = m_pdatabase->execute( stringSql );
+   if( result_.first == false ) return result_;
+   return Next();
+}
+
+/// Commit active transaction
+std::pair<bool, std::string> CBulkInsert::Commit()
+{
+   if( m_bTransaction == false ) return { true, "" };
+   m_bTransaction = false;
+   return m_pdatabase->transaction( "commit" );
+}
+
+/// Start transaction before first row, if transaction is active insert is done in that transaction
+void CBulkInsert::Begin()
+{
+   if( m_uRow == 0 ) m_bTransaction = m_pdatabase->transaction( "begin" ).first;
+}
+
+/// Count inserted row and commit if `m_uCommit` rows are inserted since last commit
+std::pair<bool, std::string> CBulkInsert::Next()
+{
+   m_uRow++;
+   if( m_bTransaction == true && m_uCommit > 0 && m_uRow % m_uCommit == 0 )
+   {
+      auto result_ = Commit();
+      if( result_.first == false ) return result_;
+      m_bTransaction = m_pdatabase->transaction( "begin" ).first;
+   }
+   return { true, "" };
+}
+
+/// Release least recently used statement if cache is full
+void CBulkInsert::Evict()
+{
+   if( m_mapStatement.size() < m_uStatementMax || m_mapStatement.empty() == true ) return;
+
+   auto itOldest = m_mapStatement.begin();
+   for( auto it = m_mapStatement.begin(); it != m_mapStatement.end(); it++ )
+   {
+      if( it->second.m_uUse < itOldest->second.m_uUse ) itOldest = it;
+   }
+   itOldest->second.m_pcursor->release();
+   m_mapStatement.erase( itOldest );
+}
+
+NAMESPACE_SERVICE_END
@@ -0,0 +1,117 @@
+// @FILE [tag: sql, insert, bulk] [description: Insert many rows with prepared statements in batched transactions] [name: SERVICE_BulkInsert.h] [type: header]
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gd/gd_database.h"
+#include "gd/gd_sql_query.h"
+#include "gd/gd_variant.h"
+#include "gd/gd_variant_view.h"
+
+#ifndef NAMESPACE_SERVICE_BEGIN
+
+#  define NAMESPACE_SERVICE_BEGIN namespace SERVICE {
+#  define NAMESPACE_SERVICE_END  }
+
+#endif
+
+NAMESPACE_SERVICE_BEGIN
+
+/** @CLASS [name: CBulkInsert] [description: Prepared insert statements for bulk insert, rows are inserted in batched transactions]
+ * \brief Insert rows with prepared statements, transaction is committed each `m_uCommit` rows
+ *
+ * Rows with the same columns (same shape) share one prepared statement, column types
+ * and the order values are bound in is resolved when first row with shape is added.
+ * Transaction is started before first row and committed each `m_uCommit` rows.
+ *
+ * Statements are cached with key, number of cached statements is limited to
+ * `m_uStatementMax`. When cache is full the least recently used statement is
+ * released. Sql without values to bind is executed directly and not cached.
+ *
+ \code
+ SERVICE::CBulkInsert bulkinsert_( pdatabase, 1000 );
+ for( const auto& row_ : vectorRow )
+ {
+    auto result_ = bulkinsert_.Execute( "INSERT INTO TTable( FName ) VALUES( ? )", { gd::variant( row_ ) } );
+    if( result_.first == false ) return result_;                                // not committed rows are rolled back when bulkinsert_ is destroyed
+ }
+ auto result_ = bulkinsert_.Commit();
+ \endcode
+ */
+class CBulkInsert
+{
+public:
+   /// prepared statement and how values in row are bound to it
+   struct statement
+   {
+      gd::database::cursor_i* m_pcursor = nullptr;
+      std::vector< std::pair<unsigned, uint32_t> > m_vectorBind; ///< index for value in row and column type for each parameter
+      uint64_t m_uUse = 0;                                        ///< last use, used to find least recently used statement
+   };
+
+// @API [tag: construction]
+public:
+   CBulkInsert( gd::database::database_i* pdatabase, uint64_t uCommit ): m_pdatabase( pdatabase ), m_uCommit( uCommit ) {}
+   CBulkInsert( const CBulkInsert& ) = delete;
+   CBulkInsert& operator=( const CBulkInsert& ) = delete;
+   ~CBulkInsert();
+
+// ## methods ------------------------------------------------------------------
+public:
+// @API [tag: get, set]
+   uint64_t GetRowCount() const { return m_uRow; }
+   size_t GetStatementCount() const { return m_mapStatement.size(); }
+   bool IsTransaction() const { return m_bTransaction; }
+
+// @API [tag: operation]
+   /// Statement for key, key is columns in row or sql text
+   statement* Find( const std::string& stringKey );
+
+   /// Prepare sql and add statement for key
+   std::pair<bool, std::string> Add( const std::string& stringKey, std::string_view stringSql, statement** ppstatement );
+   /// Add statement inserting query fields, values in row have same order as fields in query
+   std::pair<bool, std::string> Add( const std::string& stringKey, const gd::sql::query& queryInsert, statement** ppstatement );
+
+   /// Bind values in row to statement and execute, values are converted to column type
+   std::pair<bool, std::string> Execute( statement* pstatement, const std::vector<gd::variant_view>& vectorValue );
+   /// Bind values to statement and execute, commit each `m_uCommit` rows
+   std::pair<bool, std::string> Execute( statement* pstatement, const std::vector<gd::variant>& vectorBind );
+   /// Execute sql with values, statement is cached with sql as key
+   std::pair<bool, std::string> Execute( const std::string& stringSql, const std::vector<gd::variant>& vectorBind );
+   /// Execute sql without values to bind, statement is not cached
+   std::pair<bool, std::string> Execute( std::string_view stringSql );
+
+   /// Commit active transaction
+   std::pair<bool, std::string> Commit();
+
+protected:
+// @API [tag: internal]
+   /// Start transaction before first row
+   void Begin();
+   /// Count inserted row and commit if `m_uCommit` rows are inserted since last commit
+   std::pair<bool, std::string> Next();
+   /// Release least recently used statement if cache is full
+   void Evict();
+
+// ## attributes ----------------------------------------------------------------
+public:
+   gd::database::database_i* m_pdatabase;                ///< connection rows are inserted with
+   uint64_t m_uCommit;                                   ///< rows in each transaction, 0 = all rows in one transaction
+   uint64_t m_uStatementMax = m_uStatementMax_s;         ///< max number of cached statements
+   uint64_t m_uRow = 0;                                  ///< inserted rows
+   uint64_t m_uUseCounter = 0;                           ///< incremented each time a statement is used
+   bool m_bTransaction = false;                          ///< transaction is started by bulk insert
+   std::unordered_map<std::string, statement> m_mapStatement; ///< prepared statements
+   std::vector<gd::variant> m_vectorBind;                ///< buffer for values bound to statement
+   std::vector<gd::variant_view> m_vectorView;           ///< buffer for values bound to statement
+
+   inline static uint64_t m_uStatementMax_s = 32;        ///< default max number of cached statements
+};
+
+NAMESPACE_SERVICE_END